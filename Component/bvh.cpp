@@ -0,0 +1,480 @@
+#include "bvh.hpp"
+#include "camera.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Box {
+    glm::vec3 min = glm::vec3(std::numeric_limits<float>::max());
+    glm::vec3 max = glm::vec3(-std::numeric_limits<float>::max());
+
+    void grow(const glm::vec3& point) {
+        min = glm::min(min, point);
+        max = glm::max(max, point);
+    }
+
+    void grow(const glm::vec3& otherMin, const glm::vec3& otherMax) {
+        min = glm::min(min, otherMin);
+        max = glm::max(max, otherMax);
+    }
+
+    // 半表面积，只用于比较
+    float area() const {
+        const glm::vec3 size = glm::max(max - min, glm::vec3(0.0f));
+        return size.x * size.y + size.y * size.z + size.z * size.x;
+    }
+};
+
+float nodeArea(const BvhNode& node) {
+    const glm::vec3 size = glm::max(node.boundsMax - node.boundsMin, glm::vec3(0.0f));
+    return size.x * size.y + size.y * size.z + size.z * size.x;
+}
+
+// 与 FrustumCulling 的标量核心相同的运算顺序，叶子中的对象测试结果与线性剔除一致
+inline bool outsidePlane(const glm::vec4& plane, const glm::vec3& center, const glm::vec3& extents) {
+    const float distance = plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w;
+    const float extent = std::fabs(plane.x) * extents.x + std::fabs(plane.y) * extents.y + std::fabs(plane.z) * extents.z;
+    return distance + extent < 0.0f;
+}
+
+// 射线与包围盒的进入距离，未命中返回 false
+inline bool intersectBox(const glm::vec3& origin, const glm::vec3& inverseDirection,
+                         const glm::vec3& boxMin, const glm::vec3& boxMax, float maxDistance, float& entry) {
+    const glm::vec3 t0 = (boxMin - origin) * inverseDirection;
+    const glm::vec3 t1 = (boxMax - origin) * inverseDirection;
+    const glm::vec3 near = glm::min(t0, t1);
+    const glm::vec3 far = glm::max(t0, t1);
+    const float enter = std::max(std::max(near.x, near.y), std::max(near.z, 0.0f));
+    const float exit = std::min(std::min(far.x, far.y), std::min(far.z, maxDistance));
+    entry = enter;
+    return enter <= exit;
+}
+
+} // namespace
+
+struct Bvh::BuildContext {
+    std::vector<glm::vec3> centroids;
+    std::vector<glm::vec3> mins;
+    std::vector<glm::vec3> maxs;
+    std::vector<Box> bins;
+    std::vector<uint32_t> binCounts;
+    std::vector<float> rightAreas;
+};
+
+// ==================== Ray ====================
+
+Ray Ray::fromCamera(const Camera& camera, const glm::vec2& ndc) {
+    const glm::mat4 inverse = glm::inverse(camera.getProjectionMatrix() * camera.getViewMatrix());
+    glm::vec4 nearPoint = inverse * glm::vec4(ndc, -1.0f, 1.0f);
+    glm::vec4 farPoint = inverse * glm::vec4(ndc, 1.0f, 1.0f);
+    nearPoint /= nearPoint.w;
+    farPoint /= farPoint.w;
+
+    Ray ray;
+    ray.origin = glm::vec3(nearPoint);
+    ray.direction = glm::normalize(glm::vec3(farPoint) - glm::vec3(nearPoint));
+    return ray;
+}
+
+// ==================== Bvh ====================
+
+Bvh::Bvh(const BvhSettings& settings)
+    : m_settings(settings)
+{
+    m_settings.maxLeafSize = std::max(m_settings.maxLeafSize, 1u);
+    m_settings.maxSahLeafSize = std::max(m_settings.maxSahLeafSize, m_settings.maxLeafSize);
+    m_settings.binCount = std::min(std::max(m_settings.binCount, 2u), 64u);
+}
+
+void Bvh::clear() {
+    m_nodes.clear();
+    m_objectIndices.clear();
+    m_stats = BvhStats();
+}
+
+void Bvh::build(const CullingBounds& bounds) {
+    const auto start = Clock::now();
+    const uint32_t rebuilds = m_stats.rebuilds;
+    clear();
+    m_stats.rebuilds = rebuilds;
+
+    const size_t count = bounds.size();
+    m_stats.objects = count;
+    if (count == 0) {
+        return;
+    }
+
+    BuildContext context;
+    context.centroids.resize(count);
+    context.mins.resize(count);
+    context.maxs.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        const glm::vec3 center(bounds.centerX()[i], bounds.centerY()[i], bounds.centerZ()[i]);
+        const glm::vec3 extents(bounds.extentX()[i], bounds.extentY()[i], bounds.extentZ()[i]);
+        context.centroids[i] = center;
+        context.mins[i] = center - extents;
+        context.maxs[i] = center + extents;
+    }
+    context.bins.resize(m_settings.binCount);
+    context.binCounts.resize(m_settings.binCount);
+    context.rightAreas.resize(m_settings.binCount);
+
+    m_objectIndices.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        m_objectIndices[i] = static_cast<uint32_t>(i);
+    }
+    // 二叉树最多 2n-1 个节点
+    m_nodes.reserve(count * 2);
+    buildNode(context, 0, static_cast<uint32_t>(count), 1);
+
+    m_stats.nodes = m_nodes.size();
+    m_stats.buildCost = computeCost();
+    m_stats.cost = m_stats.buildCost;
+    m_stats.buildMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+uint32_t Bvh::buildNode(BuildContext& context, uint32_t begin, uint32_t end, uint32_t depth) {
+    const uint32_t nodeIndex = static_cast<uint32_t>(m_nodes.size());
+    m_nodes.push_back(BvhNode());
+    m_stats.depth = std::max(m_stats.depth, depth);
+
+    Box box;
+    Box centroidBox;
+    for (uint32_t i = begin; i < end; ++i) {
+        const uint32_t object = m_objectIndices[i];
+        box.grow(context.mins[object], context.maxs[object]);
+        centroidBox.grow(context.centroids[object]);
+    }
+    m_nodes[nodeIndex].boundsMin = box.min;
+    m_nodes[nodeIndex].boundsMax = box.max;
+
+    const uint32_t count = end - begin;
+    auto makeLeaf = [&]() {
+        m_nodes[nodeIndex].offset = begin;
+        m_nodes[nodeIndex].count = count;
+        m_stats.leaves++;
+        return nodeIndex;
+    };
+    if (count <= m_settings.maxLeafSize) {
+        return makeLeaf();
+    }
+
+    // 分箱SAH: 每个轴把质心范围等分为 binCount 份，在箱边界处评估划分代价
+    const uint32_t binCount = m_settings.binCount;
+    int bestAxis = -1;
+    uint32_t bestSplit = 0;
+    float bestCost = std::numeric_limits<float>::max();
+    for (int axis = 0; axis < 3; ++axis) {
+        const float extent = centroidBox.max[axis] - centroidBox.min[axis];
+        if (!(extent > 0.0f)) {
+            continue;
+        }
+        const float scale = static_cast<float>(binCount) / extent;
+
+        std::fill(context.bins.begin(), context.bins.end(), Box());
+        std::fill(context.binCounts.begin(), context.binCounts.end(), 0u);
+        for (uint32_t i = begin; i < end; ++i) {
+            const uint32_t object = m_objectIndices[i];
+            const uint32_t bin = std::min(binCount - 1,
+                static_cast<uint32_t>((context.centroids[object][axis] - centroidBox.min[axis]) * scale));
+            context.bins[bin].grow(context.mins[object], context.maxs[object]);
+            context.binCounts[bin]++;
+        }
+
+        Box right;
+        for (uint32_t bin = binCount - 1; bin > 0; --bin) {
+            right.grow(context.bins[bin].min, context.bins[bin].max);
+            context.rightAreas[bin] = right.area();
+        }
+
+        Box left;
+        uint32_t leftCount = 0;
+        for (uint32_t split = 0; split + 1 < binCount; ++split) {
+            left.grow(context.bins[split].min, context.bins[split].max);
+            leftCount += context.binCounts[split];
+            const uint32_t rightCount = count - leftCount;
+            if (leftCount == 0 || rightCount == 0) {
+                continue;
+            }
+            const float cost = leftCount * left.area() + rightCount * context.rightAreas[split + 1];
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestAxis = axis;
+                bestSplit = split;
+            }
+        }
+    }
+
+    uint32_t middle = begin + count / 2;
+    if (bestAxis >= 0) {
+        // 遍历代价 1、求交代价 1 (每个对象)
+        const float area = box.area();
+        const float splitCost = 1.0f + (area > 0.0f ? bestCost / area : 0.0f);
+        if (splitCost >= static_cast<float>(count) && count <= m_settings.maxSahLeafSize) {
+            return makeLeaf();
+        }
+
+        const float scale = static_cast<float>(binCount) / (centroidBox.max[bestAxis] - centroidBox.min[bestAxis]);
+        const float axisMin = centroidBox.min[bestAxis];
+        auto* split = std::partition(m_objectIndices.data() + begin, m_objectIndices.data() + end, [&](uint32_t object) {
+            const uint32_t bin = std::min(binCount - 1, static_cast<uint32_t>((context.centroids[object][bestAxis] - axisMin) * scale));
+            return bin <= bestSplit;
+        });
+        middle = static_cast<uint32_t>(split - m_objectIndices.data());
+        if (middle == begin || middle == end) {
+            middle = begin + count / 2;
+        }
+    }
+    // 质心全部重合时 (bestAxis < 0) 按当前顺序对半分
+
+    buildNode(context, begin, middle, depth + 1);
+    const uint32_t rightChild = buildNode(context, middle, end, depth + 1);
+    m_nodes[nodeIndex].offset = rightChild;
+    m_nodes[nodeIndex].count = 0;
+    return nodeIndex;
+}
+
+void Bvh::refit(const CullingBounds& bounds) {
+    if (m_nodes.empty() || bounds.size() != m_stats.objects) {
+        return;
+    }
+    const auto start = Clock::now();
+
+    // 子节点下标总大于父节点，逆序遍历即为自底向上
+    const float* centerX = bounds.centerX();
+    const float* centerY = bounds.centerY();
+    const float* centerZ = bounds.centerZ();
+    const float* extentX = bounds.extentX();
+    const float* extentY = bounds.extentY();
+    const float* extentZ = bounds.extentZ();
+    for (size_t i = m_nodes.size(); i-- > 0;) {
+        BvhNode& node = m_nodes[i];
+        Box box;
+        if (node.isLeaf()) {
+            for (uint32_t j = node.offset; j < node.offset + node.count; ++j) {
+                const uint32_t object = m_objectIndices[j];
+                const glm::vec3 center(centerX[object], centerY[object], centerZ[object]);
+                const glm::vec3 extents(extentX[object], extentY[object], extentZ[object]);
+                box.grow(center - extents, center + extents);
+            }
+        } else {
+            const BvhNode& left = m_nodes[i + 1];
+            const BvhNode& right = m_nodes[node.offset];
+            box.grow(left.boundsMin, left.boundsMax);
+            box.grow(right.boundsMin, right.boundsMax);
+        }
+        node.boundsMin = box.min;
+        node.boundsMax = box.max;
+    }
+
+    m_stats.cost = computeCost();
+    m_stats.refitsSinceBuild++;
+    m_stats.refitMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+bool Bvh::update(const CullingBounds& bounds) {
+    if (m_nodes.empty() || bounds.size() != m_stats.objects) {
+        build(bounds);
+        return true;
+    }
+
+    refit(bounds);
+    const bool degraded = m_stats.cost > m_stats.buildCost * m_settings.rebuildRatio;
+    const bool scheduled = m_settings.rebuildInterval > 0 && m_stats.refitsSinceBuild >= m_settings.rebuildInterval;
+    if (degraded || scheduled) {
+        m_stats.rebuilds++;
+        build(bounds);
+        return true;
+    }
+    return false;
+}
+
+float Bvh::computeCost() const {
+    if (m_nodes.empty()) {
+        return 0.0f;
+    }
+    const float rootArea = nodeArea(m_nodes[0]);
+    if (!(rootArea > 0.0f)) {
+        return 0.0f;
+    }
+    double cost = 0.0;
+    for (const BvhNode& node : m_nodes) {
+        cost += nodeArea(node) * (node.isLeaf() ? static_cast<double>(node.count) : 1.0);
+    }
+    return static_cast<float>(cost / rootArea);
+}
+
+void Bvh::cull(const Frustum& frustum, const CullingBounds& bounds, std::vector<uint32_t>& visible,
+               BvhQueryStats* queryStats) const {
+    visible.clear();
+    BvhQueryStats local;
+    if (m_nodes.empty() || bounds.size() != m_stats.objects) {
+        if (queryStats) {
+            *queryStats = local;
+        }
+        return;
+    }
+
+    struct Entry {
+        uint32_t node;
+        uint32_t planeMask;     // 仍需测试的平面
+    };
+    std::vector<Entry> stack;
+    stack.reserve(64);
+    stack.push_back({ 0, 0x3Fu });
+
+    while (!stack.empty()) {
+        const Entry entry = stack.back();
+        stack.pop_back();
+        const BvhNode& node = m_nodes[entry.node];
+        local.nodesVisited++;
+
+        const glm::vec3 center = (node.boundsMin + node.boundsMax) * 0.5f;
+        const glm::vec3 extents = (node.boundsMax - node.boundsMin) * 0.5f;
+        uint32_t mask = entry.planeMask;
+        bool outside = false;
+        for (int p = 0; p < 6 && !outside; ++p) {
+            if (!(mask & (1u << p))) {
+                continue;
+            }
+            const glm::vec4& plane = frustum.planes[p];
+            const float distance = glm::dot(glm::vec3(plane), center) + plane.w;
+            const float extent = glm::dot(glm::abs(glm::vec3(plane)), extents);
+            if (distance + extent < 0.0f) {
+                outside = true;
+            } else if (distance - extent >= 0.0f) {
+                mask &= ~(1u << p);
+            }
+        }
+        if (outside) {
+            continue;
+        }
+
+        if (mask == 0) {
+            // 子树完全在视锥内: 深度优先排列使其对象在 objectIndices 中连续
+            uint32_t first = entry.node;
+            while (!m_nodes[first].isLeaf()) {
+                first = first + 1;
+            }
+            uint32_t last = entry.node;
+            while (!m_nodes[last].isLeaf()) {
+                last = m_nodes[last].offset;
+            }
+            const uint32_t* begin = m_objectIndices.data() + m_nodes[first].offset;
+            const uint32_t* end = m_objectIndices.data() + m_nodes[last].offset + m_nodes[last].count;
+            visible.insert(visible.end(), begin, end);
+            continue;
+        }
+
+        if (node.isLeaf()) {
+            for (uint32_t j = node.offset; j < node.offset + node.count; ++j) {
+                const uint32_t object = m_objectIndices[j];
+                const glm::vec3 objectCenter(bounds.centerX()[object], bounds.centerY()[object], bounds.centerZ()[object]);
+                const glm::vec3 objectExtents(bounds.extentX()[object], bounds.extentY()[object], bounds.extentZ()[object]);
+                bool inside = true;
+                for (int p = 0; p < 6 && inside; ++p) {
+                    if (mask & (1u << p)) {
+                        inside = !outsidePlane(frustum.planes[p], objectCenter, objectExtents);
+                    }
+                }
+                local.objectsTested++;
+                if (inside) {
+                    visible.push_back(object);
+                }
+            }
+            continue;
+        }
+
+        // 右子节点先入栈，左子节点先访问 (内存中紧邻)
+        stack.push_back({ node.offset, mask });
+        stack.push_back({ entry.node + 1, mask });
+    }
+
+    if (queryStats) {
+        *queryStats = local;
+    }
+}
+
+bool Bvh::raycast(const Ray& ray, const CullingBounds& bounds, RayHit& hit, float maxDistance,
+                  BvhQueryStats* queryStats) const {
+    hit = RayHit();
+    BvhQueryStats local;
+    if (m_nodes.empty() || bounds.size() != m_stats.objects) {
+        if (queryStats) {
+            *queryStats = local;
+        }
+        return false;
+    }
+
+    // 方向分量为0时得到 ±inf，平板测试仍然成立
+    const glm::vec3 inverseDirection = 1.0f / ray.direction;
+    float best = maxDistance;
+
+    struct Entry {
+        uint32_t node;
+        float entry;
+    };
+    std::vector<Entry> stack;
+    stack.reserve(64);
+    float rootEntry = 0.0f;
+    if (intersectBox(ray.origin, inverseDirection, m_nodes[0].boundsMin, m_nodes[0].boundsMax, best, rootEntry)) {
+        stack.push_back({ 0, rootEntry });
+    }
+
+    while (!stack.empty()) {
+        const Entry entry = stack.back();
+        stack.pop_back();
+        if (entry.entry > best) {
+            continue;
+        }
+        const BvhNode& node = m_nodes[entry.node];
+        local.nodesVisited++;
+
+        if (node.isLeaf()) {
+            for (uint32_t j = node.offset; j < node.offset + node.count; ++j) {
+                const uint32_t object = m_objectIndices[j];
+                const glm::vec3 center(bounds.centerX()[object], bounds.centerY()[object], bounds.centerZ()[object]);
+                const glm::vec3 extents(bounds.extentX()[object], bounds.extentY()[object], bounds.extentZ()[object]);
+                float distance = 0.0f;
+                local.objectsTested++;
+                if (!intersectBox(ray.origin, inverseDirection, center - extents, center + extents, best, distance)) {
+                    continue;
+                }
+                // 距离相同时取下标小的对象，结果与遍历顺序无关
+                if (distance < hit.distance || (distance == hit.distance && object < hit.object)) {
+                    hit.object = object;
+                    hit.distance = distance;
+                    best = distance;
+                }
+            }
+            continue;
+        }
+
+        const uint32_t children[2] = { entry.node + 1, node.offset };
+        float entries[2] = { 0.0f, 0.0f };
+        bool hits[2];
+        for (int c = 0; c < 2; ++c) {
+            const BvhNode& child = m_nodes[children[c]];
+            hits[c] = intersectBox(ray.origin, inverseDirection, child.boundsMin, child.boundsMax, best, entries[c]);
+        }
+        // 远的先入栈，近的先出栈
+        const int nearChild = (hits[0] && hits[1] && entries[1] < entries[0]) ? 1 : 0;
+        const int farChild = 1 - nearChild;
+        if (hits[farChild]) {
+            stack.push_back({ children[farChild], entries[farChild] });
+        }
+        if (hits[nearChild]) {
+            stack.push_back({ children[nearChild], entries[nearChild] });
+        }
+    }
+
+    if (queryStats) {
+        *queryStats = local;
+    }
+    return hit.hit();
+}
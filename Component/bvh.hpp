@@ -0,0 +1,138 @@
+// bvh.hpp
+// 单一职责: 对象级包围体层次 - SAH分箱构建、扁平化节点、逐帧refit与退化后重建，服务视锥剔除与射线拾取
+#pragma once
+#include "frustum_culling.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+class Camera;
+
+/**
+ * @brief 扁平化节点 (32字节，两个节点占一条缓存行)
+ *
+ * 深度优先排列: 内部节点的左子节点紧跟其后，offset 为右子节点下标；
+ * 叶子的 offset 为第一个对象在 objectIndices 中的位置。
+ */
+struct BvhNode {
+    glm::vec3 boundsMin;
+    uint32_t offset;
+    glm::vec3 boundsMax;
+    uint32_t count;         // 叶子中的对象数，0 = 内部节点
+
+    bool isLeaf() const { return count > 0; }
+};
+
+struct BvhSettings {
+    uint32_t maxLeafSize = 4;       // 不超过该数量时直接成为叶子
+    uint32_t maxSahLeafSize = 16;   // SAH 认为不划分更便宜时允许的最大叶子
+    uint32_t binCount = 16;         // 每个轴的 SAH 分箱数
+    float rebuildRatio = 1.5f;      // refit 后 SAH 代价超过构建时的该倍数则重建
+    uint32_t rebuildInterval = 0;   // 每隔多少次 update 强制重建，0 = 只在退化时重建
+};
+
+struct BvhStats {
+    size_t objects = 0;
+    size_t nodes = 0;
+    size_t leaves = 0;
+    uint32_t depth = 0;
+    float buildCost = 0.0f;     // 构建时的 SAH 代价 (按根节点表面积归一化)
+    float cost = 0.0f;          // 最近一次 refit 后的 SAH 代价
+    uint32_t refitsSinceBuild = 0;
+    uint32_t rebuilds = 0;      // build 之后由 update 触发的重建次数
+    double buildMs = 0.0;
+    double refitMs = 0.0;
+};
+
+struct BvhQueryStats {
+    size_t nodesVisited = 0;
+    size_t objectsTested = 0;
+};
+
+struct Ray {
+    glm::vec3 origin = glm::vec3(0.0f);
+    glm::vec3 direction = glm::vec3(0.0f, 0.0f, -1.0f);    // 归一化
+
+    /**
+     * @brief 由相机与 NDC 坐标 ([-1,1]，y 向上) 构造世界空间拾取射线，起点在近平面上
+     */
+    static Ray fromCamera(const Camera& camera, const glm::vec2& ndc);
+};
+
+struct RayHit {
+    static constexpr uint32_t kNoObject = 0xFFFFFFFFu;
+
+    uint32_t object = kNoObject;
+    float distance = std::numeric_limits<float>::max();    // 沿射线到包围盒的距离，起点在盒内时为0
+
+    bool hit() const { return object != kNoObject; }
+};
+
+/**
+ * @brief Bvh类 - 对 CullingBounds 中的对象 AABB 建立层次结构
+ *
+ * 使用方式:
+ *   Bvh bvh;
+ *   bvh.build(bounds);                          // 分箱SAH，O(n log n)
+ *   // 每帧对象移动后:
+ *   bvh.update(bounds);                         // refit O(n)，拓扑不变；质量退化时自动重建
+ *   bvh.cull(frustum, bounds, visible);         // 与 FrustumCulling::cull 的可见集合相同
+ *   RayHit hit;
+ *   bvh.raycast(Ray::fromCamera(camera, ndc), bounds, hit);
+ *
+ * 查询时传入的 bounds 须与最近一次 build/update 相同，对象下标即 bounds 中的下标。
+ * refit 只重算节点包围盒，物体大范围移动后节点重叠增大、SAH 代价上升，超过阈值即重建。
+ */
+class Bvh {
+public:
+    explicit Bvh(const BvhSettings& settings = BvhSettings());
+
+    void build(const CullingBounds& bounds);
+
+    /**
+     * @brief 自底向上重算节点包围盒 (对象数须与构建时相同)
+     */
+    void refit(const CullingBounds& bounds);
+
+    /**
+     * @brief 对象数变化时构建，否则 refit；代价退化或到达重建间隔时重建
+     * @return 是否进行了 (重新) 构建
+     */
+    bool update(const CullingBounds& bounds);
+
+    /**
+     * @brief 视锥剔除，visible 改写为可见对象下标 (按树的遍历顺序)
+     *
+     * 节点完全在某平面内侧时，子树不再测试该平面；完全在视锥内的子树直接整体输出。
+     */
+    void cull(const Frustum& frustum, const CullingBounds& bounds, std::vector<uint32_t>& visible,
+              BvhQueryStats* queryStats = nullptr) const;
+
+    /**
+     * @brief 最近命中的对象包围盒 (近的子节点先访问，远于当前命中的节点剪枝)
+     */
+    bool raycast(const Ray& ray, const CullingBounds& bounds, RayHit& hit,
+                 float maxDistance = std::numeric_limits<float>::max(), BvhQueryStats* queryStats = nullptr) const;
+
+    void clear();
+    bool empty() const { return m_nodes.empty(); }
+    const std::vector<BvhNode>& nodes() const { return m_nodes; }
+    const std::vector<uint32_t>& objectIndices() const { return m_objectIndices; }
+    const BvhStats& stats() const { return m_stats; }
+    const BvhSettings& settings() const { return m_settings; }
+
+private:
+    struct BuildContext;
+
+    uint32_t buildNode(BuildContext& context, uint32_t begin, uint32_t end, uint32_t depth);
+    float computeCost() const;
+
+    BvhSettings m_settings;
+    std::vector<BvhNode> m_nodes;
+    std::vector<uint32_t> m_objectIndices;     // 叶子引用的对象，按叶子顺序连续排列
+    BvhStats m_stats;
+};
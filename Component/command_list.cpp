@@ -0,0 +1,180 @@
+#include "command_list.hpp"
+#include "gl_state_cache.hpp"
+#include "render_stats.hpp"
+#include "frame_allocator.hpp"
+#include "stream_buffer.hpp"
+
+#include <algorithm>
+#include <new>
+
+namespace {
+
+size_t alignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+CommandList::CommandList()
+    : m_current(0)
+    , m_commands(0)
+    , m_draws(0)
+    , m_uploadBytes(0)
+    , m_culled(0)
+    , m_occluded(0)
+{ }
+
+CommandList::~CommandList() {
+    release();
+}
+
+void CommandList::reset() {
+    // 帧竞技场的块只在分配它的那几帧内有效
+    m_blocks.erase(std::remove_if(m_blocks.begin(), m_blocks.end(), [](const Block& block) { return !block.owned; }),
+                   m_blocks.end());
+    for (Block& block : m_blocks) {
+        block.used = 0;
+    }
+    m_current = 0;
+    m_commands = 0;
+    m_draws = 0;
+    m_uploadBytes = 0;
+    m_culled = 0;
+    m_occluded = 0;
+}
+
+void CommandList::release() {
+    for (Block& block : m_blocks) {
+        if (block.owned) {
+            ::operator delete(block.data, std::align_val_t(kAlignment));
+        }
+    }
+    m_blocks.clear();
+    reset();
+}
+
+void* CommandList::allocate(CommandType type, size_t bytes) {
+    bytes = alignUp(bytes, kAlignment);
+
+    if (m_blocks.empty() || m_blocks[m_current].capacity - m_blocks[m_current].used < bytes) {
+        // 当前块放不下: 换到下一块；下一块不够大 (或不存在) 时在此插入新块，保持块的先后即命令顺序
+        const size_t next = m_blocks.empty() ? 0 : m_current + 1;
+        if (next >= m_blocks.size() || m_blocks[next].capacity < bytes) {
+            Block block;
+            block.capacity = std::max(kBlockBytes, bytes);
+            block.used = 0;
+            FrameAllocator* frame = FrameAllocator::active();
+            block.data = frame ? static_cast<uint8_t*>(frame->allocate(block.capacity, kAlignment)) : nullptr;
+            block.owned = block.data == nullptr;
+            if (block.owned) {
+                block.data = static_cast<uint8_t*>(::operator new(block.capacity, std::align_val_t(kAlignment)));
+            }
+            m_blocks.insert(m_blocks.begin() + static_cast<std::ptrdiff_t>(next), block);
+        }
+        m_current = next;
+    }
+
+    Block& block = m_blocks[m_current];
+    CommandHeader* header = reinterpret_cast<CommandHeader*>(block.data + block.used);
+    header->type = type;
+    header->size = static_cast<uint32_t>(bytes);
+    block.used += bytes;
+    m_commands++;
+    return header;
+}
+
+void CommandList::draw(const DrawCommand& command) {
+    DrawPacket* packet = static_cast<DrawPacket*>(allocate(CommandType::Draw, sizeof(DrawPacket)));
+    new (&packet->command) DrawCommand(command);
+    packet->hasModel = 0;
+    m_draws++;
+}
+
+void CommandList::draw(const DrawCommand& command, const glm::mat4& model) {
+    DrawPacket* packet = static_cast<DrawPacket*>(allocate(CommandType::Draw, sizeof(DrawPacket)));
+    new (&packet->command) DrawCommand(command);
+    new (&packet->model) glm::mat4(model);
+    packet->hasModel = 1;
+    m_draws++;
+}
+
+void* CommandList::uploadBuffer(GLenum target, GLuint buffer, size_t size) {
+    UploadPacket* packet = static_cast<UploadPacket*>(allocate(CommandType::UploadBuffer, sizeof(UploadPacket) + size));
+    packet->target = target;
+    packet->buffer = buffer;
+    packet->size = size;
+    m_uploadBytes += size;
+    return reinterpret_cast<uint8_t*>(packet) + sizeof(UploadPacket);
+}
+
+void* CommandList::streamUpload(GLuint fallbackBuffer, size_t size, StreamBindCallback bind, void* owner) {
+    StreamPacket* packet = static_cast<StreamPacket*>(allocate(CommandType::StreamUpload, sizeof(StreamPacket) + size));
+    packet->bind = bind;
+    packet->owner = owner;
+    packet->fallbackBuffer = fallbackBuffer;
+    packet->size = size;
+    m_uploadBytes += size;
+    return reinterpret_cast<uint8_t*>(packet) + sizeof(StreamPacket);
+}
+
+void CommandList::replay(RenderQueue& queue) const {
+    RenderStats::addCulled(m_culled);
+    RenderStats::addOccluded(m_occluded);
+
+    GLStateCache& state = GLStateCache::current();
+    for (size_t b = 0; b < m_blocks.size() && b <= m_current; ++b) {
+        const Block& block = m_blocks[b];
+        size_t offset = 0;
+        while (offset < block.used) {
+            const CommandHeader* header = reinterpret_cast<const CommandHeader*>(block.data + offset);
+            switch (header->type) {
+            case CommandType::Draw: {
+                const DrawPacket* packet = reinterpret_cast<const DrawPacket*>(header);
+                if (packet->hasModel) {
+                    queue.push(packet->command, packet->model);
+                } else {
+                    queue.push(packet->command);
+                }
+                break;
+            }
+            case CommandType::UploadBuffer: {
+                const UploadPacket* packet = reinterpret_cast<const UploadPacket*>(header);
+                const GLsizeiptr size = static_cast<GLsizeiptr>(packet->size);
+                state.bindBuffer(packet->target, packet->buffer);
+                glBufferData(packet->target, size, nullptr, GL_STREAM_DRAW);
+                glBufferSubData(packet->target, 0, size, reinterpret_cast<const uint8_t*>(packet) + sizeof(UploadPacket));
+                break;
+            }
+            case CommandType::StreamUpload: {
+                const StreamPacket* packet = reinterpret_cast<const StreamPacket*>(header);
+                const uint8_t* data = reinterpret_cast<const uint8_t*>(packet) + sizeof(StreamPacket);
+                StreamBuffer* stream = StreamBuffer::active();
+                const StreamAllocation allocation = stream ? stream->upload(data, packet->size) : StreamAllocation();
+                if (allocation.isValid()) {
+                    packet->bind(packet->owner, stream->id(), allocation.offset);
+                    break;
+                }
+                const GLsizeiptr size = static_cast<GLsizeiptr>(packet->size);
+                state.bindBuffer(GL_ARRAY_BUFFER, packet->fallbackBuffer);
+                glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_STREAM_DRAW);
+                glBufferSubData(GL_ARRAY_BUFFER, 0, size, data);
+                packet->bind(packet->owner, packet->fallbackBuffer, 0);
+                break;
+            }
+            }
+            offset += header->size;
+        }
+    }
+}
+
+CommandListStats CommandList::stats() const {
+    CommandListStats stats;
+    stats.commands = m_commands;
+    stats.draws = m_draws;
+    stats.uploadBytes = m_uploadBytes;
+    for (const Block& block : m_blocks) {
+        stats.usedBytes += block.used;
+        stats.capacityBytes += block.capacity;
+    }
+    return stats;
+}
@@ -0,0 +1,180 @@
+// command_list.hpp
+// 单一职责: 线性分配的POD命令流 - 渲染器可在任意线程录制 (不发出GL调用)，GL线程按录制顺序回放到 RenderQueue
+#pragma once
+
+// 平台条件编译：OpenGL ES (Android) vs OpenGL Core (PC)
+#ifdef __ANDROID__
+    #include <GLES3/gl3.h>
+    #include <GLES3/gl3ext.h>
+#else
+    #include <glad/glad.h>
+#endif
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "render_queue.hpp"
+
+/**
+ * @brief 命令类型 (命令头的第一个字段)
+ */
+enum class CommandType : uint32_t {
+    Draw,           // DrawCommand (+ 可选的模型矩阵)，回放时追加到 RenderQueue
+    UploadBuffer,   // 孤立缓冲区后写入紧随其后的数据 (GL_STREAM_DRAW)
+    StreamUpload    // 顶点数据写入活动的 StreamBuffer，再由回调把属性指向写入位置 (没有流缓冲时同 UploadBuffer)
+};
+
+/**
+ * @brief StreamUpload 回放时的回调 (GL线程): 数据位于 buffer 的 offset 处，录制方据此设置顶点属性
+ */
+using StreamBindCallback = void (*)(void* owner, GLuint buffer, GLintptr offset);
+
+/**
+ * @brief 命令头: 类型 + 含头在内的字节数 (16字节对齐，按 size 跳到下一条)
+ */
+struct alignas(16) CommandHeader {
+    CommandType type;
+    uint32_t size;
+};
+
+/**
+ * @brief CommandList 统计
+ */
+struct CommandListStats {
+    uint32_t commands = 0;
+    uint32_t draws = 0;
+    uint64_t uploadBytes = 0;
+    size_t usedBytes = 0;       // 已录制的字节 (含命令头与对齐)
+    size_t capacityBytes = 0;   // 所有块的总容量 (reset 后保留)
+};
+
+/**
+ * @brief CommandList - 一个录制线程独占的命令流
+ *
+ * 用法 (每帧):
+ *   list.reset();                                   // 录制线程: 回绕到第一块，不释放内存
+ *   list.draw(command, model);
+ *   InstanceData* data = list.uploadBuffer<InstanceData>(GL_ARRAY_BUFFER, vbo, count);   // 直接写入流中
+ *   ...
+ *   list.replay(queue);                             // GL线程: 执行上传，绘制追加到 queue
+ *   queue.sort(); queue.submit();
+ *
+ * 命令存放在 64KB 的块中顺序追加，放不下时换到下一块 (超过一块的上传单独分配足够大的块)。
+ * 有活动的 FrameAllocator 时块从当前帧的竞技场分配，reset 时直接丢弃；否则块自行分配并在 reset 后保留。
+ * 两种情况下稳定状态的录制都不产生堆分配。
+ * 录制期间不访问任何GL状态，多个列表可在不同线程同时录制；同一个列表不能被多个线程同时录制。
+ * 剔除统计也记录在列表中，回放时计入 RenderStats (RenderStats 只能在GL线程修改)。
+ */
+class CommandList {
+public:
+    static constexpr size_t kBlockBytes = 64 * 1024;
+    static constexpr size_t kAlignment = 16;
+
+    CommandList();
+    ~CommandList();
+
+    // 禁止拷贝 (块由列表独占)
+    CommandList(const CommandList&) = delete;
+    CommandList& operator=(const CommandList&) = delete;
+
+    /**
+     * @brief 清空命令，保留所有块
+     */
+    void reset();
+
+    /**
+     * @brief 释放所有块
+     */
+    void release();
+
+    /**
+     * @brief 录制一条绘制命令；带 model 时回放为 RenderQueue::push(command, model)
+     */
+    void draw(const DrawCommand& command);
+    void draw(const DrawCommand& command, const glm::mat4& model);
+
+    /**
+     * @brief 录制一次缓冲区上传，返回流中 size 字节的可写区域 (16字节对齐)，须在回放前写完
+     *
+     * 回放时绑定 buffer 到 target，glBufferData(nullptr) 孤立旧存储后 glBufferSubData 写入。
+     */
+    void* uploadBuffer(GLenum target, GLuint buffer, size_t size);
+
+    template <typename T>
+    T* uploadBuffer(GLenum target, GLuint buffer, size_t count) {
+        static_assert(std::is_trivially_copyable<T>::value, "Uploaded data must be trivially copyable");
+        static_assert(alignof(T) <= kAlignment, "Uploaded data alignment exceeds command alignment");
+        return static_cast<T*>(uploadBuffer(target, buffer, count * sizeof(T)));
+    }
+
+    /**
+     * @brief 录制一次流式顶点上传，返回流中 size 字节的可写区域
+     *
+     * 回放时写入 StreamBuffer::active() 的本帧区域并调用 bind(owner, 流缓冲, 偏移)；
+     * 没有流缓冲或区域已满时孤立 fallbackBuffer 后写入，调用 bind(owner, fallbackBuffer, 0)。
+     */
+    void* streamUpload(GLuint fallbackBuffer, size_t size, StreamBindCallback bind, void* owner);
+
+    template <typename T>
+    T* streamUpload(GLuint fallbackBuffer, size_t count, StreamBindCallback bind, void* owner) {
+        static_assert(std::is_trivially_copyable<T>::value, "Uploaded data must be trivially copyable");
+        static_assert(alignof(T) <= kAlignment, "Uploaded data alignment exceeds command alignment");
+        return static_cast<T*>(streamUpload(fallbackBuffer, count * sizeof(T), bind, owner));
+    }
+
+    // 录制线程上累计的剔除数，回放时计入 RenderStats
+    void addCulled(uint64_t count) { m_culled += count; }
+    void addOccluded(uint64_t count) { m_occluded += count; }
+
+    /**
+     * @brief 按录制顺序执行: 上传立即发出，绘制追加到 queue (由调用方排序提交)。只能在GL线程调用
+     */
+    void replay(RenderQueue& queue) const;
+
+    bool empty() const { return m_commands == 0; }
+    CommandListStats stats() const;
+
+private:
+    struct Block {
+        uint8_t* data;
+        size_t capacity;
+        size_t used;
+        bool owned;             // false: 来自 FrameAllocator，reset 时丢弃
+    };
+
+    struct DrawPacket {
+        CommandHeader header;
+        DrawCommand command;
+        glm::mat4 model;
+        uint32_t hasModel;
+    };
+
+    struct UploadPacket {
+        CommandHeader header;
+        GLenum target;
+        GLuint buffer;
+        uint64_t size;          // 数据紧随其后 (从 sizeof(UploadPacket) 开始)
+    };
+
+    struct StreamPacket {
+        CommandHeader header;
+        StreamBindCallback bind;
+        void* owner;
+        GLuint fallbackBuffer;
+        uint64_t size;          // 数据紧随其后 (从 sizeof(StreamPacket) 开始)
+    };
+
+    void* allocate(CommandType type, size_t bytes);
+
+    std::vector<Block> m_blocks;
+    size_t m_current;           // 正在写入的块，reset 后为 0
+    uint32_t m_commands;
+    uint32_t m_draws;
+    uint64_t m_uploadBytes;
+    uint64_t m_culled;
+    uint64_t m_occluded;
+};
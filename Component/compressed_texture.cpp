@@ -0,0 +1,892 @@
+#include "compressed_texture.hpp"
+#include "mip_chain.hpp"
+
+#include <SOIL2.h>
+#include <wfETC.h>
+#include <pvr_helper.h>
+extern "C" {
+#include <image_DXT.h>
+}
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+// 扩展格式的枚举值 (glad 只生成了 GL 3.3 核心，GLES 头文件中也不一定有)
+constexpr GLenum kCompressedRgbS3tcDxt1 = 0x83F0;
+constexpr GLenum kCompressedRgbaS3tcDxt1 = 0x83F1;
+constexpr GLenum kCompressedRgbaS3tcDxt3 = 0x83F2;
+constexpr GLenum kCompressedRgbaS3tcDxt5 = 0x83F3;
+constexpr GLenum kCompressedSrgbS3tcDxt1 = 0x8C4C;
+constexpr GLenum kCompressedSrgbAlphaS3tcDxt1 = 0x8C4D;
+constexpr GLenum kCompressedSrgbAlphaS3tcDxt3 = 0x8C4E;
+constexpr GLenum kCompressedSrgbAlphaS3tcDxt5 = 0x8C4F;
+constexpr GLenum kEtc1Rgb8Oes = 0x8D64;
+constexpr GLenum kCompressedRgb8Etc2 = 0x9274;
+constexpr GLenum kCompressedRgba8Etc2Eac = 0x9278;
+constexpr GLenum kCompressedSrgb8Etc2 = 0x9275;
+constexpr GLenum kCompressedSrgb8Alpha8Etc2Eac = 0x9279;
+constexpr GLenum kCompressedRgbPvrtc4Bpp = 0x8C00;
+constexpr GLenum kCompressedRgbPvrtc2Bpp = 0x8C01;
+constexpr GLenum kCompressedRgbaPvrtc4Bpp = 0x8C02;
+constexpr GLenum kCompressedRgbaPvrtc2Bpp = 0x8C03;
+
+constexpr uint32_t kDdsFourCCDxt1 = 0x31545844;    // "DXT1"
+constexpr uint32_t kDdsFourCCDxt3 = 0x33545844;    // "DXT3"
+constexpr uint32_t kDdsFourCCDxt5 = 0x35545844;    // "DXT5"
+constexpr uint32_t kDdsFourCCDx10 = 0x30315844;    // "DX10"
+constexpr uint32_t kDdsMagic = 0x20534444;         // "DDS "
+constexpr size_t kDdsDx10HeaderSize = 20;
+
+constexpr uint8_t kKtxIdentifier[12] = { 0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n' };
+constexpr size_t kKtxHeaderSize = 64;
+constexpr uint32_t kKtxEndianness = 0x04030201;
+
+constexpr size_t kPkmHeaderSize = 16;
+constexpr uint32_t kPvrV3Version = 0x03525650;
+constexpr size_t kPvrV3HeaderSize = 52;
+
+// ETC1 修正表: 像素索引 0:+a 1:+b 2:-a 3:-b
+constexpr int kEtcModifiers[8][4] = {
+    {  2,   8,  -2,   -8 }, {  5,  17,  -5,  -17 }, {  9,  29,  -9,  -29 }, { 13,  42, -13,  -42 },
+    { 18,  60, -18,  -60 }, { 24,  80, -24,  -80 }, { 33, 106, -33, -106 }, { 47, 183, -47, -183 },
+};
+
+uint32_t readU32(const uint8_t* data) {
+    uint32_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+uint16_t readU16BigEndian(const uint8_t* data) {
+    return static_cast<uint16_t>((data[0] << 8) | data[1]);
+}
+
+int clampByte(int value) {
+    return std::min(255, std::max(0, value));
+}
+
+// 连续存放的mip链 (DDS/PKM/PVR)；返回 false 表示文件被截断
+bool buildContiguousLevels(CompressedImage& image, uint32_t levelCount, size_t offset, size_t fileSize) {
+    int width = image.width;
+    int height = image.height;
+    for (uint32_t level = 0; level < levelCount; ++level) {
+        CompressedLevel entry;
+        entry.width = width;
+        entry.height = height;
+        entry.offset = offset;
+        entry.size = CompressedTexture::levelSize(image.format, width, height);
+        if (entry.offset + entry.size > fileSize) {
+            return false;
+        }
+        image.levels.push_back(entry);
+        offset += entry.size;
+        width = std::max(1, width / 2);
+        height = std::max(1, height / 2);
+    }
+    return true;
+}
+
+bool parseDds(const std::vector<uint8_t>& file, CompressedImage& image, std::string& error) {
+    if (file.size() < sizeof(DDS_header)) {
+        error = "Truncated DDS header";
+        return false;
+    }
+    DDS_header header;
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (header.dwSize != 124) {
+        error = "Invalid DDS header";
+        return false;
+    }
+    // 非压缩DDS交给 SOIL2 的通用解码
+    if (!(header.sPixelFormat.dwFlags & DDPF_FOURCC)) {
+        return false;
+    }
+    if (header.sCaps.dwCaps2 & DDSCAPS2_CUBEMAP) {
+        error = "DDS cube maps are not supported";
+        return false;
+    }
+
+    size_t offset = sizeof(DDS_header);
+    switch (header.sPixelFormat.dwFourCC) {
+    case kDdsFourCCDxt1:
+        image.format = (header.sPixelFormat.dwFlags & DDPF_ALPHAPIXELS) ? CompressedFormat::BC1A : CompressedFormat::BC1;
+        break;
+    case kDdsFourCCDxt3:
+        image.format = CompressedFormat::BC2;
+        break;
+    case kDdsFourCCDxt5:
+        image.format = CompressedFormat::BC3;
+        break;
+    case kDdsFourCCDx10: {
+        if (file.size() < offset + kDdsDx10HeaderSize) {
+            error = "Truncated DDS DX10 header";
+            return false;
+        }
+        const uint32_t dxgiFormat = readU32(file.data() + offset);
+        offset += kDdsDx10HeaderSize;
+        image.srgb = dxgiFormat == DXGI_FORMAT_BC1_UNORM_SRGB || dxgiFormat == DXGI_FORMAT_BC2_UNORM_SRGB
+                  || dxgiFormat == DXGI_FORMAT_BC3_UNORM_SRGB;
+        if (dxgiFormat == DXGI_FORMAT_BC1_UNORM || dxgiFormat == DXGI_FORMAT_BC1_UNORM_SRGB) {
+            image.format = CompressedFormat::BC1A;
+        } else if (dxgiFormat == DXGI_FORMAT_BC2_UNORM || dxgiFormat == DXGI_FORMAT_BC2_UNORM_SRGB) {
+            image.format = CompressedFormat::BC2;
+        } else if (dxgiFormat == DXGI_FORMAT_BC3_UNORM || dxgiFormat == DXGI_FORMAT_BC3_UNORM_SRGB) {
+            image.format = CompressedFormat::BC3;
+        } else {
+            error = "Unsupported DXGI format " + std::to_string(dxgiFormat);
+            return false;
+        }
+        break;
+    }
+    default:
+        error = "Unsupported DDS FourCC";
+        return false;
+    }
+
+    image.width = static_cast<int>(header.dwWidth);
+    image.height = static_cast<int>(header.dwHeight);
+    const uint32_t levels = (header.dwFlags & DDSD_MIPMAPCOUNT) ? std::max<uint32_t>(header.dwMipMapCount, 1) : 1;
+    if (!buildContiguousLevels(image, levels, offset, file.size())) {
+        error = "Truncated DDS data";
+        return false;
+    }
+    return true;
+}
+
+bool parseKtx(const std::vector<uint8_t>& file, CompressedImage& image, std::string& error) {
+    if (file.size() < kKtxHeaderSize) {
+        error = "Truncated KTX header";
+        return false;
+    }
+    uint32_t fields[13];
+    std::memcpy(fields, file.data() + sizeof(kKtxIdentifier), sizeof(fields));
+    const uint32_t endianness = fields[0];
+    const uint32_t glType = fields[1];
+    const uint32_t glInternalFormat = fields[4];
+    const uint32_t depth = fields[8];
+    const uint32_t arrayElements = fields[9];
+    const uint32_t faces = fields[10];
+    const uint32_t levelCount = std::max<uint32_t>(fields[11], 1);
+    const uint32_t keyValueBytes = fields[12];
+
+    if (endianness != kKtxEndianness) {
+        error = "Big-endian KTX files are not supported";
+        return false;
+    }
+    if (glType != 0) {
+        error = "Uncompressed KTX files are not supported";
+        return false;
+    }
+    if (depth > 1 || arrayElements > 0 || faces != 1) {
+        error = "Only 2D KTX textures are supported";
+        return false;
+    }
+
+    switch (glInternalFormat) {
+    case kCompressedRgbS3tcDxt1:   image.format = CompressedFormat::BC1; break;
+    case kCompressedRgbaS3tcDxt1:  image.format = CompressedFormat::BC1A; break;
+    case kCompressedRgbaS3tcDxt3:  image.format = CompressedFormat::BC2; break;
+    case kCompressedRgbaS3tcDxt5:  image.format = CompressedFormat::BC3; break;
+    case kEtc1Rgb8Oes:             image.format = CompressedFormat::ETC1; break;
+    case kCompressedRgb8Etc2:      image.format = CompressedFormat::ETC2_RGB; break;
+    case kCompressedRgba8Etc2Eac:  image.format = CompressedFormat::ETC2_RGBA; break;
+    case kCompressedRgbPvrtc4Bpp:  image.format = CompressedFormat::PVRTC_RGB_4BPP; break;
+    case kCompressedRgbPvrtc2Bpp:  image.format = CompressedFormat::PVRTC_RGB_2BPP; break;
+    case kCompressedRgbaPvrtc4Bpp: image.format = CompressedFormat::PVRTC_RGBA_4BPP; break;
+    case kCompressedRgbaPvrtc2Bpp: image.format = CompressedFormat::PVRTC_RGBA_2BPP; break;
+    default:
+        error = "Unsupported KTX internal format " + std::to_string(glInternalFormat);
+        return false;
+    }
+
+    image.width = static_cast<int>(fields[6]);
+    image.height = static_cast<int>(std::max<uint32_t>(fields[7], 1));
+
+    // 每个层级前有 4 字节的 imageSize，数据按 4 字节对齐
+    size_t offset = kKtxHeaderSize + keyValueBytes;
+    int width = image.width;
+    int height = image.height;
+    for (uint32_t level = 0; level < levelCount; ++level) {
+        if (offset + sizeof(uint32_t) > file.size()) {
+            error = "Truncated KTX data";
+            return false;
+        }
+        CompressedLevel entry;
+        entry.width = width;
+        entry.height = height;
+        entry.offset = offset + sizeof(uint32_t);
+        entry.size = readU32(file.data() + offset);
+        if (entry.size < CompressedTexture::levelSize(image.format, width, height) || entry.offset + entry.size > file.size()) {
+            error = "Truncated KTX data";
+            return false;
+        }
+        image.levels.push_back(entry);
+        offset = entry.offset + ((entry.size + 3) & ~size_t(3));
+        width = std::max(1, width / 2);
+        height = std::max(1, height / 2);
+    }
+    return true;
+}
+
+bool parsePkm(const std::vector<uint8_t>& file, CompressedImage& image, std::string& error) {
+    if (file.size() < kPkmHeaderSize) {
+        error = "Truncated PKM header";
+        return false;
+    }
+    const uint8_t* header = file.data();
+    if (header[4] == '1' && header[5] == '0') {
+        image.format = CompressedFormat::ETC1;
+    } else if (header[4] == '2' && header[5] == '0') {
+        switch (readU16BigEndian(header + 6)) {
+        case 0: image.format = CompressedFormat::ETC1; break;
+        case 1: image.format = CompressedFormat::ETC2_RGB; break;
+        case 3: image.format = CompressedFormat::ETC2_RGBA; break;
+        default:
+            error = "Unsupported PKM format";
+            return false;
+        }
+    } else {
+        error = "Unsupported PKM version";
+        return false;
+    }
+
+    image.width = readU16BigEndian(header + 12);
+    image.height = readU16BigEndian(header + 14);
+    if (!buildContiguousLevels(image, 1, kPkmHeaderSize, file.size())) {
+        error = "Truncated PKM data";
+        return false;
+    }
+    return true;
+}
+
+bool parsePvrV3(const std::vector<uint8_t>& file, CompressedImage& image, std::string& error) {
+    if (file.size() < kPvrV3HeaderSize) {
+        error = "Truncated PVR header";
+        return false;
+    }
+    uint32_t fields[13];
+    std::memcpy(fields, file.data(), sizeof(fields));
+    const uint32_t pixelFormatLow = fields[2];
+    const uint32_t pixelFormatHigh = fields[3];
+    const uint32_t depth = fields[8];
+    const uint32_t surfaces = fields[9];
+    const uint32_t faces = fields[10];
+    const uint32_t levelCount = std::max<uint32_t>(fields[11], 1);
+    const uint32_t metaDataBytes = fields[12];
+
+    // 高32位非零表示按通道描述的非压缩格式
+    if (pixelFormatHigh != 0) {
+        error = "Uncompressed PVR v3 files are not supported";
+        return false;
+    }
+    if (depth > 1 || surfaces > 1 || faces > 1) {
+        error = "Only 2D PVR textures are supported";
+        return false;
+    }
+    switch (pixelFormatLow) {
+    case 0:  image.format = CompressedFormat::PVRTC_RGB_2BPP; break;
+    case 1:  image.format = CompressedFormat::PVRTC_RGBA_2BPP; break;
+    case 2:  image.format = CompressedFormat::PVRTC_RGB_4BPP; break;
+    case 3:  image.format = CompressedFormat::PVRTC_RGBA_4BPP; break;
+    case 6:  image.format = CompressedFormat::ETC1; break;
+    case 7:  image.format = CompressedFormat::BC1; break;
+    case 9:  image.format = CompressedFormat::BC2; break;
+    case 11: image.format = CompressedFormat::BC3; break;
+    case 22: image.format = CompressedFormat::ETC2_RGB; break;
+    case 23: image.format = CompressedFormat::ETC2_RGBA; break;
+    default:
+        error = "Unsupported PVR pixel format " + std::to_string(pixelFormatLow);
+        return false;
+    }
+
+    image.height = static_cast<int>(fields[6]);
+    image.width = static_cast<int>(fields[7]);
+    if (!buildContiguousLevels(image, levelCount, kPvrV3HeaderSize + metaDataBytes, file.size())) {
+        error = "Truncated PVR data";
+        return false;
+    }
+    return true;
+}
+
+bool parsePvrV2(const std::vector<uint8_t>& file, CompressedImage& image, std::string& error) {
+    PVR_Texture_Header header;
+    std::memcpy(&header, file.data(), sizeof(header));
+    const bool alpha = header.dwAlphaBitMask != 0;
+    switch (header.dwpfFlags & PVRTEX_PIXELTYPE) {
+    case MGLPT_PVRTC2:
+    case OGL_PVRTC2:
+        image.format = alpha ? CompressedFormat::PVRTC_RGBA_2BPP : CompressedFormat::PVRTC_RGB_2BPP;
+        break;
+    case MGLPT_PVRTC4:
+    case OGL_PVRTC4:
+        image.format = alpha ? CompressedFormat::PVRTC_RGBA_4BPP : CompressedFormat::PVRTC_RGB_4BPP;
+        break;
+    default:
+        // 非压缩像素交给 SOIL2 的通用解码
+        return false;
+    }
+    if (header.dwpfFlags & (PVRTEX_CUBEMAP | PVRTEX_VOLUME)) {
+        error = "Only 2D PVR textures are supported";
+        return false;
+    }
+
+    image.width = static_cast<int>(header.dwWidth);
+    image.height = static_cast<int>(header.dwHeight);
+    // v2 的 dwMipMapCount 不含第0级
+    const uint32_t levels = (header.dwpfFlags & PVRTEX_MIPMAP) ? header.dwMipMapCount + 1 : 1;
+    if (!buildContiguousLevels(image, levels, header.dwHeaderSize, file.size())) {
+        error = "Truncated PVR data";
+        return false;
+    }
+    return true;
+}
+
+void expand565(uint16_t color, uint8_t* rgba) {
+    const int r = (color >> 11) & 0x1F;
+    const int g = (color >> 5) & 0x3F;
+    const int b = color & 0x1F;
+    rgba[0] = static_cast<uint8_t>((r << 3) | (r >> 2));
+    rgba[1] = static_cast<uint8_t>((g << 2) | (g >> 4));
+    rgba[2] = static_cast<uint8_t>((b << 3) | (b >> 2));
+    rgba[3] = 255;
+}
+
+// BC1 颜色块 → 16个RGBA像素；BC2/BC3 的颜色块总是四色模式
+void decodeColorBlock(const uint8_t* block, bool punchThrough, uint8_t* pixels) {
+    const uint16_t c0 = static_cast<uint16_t>(block[0] | (block[1] << 8));
+    const uint16_t c1 = static_cast<uint16_t>(block[2] | (block[3] << 8));
+    uint8_t palette[4][4];
+    expand565(c0, palette[0]);
+    expand565(c1, palette[1]);
+    for (int c = 0; c < 3; ++c) {
+        if (c0 > c1 || !punchThrough) {
+            palette[2][c] = static_cast<uint8_t>((2 * palette[0][c] + palette[1][c]) / 3);
+            palette[3][c] = static_cast<uint8_t>((palette[0][c] + 2 * palette[1][c]) / 3);
+        } else {
+            palette[2][c] = static_cast<uint8_t>((palette[0][c] + palette[1][c]) / 2);
+            palette[3][c] = 0;
+        }
+    }
+    palette[2][3] = 255;
+    palette[3][3] = (c0 > c1 || !punchThrough) ? 255 : 0;
+
+    const uint32_t indices = readU32(block + 4);
+    for (int i = 0; i < 16; ++i) {
+        std::memcpy(pixels + i * 4, palette[(indices >> (2 * i)) & 3], 4);
+    }
+}
+
+void decodeBc2Alpha(const uint8_t* block, uint8_t* pixels) {
+    for (int i = 0; i < 16; ++i) {
+        const int nibble = (block[i / 2] >> ((i & 1) * 4)) & 0xF;
+        pixels[i * 4 + 3] = static_cast<uint8_t>(nibble * 17);
+    }
+}
+
+void decodeBc3Alpha(const uint8_t* block, uint8_t* pixels) {
+    const int a0 = block[0];
+    const int a1 = block[1];
+    int palette[8] = { a0, a1 };
+    if (a0 > a1) {
+        for (int k = 2; k < 8; ++k) {
+            palette[k] = ((8 - k) * a0 + (k - 1) * a1) / 7;
+        }
+    } else {
+        for (int k = 2; k < 6; ++k) {
+            palette[k] = ((6 - k) * a0 + (k - 1) * a1) / 5;
+        }
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+
+    uint64_t bits = 0;
+    for (int i = 0; i < 6; ++i) {
+        bits |= static_cast<uint64_t>(block[2 + i]) << (8 * i);
+    }
+    for (int i = 0; i < 16; ++i) {
+        pixels[i * 4 + 3] = static_cast<uint8_t>(palette[(bits >> (3 * i)) & 7]);
+    }
+}
+
+// 一个ETC1子块 (8个像素) 的最优基色/修正表，返回误差
+int fitEtc1SubBlock(const uint8_t (*pixels)[4], const int* subset, int color4[3], int& table, int indices[8]) {
+    int sum[3] = { 0, 0, 0 };
+    for (int i = 0; i < 8; ++i) {
+        for (int c = 0; c < 3; ++c) {
+            sum[c] += pixels[subset[i]][c];
+        }
+    }
+    int base[3];
+    for (int c = 0; c < 3; ++c) {
+        color4[c] = std::min(15, (sum[c] * 15 + 8 * 255 / 2) / (8 * 255));
+        base[c] = color4[c] * 17;
+    }
+
+    int bestError = INT_MAX;
+    for (int t = 0; t < 8; ++t) {
+        int error = 0;
+        int candidate[8];
+        for (int i = 0; i < 8 && error < bestError; ++i) {
+            const uint8_t* pixel = pixels[subset[i]];
+            int pixelBest = INT_MAX;
+            for (int m = 0; m < 4; ++m) {
+                int distance = 0;
+                for (int c = 0; c < 3; ++c) {
+                    const int diff = clampByte(base[c] + kEtcModifiers[t][m]) - pixel[c];
+                    distance += diff * diff;
+                }
+                if (distance < pixelBest) {
+                    pixelBest = distance;
+                    candidate[i] = m;
+                }
+            }
+            error += pixelBest;
+        }
+        if (error < bestError) {
+            bestError = error;
+            table = t;
+            std::copy(candidate, candidate + 8, indices);
+        }
+    }
+    return bestError;
+}
+
+} // namespace
+
+// ============ CompressedFormatSupport ============
+
+CompressedFormatSupport CompressedFormatSupport::query() {
+    CompressedFormatSupport support;
+#ifdef __ANDROID__
+    // GLES 3.0 核心包含 ETC2/EAC
+    support.etc2 = true;
+#else
+    // GL 4.3 核心包含 ETC2/EAC，之前通过 ARB_ES3_compatibility 提供
+    GLint major = 0;
+    GLint minor = 0;
+    glGetIntegerv(GL_MAJOR_VERSION, &major);
+    glGetIntegerv(GL_MINOR_VERSION, &minor);
+    support.etc2 = major > 4 || (major == 4 && minor >= 3);
+#endif
+
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    for (GLint i = 0; i < count; ++i) {
+        const char* name = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i)));
+        if (!name) {
+            continue;
+        }
+        if (std::strcmp(name, "GL_EXT_texture_compression_s3tc") == 0) {
+            support.s3tc = true;
+        } else if (std::strcmp(name, "GL_EXT_texture_sRGB") == 0
+                   || std::strcmp(name, "GL_EXT_texture_compression_s3tc_srgb") == 0
+                   || std::strcmp(name, "GL_NV_sRGB_formats") == 0) {
+            support.s3tcSrgb = true;
+        } else if (std::strcmp(name, "GL_ARB_ES3_compatibility") == 0) {
+            support.etc2 = true;
+        } else if (std::strcmp(name, "GL_IMG_texture_compression_pvrtc") == 0) {
+            support.pvrtc = true;
+        }
+    }
+    // sRGB 的 S3TC 枚举由 sRGB 扩展定义，但仍需要 S3TC 本身
+    support.s3tcSrgb = support.s3tcSrgb && support.s3tc;
+    return support;
+}
+
+bool CompressedFormatSupport::supports(CompressedFormat format) const {
+    switch (format) {
+    case CompressedFormat::None:
+        return true;
+    case CompressedFormat::BC1:
+    case CompressedFormat::BC1A:
+    case CompressedFormat::BC2:
+    case CompressedFormat::BC3:
+        return s3tc;
+    case CompressedFormat::ETC1:
+    case CompressedFormat::ETC2_RGB:
+    case CompressedFormat::ETC2_RGBA:
+        return etc2;
+    default:
+        return pvrtc;
+    }
+}
+
+bool CompressedFormatSupport::supports(const CompressedImage& image) const {
+    if (!supports(image.format)) {
+        return false;
+    }
+    // ETC2 的 sRGB 变体与 ETC2 同属 GLES 3.0 / GL 4.3 核心，只有 BC 需要单独的扩展
+    switch (image.format) {
+    case CompressedFormat::BC1:
+    case CompressedFormat::BC1A:
+    case CompressedFormat::BC2:
+    case CompressedFormat::BC3:
+        return !image.srgb || s3tcSrgb;
+    default:
+        return true;
+    }
+}
+
+std::string CompressedFormatSupport::describe() const {
+    std::string text = "Compressed textures:";
+    text += s3tc ? (s3tcSrgb ? " BC (sRGB)" : " BC") : "";
+    text += etc2 ? " ETC2" : "";
+    text += pvrtc ? " PVRTC" : "";
+    return (s3tc || etc2 || pvrtc) ? text : text + " none";
+}
+
+// ============ CompressedImage ============
+
+bool CompressedImage::hasAlpha() const {
+    switch (format) {
+    case CompressedFormat::BC1:
+    case CompressedFormat::ETC1:
+    case CompressedFormat::ETC2_RGB:
+    case CompressedFormat::PVRTC_RGB_4BPP:
+    case CompressedFormat::PVRTC_RGB_2BPP:
+        return false;
+    default:
+        return true;
+    }
+}
+
+GLenum CompressedImage::glInternalFormat() const {
+    if (srgb) {
+        switch (format) {
+        case CompressedFormat::BC1:         return kCompressedSrgbS3tcDxt1;
+        case CompressedFormat::BC1A:        return kCompressedSrgbAlphaS3tcDxt1;
+        case CompressedFormat::BC2:         return kCompressedSrgbAlphaS3tcDxt3;
+        case CompressedFormat::BC3:         return kCompressedSrgbAlphaS3tcDxt5;
+        case CompressedFormat::ETC1:        return kCompressedSrgb8Etc2;
+        case CompressedFormat::ETC2_RGB:    return kCompressedSrgb8Etc2;
+        case CompressedFormat::ETC2_RGBA:   return kCompressedSrgb8Alpha8Etc2Eac;
+        case CompressedFormat::None:        return GL_SRGB8_ALPHA8;
+        default:                            break;  // PVRTC 的 sRGB 需要另外的扩展，容器也不会标记
+        }
+    }
+    switch (format) {
+    case CompressedFormat::BC1:             return kCompressedRgbS3tcDxt1;
+    case CompressedFormat::BC1A:            return kCompressedRgbaS3tcDxt1;
+    case CompressedFormat::BC2:             return kCompressedRgbaS3tcDxt3;
+    case CompressedFormat::BC3:             return kCompressedRgbaS3tcDxt5;
+    // ETC1 数据是合法的 ETC2 RGB 数据，GLES3/桌面都按 ETC2 上传
+    case CompressedFormat::ETC1:            return kCompressedRgb8Etc2;
+    case CompressedFormat::ETC2_RGB:        return kCompressedRgb8Etc2;
+    case CompressedFormat::ETC2_RGBA:       return kCompressedRgba8Etc2Eac;
+    case CompressedFormat::PVRTC_RGB_4BPP:  return kCompressedRgbPvrtc4Bpp;
+    case CompressedFormat::PVRTC_RGBA_4BPP: return kCompressedRgbaPvrtc4Bpp;
+    case CompressedFormat::PVRTC_RGB_2BPP:  return kCompressedRgbPvrtc2Bpp;
+    case CompressedFormat::PVRTC_RGBA_2BPP: return kCompressedRgbaPvrtc2Bpp;
+    default:                                return GL_RGBA8;
+    }
+}
+
+namespace CompressedTexture {
+
+const char* formatName(CompressedFormat format) {
+    switch (format) {
+    case CompressedFormat::BC1:             return "BC1";
+    case CompressedFormat::BC1A:            return "BC1A";
+    case CompressedFormat::BC2:             return "BC2";
+    case CompressedFormat::BC3:             return "BC3";
+    case CompressedFormat::ETC1:            return "ETC1";
+    case CompressedFormat::ETC2_RGB:        return "ETC2_RGB";
+    case CompressedFormat::ETC2_RGBA:       return "ETC2_RGBA";
+    case CompressedFormat::PVRTC_RGB_4BPP:  return "PVRTC_RGB_4BPP";
+    case CompressedFormat::PVRTC_RGBA_4BPP: return "PVRTC_RGBA_4BPP";
+    case CompressedFormat::PVRTC_RGB_2BPP:  return "PVRTC_RGB_2BPP";
+    case CompressedFormat::PVRTC_RGBA_2BPP: return "PVRTC_RGBA_2BPP";
+    default:                                return "RGBA8";
+    }
+}
+
+size_t levelSize(CompressedFormat format, int width, int height) {
+    const size_t blocks = static_cast<size_t>((width + 3) / 4) * static_cast<size_t>((height + 3) / 4);
+    switch (format) {
+    case CompressedFormat::BC1:
+    case CompressedFormat::BC1A:
+    case CompressedFormat::ETC1:
+    case CompressedFormat::ETC2_RGB:
+        return blocks * 8;
+    case CompressedFormat::BC2:
+    case CompressedFormat::BC3:
+    case CompressedFormat::ETC2_RGBA:
+        return blocks * 16;
+    case CompressedFormat::PVRTC_RGB_4BPP:
+    case CompressedFormat::PVRTC_RGBA_4BPP:
+        return static_cast<size_t>(std::max(width, PVRTC4_MIN_TEXWIDTH)) * std::max(height, PVRTC4_MIN_TEXHEIGHT) / 2;
+    case CompressedFormat::PVRTC_RGB_2BPP:
+    case CompressedFormat::PVRTC_RGBA_2BPP:
+        return static_cast<size_t>(std::max(width, PVRTC2_MIN_TEXWIDTH)) * std::max(height, PVRTC2_MIN_TEXHEIGHT) / 4;
+    default:
+        return static_cast<size_t>(width) * height * 4;
+    }
+}
+
+bool parse(std::vector<uint8_t>& file, CompressedImage& image, std::string& error) {
+    image = CompressedImage();
+    error.clear();
+    if (file.size() < 4) {
+        return false;
+    }
+
+    bool parsed = false;
+    if (readU32(file.data()) == kDdsMagic) {
+        parsed = parseDds(file, image, error);
+    } else if (file.size() >= sizeof(kKtxIdentifier) && std::memcmp(file.data(), kKtxIdentifier, sizeof(kKtxIdentifier)) == 0) {
+        parsed = parseKtx(file, image, error);
+    } else if (std::memcmp(file.data(), "PKM ", 4) == 0) {
+        parsed = parsePkm(file, image, error);
+    } else if (readU32(file.data()) == kPvrV3Version) {
+        parsed = parsePvrV3(file, image, error);
+    } else if (file.size() >= sizeof(PVR_Texture_Header) && readU32(file.data()) == sizeof(PVR_Texture_Header)
+               && readU32(file.data() + offsetof(PVR_Texture_Header, dwPVR)) == PVRTEX_IDENTIFIER) {
+        parsed = parsePvrV2(file, image, error);
+    }
+
+    if (parsed && (image.width <= 0 || image.height <= 0)) {
+        error = "Invalid texture size";
+        parsed = false;
+    }
+    if (!parsed) {
+        image = CompressedImage();
+        return false;
+    }
+    image.data = std::move(file);
+    return true;
+}
+
+bool decodeToRgba(const CompressedImage& image, std::vector<uint8_t>& rgba) {
+    const CompressedFormat format = image.format;
+    if (!image.isValid() || (format != CompressedFormat::BC1 && format != CompressedFormat::BC1A &&
+                             format != CompressedFormat::BC2 && format != CompressedFormat::BC3 &&
+                             format != CompressedFormat::ETC1)) {
+        return false;
+    }
+
+    const int width = image.width;
+    const int height = image.height;
+    const size_t blockBytes = (format == CompressedFormat::BC2 || format == CompressedFormat::BC3) ? 16 : 8;
+    const uint8_t* block = image.data.data() + image.levels[0].offset;
+    rgba.assign(static_cast<size_t>(width) * height * 4, 0);
+
+    uint8_t pixels[16 * 4];
+    uint32_t etcPixels[16];
+    for (int by = 0; by < height; by += 4) {
+        for (int bx = 0; bx < width; bx += 4, block += blockBytes) {
+            switch (format) {
+            case CompressedFormat::BC1:
+            case CompressedFormat::BC1A:
+                decodeColorBlock(block, true, pixels);
+                break;
+            case CompressedFormat::BC2:
+                decodeColorBlock(block + 8, false, pixels);
+                decodeBc2Alpha(block, pixels);
+                break;
+            case CompressedFormat::BC3:
+                decodeColorBlock(block + 8, false, pixels);
+                decodeBc3Alpha(block, pixels);
+                break;
+            default:
+                // wfETC 输出 0xAARRGGBB
+                wfETC1_DecodeBlock(block, etcPixels, 4);
+                for (int i = 0; i < 16; ++i) {
+                    pixels[i * 4 + 0] = static_cast<uint8_t>(etcPixels[i] >> 16);
+                    pixels[i * 4 + 1] = static_cast<uint8_t>(etcPixels[i] >> 8);
+                    pixels[i * 4 + 2] = static_cast<uint8_t>(etcPixels[i]);
+                    pixels[i * 4 + 3] = 255;
+                }
+                break;
+            }
+
+            for (int y = 0; y < 4 && by + y < height; ++y) {
+                for (int x = 0; x < 4 && bx + x < width; ++x) {
+                    std::memcpy(&rgba[(static_cast<size_t>(by + y) * width + bx + x) * 4], pixels + (y * 4 + x) * 4, 4);
+                }
+            }
+        }
+    }
+    return true;
+}
+
+std::vector<uint8_t> encodeEtc1(const uint8_t* rgba, int width, int height) {
+    std::vector<uint8_t> result;
+    result.reserve(levelSize(CompressedFormat::ETC1, width, height));
+
+    // 子块像素 (像素编号 = y * 4 + x): 不翻转为左右两个 2x4，翻转为上下两个 4x2
+    static const int kSubsets[2][2][8] = {
+        { { 0, 1, 4, 5, 8, 9, 12, 13 }, { 2, 3, 6, 7, 10, 11, 14, 15 } },
+        { { 0, 1, 2, 3, 4, 5, 6, 7 },   { 8, 9, 10, 11, 12, 13, 14, 15 } },
+    };
+
+    uint8_t pixels[16][4];
+    for (int by = 0; by < height; by += 4) {
+        for (int bx = 0; bx < width; bx += 4) {
+            // 边缘块重复最后一行/列
+            for (int y = 0; y < 4; ++y) {
+                for (int x = 0; x < 4; ++x) {
+                    const int sx = std::min(bx + x, width - 1);
+                    const int sy = std::min(by + y, height - 1);
+                    std::memcpy(pixels[y * 4 + x], rgba + (static_cast<size_t>(sy) * width + sx) * 4, 4);
+                }
+            }
+
+            int bestError = INT_MAX;
+            uint32_t bestHigh = 0;
+            uint32_t bestLow = 0;
+            for (int flip = 0; flip < 2; ++flip) {
+                int colors[2][3];
+                int tables[2];
+                int indices[2][8];
+                int error = 0;
+                for (int sub = 0; sub < 2; ++sub) {
+                    error += fitEtc1SubBlock(pixels, kSubsets[flip][sub], colors[sub], tables[sub], indices[sub]);
+                }
+                if (error >= bestError) {
+                    continue;
+                }
+                bestError = error;
+
+                // 单独模式 (diff = 0): 两个子块各自 RGB444 基色
+                bestHigh = (static_cast<uint32_t>(colors[0][0]) << 28) | (static_cast<uint32_t>(colors[1][0]) << 24)
+                         | (static_cast<uint32_t>(colors[0][1]) << 20) | (static_cast<uint32_t>(colors[1][1]) << 16)
+                         | (static_cast<uint32_t>(colors[0][2]) << 12) | (static_cast<uint32_t>(colors[1][2]) << 8)
+                         | (static_cast<uint32_t>(tables[0]) << 5) | (static_cast<uint32_t>(tables[1]) << 2)
+                         | static_cast<uint32_t>(flip);
+                // 像素索引按列优先编号 (x * 4 + y)，高位在 31..16，低位在 15..0
+                bestLow = 0;
+                for (int sub = 0; sub < 2; ++sub) {
+                    for (int i = 0; i < 8; ++i) {
+                        const int pixel = kSubsets[flip][sub][i];
+                        const int bit = (pixel % 4) * 4 + pixel / 4;
+                        const uint32_t index = static_cast<uint32_t>(indices[sub][i]);
+                        bestLow |= ((index >> 1) & 1u) << (16 + bit);
+                        bestLow |= (index & 1u) << bit;
+                    }
+                }
+            }
+
+            const uint32_t words[2] = { bestHigh, bestLow };
+            for (uint32_t word : words) {
+                result.push_back(static_cast<uint8_t>(word >> 24));
+                result.push_back(static_cast<uint8_t>(word >> 16));
+                result.push_back(static_cast<uint8_t>(word >> 8));
+                result.push_back(static_cast<uint8_t>(word));
+            }
+        }
+    }
+    return result;
+}
+
+bool transcode(const CompressedImage& image, const CompressedFormatSupport& support,
+               CompressedImage& result, std::string& error) {
+    std::vector<uint8_t> rgba;
+    if (!decodeToRgba(image, rgba)) {
+        // 自带解码器不支持的格式 (如 PVRTC) 交给 SOIL2: stbi_DDS/stbi_pkm/stbi_pvr 会解压为 RGBA8
+        int width = 0;
+        int height = 0;
+        int channels = 0;
+        unsigned char* pixels = SOIL_load_image_from_memory(image.data.data(), static_cast<int>(image.data.size()),
+                                                            &width, &height, &channels, SOIL_LOAD_RGBA);
+        if (!pixels || width != image.width || height != image.height) {
+            SOIL_free_image_data(pixels);
+            error = std::string("Cannot decode ") + formatName(image.format) + " on the CPU and the driver does not support it";
+            return false;
+        }
+        rgba.assign(pixels, pixels + static_cast<size_t>(width) * height * 4);
+        SOIL_free_image_data(pixels);
+    }
+
+    bool alpha = false;
+    if (image.hasAlpha()) {
+        for (size_t i = 3; i < rgba.size() && !alpha; i += 4) {
+            alpha = rgba[i] != 255;
+        }
+    }
+
+    // 重新编码后仍是 sRGB 数据，内部格式保持 sRGB (见 glInternalFormat)
+    result.srgb = image.srgb;
+    if (support.s3tc && (!image.srgb || support.s3tcSrgb)) {
+        result.format = alpha ? CompressedFormat::BC3 : CompressedFormat::BC1;
+    } else if (support.etc2 && !alpha) {
+        result.format = CompressedFormat::ETC1;
+    } else {
+        result.format = CompressedFormat::None;
+    }
+    result.width = image.width;
+    result.height = image.height;
+    result.levels.clear();
+    result.data.clear();
+
+    // 源文件带mip链时在CPU上重新生成 (压缩纹理无法 glGenerateMipmap)
+    const size_t levelCount = image.levels.size();
+    int width = image.width;
+    int height = image.height;
+    for (size_t level = 0; level < levelCount; ++level) {
+        CompressedLevel entry;
+        entry.width = width;
+        entry.height = height;
+        entry.offset = result.data.size();
+
+        if (result.format == CompressedFormat::BC1 || result.format == CompressedFormat::BC3) {
+            int size = 0;
+            unsigned char* encoded = result.format == CompressedFormat::BC1
+                ? convert_image_to_DXT1(rgba.data(), width, height, 4, &size)
+                : convert_image_to_DXT5(rgba.data(), width, height, 4, &size);
+            if (!encoded) {
+                error = "DXT encoding failed";
+                return false;
+            }
+            result.data.insert(result.data.end(), encoded, encoded + size);
+            std::free(encoded);
+        } else if (result.format == CompressedFormat::ETC1) {
+            const std::vector<uint8_t> encoded = encodeEtc1(rgba.data(), width, height);
+            result.data.insert(result.data.end(), encoded.begin(), encoded.end());
+        } else {
+            result.data.insert(result.data.end(), rgba.begin(), rgba.end());
+        }
+        entry.size = result.data.size() - entry.offset;
+        result.levels.push_back(entry);
+
+        if (level + 1 < levelCount) {
+            rgba = MipChain::downsample(rgba, width, height);
+            width = std::max(1, width / 2);
+            height = std::max(1, height / 2);
+        }
+    }
+    return true;
+}
+
+std::vector<std::string> preferredExtensions(const CompressedFormatSupport& support) {
+    std::vector<std::string> extensions;
+#ifdef __ANDROID__
+    // 移动GPU: ETC2 是 GLES3 核心格式，优先
+    if (support.etc2) {
+        extensions.push_back(".ktx");
+        extensions.push_back(".pkm");
+    }
+    if (support.pvrtc) {
+        extensions.push_back(".pvr");
+    }
+    if (support.s3tc) {
+        extensions.push_back(".dds");
+    }
+#else
+    // 桌面GPU: BC 由硬件直接采样，ETC2 多数驱动在上传时解压
+    if (support.s3tc) {
+        extensions.push_back(".dds");
+    }
+    if (support.etc2) {
+        extensions.push_back(".ktx");
+        extensions.push_back(".pkm");
+    }
+#endif
+    return extensions;
+}
+
+} // namespace CompressedTexture
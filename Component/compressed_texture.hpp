@@ -0,0 +1,117 @@
+// compressed_texture.hpp
+// 单一职责: 块压缩纹理容器 (DDS/KTX/PKM/PVR) 解析、驱动支持查询与不支持时的CPU转码
+#pragma once
+
+// 平台条件编译：OpenGL ES (Android) vs OpenGL Core (PC)
+#ifdef __ANDROID__
+    #include <GLES3/gl3.h>
+    #include <GLES3/gl3ext.h>
+#else
+    #include <glad/glad.h>
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+enum class CompressedFormat {
+    None,           // 非压缩 RGBA8 (转码回退的最后一级)
+    BC1,            // DXT1 (RGB)
+    BC1A,           // DXT1 (1位alpha)
+    BC2,            // DXT3
+    BC3,            // DXT5
+    ETC1,
+    ETC2_RGB,
+    ETC2_RGBA,      // ETC2 + EAC alpha
+    PVRTC_RGB_4BPP,
+    PVRTC_RGBA_4BPP,
+    PVRTC_RGB_2BPP,
+    PVRTC_RGBA_2BPP
+};
+
+struct CompressedImage;
+
+/**
+ * @brief 当前上下文可直接上传的压缩格式 (须在GL线程查询)
+ */
+struct CompressedFormatSupport {
+    bool s3tc = false;      // BC1~BC3
+    bool s3tcSrgb = false;  // BC1~BC3 的 sRGB 变体 (EXT_texture_sRGB / EXT_texture_compression_s3tc_srgb)
+    bool etc2 = false;      // ETC2/EAC (ETC1 数据按 ETC2 RGB 上传)
+    bool pvrtc = false;
+
+    static CompressedFormatSupport query();
+
+    bool supports(CompressedFormat format) const;
+    bool supports(const CompressedImage& image) const;     // 同时考虑 sRGB
+    std::string describe() const;
+};
+
+struct CompressedLevel {
+    int width = 0;
+    int height = 0;
+    size_t offset = 0;      // 在 CompressedImage::data 中的偏移
+    size_t size = 0;
+};
+
+/**
+ * @brief 块压缩图像: 文件内容原样保留，各mip层级按偏移引用
+ *
+ * 容器中的像素按存储顺序上传，不做上下翻转 (压缩块无法按行翻转)，
+ * 需要GL纹理坐标约定的资源应在离线工具中翻转后再压缩。
+ */
+struct CompressedImage {
+    CompressedFormat format = CompressedFormat::None;
+    int width = 0;
+    int height = 0;
+    std::vector<CompressedLevel> levels;
+    std::vector<uint8_t> data;
+    bool srgb = false;      // 颜色按 sRGB 编码 (DDS *_UNORM_SRGB)，上传为对应的 sRGB 内部格式，采样时解码为线性
+
+    bool isValid() const { return !levels.empty(); }
+    bool hasAlpha() const;
+    GLenum glInternalFormat() const;
+};
+
+namespace CompressedTexture {
+
+const char* formatName(CompressedFormat format);
+
+/**
+ * @brief 某格式一个层级的字节数
+ */
+size_t levelSize(CompressedFormat format, int width, int height);
+
+/**
+ * @brief 解析内存中的容器文件，成功时 file 的内容移入 image.data (各层级不拷贝)
+ * @return 不是支持的压缩容器时返回 false 且 error 为空 (调用方改走普通图片解码)；
+ *         是压缩容器但内容非法时返回 false 并给出 error
+ */
+bool parse(std::vector<uint8_t>& file, CompressedImage& image, std::string& error);
+
+/**
+ * @brief 驱动不支持 image 的格式时在CPU上转码 (在工作线程调用)
+ *
+ * 先解码为 RGBA8，再按支持情况重新编码: S3TC → BC1/BC3；ETC2 → ETC1 (仅不透明)；
+ * 都不可用时输出 format == None 的 RGBA8 mip 链。
+ */
+bool transcode(const CompressedImage& image, const CompressedFormatSupport& support,
+               CompressedImage& result, std::string& error);
+
+/**
+ * @brief 解码为 RGBA8 (仅第0级)；支持 BC1~BC3 与 ETC1
+ */
+bool decodeToRgba(const CompressedImage& image, std::vector<uint8_t>& rgba);
+
+/**
+ * @brief ETC1 编码 (单独模式，逐块枚举翻转方向与修正表)
+ */
+std::vector<uint8_t> encodeEtc1(const uint8_t* rgba, int width, int height);
+
+/**
+ * @brief 按支持情况排序的压缩资源扩展名，用于查找同名的压缩版本 (桌面优先 .dds，GLES 优先 .ktx/.pkm)
+ */
+std::vector<std::string> preferredExtensions(const CompressedFormatSupport& support);
+
+} // namespace CompressedTexture
@@ -0,0 +1,146 @@
+#include "frame_allocator.hpp"
+
+#include <algorithm>
+
+namespace {
+
+FrameAllocator* s_activeAllocator = nullptr;
+
+size_t alignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+} // namespace
+
+FrameAllocator::FrameAllocator()
+    : m_current(nullptr)
+    , m_frame(0)
+    , m_peakBytes(0)
+    , m_heapAllocations(0)
+{ }
+
+FrameAllocator::~FrameAllocator() {
+    release();
+}
+
+bool FrameAllocator::create(const FrameAllocatorSettings& settings) {
+    if (isCreated()) {
+        return true;
+    }
+
+    const uint32_t frames = std::max(1u, settings.frames);
+    const size_t capacity = alignUp(std::max<size_t>(settings.arenaBytes, kArenaAlignment), kArenaAlignment);
+    for (uint32_t i = 0; i < frames; ++i) {
+        std::unique_ptr<Arena> arena(new Arena());
+        arena->data = static_cast<uint8_t*>(::operator new(capacity, std::align_val_t(kArenaAlignment)));
+        arena->capacity = capacity;
+        m_arenas.push_back(std::move(arena));
+        m_heapAllocations++;
+    }
+    m_current = m_arenas[0].get();
+    m_frame = 0;
+    m_peakBytes = 0;
+    return true;
+}
+
+void FrameAllocator::release() {
+    for (const std::unique_ptr<Arena>& arena : m_arenas) {
+        rewind(*arena);
+        ::operator delete(arena->data, std::align_val_t(kArenaAlignment));
+    }
+    m_arenas.clear();
+    m_current = nullptr;
+}
+
+void FrameAllocator::beginFrame(uint64_t frameNumber) {
+    if (!isCreated()) {
+        return;
+    }
+
+    // 上一帧的用量 (含溢出) 计入峰值
+    const size_t previousUsed = m_current->offset.load(std::memory_order_relaxed) + m_current->overflowBytes.load(std::memory_order_relaxed);
+    m_peakBytes = std::max(m_peakBytes, previousUsed);
+
+    m_frame = frameNumber;
+    Arena& arena = *m_arenas[frameNumber % m_arenas.size()];
+
+    // 上次轮到它时溢出过: 按当时的总用量扩容，之后同样负载的帧不再溢出
+    const size_t needed = arena.offset.load(std::memory_order_relaxed) + arena.overflowBytes.load(std::memory_order_relaxed);
+    if (arena.overflowBytes.load(std::memory_order_relaxed) > 0 && needed > arena.capacity) {
+        const size_t capacity = alignUp(std::max(needed + needed / 4, arena.capacity * 2), kArenaAlignment);
+        ::operator delete(arena.data, std::align_val_t(kArenaAlignment));
+        arena.data = static_cast<uint8_t*>(::operator new(capacity, std::align_val_t(kArenaAlignment)));
+        arena.capacity = capacity;
+        m_heapAllocations++;
+    }
+
+    rewind(arena);
+    m_current = &arena;
+}
+
+void* FrameAllocator::allocate(size_t bytes, size_t alignment) {
+    if (!m_current) {
+        return nullptr;
+    }
+    Arena& arena = *m_current;
+    arena.allocations.fetch_add(1, std::memory_order_relaxed);
+    bytes = std::max<size_t>(bytes, 1);
+
+    // 无锁移动偏移: 起点按 alignment 对齐 (竞技场本身按 kArenaAlignment 对齐)
+    size_t current = arena.offset.load(std::memory_order_relaxed);
+    for (;;) {
+        const size_t begin = alignUp(current, alignment);
+        const size_t end = begin + bytes;
+        if (end > arena.capacity) {
+            return allocateOverflow(arena, bytes, alignment);
+        }
+        if (arena.offset.compare_exchange_weak(current, end, std::memory_order_relaxed)) {
+            return arena.data + begin;
+        }
+    }
+}
+
+void* FrameAllocator::allocateOverflow(Arena& arena, size_t bytes, size_t alignment) {
+    const size_t blockAlignment = std::max(alignment, kDefaultAlignment);
+    void* block = ::operator new(bytes, std::align_val_t(blockAlignment));
+    arena.overflowBytes.fetch_add(bytes + alignment, std::memory_order_relaxed);
+    m_heapAllocations.fetch_add(1, std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(m_overflowMutex);
+    arena.overflow.push_back({ block, blockAlignment });
+    return block;
+}
+
+void FrameAllocator::rewind(Arena& arena) {
+    for (const OverflowBlock& block : arena.overflow) {
+        ::operator delete(block.data, std::align_val_t(block.alignment));
+    }
+    arena.overflow.clear();
+    arena.offset.store(0, std::memory_order_relaxed);
+    arena.overflowBytes.store(0, std::memory_order_relaxed);
+    arena.allocations.store(0, std::memory_order_relaxed);
+}
+
+FrameAllocatorStats FrameAllocator::stats() const {
+    FrameAllocatorStats stats;
+    stats.frame = m_frame;
+    stats.heapAllocations = m_heapAllocations.load(std::memory_order_relaxed);
+    stats.peakBytes = m_peakBytes;
+    if (m_current) {
+        const Arena& arena = *m_current;
+        stats.usedBytes = std::min(arena.offset.load(std::memory_order_relaxed), arena.capacity);
+        stats.capacityBytes = arena.capacity;
+        stats.allocations = arena.allocations.load(std::memory_order_relaxed);
+        stats.overflowAllocations = arena.overflow.size();
+        stats.peakBytes = std::max(stats.peakBytes, stats.usedBytes + arena.overflowBytes.load(std::memory_order_relaxed));
+    }
+    return stats;
+}
+
+void FrameAllocator::setActive(FrameAllocator* allocator) {
+    s_activeAllocator = allocator;
+}
+
+FrameAllocator* FrameAllocator::active() {
+    return s_activeAllocator;
+}
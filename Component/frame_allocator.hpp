@@ -0,0 +1,163 @@
+// frame_allocator.hpp
+// 单一职责: 逐帧线性分配器 - N 个竞技场按帧号轮流使用，帧内只移动指针 (可多线程)，整帧一次性回收
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#include "render_context.hpp"
+
+struct FrameAllocatorSettings {
+    size_t arenaBytes = 4 * 1024 * 1024;   // 每个竞技场的初始容量 (不够时下次轮到它时按峰值扩容)
+    uint32_t frames = 3;                    // 竞技场个数: 第 f 帧分配的内存在第 f + frames - 1 帧结束前有效
+};
+
+struct FrameAllocatorStats {
+    uint64_t frame = 0;                 // 最近一次 beginFrame 的帧号
+    size_t usedBytes = 0;               // 本帧已分配 (含对齐填充，不含溢出)
+    size_t capacityBytes = 0;           // 本帧竞技场的容量
+    size_t peakBytes = 0;               // 各帧用量 (含溢出) 的最大值
+    uint64_t allocations = 0;           // 本帧分配次数
+    uint64_t overflowAllocations = 0;   // 本帧超出竞技场、退回堆的次数
+    uint64_t heapAllocations = 0;       // 分配器自身的堆分配累计 (竞技场创建/扩容 + 溢出)
+};
+
+/**
+ * @brief FrameAllocator类 - 逐帧数据 (可见列表、命令流、暂存数据) 的线性分配器
+ *
+ * 使用方式:
+ *   FrameAllocator frames;
+ *   frames.create();
+ *   FrameAllocator::setActive(&frames);
+ *
+ *   // 每帧开始 (渲染之前):
+ *   frames.beginFrame(context);                  // 按 context.frameNumer() % frames 选择竞技场并回绕
+ *   float* keys = frames.allocateArray<float>(n);
+ *   FrameVector<uint32_t> visible;               // STL 容器同样从当前竞技场分配
+ *
+ * 分配只是原子地移动偏移，任意线程可同时调用；单个释放是空操作，整帧在竞技场下次轮到时一起回收。
+ * 竞技场放不下时退回堆分配 (计入 overflowAllocations)，该竞技场下次轮到时按本帧用量扩容，
+ * 之后的稳定帧不再有任何堆分配。beginFrame 不能与 allocate 并发。
+ */
+class FrameAllocator {
+public:
+    static constexpr size_t kDefaultAlignment = 16;
+    static constexpr size_t kArenaAlignment = 64;
+
+    FrameAllocator();
+    ~FrameAllocator();
+
+    // 禁止拷贝
+    FrameAllocator(const FrameAllocator&) = delete;
+    FrameAllocator& operator=(const FrameAllocator&) = delete;
+
+    bool create(const FrameAllocatorSettings& settings = FrameAllocatorSettings());
+    void release();
+    bool isCreated() const { return !m_arenas.empty(); }
+
+    /**
+     * @brief 切换到 frameNumber % frames 的竞技场并回绕 (释放它 frames 帧之前的全部分配)
+     */
+    void beginFrame(uint64_t frameNumber);
+    void beginFrame(const RenderContext& context) { beginFrame(context.frameNumer()); }
+
+    /**
+     * @brief 从当前竞技场分配 (alignment 须为2的幂)，未创建时返回 nullptr
+     */
+    void* allocate(size_t bytes, size_t alignment = kDefaultAlignment);
+
+    template <typename T>
+    T* allocateArray(size_t count) {
+        static_assert(std::is_trivially_destructible<T>::value, "Frame allocations are never destroyed");
+        return static_cast<T*>(allocate(count * sizeof(T), alignof(T) > kDefaultAlignment ? alignof(T) : kDefaultAlignment));
+    }
+
+    FrameAllocatorStats stats() const;
+
+    // 与 JobSystem 相同，由应用持有实例并设置
+    static void setActive(FrameAllocator* allocator);
+    static FrameAllocator* active();
+
+private:
+    struct OverflowBlock {
+        void* data;
+        size_t alignment;
+    };
+
+    struct Arena {
+        uint8_t* data = nullptr;
+        size_t capacity = 0;
+        std::atomic<size_t> offset{ 0 };
+        std::atomic<size_t> overflowBytes{ 0 };    // 溢出到堆的字节 (扩容依据)
+        std::atomic<uint64_t> allocations{ 0 };
+        std::vector<OverflowBlock> overflow;       // 溢出的堆块，回绕时释放 (m_overflowMutex 保护)
+    };
+
+    void* allocateOverflow(Arena& arena, size_t bytes, size_t alignment);
+    void rewind(Arena& arena);
+
+    std::vector<std::unique_ptr<Arena>> m_arenas;
+    Arena* m_current;
+    uint64_t m_frame;
+    size_t m_peakBytes;
+    std::atomic<uint64_t> m_heapAllocations;
+    std::mutex m_overflowMutex;
+};
+
+/**
+ * @brief STL 分配器适配: 从构造时活动的 FrameAllocator 分配，deallocate 为空操作
+ *
+ * 容器的生命周期不能超过 frames - 1 帧，也不能晚于 FrameAllocator::release；
+ * 构造时没有活动的 FrameAllocator 则始终使用普通堆分配。
+ */
+template <typename T>
+class FrameStlAllocator {
+public:
+    using value_type = T;
+
+    FrameStlAllocator() noexcept : FrameStlAllocator(FrameAllocator::active()) { }
+    explicit FrameStlAllocator(FrameAllocator* allocator) noexcept
+        : m_allocator(allocator && allocator->isCreated() ? allocator : nullptr)
+    { }
+
+    template <typename U>
+    FrameStlAllocator(const FrameStlAllocator<U>& other) noexcept : m_allocator(other.allocator()) { }
+
+    T* allocate(size_t count) {
+        const size_t bytes = count * sizeof(T);
+        if (!m_allocator) {
+            return static_cast<T*>(::operator new(bytes));
+        }
+        const size_t alignment = alignof(T) > FrameAllocator::kDefaultAlignment ? alignof(T) : FrameAllocator::kDefaultAlignment;
+        void* memory = m_allocator->allocate(bytes, alignment);
+        if (!memory) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(memory);
+    }
+
+    void deallocate(T* pointer, size_t count) noexcept {
+        (void)count;
+        if (!m_allocator) {
+            ::operator delete(pointer);
+        }
+    }
+
+    FrameAllocator* allocator() const { return m_allocator; }
+
+    template <typename U>
+    bool operator==(const FrameStlAllocator<U>& other) const { return m_allocator == other.allocator(); }
+    template <typename U>
+    bool operator!=(const FrameStlAllocator<U>& other) const { return m_allocator != other.allocator(); }
+
+private:
+    FrameAllocator* m_allocator;
+};
+
+template <typename T>
+using FrameVector = std::vector<T, FrameStlAllocator<T>>;
@@ -0,0 +1,64 @@
+// frame_uniforms.hpp
+// 单一职责: 帧全局uniform块 (FrameBlock) 的 std140 CPU 镜像与每帧更新
+#pragma once
+#include "uniform_buffer.hpp"
+#include "render_context.hpp"
+
+#include <cstddef>
+#include <glm/glm.hpp>
+
+/**
+ * 与着色器中的声明逐字节对应:
+ *
+ *   layout(std140) uniform FrameBlock {
+ *       mat4 projection;
+ *       mat4 view;
+ *       mat4 viewProjection;
+ *       vec4 viewport;     // (width, height, 1/width, 1/height)
+ *       vec4 timing;       // (deltaTime, frameNumber, 0, 0)
+ *   } frame;
+ */
+struct FrameUniforms {
+    glm::mat4 projection;
+    glm::mat4 view;
+    glm::mat4 viewProjection;
+    glm::vec4 viewport;
+    glm::vec4 timing;
+};
+
+static_assert(offsetof(FrameUniforms, projection) == 0, "std140 layout mismatch");
+static_assert(offsetof(FrameUniforms, view) == 64, "std140 layout mismatch");
+static_assert(offsetof(FrameUniforms, viewProjection) == 128, "std140 layout mismatch");
+static_assert(offsetof(FrameUniforms, viewport) == 192, "std140 layout mismatch");
+static_assert(offsetof(FrameUniforms, timing) == 208, "std140 layout mismatch");
+static_assert(sizeof(FrameUniforms) == 224, "std140 layout mismatch");
+
+/**
+ * @brief FrameUniformBuffer - 每帧由帧循环写入一次，所有渲染器共享
+ */
+class FrameUniformBuffer {
+public:
+    bool create() {
+        return m_block.create(UniformBinding::Frame);
+    }
+
+    void update(const RenderContext& context, const glm::mat4& view = glm::mat4(1.0f)) {
+        FrameUniforms& data = m_block.data();
+        const float width = static_cast<float>(context.width() > 0 ? context.width() : 1);
+        const float height = static_cast<float>(context.height() > 0 ? context.height() : 1);
+
+        data.projection = context.projectionMatrix();
+        data.view = view;
+        data.viewProjection = data.projection * view;
+        data.viewport = glm::vec4(width, height, 1.0f / width, 1.0f / height);
+        data.timing = glm::vec4(context.deltaTime(), static_cast<float>(context.frameNumer()), 0.0f, 0.0f);
+
+        m_block.upload();
+    }
+
+    void release() { m_block.release(); }
+    bool isValid() const { return m_block.isValid(); }
+
+private:
+    UniformBlock<FrameUniforms> m_block;
+};
@@ -0,0 +1,173 @@
+#include "framebuffer.hpp"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <utility>
+
+Framebuffer::Framebuffer()
+    : m_fbo(0)
+    , m_colorRbo(0)
+    , m_depthRbo(0)
+    , m_width(0)
+    , m_height(0)
+{
+}
+
+Framebuffer::~Framebuffer() {
+    release();
+}
+
+Framebuffer::Framebuffer(Framebuffer&& other) noexcept
+    : m_fbo(std::exchange(other.m_fbo, 0))
+    , m_colorRbo(std::exchange(other.m_colorRbo, 0))
+    , m_depthRbo(std::exchange(other.m_depthRbo, 0))
+    , m_width(other.m_width)
+    , m_height(other.m_height)
+    , m_lastError(std::move(other.m_lastError))
+{
+}
+
+Framebuffer& Framebuffer::operator=(Framebuffer&& other) noexcept {
+    if (this != &other) {
+        release();
+        m_fbo = std::exchange(other.m_fbo, 0);
+        m_colorRbo = std::exchange(other.m_colorRbo, 0);
+        m_depthRbo = std::exchange(other.m_depthRbo, 0);
+        m_width = other.m_width;
+        m_height = other.m_height;
+        m_lastError = std::move(other.m_lastError);
+    }
+    return *this;
+}
+
+bool Framebuffer::create(int width, int height) {
+    release();
+
+    if (width <= 0 || height <= 0) {
+        m_lastError = "Invalid framebuffer size";
+        return false;
+    }
+
+    m_width = width;
+    m_height = height;
+
+    glGenFramebuffers(1, &m_fbo);
+    glGenRenderbuffers(1, &m_colorRbo);
+    glGenRenderbuffers(1, &m_depthRbo);
+
+    if (!allocateAttachments()) {
+        release();
+        return false;
+    }
+    return true;
+}
+
+bool Framebuffer::resize(int width, int height) {
+    if (m_fbo == 0) {
+        return create(width, height);
+    }
+    if (width <= 0 || height <= 0) {
+        m_lastError = "Invalid framebuffer size";
+        return false;
+    }
+    if (width == m_width && height == m_height) {
+        return true;
+    }
+
+    m_width = width;
+    m_height = height;
+    return allocateAttachments();
+}
+
+bool Framebuffer::allocateAttachments() {
+    glBindRenderbuffer(GL_RENDERBUFFER, m_colorRbo);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, m_width, m_height);
+
+    glBindRenderbuffer(GL_RENDERBUFFER, m_depthRbo);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, m_width, m_height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, m_fbo);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_colorRbo);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_depthRbo);
+
+    // 检查完整性
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        std::ostringstream oss;
+        oss << "Framebuffer incomplete, status: 0x" << std::hex << status;
+        m_lastError = oss.str();
+        std::cerr << "Framebuffer: " << m_lastError << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void Framebuffer::bind() const {
+    glBindFramebuffer(GL_FRAMEBUFFER, m_fbo);
+}
+
+void Framebuffer::unbind() const {
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+bool Framebuffer::readPixels(std::vector<uint8_t>& pixels) const {
+    if (m_fbo == 0) {
+        return false;
+    }
+
+    pixels.resize(static_cast<size_t>(m_width) * m_height * 4);
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, m_fbo);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, m_width, m_height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+    return true;
+}
+
+bool Framebuffer::savePPM(const std::string& path) const {
+    std::vector<uint8_t> pixels;
+    if (!readPixels(pixels)) {
+        return false;
+    }
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Framebuffer: Failed to open file: " << path << std::endl;
+        return false;
+    }
+
+    file << "P6\n" << m_width << " " << m_height << "\n255\n";
+
+    // GL的行序是自下而上，PPM是自上而下
+    std::vector<uint8_t> row(static_cast<size_t>(m_width) * 3);
+    for (int y = m_height - 1; y >= 0; --y) {
+        const uint8_t* src = pixels.data() + static_cast<size_t>(y) * m_width * 4;
+        for (int x = 0; x < m_width; ++x) {
+            row[x * 3 + 0] = src[x * 4 + 0];
+            row[x * 3 + 1] = src[x * 4 + 1];
+            row[x * 3 + 2] = src[x * 4 + 2];
+        }
+        file.write(reinterpret_cast<const char*>(row.data()), static_cast<std::streamsize>(row.size()));
+    }
+    return file.good();
+}
+
+void Framebuffer::release() {
+    if (m_fbo != 0) {
+        glDeleteFramebuffers(1, &m_fbo);
+        m_fbo = 0;
+    }
+    if (m_colorRbo != 0) {
+        glDeleteRenderbuffers(1, &m_colorRbo);
+        m_colorRbo = 0;
+    }
+    if (m_depthRbo != 0) {
+        glDeleteRenderbuffers(1, &m_depthRbo);
+        m_depthRbo = 0;
+    }
+    m_width = 0;
+    m_height = 0;
+}
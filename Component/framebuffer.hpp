@@ -0,0 +1,87 @@
+#pragma once
+
+// 平台条件编译：OpenGL ES (Android) vs OpenGL Core (PC)
+#ifdef __ANDROID__
+    #include <GLES3/gl3.h>
+    #include <GLES3/gl3ext.h>
+#else
+    #include <glad/glad.h>
+#endif
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Framebuffer类 - 封装离屏渲染目标 (FBO + 颜色/深度RBO)
+ *
+ * 单一职责: 管理FBO的创建、绑定、尺寸调整与像素回读
+ * 无窗口(headless)模式下所有渲染器都绘制到这里，而不是默认帧缓冲
+ */
+class Framebuffer {
+public:
+    Framebuffer();
+    ~Framebuffer();
+
+    // 禁止拷贝，允许移动
+    Framebuffer(const Framebuffer&) = delete;
+    Framebuffer& operator=(const Framebuffer&) = delete;
+    Framebuffer(Framebuffer&& other) noexcept;
+    Framebuffer& operator=(Framebuffer&& other) noexcept;
+
+    /**
+     * @brief 创建 RGBA8 颜色 + 24位深度/8位模板 的帧缓冲
+     * @param width 宽度（像素）
+     * @param height 高度（像素）
+     * @return 是否成功（失败原因见 lastError）
+     */
+    bool create(int width, int height);
+
+    /**
+     * @brief 调整尺寸（重新分配附件存储）
+     */
+    bool resize(int width, int height);
+
+    /**
+     * @brief 绑定为当前绘制目标
+     */
+    void bind() const;
+
+    /**
+     * @brief 恢复默认帧缓冲
+     */
+    void unbind() const;
+
+    /**
+     * @brief 回读颜色附件 (RGBA8, 自下而上的行序)
+     */
+    bool readPixels(std::vector<uint8_t>& pixels) const;
+
+    /**
+     * @brief 将颜色附件保存为二进制PPM文件（自上而下的行序）
+     */
+    bool savePPM(const std::string& path) const;
+
+    /**
+     * @brief 释放GL资源
+     */
+    void release();
+
+    GLuint id() const { return m_fbo; }
+    int width() const { return m_width; }
+    int height() const { return m_height; }
+    bool isValid() const { return m_fbo != 0; }
+
+    std::string lastError() const { return m_lastError; }
+
+private:
+    bool allocateAttachments();
+
+private:
+    GLuint m_fbo;
+    GLuint m_colorRbo;
+    GLuint m_depthRbo;
+    int m_width;
+    int m_height;
+    std::string m_lastError;
+};
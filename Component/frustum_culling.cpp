@@ -0,0 +1,414 @@
+#include "frustum_culling.hpp"
+#include "camera.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    #include <immintrin.h>
+    #define FRUSTUM_CULLING_X86 1
+    #if defined(_MSC_VER) && !defined(__clang__)
+        #include <intrin.h>
+        #define FRUSTUM_CULLING_AVX2_TARGET
+    #else
+        // 只为AVX2核心函数启用该指令集，其余代码保持基线目标，运行时再选择
+        #define FRUSTUM_CULLING_AVX2_TARGET __attribute__((target("avx2")))
+    #endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define FRUSTUM_CULLING_NEON 1
+#endif
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// 六个平面按分量展开，SIMD 核心逐平面广播
+struct PlaneSet {
+    float nx[6];
+    float ny[6];
+    float nz[6];
+    float w[6];
+    float ax[6];    // |n|，AABB 在法线方向上的投影半径
+    float ay[6];
+    float az[6];
+};
+
+PlaneSet makePlaneSet(const Frustum& frustum) {
+    PlaneSet set;
+    for (int p = 0; p < 6; ++p) {
+        const glm::vec4& plane = frustum.planes[p];
+        set.nx[p] = plane.x;
+        set.ny[p] = plane.y;
+        set.nz[p] = plane.z;
+        set.w[p] = plane.w;
+        set.ax[p] = std::fabs(plane.x);
+        set.ay[p] = std::fabs(plane.y);
+        set.az[p] = std::fabs(plane.z);
+    }
+    return set;
+}
+
+size_t paddedCount(size_t count) {
+    return (count + CullingBounds::kLanes - 1) / CullingBounds::kLanes * CullingBounds::kLanes;
+}
+
+// 可见位掩码追加到输出: 无分支，每个通道都写入，可见时前进
+inline size_t appendMask(unsigned mask, uint32_t base, int lanes, uint32_t* out, size_t written) {
+    for (int lane = 0; lane < lanes; ++lane) {
+        out[written] = base + static_cast<uint32_t>(lane);
+        written += (mask >> lane) & 1u;
+    }
+    return written;
+}
+
+// 末尾不足一组时屏蔽补齐的通道
+inline unsigned tailMask(size_t base, size_t count, int lanes) {
+    const size_t remaining = count - base;
+    return remaining >= static_cast<size_t>(lanes) ? 0xFFu : ((1u << remaining) - 1u);
+}
+
+size_t cullScalar(const PlaneSet& planes, const CullingBounds& bounds, CullShape shape, uint32_t* out) {
+    const size_t count = bounds.size();
+    size_t written = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const float cx = bounds.centerX()[i];
+        const float cy = bounds.centerY()[i];
+        const float cz = bounds.centerZ()[i];
+        bool inside = true;
+        for (int p = 0; p < 6; ++p) {
+            const float distance = planes.nx[p] * cx + planes.ny[p] * cy + planes.nz[p] * cz + planes.w[p];
+            const float extent = shape == CullShape::Aabb
+                ? planes.ax[p] * bounds.extentX()[i] + planes.ay[p] * bounds.extentY()[i] + planes.az[p] * bounds.extentZ()[i]
+                : bounds.radius()[i];
+            inside &= !(distance + extent < 0.0f);
+        }
+        out[written] = static_cast<uint32_t>(i);
+        written += inside ? 1 : 0;
+    }
+    return written;
+}
+
+#if defined(FRUSTUM_CULLING_X86)
+
+size_t cullSse(const PlaneSet& planes, const CullingBounds& bounds, CullShape shape, uint32_t* out) {
+    const size_t count = bounds.size();
+    const __m128 zero = _mm_setzero_ps();
+    size_t written = 0;
+    for (size_t base = 0; base < count; base += 4) {
+        const __m128 cx = _mm_loadu_ps(bounds.centerX() + base);
+        const __m128 cy = _mm_loadu_ps(bounds.centerY() + base);
+        const __m128 cz = _mm_loadu_ps(bounds.centerZ() + base);
+        __m128 outside = _mm_setzero_ps();
+
+        if (shape == CullShape::Aabb) {
+            const __m128 ex = _mm_loadu_ps(bounds.extentX() + base);
+            const __m128 ey = _mm_loadu_ps(bounds.extentY() + base);
+            const __m128 ez = _mm_loadu_ps(bounds.extentZ() + base);
+            for (int p = 0; p < 6; ++p) {
+                __m128 distance = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(planes.nx[p]), cx), _mm_mul_ps(_mm_set1_ps(planes.ny[p]), cy));
+                distance = _mm_add_ps(_mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(planes.nz[p]), cz)), _mm_set1_ps(planes.w[p]));
+                __m128 extent = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(planes.ax[p]), ex), _mm_mul_ps(_mm_set1_ps(planes.ay[p]), ey));
+                extent = _mm_add_ps(extent, _mm_mul_ps(_mm_set1_ps(planes.az[p]), ez));
+                outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, extent), zero));
+            }
+        } else {
+            const __m128 radius = _mm_loadu_ps(bounds.radius() + base);
+            for (int p = 0; p < 6; ++p) {
+                __m128 distance = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(planes.nx[p]), cx), _mm_mul_ps(_mm_set1_ps(planes.ny[p]), cy));
+                distance = _mm_add_ps(_mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(planes.nz[p]), cz)), _mm_set1_ps(planes.w[p]));
+                outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, radius), zero));
+            }
+        }
+
+        const unsigned mask = (~static_cast<unsigned>(_mm_movemask_ps(outside)) & 0xFu) & tailMask(base, count, 4);
+        written = appendMask(mask, static_cast<uint32_t>(base), 4, out, written);
+    }
+    return written;
+}
+
+FRUSTUM_CULLING_AVX2_TARGET
+size_t cullAvx2(const PlaneSet& planes, const CullingBounds& bounds, CullShape shape, uint32_t* out) {
+    const size_t count = bounds.size();
+    const __m256 zero = _mm256_setzero_ps();
+    size_t written = 0;
+    for (size_t base = 0; base < count; base += 8) {
+        const __m256 cx = _mm256_loadu_ps(bounds.centerX() + base);
+        const __m256 cy = _mm256_loadu_ps(bounds.centerY() + base);
+        const __m256 cz = _mm256_loadu_ps(bounds.centerZ() + base);
+        __m256 outside = _mm256_setzero_ps();
+
+        if (shape == CullShape::Aabb) {
+            const __m256 ex = _mm256_loadu_ps(bounds.extentX() + base);
+            const __m256 ey = _mm256_loadu_ps(bounds.extentY() + base);
+            const __m256 ez = _mm256_loadu_ps(bounds.extentZ() + base);
+            for (int p = 0; p < 6; ++p) {
+                __m256 distance = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(planes.nx[p]), cx), _mm256_mul_ps(_mm256_set1_ps(planes.ny[p]), cy));
+                distance = _mm256_add_ps(_mm256_add_ps(distance, _mm256_mul_ps(_mm256_set1_ps(planes.nz[p]), cz)), _mm256_set1_ps(planes.w[p]));
+                __m256 extent = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(planes.ax[p]), ex), _mm256_mul_ps(_mm256_set1_ps(planes.ay[p]), ey));
+                extent = _mm256_add_ps(extent, _mm256_mul_ps(_mm256_set1_ps(planes.az[p]), ez));
+                outside = _mm256_or_ps(outside, _mm256_cmp_ps(_mm256_add_ps(distance, extent), zero, _CMP_LT_OQ));
+            }
+        } else {
+            const __m256 radius = _mm256_loadu_ps(bounds.radius() + base);
+            for (int p = 0; p < 6; ++p) {
+                __m256 distance = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(planes.nx[p]), cx), _mm256_mul_ps(_mm256_set1_ps(planes.ny[p]), cy));
+                distance = _mm256_add_ps(_mm256_add_ps(distance, _mm256_mul_ps(_mm256_set1_ps(planes.nz[p]), cz)), _mm256_set1_ps(planes.w[p]));
+                outside = _mm256_or_ps(outside, _mm256_cmp_ps(_mm256_add_ps(distance, radius), zero, _CMP_LT_OQ));
+            }
+        }
+
+        const unsigned mask = (~static_cast<unsigned>(_mm256_movemask_ps(outside)) & 0xFFu) & tailMask(base, count, 8);
+        written = appendMask(mask, static_cast<uint32_t>(base), 8, out, written);
+    }
+    return written;
+}
+
+bool detectAvx2() {
+#if defined(__AVX2__)
+    return true;
+#elif defined(_MSC_VER) && !defined(__clang__)
+    int info[4] = {};
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) {
+        return false;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+
+#endif // FRUSTUM_CULLING_X86
+
+#if defined(FRUSTUM_CULLING_NEON)
+
+size_t cullNeon(const PlaneSet& planes, const CullingBounds& bounds, CullShape shape, uint32_t* out) {
+    const size_t count = bounds.size();
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    const uint32_t laneBitsData[4] = { 1u, 2u, 4u, 8u };
+    const uint32x4_t laneBits = vld1q_u32(laneBitsData);
+    size_t written = 0;
+    for (size_t base = 0; base < count; base += 4) {
+        const float32x4_t cx = vld1q_f32(bounds.centerX() + base);
+        const float32x4_t cy = vld1q_f32(bounds.centerY() + base);
+        const float32x4_t cz = vld1q_f32(bounds.centerZ() + base);
+        uint32x4_t outside = vdupq_n_u32(0);
+
+        // vmulq + vaddq 而非 vmlaq/vfmaq，保持与标量版本相同的舍入
+        if (shape == CullShape::Aabb) {
+            const float32x4_t ex = vld1q_f32(bounds.extentX() + base);
+            const float32x4_t ey = vld1q_f32(bounds.extentY() + base);
+            const float32x4_t ez = vld1q_f32(bounds.extentZ() + base);
+            for (int p = 0; p < 6; ++p) {
+                float32x4_t distance = vaddq_f32(vmulq_n_f32(cx, planes.nx[p]), vmulq_n_f32(cy, planes.ny[p]));
+                distance = vaddq_f32(vaddq_f32(distance, vmulq_n_f32(cz, planes.nz[p])), vdupq_n_f32(planes.w[p]));
+                float32x4_t extent = vaddq_f32(vmulq_n_f32(ex, planes.ax[p]), vmulq_n_f32(ey, planes.ay[p]));
+                extent = vaddq_f32(extent, vmulq_n_f32(ez, planes.az[p]));
+                outside = vorrq_u32(outside, vcltq_f32(vaddq_f32(distance, extent), zero));
+            }
+        } else {
+            const float32x4_t radius = vld1q_f32(bounds.radius() + base);
+            for (int p = 0; p < 6; ++p) {
+                float32x4_t distance = vaddq_f32(vmulq_n_f32(cx, planes.nx[p]), vmulq_n_f32(cy, planes.ny[p]));
+                distance = vaddq_f32(vaddq_f32(distance, vmulq_n_f32(cz, planes.nz[p])), vdupq_n_f32(planes.w[p]));
+                outside = vorrq_u32(outside, vcltq_f32(vaddq_f32(distance, radius), zero));
+            }
+        }
+
+        // NEON 没有 movemask: 每个通道与其位值相与后水平求和
+        const uint32x4_t bits = vandq_u32(vmvnq_u32(outside), laneBits);
+#if defined(__aarch64__)
+        const unsigned visibleBits = vaddvq_u32(bits);
+#else
+        const uint32x2_t pair = vadd_u32(vget_low_u32(bits), vget_high_u32(bits));
+        const unsigned visibleBits = vget_lane_u32(vpadd_u32(pair, pair), 0);
+#endif
+        const unsigned mask = visibleBits & tailMask(base, count, 4);
+        written = appendMask(mask, static_cast<uint32_t>(base), 4, out, written);
+    }
+    return written;
+}
+
+#endif // FRUSTUM_CULLING_NEON
+
+} // namespace
+
+// ==================== Frustum ====================
+
+Frustum Frustum::fromMatrix(const glm::mat4& m) {
+    // glm 为列主序: 第 i 行 = (m[0][i], m[1][i], m[2][i], m[3][i])
+    const glm::vec4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+    const glm::vec4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+    const glm::vec4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+    const glm::vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+    Frustum frustum;
+    frustum.planes[0] = row3 + row0;    // 左
+    frustum.planes[1] = row3 - row0;    // 右
+    frustum.planes[2] = row3 + row1;    // 下
+    frustum.planes[3] = row3 - row1;    // 上
+    frustum.planes[4] = row3 + row2;    // 近
+    frustum.planes[5] = row3 - row2;    // 远
+
+    // 归一化后 w 分量即为到平面的有符号距离，球半径可以直接比较
+    for (glm::vec4& plane : frustum.planes) {
+        const float length = glm::length(glm::vec3(plane));
+        if (length > 0.0f) {
+            plane /= length;
+        }
+    }
+    return frustum;
+}
+
+Frustum Frustum::fromCamera(const Camera& camera) {
+    return fromMatrix(camera.getProjectionMatrix() * camera.getViewMatrix());
+}
+
+// ==================== CullingBounds ====================
+
+void CullingBounds::clear() {
+    resize(0);
+}
+
+void CullingBounds::resize(size_t count) {
+    // 补齐部分保持为零，被 tailMask 屏蔽
+    const size_t padded = paddedCount(count);
+    for (std::vector<float>* array : { &m_centerX, &m_centerY, &m_centerZ, &m_extentX, &m_extentY, &m_extentZ, &m_radius }) {
+        array->resize(padded, 0.0f);
+    }
+    m_count = count;
+}
+
+uint32_t CullingBounds::addAabb(const glm::vec3& center, const glm::vec3& extents) {
+    const size_t index = m_count;
+    resize(m_count + 1);
+    setAabb(index, center, extents);
+    return static_cast<uint32_t>(index);
+}
+
+uint32_t CullingBounds::addSphere(const glm::vec3& center, float radius) {
+    const size_t index = m_count;
+    resize(m_count + 1);
+    setSphere(index, center, radius);
+    return static_cast<uint32_t>(index);
+}
+
+void CullingBounds::setAabb(size_t index, const glm::vec3& center, const glm::vec3& extents) {
+    m_centerX[index] = center.x;
+    m_centerY[index] = center.y;
+    m_centerZ[index] = center.z;
+    m_extentX[index] = extents.x;
+    m_extentY[index] = extents.y;
+    m_extentZ[index] = extents.z;
+    m_radius[index] = glm::length(extents);
+}
+
+void CullingBounds::setSphere(size_t index, const glm::vec3& center, float radius) {
+    m_centerX[index] = center.x;
+    m_centerY[index] = center.y;
+    m_centerZ[index] = center.z;
+    m_extentX[index] = radius;
+    m_extentY[index] = radius;
+    m_extentZ[index] = radius;
+    m_radius[index] = radius;
+}
+
+void CullingBounds::setTransformed(size_t index, const glm::vec3& localCenter, const glm::vec3& localExtents,
+                                   const glm::mat4& transform) {
+    const glm::vec3 center = glm::vec3(transform * glm::vec4(localCenter, 1.0f));
+    glm::vec3 extents(0.0f);
+    for (int column = 0; column < 3; ++column) {
+        extents += glm::abs(glm::vec3(transform[column])) * localExtents[column];
+    }
+    setAabb(index, center, extents);
+}
+
+// ==================== FrustumCulling ====================
+
+namespace FrustumCulling {
+
+CullIsa bestIsa() {
+#if defined(FRUSTUM_CULLING_X86)
+    static const CullIsa best = detectAvx2() ? CullIsa::Avx2 : CullIsa::Sse;
+    return best;
+#elif defined(FRUSTUM_CULLING_NEON)
+    return CullIsa::Neon;
+#else
+    return CullIsa::Scalar;
+#endif
+}
+
+bool isSupported(CullIsa isa) {
+    switch (isa) {
+    case CullIsa::Scalar:
+        return true;
+#if defined(FRUSTUM_CULLING_X86)
+    case CullIsa::Sse:
+        return true;
+    case CullIsa::Avx2:
+        return bestIsa() == CullIsa::Avx2;
+#endif
+#if defined(FRUSTUM_CULLING_NEON)
+    case CullIsa::Neon:
+        return true;
+#endif
+    default:
+        return false;
+    }
+}
+
+const char* isaName(CullIsa isa) {
+    switch (isa) {
+    case CullIsa::Scalar: return "scalar";
+    case CullIsa::Sse:    return "sse";
+    case CullIsa::Avx2:   return "avx2";
+    case CullIsa::Neon:   return "neon";
+    }
+    return "unknown";
+}
+
+CullStats cull(const Frustum& frustum, const CullingBounds& bounds, CullShape shape,
+               std::vector<uint32_t>& visible, CullIsa isa) {
+    CullStats stats;
+    stats.isa = isSupported(isa) ? isa : bestIsa();
+    stats.tested = bounds.size();
+
+    // 每个通道都会写入一次，按补齐后的长度预留
+    visible.resize(paddedCount(bounds.size()));
+    const auto start = Clock::now();
+
+    const PlaneSet planes = makePlaneSet(frustum);
+    size_t written = 0;
+    switch (stats.isa) {
+#if defined(FRUSTUM_CULLING_X86)
+    case CullIsa::Sse:
+        written = cullSse(planes, bounds, shape, visible.data());
+        break;
+    case CullIsa::Avx2:
+        written = cullAvx2(planes, bounds, shape, visible.data());
+        break;
+#endif
+#if defined(FRUSTUM_CULLING_NEON)
+    case CullIsa::Neon:
+        written = cullNeon(planes, bounds, shape, visible.data());
+        break;
+#endif
+    default:
+        written = cullScalar(planes, bounds, shape, visible.data());
+        break;
+    }
+
+    stats.ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    visible.resize(written);
+    stats.visible = written;
+    stats.culled = stats.tested - written;
+    stats.nsPerObject = stats.tested > 0 ? stats.ms * 1.0e6 / static_cast<double>(stats.tested) : 0.0;
+    return stats;
+}
+
+} // namespace FrustumCulling
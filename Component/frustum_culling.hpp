@@ -0,0 +1,117 @@
+// frustum_culling.hpp
+// 单一职责: CPU视锥剔除 - 由视图投影矩阵提取六个平面，对 SoA 包围体批量测试 (SSE/AVX2/NEON)，输出紧凑的可见下标列表
+#pragma once
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class Camera;
+
+/**
+ * @brief 视锥的六个平面 (世界空间，法线指向内侧并归一化)
+ *
+ * 平面 p 满足 dot(p.xyz, x) + p.w >= 0 的点在内侧。
+ * 顺序: 左、右、下、上、近、远。
+ */
+struct Frustum {
+    glm::vec4 planes[6];
+
+    /**
+     * @brief Gribb-Hartmann 平面提取 (GL 裁剪空间 -w <= z <= w)
+     * @param viewProjection 投影 x 视图；传入 投影 x 视图 x 模型 时得到模型空间的平面
+     */
+    static Frustum fromMatrix(const glm::mat4& viewProjection);
+
+    static Frustum fromCamera(const Camera& camera);
+};
+
+enum class CullShape {
+    Aabb,       // 中心 + 半长 (轴对齐)
+    Sphere      // 中心 + 半径
+};
+
+enum class CullIsa {
+    Scalar,
+    Sse,        // 4 路
+    Avx2,       // 8 路 (运行时检测)
+    Neon        // 4 路
+};
+
+/**
+ * @brief SoA 布局的包围体集合
+ *
+ * 每个分量一个连续数组，SIMD 一次加载 4/8 个对象的同一分量。
+ * 数组长度按 kLanes 向上取整，尾部补零，核心循环不需要标量收尾。
+ * 每个对象同时保存 AABB 半长与包围球半径，两种测试共用一份数据。
+ */
+class CullingBounds {
+public:
+    static constexpr size_t kLanes = 8;
+
+    void clear();
+    void resize(size_t count);
+    size_t size() const { return m_count; }
+    bool empty() const { return m_count == 0; }
+
+    uint32_t addAabb(const glm::vec3& center, const glm::vec3& extents);
+    uint32_t addSphere(const glm::vec3& center, float radius);
+
+    void setAabb(size_t index, const glm::vec3& center, const glm::vec3& extents);
+    void setSphere(size_t index, const glm::vec3& center, float radius);
+
+    /**
+     * @brief 局部空间 AABB 经仿射变换后的世界 AABB (Arvo: 半长 = |M3x3| * 半长)
+     */
+    void setTransformed(size_t index, const glm::vec3& localCenter, const glm::vec3& localExtents,
+                        const glm::mat4& transform);
+
+    const float* centerX() const { return m_centerX.data(); }
+    const float* centerY() const { return m_centerY.data(); }
+    const float* centerZ() const { return m_centerZ.data(); }
+    const float* extentX() const { return m_extentX.data(); }
+    const float* extentY() const { return m_extentY.data(); }
+    const float* extentZ() const { return m_extentZ.data(); }
+    const float* radius() const { return m_radius.data(); }
+
+private:
+    std::vector<float> m_centerX;
+    std::vector<float> m_centerY;
+    std::vector<float> m_centerZ;
+    std::vector<float> m_extentX;
+    std::vector<float> m_extentY;
+    std::vector<float> m_extentZ;
+    std::vector<float> m_radius;
+    size_t m_count = 0;
+};
+
+struct CullStats {
+    size_t tested = 0;
+    size_t visible = 0;
+    size_t culled = 0;
+    double ms = 0.0;
+    double nsPerObject = 0.0;
+    CullIsa isa = CullIsa::Scalar;
+};
+
+namespace FrustumCulling {
+
+/**
+ * @brief 本机可用的最宽指令集 (AVX2 在运行时检测，其余由编译目标决定)
+ */
+CullIsa bestIsa();
+bool isSupported(CullIsa isa);
+const char* isaName(CullIsa isa);
+
+/**
+ * @brief 测试全部包围体，visible 改写为与视锥相交的对象下标 (升序)
+ *
+ * 保守测试: 只剔除完全位于某个平面外侧的对象，跨越角落的少量对象会被误判为可见。
+ * 各指令集按相同顺序做乘、加 (不融合)，只有恰好贴着平面的对象可能因舍入与标量版本不同。
+ * @param isa 不支持时退回 bestIsa()
+ */
+CullStats cull(const Frustum& frustum, const CullingBounds& bounds, CullShape shape,
+               std::vector<uint32_t>& visible, CullIsa isa = bestIsa());
+
+} // namespace FrustumCulling
@@ -0,0 +1,287 @@
+#include "gl_state_cache.hpp"
+
+// ============ GLStateCacheStats ============
+
+uint64_t GLStateCacheStats::totalIssued() const {
+    uint64_t total = 0;
+    for (int i = 0; i < CategoryCount; ++i) {
+        total += issued[i];
+    }
+    return total;
+}
+
+uint64_t GLStateCacheStats::totalSkipped() const {
+    uint64_t total = 0;
+    for (int i = 0; i < CategoryCount; ++i) {
+        total += skipped[i];
+    }
+    return total;
+}
+
+const char* GLStateCacheStats::categoryName(Category category) {
+    switch (category) {
+        case Program:       return "program";
+        case VertexArray:   return "vertex_array";
+        case Buffer:        return "buffer";
+        case Texture:       return "texture";
+        case Capability:    return "capability";
+        case FixedFunction: return "fixed_function";
+        default:            return "unknown";
+    }
+}
+
+// ============ GLStateCache ============
+
+GLStateCache& GLStateCache::current() {
+    thread_local GLStateCache cache;
+    return cache;
+}
+
+GLStateCache::GLStateCache() {
+    invalidate();
+}
+
+void GLStateCache::invalidate() {
+    m_program = kUnknown;
+    m_vertexArray = kUnknown;
+    for (GLuint& buffer : m_buffers) {
+        buffer = kUnknown;
+    }
+    for (GLuint& buffer : m_uniformBindings) {
+        buffer = kUnknown;
+    }
+    m_activeTexture = kUnknown;
+    for (auto& unit : m_textures) {
+        for (GLuint& texture : unit) {
+            texture = kUnknown;
+        }
+    }
+    for (GLuint& capability : m_capabilities) {
+        capability = kUnknown;
+    }
+    m_blendSource = kUnknown;
+    m_blendDest = kUnknown;
+    m_depthFunc = kUnknown;
+    m_depthMask = kUnknown;
+}
+
+bool GLStateCache::update(GLuint& cached, GLuint value, GLStateCacheStats::Category category) {
+    if (cached == value) {
+        m_stats.skipped[category]++;
+        return false;
+    }
+    cached = value;
+    m_stats.issued[category]++;
+    return true;
+}
+
+// ============ 对象绑定 ============
+
+void GLStateCache::useProgram(GLuint program) {
+    if (update(m_program, program, GLStateCacheStats::Program)) {
+        glUseProgram(program);
+    }
+}
+
+void GLStateCache::bindVertexArray(GLuint vao) {
+    if (update(m_vertexArray, vao, GLStateCacheStats::VertexArray)) {
+        glBindVertexArray(vao);
+        // 索引缓冲绑定随VAO切换
+        m_buffers[ElementArrayBuffer] = kUnknown;
+    }
+}
+
+void GLStateCache::bindBuffer(GLenum target, GLuint buffer) {
+    const int slot = bufferSlot(target);
+    if (slot < 0) {
+        m_stats.issued[GLStateCacheStats::Buffer]++;
+        glBindBuffer(target, buffer);
+        return;
+    }
+    if (update(m_buffers[slot], buffer, GLStateCacheStats::Buffer)) {
+        glBindBuffer(target, buffer);
+    }
+}
+
+void GLStateCache::bindBufferBase(GLenum target, GLuint index, GLuint buffer) {
+    if (target == GL_UNIFORM_BUFFER && index < kMaxUniformBindings) {
+        if (!update(m_uniformBindings[index], buffer, GLStateCacheStats::Buffer)) {
+            return;
+        }
+    } else {
+        m_stats.issued[GLStateCacheStats::Buffer]++;
+    }
+
+    glBindBufferBase(target, index, buffer);
+
+    // glBindBufferBase 同时修改该目标的通用绑定点
+    const int slot = bufferSlot(target);
+    if (slot >= 0) {
+        m_buffers[slot] = buffer;
+    }
+}
+
+void GLStateCache::bindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size) {
+    // 范围绑定通常逐帧换偏移，总是发出；绑定点记为未知，之后的 bindBufferBase 不会被误跳过
+    m_stats.issued[GLStateCacheStats::Buffer]++;
+    glBindBufferRange(target, index, buffer, offset, size);
+
+    if (target == GL_UNIFORM_BUFFER && index < kMaxUniformBindings) {
+        m_uniformBindings[index] = kUnknown;
+    }
+    const int slot = bufferSlot(target);
+    if (slot >= 0) {
+        m_buffers[slot] = buffer;
+    }
+}
+
+void GLStateCache::activeTexture(GLuint unit) {
+    if (update(m_activeTexture, unit, GLStateCacheStats::Texture)) {
+        glActiveTexture(GL_TEXTURE0 + unit);
+    }
+}
+
+void GLStateCache::bindTexture(GLenum target, GLuint texture, GLuint unit) {
+    const int slot = textureSlot(target);
+    if (slot < 0 || unit >= kMaxTextureUnits) {
+        activeTexture(unit);
+        m_stats.issued[GLStateCacheStats::Texture]++;
+        glBindTexture(target, texture);
+        return;
+    }
+
+    if (m_textures[unit][slot] == texture) {
+        m_stats.skipped[GLStateCacheStats::Texture]++;
+        return;
+    }
+    activeTexture(unit);
+    update(m_textures[unit][slot], texture, GLStateCacheStats::Texture);
+    glBindTexture(target, texture);
+}
+
+// ============ 固定功能状态 ============
+
+void GLStateCache::setEnabled(GLenum capability, bool enabled) {
+    const int slot = capabilitySlot(capability);
+    if (slot >= 0 && !update(m_capabilities[slot], enabled ? 1u : 0u, GLStateCacheStats::Capability)) {
+        return;
+    }
+    if (slot < 0) {
+        m_stats.issued[GLStateCacheStats::Capability]++;
+    }
+
+    if (enabled) {
+        glEnable(capability);
+    } else {
+        glDisable(capability);
+    }
+}
+
+void GLStateCache::blendFunc(GLenum sourceFactor, GLenum destFactor) {
+    if (m_blendSource == sourceFactor && m_blendDest == destFactor) {
+        m_stats.skipped[GLStateCacheStats::FixedFunction]++;
+        return;
+    }
+    m_blendSource = sourceFactor;
+    m_blendDest = destFactor;
+    m_stats.issued[GLStateCacheStats::FixedFunction]++;
+    glBlendFunc(sourceFactor, destFactor);
+}
+
+void GLStateCache::depthFunc(GLenum func) {
+    if (update(m_depthFunc, func, GLStateCacheStats::FixedFunction)) {
+        glDepthFunc(func);
+    }
+}
+
+void GLStateCache::depthMask(bool writeEnabled) {
+    if (update(m_depthMask, writeEnabled ? 1u : 0u, GLStateCacheStats::FixedFunction)) {
+        glDepthMask(writeEnabled ? GL_TRUE : GL_FALSE);
+    }
+}
+
+// ============ 删除通知 ============
+// GL删除当前绑定的对象时会把绑定重置为0
+
+void GLStateCache::onProgramDeleted(GLuint program) {
+    if (program != 0 && m_program == program) {
+        // 正在使用的程序删除后仍保持"当前"直到切换，状态未知最安全
+        m_program = kUnknown;
+    }
+}
+
+void GLStateCache::onVertexArrayDeleted(GLuint vao) {
+    if (vao != 0 && m_vertexArray == vao) {
+        m_vertexArray = 0;
+        m_buffers[ElementArrayBuffer] = kUnknown;
+    }
+}
+
+void GLStateCache::onBufferDeleted(GLuint buffer) {
+    if (buffer == 0) {
+        return;
+    }
+    for (GLuint& bound : m_buffers) {
+        if (bound == buffer) {
+            bound = 0;
+        }
+    }
+    for (GLuint& bound : m_uniformBindings) {
+        if (bound == buffer) {
+            bound = 0;
+        }
+    }
+}
+
+void GLStateCache::onTextureDeleted(GLuint texture) {
+    if (texture == 0) {
+        return;
+    }
+    for (auto& unit : m_textures) {
+        for (GLuint& bound : unit) {
+            if (bound == texture) {
+                bound = 0;
+            }
+        }
+    }
+}
+
+// ============ 目标映射 ============
+
+int GLStateCache::bufferSlot(GLenum target) {
+    switch (target) {
+        case GL_ARRAY_BUFFER:           return ArrayBuffer;
+        case GL_ELEMENT_ARRAY_BUFFER:   return ElementArrayBuffer;
+        case GL_UNIFORM_BUFFER:         return UniformBuffer;
+        case GL_COPY_READ_BUFFER:       return CopyReadBuffer;
+        case GL_COPY_WRITE_BUFFER:      return CopyWriteBuffer;
+        case GL_PIXEL_PACK_BUFFER:      return PixelPackBuffer;
+        case GL_PIXEL_UNPACK_BUFFER:    return PixelUnpackBuffer;
+#ifdef GL_DRAW_INDIRECT_BUFFER
+        case GL_DRAW_INDIRECT_BUFFER:   return DrawIndirectBuffer;
+#endif
+        default:                        return -1;
+    }
+}
+
+int GLStateCache::textureSlot(GLenum target) {
+    switch (target) {
+        case GL_TEXTURE_2D:         return Texture2D;
+        case GL_TEXTURE_2D_ARRAY:   return Texture2DArray;
+        case GL_TEXTURE_3D:         return Texture3D;
+        case GL_TEXTURE_CUBE_MAP:   return TextureCubeMap;
+        default:                    return -1;
+    }
+}
+
+int GLStateCache::capabilitySlot(GLenum capability) {
+    switch (capability) {
+        case GL_BLEND:                  return CapBlend;
+        case GL_DEPTH_TEST:             return CapDepthTest;
+        case GL_CULL_FACE:              return CapCullFace;
+        case GL_SCISSOR_TEST:           return CapScissorTest;
+        case GL_STENCIL_TEST:           return CapStencilTest;
+        case GL_POLYGON_OFFSET_FILL:    return CapPolygonOffsetFill;
+        default:                        return -1;
+    }
+}
@@ -0,0 +1,148 @@
+// gl_state_cache.hpp
+// 单一职责: 缓存当前上下文的GL绑定与开关状态，跳过重复的 bind/enable 调用并计数
+#pragma once
+
+// 平台条件编译：OpenGL ES (Android) vs OpenGL Core (PC)
+#ifdef __ANDROID__
+    #include <GLES3/gl3.h>
+    #include <GLES3/gl3ext.h>
+#else
+    #include <glad/glad.h>
+#endif
+
+#include <cstdint>
+
+/**
+ * @brief 状态调用统计 (按类别记录实际发出与被跳过的调用数)
+ */
+struct GLStateCacheStats {
+    enum Category {
+        Program = 0,
+        VertexArray,
+        Buffer,
+        Texture,
+        Capability,     // glEnable/glDisable
+        FixedFunction,  // blend/depth 函数与写掩码
+        CategoryCount
+    };
+
+    uint64_t issued[CategoryCount] = {};
+    uint64_t skipped[CategoryCount] = {};
+
+    uint64_t totalIssued() const;
+    uint64_t totalSkipped() const;
+
+    static const char* categoryName(Category category);
+};
+
+/**
+ * @brief GLStateCache - 每个GL上下文一份的状态镜像
+ *
+ * GL上下文同一时刻只在一个线程上为当前，因此以线程为单位保存 (thread_local)：
+ * 主渲染线程与着色器编译线程各自拥有独立的缓存。
+ *
+ * 约定:
+ * - Component/ 中的绑定都经过这里；绕过缓存直接调用GL后必须 invalidate()
+ * - 删除对象后调用对应的 onXxxDeleted()，GL会把已删除的绑定重置为0，且名字可能被复用
+ * - 上下文重新创建 (Android Surface 重建) 后调用 invalidate()
+ * - GL_ELEMENT_ARRAY_BUFFER 属于VAO状态，切换VAO时自动失效
+ */
+class GLStateCache {
+public:
+    static GLStateCache& current();
+
+    // ============ 对象绑定 ============
+
+    void useProgram(GLuint program);
+    void bindVertexArray(GLuint vao);
+    void bindBuffer(GLenum target, GLuint buffer);
+    void bindBufferBase(GLenum target, GLuint index, GLuint buffer);
+    void bindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size);
+    void activeTexture(GLuint unit);
+    void bindTexture(GLenum target, GLuint texture, GLuint unit = 0);
+
+    // ============ 固定功能状态 ============
+
+    void setEnabled(GLenum capability, bool enabled);
+    void enable(GLenum capability) { setEnabled(capability, true); }
+    void disable(GLenum capability) { setEnabled(capability, false); }
+    void blendFunc(GLenum sourceFactor, GLenum destFactor);
+    void depthFunc(GLenum func);
+    void depthMask(bool writeEnabled);
+
+    // ============ 删除通知 ============
+
+    void onProgramDeleted(GLuint program);
+    void onVertexArrayDeleted(GLuint vao);
+    void onBufferDeleted(GLuint buffer);
+    void onTextureDeleted(GLuint texture);
+
+    /**
+     * @brief 丢弃所有已知状态，下一次设置一定会发出GL调用
+     */
+    void invalidate();
+
+    const GLStateCacheStats& stats() const { return m_stats; }
+    void resetStats() { m_stats = GLStateCacheStats(); }
+
+    static constexpr GLuint kMaxTextureUnits = 16;
+    static constexpr GLuint kMaxUniformBindings = 16;
+
+private:
+    GLStateCache();
+
+    enum BufferSlot {
+        ArrayBuffer = 0,
+        ElementArrayBuffer,
+        UniformBuffer,
+        CopyReadBuffer,
+        CopyWriteBuffer,
+        PixelPackBuffer,
+        PixelUnpackBuffer,
+        DrawIndirectBuffer,
+        BufferSlotCount
+    };
+
+    enum TextureSlot {
+        Texture2D = 0,
+        Texture2DArray,
+        Texture3D,
+        TextureCubeMap,
+        TextureSlotCount
+    };
+
+    enum CapabilitySlot {
+        CapBlend = 0,
+        CapDepthTest,
+        CapCullFace,
+        CapScissorTest,
+        CapStencilTest,
+        CapPolygonOffsetFill,
+        CapabilitySlotCount
+    };
+
+    static int bufferSlot(GLenum target);
+    static int textureSlot(GLenum target);
+    static int capabilitySlot(GLenum capability);
+
+    // 返回true表示需要发出GL调用 (同时更新缓存与计数)
+    bool update(GLuint& cached, GLuint value, GLStateCacheStats::Category category);
+
+private:
+    // kUnknown: 状态未知 (初始或 invalidate 之后)，下次设置必定发出调用
+    static constexpr GLuint kUnknown = 0xFFFFFFFFu;
+
+    GLuint m_program;
+    GLuint m_vertexArray;
+    GLuint m_buffers[BufferSlotCount];
+    GLuint m_uniformBindings[kMaxUniformBindings];
+    GLuint m_activeTexture;
+    GLuint m_textures[kMaxTextureUnits][TextureSlotCount];
+    GLuint m_capabilities[CapabilitySlotCount];     // 0/1/kUnknown
+    GLuint m_blendSource;
+    GLuint m_blendDest;
+    GLuint m_depthFunc;
+    GLuint m_depthMask;
+
+    GLStateCacheStats m_stats;
+};
@@ -0,0 +1,126 @@
+#include "gpu_timer.hpp"
+#include <algorithm>
+
+GpuTimer::GpuTimer(size_t latency)
+    : m_queries(latency == 0 ? 1 : latency, 0)
+    , m_frameIds(m_queries.size(), 0)
+    , m_pending(m_queries.size(), false)
+    , m_next(0)
+    , m_active(false)
+{
+}
+
+GpuTimer::~GpuTimer() {
+    release();
+}
+
+bool GpuTimer::isSupported() const {
+#ifdef __ANDROID__
+    return false;
+#else
+    return true;
+#endif
+}
+
+bool GpuTimer::create() {
+    if (!isSupported()) {
+        return false;
+    }
+    release();
+    glGenQueries(static_cast<GLsizei>(m_queries.size()), m_queries.data());
+    return true;
+}
+
+void GpuTimer::release() {
+    if (!m_queries.empty() && m_queries[0] != 0) {
+        glDeleteQueries(static_cast<GLsizei>(m_queries.size()), m_queries.data());
+        std::fill(m_queries.begin(), m_queries.end(), 0);
+    }
+    std::fill(m_pending.begin(), m_pending.end(), false);
+    m_ready.clear();
+    m_next = 0;
+    m_active = false;
+}
+
+void GpuTimer::begin(uint64_t frameId) {
+#ifndef __ANDROID__
+    if (m_queries[0] == 0 || m_active) {
+        return;
+    }
+
+    // 环满时必须先取回最旧的结果才能复用查询对象 (结果暂存，下次 collect 时交付)
+    if (m_pending[m_next]) {
+        readSlot(m_next, true);
+    }
+
+    m_frameIds[m_next] = frameId;
+    glBeginQuery(GL_TIME_ELAPSED, m_queries[m_next]);
+    m_active = true;
+#else
+    (void)frameId;
+#endif
+}
+
+void GpuTimer::end() {
+#ifndef __ANDROID__
+    if (!m_active) {
+        return;
+    }
+    glEndQuery(GL_TIME_ELAPSED);
+    m_pending[m_next] = true;
+    m_next = (m_next + 1) % m_queries.size();
+    m_active = false;
+#endif
+}
+
+void GpuTimer::collect(const ResultCallback& callback) {
+    // 从最旧的槽位开始，保持结果按帧顺序返回
+    for (size_t i = 0; i < m_queries.size(); ++i) {
+        size_t slot = (m_next + i) % m_queries.size();
+        if (m_pending[slot] && !readSlot(slot, false)) {
+            break;
+        }
+    }
+    dispatch(callback);
+}
+
+void GpuTimer::drain(const ResultCallback& callback) {
+    for (size_t i = 0; i < m_queries.size(); ++i) {
+        size_t slot = (m_next + i) % m_queries.size();
+        if (m_pending[slot]) {
+            readSlot(slot, true);
+        }
+    }
+    dispatch(callback);
+}
+
+void GpuTimer::dispatch(const ResultCallback& callback) {
+    if (callback) {
+        for (const auto& result : m_ready) {
+            callback(result.first, result.second);
+        }
+    }
+    m_ready.clear();
+}
+
+bool GpuTimer::readSlot(size_t slot, bool wait) {
+#ifndef __ANDROID__
+    if (!wait) {
+        GLuint available = 0;
+        glGetQueryObjectuiv(m_queries[slot], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) {
+            return false;
+        }
+    }
+
+    GLuint64 elapsedNs = 0;
+    glGetQueryObjectui64v(m_queries[slot], GL_QUERY_RESULT, &elapsedNs);
+    m_pending[slot] = false;
+    m_ready.emplace_back(m_frameIds[slot], static_cast<double>(elapsedNs) / 1.0e6);
+    return true;
+#else
+    (void)slot;
+    (void)wait;
+    return false;
+#endif
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+// 平台条件编译：OpenGL ES (Android) vs OpenGL Core (PC)
+#ifdef __ANDROID__
+    #include <GLES3/gl3.h>
+    #include <GLES3/gl3ext.h>
+#else
+    #include <glad/glad.h>
+#endif
+
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief GpuTimer类 - 基于 GL_TIME_ELAPSED 查询的GPU耗时测量
+ *
+ * 使用查询对象环形队列: 第N帧的结果在若干帧之后才读取，
+ * 避免 glGetQueryObject 让CPU等待GPU而破坏被测的帧节奏。
+ *
+ * Android (GLES 3.0) 没有核心的计时查询，isSupported() 返回 false。
+ */
+class GpuTimer {
+public:
+    // 结果回调: (帧标识, GPU耗时毫秒)
+    using ResultCallback = std::function<void(uint64_t, double)>;
+
+    explicit GpuTimer(size_t latency = 4);
+    ~GpuTimer();
+
+    GpuTimer(const GpuTimer&) = delete;
+    GpuTimer& operator=(const GpuTimer&) = delete;
+
+    bool create();
+    void release();
+
+    bool isSupported() const;
+
+    /**
+     * @brief 开始计时 (同一时刻只能有一个 GL_TIME_ELAPSED 查询处于活动状态)
+     * @param frameId 调用方定义的帧标识，随结果一起返回
+     */
+    void begin(uint64_t frameId);
+    void end();
+
+    /**
+     * @brief 读取已就绪的结果 (非阻塞)
+     */
+    void collect(const ResultCallback& callback);
+
+    /**
+     * @brief 等待并读取所有未决的结果 (阻塞，用于测量结束时)
+     */
+    void drain(const ResultCallback& callback);
+
+private:
+    bool readSlot(size_t slot, bool wait);
+    void dispatch(const ResultCallback& callback);
+
+private:
+    std::vector<GLuint> m_queries;
+    std::vector<std::pair<uint64_t, double>> m_ready;   // 已读取、尚未交给调用方的结果
+    std::vector<uint64_t> m_frameIds;
+    std::vector<bool> m_pending;
+    size_t m_next;
+    bool m_active;
+};
@@ -0,0 +1,92 @@
+#include "index_buffer.hpp"
+#include "gl_state_cache.hpp"
+
+#include <utility>
+#include <vector>
+
+IndexBuffer::IndexBuffer()
+    : m_ebo(0)
+    , m_type(GL_UNSIGNED_INT)
+    , m_count(0)
+{
+}
+
+IndexBuffer::~IndexBuffer() {
+    release();
+}
+
+IndexBuffer::IndexBuffer(IndexBuffer&& other) noexcept
+    : m_ebo(std::exchange(other.m_ebo, 0))
+    , m_type(other.m_type)
+    , m_count(std::exchange(other.m_count, 0))
+{
+}
+
+IndexBuffer& IndexBuffer::operator=(IndexBuffer&& other) noexcept {
+    if (this != &other) {
+        release();
+        m_ebo = std::exchange(other.m_ebo, 0);
+        m_type = other.m_type;
+        m_count = std::exchange(other.m_count, 0);
+    }
+    return *this;
+}
+
+bool IndexBuffer::create(const uint32_t* indices, size_t indexCount, size_t vertexCount) {
+    release();
+
+    if (!indices || indexCount == 0 || vertexCount == 0) {
+        return false;
+    }
+
+    m_type = typeFor(vertexCount);
+    m_count = static_cast<GLsizei>(indexCount);
+
+    glGenBuffers(1, &m_ebo);
+    GLStateCache::current().bindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo);
+
+    if (m_type == GL_UNSIGNED_SHORT) {
+        std::vector<uint16_t> packed(indices, indices + indexCount);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, packed.size() * sizeof(uint16_t), packed.data(), GL_STATIC_DRAW);
+    } else {
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexCount * sizeof(uint32_t), indices, GL_STATIC_DRAW);
+    }
+    return true;
+}
+
+bool IndexBuffer::createPacked(const void* data, size_t indexCount, GLenum type) {
+    release();
+
+    if (!data || indexCount == 0 || (type != GL_UNSIGNED_SHORT && type != GL_UNSIGNED_INT)) {
+        return false;
+    }
+
+    m_type = type;
+    m_count = static_cast<GLsizei>(indexCount);
+
+    glGenBuffers(1, &m_ebo);
+    GLStateCache::current().bindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexCount * sizeOfType(type), data, GL_STATIC_DRAW);
+    return true;
+}
+
+void IndexBuffer::release() {
+    if (m_ebo != 0) {
+        GLStateCache::current().onBufferDeleted(m_ebo);
+        glDeleteBuffers(1, &m_ebo);
+        m_ebo = 0;
+    }
+    m_count = 0;
+}
+
+GLenum IndexBuffer::typeFor(size_t vertexCount) {
+    return vertexCount <= 0x10000 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+}
+
+size_t IndexBuffer::sizeOfType(GLenum type) {
+    switch (type) {
+        case GL_UNSIGNED_BYTE:  return 1;
+        case GL_UNSIGNED_SHORT: return 2;
+        default:                return 4;
+    }
+}
@@ -0,0 +1,64 @@
+// index_buffer.hpp
+// 单一职责: 管理索引缓冲(EBO)，按顶点数自动选择16/32位索引
+#pragma once
+
+// 平台条件编译：OpenGL ES (Android) vs OpenGL Core (PC)
+#ifdef __ANDROID__
+    #include <GLES3/gl3.h>
+    #include <GLES3/gl3ext.h>
+#else
+    #include <glad/glad.h>
+#endif
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief IndexBuffer类 - 封装 GL_ELEMENT_ARRAY_BUFFER
+ *
+ * 索引统一以32位传入；顶点数不超过 65536 时打包为 GL_UNSIGNED_SHORT 上传，
+ * 带宽与后变换缓存查找都减半。
+ *
+ * 索引缓冲绑定属于VAO状态: create() 必须在目标VAO已绑定时调用。
+ */
+class IndexBuffer {
+public:
+    IndexBuffer();
+    ~IndexBuffer();
+
+    // 禁止拷贝，允许移动
+    IndexBuffer(const IndexBuffer&) = delete;
+    IndexBuffer& operator=(const IndexBuffer&) = delete;
+    IndexBuffer(IndexBuffer&& other) noexcept;
+    IndexBuffer& operator=(IndexBuffer&& other) noexcept;
+
+    /**
+     * @brief 上传索引并绑定到当前VAO
+     * @param vertexCount 被索引的顶点数，决定索引位宽
+     */
+    bool create(const uint32_t* indices, size_t indexCount, size_t vertexCount);
+
+    /**
+     * @brief 直接上传已按 type 打包好的索引 (如内存映射的网格资源)，不做任何转换
+     */
+    bool createPacked(const void* data, size_t indexCount, GLenum type);
+
+    void release();
+
+    /**
+     * @brief 能容纳 vertexCount 个顶点的最小索引类型
+     */
+    static GLenum typeFor(size_t vertexCount);
+    static size_t sizeOfType(GLenum type);
+
+    GLuint id() const { return m_ebo; }
+    GLenum type() const { return m_type; }
+    GLsizei count() const { return m_count; }
+    size_t indexSize() const { return sizeOfType(m_type); }
+    bool isValid() const { return m_ebo != 0; }
+
+private:
+    GLuint m_ebo;
+    GLenum m_type;
+    GLsizei m_count;
+};
@@ -1,8 +1,10 @@
 // IRenderConfig.hpp
 // 单一职责: 定义渲染器配置的抽象接口
 #pragma once
+#include <cstdint>
 #include <string>
 #include <glm/glm.hpp>
+#include "vertex_format.hpp"
 
 class IRenderConfig {
 public:
@@ -20,4 +22,12 @@ public:
     virtual const void* vertexData() const = 0;
     virtual size_t vertexCount() const = 0;
     virtual size_t vertexStride() const = 0;
+
+    // 索引数据 (可选，三角形列表)：为空时渲染器按顶点顺序每3个组成一个三角形
+    // 统一以32位提供，上传时按顶点数自动选择16/32位 (IndexBuffer)
+    virtual const uint32_t* indexData() const { return nullptr; }
+    virtual size_t indexCount() const { return 0; }
+
+    // 上传到GPU时各属性的存储格式 (默认全浮点；紧凑格式见 VertexFormat::compact)
+    virtual VertexFormat vertexFormat() const { return VertexFormat(); }
 };
@@ -8,6 +8,8 @@
 // 前向声明
 class RenderContext;
 class IRenderConfig;
+class RenderQueue;
+class CommandList;
 
 enum class RenderError {
     None = 0,
@@ -30,6 +32,28 @@ public:
     
     // 执行渲染
     virtual bool render(const RenderContext& context) = 0;
+
+    // 是否支持命令队列 (record)；不支持的渲染器由 RenderPipeline 退回 render()
+    virtual bool usesRenderQueue() const { return false; }
+
+    // 把本帧的绘制命令追加到队列 (不清屏、不发出绘制调用)，由帧循环统一排序提交
+    // 仅在 usesRenderQueue() 为true时调用，返回false表示出错
+    virtual bool record(const RenderContext& context, RenderQueue& queue) {
+        (void)context;
+        (void)queue;
+        return false;
+    }
+
+    // 本帧能否录制到 CommandList (例如着色器就绪之后)；为false时 RenderPipeline 退回 record()/render()
+    virtual bool usesCommandList() const { return false; }
+
+    // 把本帧的命令录制到 list: 不得发出GL调用，可能在任务系统的工作线程上调用 (与其他渲染器并行)
+    // GL线程稍后回放 list；仅在 usesCommandList() 为true时调用，返回false表示出错
+    virtual bool recordCommands(const RenderContext& context, CommandList& list) {
+        (void)context;
+        (void)list;
+        return false;
+    }
     
     // 调整视口大小
     virtual bool resize(int width, int height) = 0;
@@ -43,4 +67,7 @@ public:
     
     // 获取渲染器名称（用于调试）
     virtual std::string getName() const = 0;
+
+    // 着色器是否已编译完成（异步编译期间渲染器绘制占位内容）
+    virtual bool isReady() const { return true; }
 };
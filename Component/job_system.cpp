@@ -0,0 +1,389 @@
+#include "job_system.hpp"
+
+#include <algorithm>
+#include <iostream>
+
+namespace {
+
+JobSystem* s_activeSystem = nullptr;
+
+// 当前线程所属的 JobSystem 与线程下标 (所有者线程为0)
+thread_local const JobSystem* t_system = nullptr;
+thread_local int t_threadIndex = -1;
+
+uint32_t nextRandom(uint32_t& state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+} // namespace
+
+// ============ WorkStealingDeque ============
+
+WorkStealingDeque::WorkStealingDeque()
+    : m_top(0)
+    , m_bottom(0)
+{
+    for (std::atomic<Job*>& item : m_items) {
+        item.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+bool WorkStealingDeque::push(Job* job) {
+    const int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+    const int64_t top = m_top.load(std::memory_order_acquire);
+    if (bottom - top >= kCapacity) {
+        return false;
+    }
+    // 任务内容先于 m_bottom 对窃取者可见 (用 release 存储代替独立栅栏，x86 上没有额外开销)
+    m_items[bottom & (kCapacity - 1)].store(job, std::memory_order_release);
+    m_bottom.store(bottom + 1, std::memory_order_release);
+    return true;
+}
+
+Job* WorkStealingDeque::pop() {
+    const int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+    m_bottom.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t top = m_top.load(std::memory_order_relaxed);
+
+    if (top > bottom) {
+        // 队列为空
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    Job* job = m_items[bottom & (kCapacity - 1)].load(std::memory_order_relaxed);
+    if (top == bottom) {
+        // 最后一个元素: 与窃取者竞争
+        if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            job = nullptr;
+        }
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+    return job;
+}
+
+Job* WorkStealingDeque::steal() {
+    int64_t top = m_top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const int64_t bottom = m_bottom.load(std::memory_order_acquire);
+    if (top >= bottom) {
+        return nullptr;
+    }
+
+    Job* job = m_items[top & (kCapacity - 1)].load(std::memory_order_acquire);
+    if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        return nullptr;
+    }
+    return job;
+}
+
+// ============ JobSystem ============
+
+JobSystem::JobSystem()
+    : m_pending(0)
+    , m_sleeping(0)
+    , m_stopping(false)
+{ }
+
+JobSystem::~JobSystem() {
+    this->release();
+}
+
+void JobSystem::setActive(JobSystem* system) {
+    s_activeSystem = system;
+}
+
+JobSystem* JobSystem::active() {
+    return s_activeSystem;
+}
+
+bool JobSystem::create(const JobSystemSettings& settings) {
+    if (isCreated()) {
+        return true;
+    }
+
+    int workers = settings.workers;
+    if (workers < 0) {
+        workers = static_cast<int>(std::thread::hardware_concurrency()) - 1;
+    }
+    workers = std::max(0, std::min(workers, kMaxWorkers));
+
+    const int threads = workers + 1;
+    for (int i = 0; i < threads; ++i) {
+        m_queues.push_back(std::unique_ptr<WorkStealingDeque>(new WorkStealingDeque()));
+        std::unique_ptr<ThreadState> state(new ThreadState());
+        state->pool.reset(new Job[kJobsPerThread]);
+        state->random = 0x9E3779B9u * static_cast<uint32_t>(i + 1);
+        m_states.push_back(std::move(state));
+    }
+
+    t_system = this;
+    t_threadIndex = 0;
+
+    m_stopping = false;
+    for (int i = 1; i < threads; ++i) {
+        m_threads.emplace_back(&JobSystem::workerMain, this, i);
+    }
+    return true;
+}
+
+void JobSystem::release() {
+    if (!isCreated()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wakeup.notify_all();
+    for (std::thread& thread : m_threads) {
+        thread.join();
+    }
+    m_threads.clear();
+    m_queues.clear();
+    m_states.clear();
+    m_pending = 0;
+    m_stopping = false;
+
+    if (t_system == this) {
+        t_system = nullptr;
+        t_threadIndex = -1;
+    }
+    if (s_activeSystem == this) {
+        s_activeSystem = nullptr;
+    }
+}
+
+int JobSystem::currentThreadIndex() const {
+    return t_system == this ? t_threadIndex : -1;
+}
+
+Job* JobSystem::allocate(int thread) {
+    ThreadState& state = *m_states[thread];
+    for (;;) {
+        for (uint32_t attempt = 0; attempt < kJobsPerThread; ++attempt) {
+            Job& job = state.pool[state.nextJob];
+            state.nextJob = (state.nextJob + 1) % kJobsPerThread;
+            if (!job.finished.load(std::memory_order_acquire)) {
+                continue;
+            }
+
+            // 代数先变，持有旧句柄的一方随即视为已完成
+            job.generation.fetch_add(1, std::memory_order_release);
+            job.finished.store(false, std::memory_order_relaxed);
+            job.range = nullptr;
+            job.context = nullptr;
+            job.parent = nullptr;
+            job.unfinished.store(1, std::memory_order_relaxed);
+            job.dependencies.store(1, std::memory_order_relaxed);
+            return &job;
+        }
+
+        // 任务池用尽: 帮助执行一个任务再重试
+        if (Job* other = findJob(thread)) {
+            execute(thread, other);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+JobHandle JobSystem::createJob(std::function<void()> function, JobHandle parent) {
+    const int thread = currentThreadIndex();
+    if (thread < 0) {
+        std::cerr << "JobSystem: createJob called from a thread that does not belong to this JobSystem" << std::endl;
+        return JobHandle();
+    }
+
+    Job* job = allocate(thread);
+    job->function = std::move(function);
+    if (parent.isValid() && !isDone(parent)) {
+        job->parent = parent.m_job;
+        parent.m_job->unfinished.fetch_add(1, std::memory_order_relaxed);
+    }
+    return JobHandle(job, job->generation.load(std::memory_order_relaxed));
+}
+
+void JobSystem::addDependency(JobHandle job, JobHandle dependency) {
+    if (!job.isValid() || !dependency.isValid() || isDone(dependency)) {
+        return;
+    }
+    dependency.m_job->continuations.push_back(job.m_job);
+    job.m_job->dependencies.fetch_add(1, std::memory_order_relaxed);
+}
+
+void JobSystem::submit(JobHandle job) {
+    const int thread = currentThreadIndex();
+    if (!job.isValid() || thread < 0) {
+        return;
+    }
+    if (job.m_job->dependencies.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        push(thread, job.m_job);
+    }
+}
+
+JobHandle JobSystem::schedule(std::function<void()> function, JobHandle parent) {
+    JobHandle job = createJob(std::move(function), parent);
+    submit(job);
+    return job;
+}
+
+bool JobSystem::isDone(JobHandle job) const {
+    if (!job.isValid()) {
+        return true;
+    }
+    return job.m_job->generation.load(std::memory_order_acquire) != job.m_generation
+        || job.m_job->finished.load(std::memory_order_acquire);
+}
+
+void JobSystem::wait(JobHandle job) {
+    const int thread = currentThreadIndex();
+    while (!isDone(job)) {
+        Job* other = thread >= 0 ? findJob(thread) : nullptr;
+        if (other) {
+            execute(thread, other);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::push(int thread, Job* job) {
+    if (!m_queues[thread]->push(job)) {
+        // 队列已满: 就地执行
+        execute(thread, job);
+        return;
+    }
+
+    // 与 workerMain 中 m_sleeping/m_pending 的检查顺序相反 (均为 seq_cst)，不会丢失唤醒
+    m_pending.fetch_add(1, std::memory_order_seq_cst);
+    if (m_sleeping.load(std::memory_order_seq_cst) > 0) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_wakeup.notify_one();
+    }
+}
+
+Job* JobSystem::findJob(int thread) {
+    Job* job = m_queues[thread]->pop();
+    if (!job) {
+        // 从随机位置开始依次尝试其他线程的队列
+        ThreadState& state = *m_states[thread];
+        const size_t count = m_queues.size();
+        const size_t start = nextRandom(state.random) % count;
+        for (size_t i = 0; i < count && !job; ++i) {
+            const size_t victim = (start + i) % count;
+            if (victim != static_cast<size_t>(thread)) {
+                job = m_queues[victim]->steal();
+            }
+        }
+        if (job) {
+            state.stolen.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    if (job) {
+        m_pending.fetch_sub(1, std::memory_order_relaxed);
+    }
+    return job;
+}
+
+void JobSystem::execute(int thread, Job* job) {
+    if (job->range) {
+        job->range(job->context, job->begin, job->end);
+    } else if (job->function) {
+        job->function();
+    }
+    m_states[thread]->executed.fetch_add(1, std::memory_order_relaxed);
+    finish(thread, job);
+}
+
+void JobSystem::finish(int thread, Job* job) {
+    if (job->unfinished.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+        return;
+    }
+
+    // 自身与所有子任务都已完成: 释放后继任务，再通知父任务
+    for (Job* continuation : job->continuations) {
+        if (continuation->dependencies.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            push(thread, continuation);
+        }
+    }
+    job->continuations.clear();
+    job->function = nullptr;
+
+    Job* parent = job->parent;
+    job->finished.store(true, std::memory_order_release);
+    if (parent) {
+        finish(thread, parent);
+    }
+}
+
+void JobSystem::runRanges(size_t count, size_t minGrain, void* context, void (*range)(void*, size_t, size_t)) {
+    const int thread = currentThreadIndex();
+    const size_t maxRanges = static_cast<size_t>(threadCount()) * 4;
+    const size_t grain = std::max({ minGrain, static_cast<size_t>(1), (count + maxRanges - 1) / maxRanges });
+    const size_t ranges = (count + grain - 1) / grain;
+    if (ranges <= 1) {
+        range(context, 0, count);
+        return;
+    }
+
+    // 根任务没有自身工作，只等待各分段 (子任务) 完成
+    Job* root = allocate(thread);
+    const JobHandle rootHandle(root, root->generation.load(std::memory_order_relaxed));
+    for (size_t i = 0; i < ranges; ++i) {
+        Job* job = allocate(thread);
+        job->range = range;
+        job->context = context;
+        job->begin = i * grain;
+        job->end = std::min(count, job->begin + grain);
+        job->parent = root;
+        root->unfinished.fetch_add(1, std::memory_order_relaxed);
+        job->dependencies.store(0, std::memory_order_relaxed);
+        push(thread, job);
+    }
+    finish(thread, root);
+    wait(rootHandle);
+}
+
+void JobSystem::workerMain(int thread) {
+    t_system = this;
+    t_threadIndex = thread;
+
+    for (;;) {
+        if (Job* job = findJob(thread)) {
+            execute(thread, job);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_sleeping.fetch_add(1, std::memory_order_seq_cst);
+        m_wakeup.wait(lock, [this] {
+            return m_stopping.load() || m_pending.load(std::memory_order_seq_cst) > 0;
+        });
+        m_sleeping.fetch_sub(1, std::memory_order_seq_cst);
+        if (m_stopping.load()) {
+            break;
+        }
+    }
+}
+
+JobSystemStats JobSystem::stats() const {
+    JobSystemStats stats;
+    for (const auto& state : m_states) {
+        stats.executed += state->executed.load(std::memory_order_relaxed);
+        stats.stolen += state->stolen.load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+void JobSystem::resetStats() {
+    for (const auto& state : m_states) {
+        state->executed.store(0, std::memory_order_relaxed);
+        state->stolen.store(0, std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,206 @@
+// job_system.hpp
+// 单一职责: 逐帧CPU任务的工作窃取线程池 - 每线程一个 Chase-Lev 双端队列，任务可有父子与前后依赖，提供 parallelFor
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+struct JobSystemSettings {
+    int workers = -1;           // 工作线程数 (不含创建线程)，-1 = 硬件线程数 - 1
+};
+
+struct JobSystemStats {
+    uint64_t executed = 0;      // 执行的任务数 (所有线程)
+    uint64_t stolen = 0;        // 其中从其他线程队列窃取的
+};
+
+/**
+ * @brief 任务: 由 JobSystem 的逐线程任务池分配，槽位在任务完成后复用
+ */
+struct alignas(64) Job {
+    std::function<void()> function;
+    void (*range)(void* context, size_t begin, size_t end) = nullptr;  // parallelFor 的分段，不经 std::function
+    void* context = nullptr;
+    size_t begin = 0;
+    size_t end = 0;
+    Job* parent = nullptr;
+    std::vector<Job*> continuations;            // 完成后释放的后继任务 (清空时保留容量)
+    std::atomic<int> unfinished{ 0 };           // 自身 + 未完成的子任务
+    std::atomic<int> dependencies{ 0 };         // 未完成的前置任务 + 尚未提交 (1)
+    std::atomic<uint32_t> generation{ 0 };
+    std::atomic<bool> finished{ true };         // 完成且后继已派发，槽位可复用
+};
+
+/**
+ * @brief 任务句柄: 槽位 + 代数，槽位复用后旧句柄视为已完成
+ */
+class JobHandle {
+public:
+    JobHandle() = default;
+    bool isValid() const { return m_job != nullptr; }
+
+private:
+    friend class JobSystem;
+    JobHandle(Job* job, uint32_t generation) : m_job(job), m_generation(generation) { }
+
+    Job* m_job = nullptr;
+    uint32_t m_generation = 0;
+};
+
+/**
+ * @brief 每线程一个的 Chase-Lev 工作窃取队列 (Lê 等 2013 的弱内存序版本)
+ *
+ * 所有者在底部 push/pop (后进先出，缓存友好)，其他线程从顶部 steal。容量固定，满时 push 返回 false。
+ */
+class WorkStealingDeque {
+public:
+    static constexpr int64_t kCapacity = 4096;
+
+    WorkStealingDeque();
+
+    bool push(Job* job);        // 仅所有者
+    Job* pop();                 // 仅所有者
+    Job* steal();               // 任意线程
+
+private:
+    alignas(64) std::atomic<int64_t> m_top;
+    alignas(64) std::atomic<int64_t> m_bottom;
+    alignas(64) std::atomic<Job*> m_items[kCapacity];
+};
+
+/**
+ * @brief JobSystem类 - 固定大小的工作窃取线程池
+ *
+ * 使用方式:
+ *   JobSystem jobs;
+ *   jobs.create();                                   // 创建线程即所有者线程 (通常是GL线程)
+ *   JobSystem::setActive(&jobs);                     // 提供给渲染器
+ *
+ *   JobHandle animate = jobs.createJob([]{ ... });
+ *   JobHandle bounds = jobs.createJob([]{ ... });
+ *   jobs.addDependency(bounds, animate);             // bounds 在 animate 完成后执行
+ *   jobs.submit(animate);
+ *   jobs.submit(bounds);
+ *   jobs.wait(bounds);                               // 等待期间调用线程也执行任务
+ *
+ *   jobs.parallelFor(count, 1024, [](size_t begin, size_t end) { ... });
+ *
+ * 任务没有独立的栈 (不使用纤程): wait() 在当前线程上执行其他任务直到目标完成，任务内部也可以 wait。
+ * createJob/submit/wait/parallelFor 只能在所有者线程与任务内部调用；其他线程调用 parallelFor 时顺序执行。
+ * 每个线程最多同时持有 kJobsPerThread 个未完成任务，任务池用尽时分配方先帮助执行任务再重试。
+ */
+class JobSystem {
+public:
+    static constexpr uint32_t kJobsPerThread = 1024;
+    static constexpr int kMaxWorkers = 63;
+
+    JobSystem();
+    ~JobSystem();
+
+    // 禁止拷贝
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    /**
+     * @brief 启动工作线程，调用线程成为所有者线程
+     */
+    bool create(const JobSystemSettings& settings = JobSystemSettings());
+
+    /**
+     * @brief 停止并回收工作线程 (调用前须等待所有已提交的任务)
+     */
+    void release();
+
+    bool isCreated() const { return !m_queues.empty(); }
+
+    // 参与执行任务的线程数 (工作线程 + 所有者线程)
+    unsigned threadCount() const { return static_cast<unsigned>(m_queues.size()); }
+
+    /**
+     * @brief 创建任务 (尚未提交)。指定 parent 时父任务在此任务完成后才算完成
+     */
+    JobHandle createJob(std::function<void()> function, JobHandle parent = JobHandle());
+
+    /**
+     * @brief job 在 dependency 完成后才执行；须在两者提交之前调用
+     */
+    void addDependency(JobHandle job, JobHandle dependency);
+
+    /**
+     * @brief 提交任务，前置任务全部完成后进入当前线程的队列
+     */
+    void submit(JobHandle job);
+
+    /**
+     * @brief 创建并立即提交
+     */
+    JobHandle schedule(std::function<void()> function, JobHandle parent = JobHandle());
+
+    /**
+     * @brief 阻塞直到任务 (及其所有子任务) 完成，等待期间执行其他任务
+     */
+    void wait(JobHandle job);
+
+    bool isDone(JobHandle job) const;
+
+    /**
+     * @brief [0, count) 分段并行执行 fn(begin, end)，返回时全部完成
+     * @param minGrain 每段的最小元素数；段数不超过线程数的4倍
+     */
+    template <typename Fn>
+    void parallelFor(size_t count, size_t minGrain, Fn&& fn) {
+        if (count == 0) {
+            return;
+        }
+        if (!isCreated() || currentThreadIndex() < 0) {
+            fn(static_cast<size_t>(0), count);
+            return;
+        }
+        using Function = typename std::remove_reference<Fn>::type;
+        runRanges(count, minGrain, const_cast<void*>(static_cast<const void*>(&fn)),
+                  [](void* context, size_t begin, size_t end) { (*static_cast<Function*>(context))(begin, end); });
+    }
+
+    JobSystemStats stats() const;
+    void resetStats();
+
+    // 与 TextureManager 相同，由应用持有实例并设置，渲染器取用；未设置时渲染器顺序执行
+    static void setActive(JobSystem* system);
+    static JobSystem* active();
+
+private:
+    struct alignas(64) ThreadState {
+        std::unique_ptr<Job[]> pool;
+        uint32_t nextJob = 0;
+        uint32_t random = 0;                    // 选择窃取对象的 xorshift 状态
+        std::atomic<uint64_t> executed{ 0 };
+        std::atomic<uint64_t> stolen{ 0 };
+    };
+
+    int currentThreadIndex() const;
+    Job* allocate(int thread);
+    void push(int thread, Job* job);
+    Job* findJob(int thread);
+    void execute(int thread, Job* job);
+    void finish(int thread, Job* job);
+    void runRanges(size_t count, size_t minGrain, void* context, void (*range)(void*, size_t, size_t));
+    void workerMain(int thread);
+
+    std::vector<std::unique_ptr<WorkStealingDeque>> m_queues;   // [0] 所有者线程，其余为工作线程
+    std::vector<std::unique_ptr<ThreadState>> m_states;
+    std::vector<std::thread> m_threads;
+
+    // 空闲的工作线程在此休眠；m_pending 是所有队列中尚未取走的任务数
+    std::mutex m_mutex;
+    std::condition_variable m_wakeup;
+    std::atomic<int64_t> m_pending;
+    std::atomic<int> m_sleeping;
+    std::atomic<bool> m_stopping;
+};
@@ -0,0 +1,302 @@
+#include "mesh_asset.hpp"
+#include "index_buffer.hpp"
+
+#include <glm/gtc/type_ptr.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <utility>
+
+namespace {
+
+uint64_t alignUp(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+// offset + bytes 不越界且不溢出
+bool rangeInFile(uint64_t offset, uint64_t bytes, size_t fileSize) {
+    return offset <= fileSize && bytes <= fileSize - offset;
+}
+
+void writePadding(std::ofstream& file, uint64_t& position, uint64_t target) {
+    static const char zeros[MeshAssetFormat::kStreamAlignment] = {};
+    while (position < target) {
+        const uint64_t chunk = std::min<uint64_t>(target - position, sizeof(zeros));
+        file.write(zeros, static_cast<std::streamsize>(chunk));
+        position += chunk;
+    }
+}
+
+} // namespace
+
+MeshAsset::MeshAsset()
+    : m_header(nullptr)
+{
+}
+
+MeshAsset::MeshAsset(MeshAsset&& other) noexcept
+    : m_file(std::move(other.m_file))
+    , m_header(std::exchange(other.m_header, nullptr))
+    , m_lastError(std::move(other.m_lastError))
+{
+}
+
+MeshAsset& MeshAsset::operator=(MeshAsset&& other) noexcept {
+    if (this != &other) {
+        m_file = std::move(other.m_file);
+        m_header = std::exchange(other.m_header, nullptr);
+        m_lastError = std::move(other.m_lastError);
+    }
+    return *this;
+}
+
+// ============ 写出 ============
+
+bool MeshAsset::write(const std::string& path,
+                      const VertexStream& stream,
+                      const std::vector<uint32_t>& indices,
+                      const std::vector<MeshSubmesh>& submeshes,
+                      const glm::vec3& boundsMin,
+                      const glm::vec3& boundsMax,
+                      std::string& error) {
+    using namespace MeshAssetFormat;
+
+    if (stream.vertexCount == 0 || stream.stride == 0 || indices.empty()) {
+        error = "Empty mesh";
+        return false;
+    }
+    if (stream.attributes.size() > kMaxAttributes) {
+        error = "Too many vertex attributes";
+        return false;
+    }
+    for (const MeshSubmesh& submesh : submeshes) {
+        if (static_cast<uint64_t>(submesh.firstIndex) + submesh.indexCount > indices.size()) {
+            error = "Submesh index range out of bounds";
+            return false;
+        }
+    }
+
+    const GLenum indexType = IndexBuffer::typeFor(stream.vertexCount);
+    const size_t indexSize = IndexBuffer::sizeOfType(indexType);
+
+    Header header;
+    std::memset(&header, 0, sizeof(header));
+    header.magic = kMagic;
+    header.version = kVersion;
+    header.headerSize = sizeof(Header);
+    header.attributeCount = static_cast<uint32_t>(stream.attributes.size());
+    header.vertexCount = stream.vertexCount;
+    header.indexCount = indices.size();
+    header.vertexStride = static_cast<uint32_t>(stream.stride);
+    header.indexType = indexType;
+    header.submeshCount = static_cast<uint32_t>(submeshes.size());
+
+    header.vertexOffset = alignUp(sizeof(Header), kStreamAlignment);
+    header.vertexBytes = stream.data.size();
+    header.indexOffset = alignUp(header.vertexOffset + header.vertexBytes, kStreamAlignment);
+    header.indexBytes = indices.size() * indexSize;
+    header.submeshOffset = alignUp(header.indexOffset + header.indexBytes, kStreamAlignment);
+
+    for (int axis = 0; axis < 3; ++axis) {
+        header.boundsMin[axis] = boundsMin[axis];
+        header.boundsMax[axis] = boundsMax[axis];
+    }
+    std::memcpy(header.dequantize, glm::value_ptr(stream.dequantize), sizeof(header.dequantize));
+
+    for (size_t i = 0; i < stream.attributes.size(); ++i) {
+        const VertexAttribute& attribute = stream.attributes[i];
+        AttributeRecord& record = header.attributes[i];
+        record.location = attribute.location;
+        record.type = attribute.type;
+        record.offset = static_cast<uint32_t>(attribute.offset);
+        record.components = static_cast<uint8_t>(attribute.components);
+        record.normalized = attribute.normalized ? 1 : 0;
+        record.integer = attribute.integer ? 1 : 0;
+    }
+
+    // 先写临时文件再改名，写到一半中断不会留下被映射的半截文件
+    const std::string temporaryPath = path + ".tmp";
+    {
+        std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            error = "Failed to open " + temporaryPath + " for writing";
+            return false;
+        }
+
+        uint64_t position = 0;
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        position += sizeof(header);
+
+        writePadding(file, position, header.vertexOffset);
+        file.write(reinterpret_cast<const char*>(stream.data.data()), static_cast<std::streamsize>(header.vertexBytes));
+        position += header.vertexBytes;
+
+        writePadding(file, position, header.indexOffset);
+        if (indexType == GL_UNSIGNED_SHORT) {
+            std::vector<uint16_t> packed(indices.begin(), indices.end());
+            file.write(reinterpret_cast<const char*>(packed.data()), static_cast<std::streamsize>(header.indexBytes));
+        } else {
+            file.write(reinterpret_cast<const char*>(indices.data()), static_cast<std::streamsize>(header.indexBytes));
+        }
+        position += header.indexBytes;
+
+        writePadding(file, position, header.submeshOffset);
+        if (!submeshes.empty()) {
+            file.write(reinterpret_cast<const char*>(submeshes.data()),
+                       static_cast<std::streamsize>(submeshes.size() * sizeof(MeshSubmesh)));
+        }
+
+        if (!file.good()) {
+            error = "Failed to write " + temporaryPath;
+            return false;
+        }
+    }
+
+    std::remove(path.c_str());
+    if (std::rename(temporaryPath.c_str(), path.c_str()) != 0) {
+        error = "Failed to rename " + temporaryPath + " to " + path;
+        std::remove(temporaryPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+// ============ 加载 ============
+
+bool MeshAsset::load(const std::string& path) {
+    release();
+
+    if (!m_file.open(path)) {
+        m_lastError = m_file.lastError();
+        return false;
+    }
+    if (m_file.size() < sizeof(MeshAssetFormat::Header)) {
+        m_lastError = "File too small for a mesh asset: " + path;
+        m_file.close();
+        return false;
+    }
+
+    // 映射起始地址按页对齐，Header 可以原地访问
+    const auto* header = reinterpret_cast<const MeshAssetFormat::Header*>(m_file.data());
+    if (!validate(*header, m_file.size())) {
+        m_lastError += ": " + path;
+        m_file.close();
+        return false;
+    }
+
+    m_header = header;
+    return true;
+}
+
+bool MeshAsset::validate(const MeshAssetFormat::Header& header, size_t fileSize) {
+    using namespace MeshAssetFormat;
+
+    if (header.magic != kMagic) {
+        m_lastError = "Not a mesh asset";
+        return false;
+    }
+    if (header.version != kVersion || header.headerSize != sizeof(Header)) {
+        m_lastError = "Unsupported mesh asset version " + std::to_string(header.version);
+        return false;
+    }
+    if (header.attributeCount == 0 || header.attributeCount > kMaxAttributes || header.vertexStride == 0) {
+        m_lastError = "Invalid vertex layout";
+        return false;
+    }
+    for (uint32_t i = 0; i < header.attributeCount; ++i) {
+        if (header.attributes[i].offset >= header.vertexStride) {
+            m_lastError = "Vertex attribute outside stride";
+            return false;
+        }
+    }
+    if (header.indexType != GL_UNSIGNED_SHORT && header.indexType != GL_UNSIGNED_INT) {
+        m_lastError = "Invalid index type";
+        return false;
+    }
+
+    if (header.vertexCount == 0 || header.vertexBytes / header.vertexStride != header.vertexCount
+        || header.vertexBytes % header.vertexStride != 0) {
+        m_lastError = "Vertex stream size mismatch";
+        return false;
+    }
+    const uint64_t indexSize = IndexBuffer::sizeOfType(header.indexType);
+    if (header.indexCount == 0 || header.indexBytes / indexSize != header.indexCount || header.indexBytes % indexSize != 0) {
+        m_lastError = "Index stream size mismatch";
+        return false;
+    }
+
+    const uint64_t submeshBytes = static_cast<uint64_t>(header.submeshCount) * sizeof(MeshSubmesh);
+    if (!rangeInFile(header.vertexOffset, header.vertexBytes, fileSize)
+        || !rangeInFile(header.indexOffset, header.indexBytes, fileSize)
+        || !rangeInFile(header.submeshOffset, submeshBytes, fileSize)) {
+        m_lastError = "Truncated mesh asset";
+        return false;
+    }
+    if (header.vertexOffset % kStreamAlignment != 0 || header.indexOffset % kStreamAlignment != 0
+        || header.submeshOffset % kStreamAlignment != 0) {
+        m_lastError = "Misaligned mesh asset stream";
+        return false;
+    }
+
+    // 子网格表很小，校验其范围不违背"零解析" (顶点/索引数据本身不读取)
+    const auto* submeshes = reinterpret_cast<const MeshSubmesh*>(m_file.data() + header.submeshOffset);
+    for (uint32_t i = 0; i < header.submeshCount; ++i) {
+        if (static_cast<uint64_t>(submeshes[i].firstIndex) + submeshes[i].indexCount > header.indexCount) {
+            m_lastError = "Submesh index range out of bounds";
+            return false;
+        }
+    }
+    return true;
+}
+
+void MeshAsset::release() {
+    m_header = nullptr;
+    m_file.close();
+}
+
+// ============ 访问 ============
+
+const void* MeshAsset::vertexData() const {
+    return m_header ? m_file.data() + m_header->vertexOffset : nullptr;
+}
+
+const void* MeshAsset::indexData() const {
+    return m_header ? m_file.data() + m_header->indexOffset : nullptr;
+}
+
+const MeshSubmesh* MeshAsset::submeshes() const {
+    return m_header ? reinterpret_cast<const MeshSubmesh*>(m_file.data() + m_header->submeshOffset) : nullptr;
+}
+
+std::vector<VertexAttribute> MeshAsset::attributes() const {
+    std::vector<VertexAttribute> result;
+    if (!m_header) {
+        return result;
+    }
+    result.reserve(m_header->attributeCount);
+    for (uint32_t i = 0; i < m_header->attributeCount; ++i) {
+        const MeshAssetFormat::AttributeRecord& record = m_header->attributes[i];
+        VertexAttribute attribute;
+        attribute.location = record.location;
+        attribute.components = record.components;
+        attribute.type = record.type;
+        attribute.normalized = record.normalized != 0;
+        attribute.integer = record.integer != 0;
+        attribute.offset = record.offset;
+        result.push_back(attribute);
+    }
+    return result;
+}
+
+glm::vec3 MeshAsset::boundsMin() const {
+    return m_header ? glm::vec3(m_header->boundsMin[0], m_header->boundsMin[1], m_header->boundsMin[2]) : glm::vec3(0.0f);
+}
+
+glm::vec3 MeshAsset::boundsMax() const {
+    return m_header ? glm::vec3(m_header->boundsMax[0], m_header->boundsMax[1], m_header->boundsMax[2]) : glm::vec3(0.0f);
+}
+
+glm::mat4 MeshAsset::dequantize() const {
+    return m_header ? glm::make_mat4(m_header->dequantize) : glm::mat4(1.0f);
+}
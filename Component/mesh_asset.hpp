@@ -0,0 +1,165 @@
+// mesh_asset.hpp
+// 单一职责: 网格二进制资源格式 (.meshbin) 的写出与内存映射加载 - 运行时零解析，顶点/索引段可直接上传GPU
+#pragma once
+
+// 平台条件编译：OpenGL ES (Android) vs OpenGL Core (PC)
+#ifdef __ANDROID__
+    #include <GLES3/gl3.h>
+    #include <GLES3/gl3ext.h>
+#else
+    #include <glad/glad.h>
+#endif
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "vertex_format.hpp"
+#include "platform/mapped_file.hpp"
+
+/**
+ * @brief 子网格: 共享同一顶点/索引缓冲的一段索引范围 (对应导入源中的一个 mesh)
+ */
+struct MeshSubmesh {
+    uint32_t firstIndex = 0;
+    uint32_t indexCount = 0;
+    uint32_t materialIndex = 0;
+    uint32_t reserved = 0;
+};
+
+/**
+ * 文件布局 (小端，所有段起始按 kStreamAlignment 对齐):
+ *
+ *   [Header][pad][顶点段: vertexCount x vertexStride][pad][索引段: 16/32位][pad][MeshSubmesh x submeshCount]
+ *
+ * 顶点段是 VertexStreamBuilder 打包后的交错缓冲，属性描述保存在 Header 中；
+ * 加载时只校验 Header，数据段以指针形式直接交给 glBufferData。
+ */
+namespace MeshAssetFormat {
+
+constexpr uint32_t kMagic = 0x4853454Du;        // "MESH"
+constexpr uint32_t kVersion = 1;
+constexpr uint32_t kStreamAlignment = 64;       // 缓存行，也满足所有属性类型的对齐
+constexpr uint32_t kMaxAttributes = 8;
+
+struct AttributeRecord {
+    uint32_t location;
+    uint32_t type;          // GLenum
+    uint32_t offset;
+    uint8_t components;
+    uint8_t normalized;
+    uint8_t integer;
+    uint8_t reserved;
+};
+
+struct Header {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t headerSize;
+    uint32_t attributeCount;
+
+    uint64_t vertexCount;
+    uint64_t indexCount;
+
+    uint64_t vertexOffset;
+    uint64_t vertexBytes;
+    uint64_t indexOffset;
+    uint64_t indexBytes;
+    uint64_t submeshOffset;
+
+    uint32_t vertexStride;
+    uint32_t indexType;     // GL_UNSIGNED_SHORT / GL_UNSIGNED_INT
+    uint32_t submeshCount;
+    uint32_t reserved;
+
+    float boundsMin[4];     // 模型空间包围盒 (反量化后)
+    float boundsMax[4];
+    float dequantize[16];   // 列主序，见 VertexStream::dequantize
+
+    AttributeRecord attributes[kMaxAttributes];
+};
+
+static_assert(sizeof(AttributeRecord) == 16, "AttributeRecord layout changed");
+static_assert(sizeof(Header) == 312, "Header layout changed, bump kVersion");
+static_assert(std::is_trivially_copyable<Header>::value, "Header must be trivially copyable");
+static_assert(std::is_trivially_copyable<MeshSubmesh>::value, "MeshSubmesh must be trivially copyable");
+
+} // namespace MeshAssetFormat
+
+/**
+ * @brief MeshAsset类 - 内存映射的网格资源
+ *
+ * 使用方式:
+ *   MeshAsset asset;
+ *   if (asset.load("model.meshbin")) {
+ *       glBufferData(GL_ARRAY_BUFFER, asset.vertexBytes(), asset.vertexData(), GL_STATIC_DRAW);
+ *       ...
+ *       asset.release();    // 上传完成后即可解除映射
+ *   }
+ */
+class MeshAsset {
+public:
+    MeshAsset();
+    ~MeshAsset() = default;
+
+    // 禁止拷贝，允许移动
+    MeshAsset(const MeshAsset&) = delete;
+    MeshAsset& operator=(const MeshAsset&) = delete;
+    MeshAsset(MeshAsset&& other) noexcept;
+    MeshAsset& operator=(MeshAsset&& other) noexcept;
+
+    /**
+     * @brief 写出资源文件 (离线导入工具使用)
+     * @param indices 32位索引，按 IndexBuffer::typeFor(顶点数) 打包为16/32位
+     */
+    static bool write(const std::string& path,
+                      const VertexStream& stream,
+                      const std::vector<uint32_t>& indices,
+                      const std::vector<MeshSubmesh>& submeshes,
+                      const glm::vec3& boundsMin,
+                      const glm::vec3& boundsMax,
+                      std::string& error);
+
+    /**
+     * @brief 映射文件并校验 Header (不读取、不拷贝数据段)
+     */
+    bool load(const std::string& path);
+
+    void release();
+
+    bool isLoaded() const { return m_header != nullptr; }
+
+    // 顶点段
+    const void* vertexData() const;
+    size_t vertexBytes() const { return m_header ? static_cast<size_t>(m_header->vertexBytes) : 0; }
+    size_t vertexCount() const { return m_header ? static_cast<size_t>(m_header->vertexCount) : 0; }
+    size_t vertexStride() const { return m_header ? m_header->vertexStride : 0; }
+    std::vector<VertexAttribute> attributes() const;
+
+    // 索引段 (已打包，可直接交给 IndexBuffer::createPacked)
+    const void* indexData() const;
+    size_t indexBytes() const { return m_header ? static_cast<size_t>(m_header->indexBytes) : 0; }
+    size_t indexCount() const { return m_header ? static_cast<size_t>(m_header->indexCount) : 0; }
+    GLenum indexType() const { return m_header ? m_header->indexType : 0; }
+
+    // 子网格与包围信息
+    const MeshSubmesh* submeshes() const;
+    size_t submeshCount() const { return m_header ? m_header->submeshCount : 0; }
+    glm::vec3 boundsMin() const;
+    glm::vec3 boundsMax() const;
+    glm::mat4 dequantize() const;
+
+    size_t fileSize() const { return m_file.size(); }
+    std::string lastError() const { return m_lastError; }
+
+private:
+    bool validate(const MeshAssetFormat::Header& header, size_t fileSize);
+
+    MappedFile m_file;
+    const MeshAssetFormat::Header* m_header;
+    std::string m_lastError;
+};
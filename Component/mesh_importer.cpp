@@ -0,0 +1,176 @@
+#include "mesh_importer.hpp"
+#include "mesh_asset.hpp"
+#include "mesh_optimizer.hpp"
+
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+#include <limits>
+#include <vector>
+
+namespace {
+
+// 导入时的中间顶点 (全浮点、无填充，MeshOptimizer 按字节去重)
+struct ImportVertex {
+    glm::vec3 position;
+    glm::vec3 normal;
+    glm::vec2 texCoord;
+    glm::vec3 color;
+};
+static_assert(sizeof(ImportVertex) == 11 * sizeof(float), "ImportVertex must not contain padding");
+
+// 与 shaders/mesh/mesh.vert.glsl 的 location 对应
+constexpr GLuint kPositionLocation = 0;
+constexpr GLuint kNormalLocation = 1;
+constexpr GLuint kTexCoordLocation = 2;
+constexpr GLuint kColorLocation = 3;
+
+std::vector<ImportVertex> readVertices(const aiMesh& mesh) {
+    std::vector<ImportVertex> vertices(mesh.mNumVertices);
+    const bool hasTexCoords = mesh.HasTextureCoords(0);
+    const bool hasColors = mesh.HasVertexColors(0);
+
+    for (unsigned int i = 0; i < mesh.mNumVertices; ++i) {
+        ImportVertex& vertex = vertices[i];
+        vertex.position = glm::vec3(mesh.mVertices[i].x, mesh.mVertices[i].y, mesh.mVertices[i].z);
+        vertex.normal = mesh.HasNormals()
+            ? glm::vec3(mesh.mNormals[i].x, mesh.mNormals[i].y, mesh.mNormals[i].z)
+            : glm::vec3(0.0f, 0.0f, 1.0f);
+        vertex.texCoord = hasTexCoords
+            ? glm::vec2(mesh.mTextureCoords[0][i].x, mesh.mTextureCoords[0][i].y)
+            : glm::vec2(0.0f);
+        vertex.color = hasColors
+            ? glm::vec3(mesh.mColors[0][i].r, mesh.mColors[0][i].g, mesh.mColors[0][i].b)
+            : glm::vec3(1.0f);
+    }
+    return vertices;
+}
+
+std::vector<uint32_t> readIndices(const aiMesh& mesh) {
+    std::vector<uint32_t> indices;
+    indices.reserve(static_cast<size_t>(mesh.mNumFaces) * 3);
+    for (unsigned int i = 0; i < mesh.mNumFaces; ++i) {
+        const aiFace& face = mesh.mFaces[i];
+        if (face.mNumIndices == 3) {
+            indices.insert(indices.end(), { face.mIndices[0], face.mIndices[1], face.mIndices[2] });
+        }
+    }
+    return indices;
+}
+
+} // namespace
+
+namespace MeshImporter {
+
+bool importFile(const std::string& sourcePath, const std::string& assetPath,
+                const MeshImportOptions& options, MeshImportStats& stats, std::string& error) {
+    stats = MeshImportStats();
+
+    Assimp::Importer importer;
+    // 点/线图元直接丢弃，只保留三角形
+    importer.SetPropertyInteger(AI_CONFIG_PP_SBP_REMOVE, aiPrimitiveType_POINT | aiPrimitiveType_LINE);
+
+    unsigned int flags = aiProcess_Triangulate
+                       | aiProcess_JoinIdenticalVertices
+                       | aiProcess_GenSmoothNormals
+                       | aiProcess_PreTransformVertices
+                       | aiProcess_SortByPType
+                       | aiProcess_FindDegenerates
+                       | aiProcess_ValidateDataStructure;
+    if (options.flipUVs) {
+        flags |= aiProcess_FlipUVs;
+    }
+
+    const aiScene* scene = importer.ReadFile(sourcePath, flags);
+    if (!scene || (scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE) || scene->mNumMeshes == 0) {
+        error = "Assimp failed to import " + sourcePath + ": " + importer.GetErrorString();
+        return false;
+    }
+
+    std::vector<ImportVertex> vertices;
+    std::vector<uint32_t> indices;
+    std::vector<MeshSubmesh> submeshes;
+    double weightedAcmrBefore = 0.0;
+    double weightedAcmrAfter = 0.0;
+
+    for (unsigned int m = 0; m < scene->mNumMeshes; ++m) {
+        const aiMesh& mesh = *scene->mMeshes[m];
+        if (!(mesh.mPrimitiveTypes & aiPrimitiveType_TRIANGLE)) {
+            continue;
+        }
+
+        std::vector<ImportVertex> meshVertices = readVertices(mesh);
+        std::vector<uint32_t> meshIndices = readIndices(mesh);
+        if (meshIndices.empty()) {
+            continue;
+        }
+
+        // 每个子网格单独优化: 三角形重排不跨越子网格边界
+        if (options.optimize) {
+            const MeshOptimizeStats meshStats = MeshOptimizer::optimizeMesh(meshVertices, meshIndices);
+            weightedAcmrBefore += static_cast<double>(meshStats.acmrBefore) * meshStats.triangles;
+            weightedAcmrAfter += static_cast<double>(meshStats.acmrAfter) * meshStats.triangles;
+        }
+
+        if (vertices.size() + meshVertices.size() > std::numeric_limits<uint32_t>::max()) {
+            error = "Too many vertices in " + sourcePath;
+            return false;
+        }
+
+        MeshSubmesh submesh;
+        submesh.firstIndex = static_cast<uint32_t>(indices.size());
+        submesh.indexCount = static_cast<uint32_t>(meshIndices.size());
+        submesh.materialIndex = mesh.mMaterialIndex;
+        submeshes.push_back(submesh);
+
+        const uint32_t baseVertex = static_cast<uint32_t>(vertices.size());
+        for (uint32_t index : meshIndices) {
+            indices.push_back(baseVertex + index);
+        }
+        vertices.insert(vertices.end(), meshVertices.begin(), meshVertices.end());
+    }
+
+    if (vertices.empty() || indices.empty()) {
+        error = "No triangle meshes in " + sourcePath;
+        return false;
+    }
+
+    glm::vec3 boundsMin = vertices[0].position;
+    glm::vec3 boundsMax = vertices[0].position;
+    for (const ImportVertex& vertex : vertices) {
+        boundsMin = glm::min(boundsMin, vertex.position);
+        boundsMax = glm::max(boundsMax, vertex.position);
+    }
+
+    VertexStreamBuilder builder(vertices.size());
+    builder.addPosition(kPositionLocation, options.format.position, &vertices[0].position, sizeof(ImportVertex));
+    builder.addNormal(kNormalLocation, options.format.normal, &vertices[0].normal, sizeof(ImportVertex));
+    builder.addTexCoord(kTexCoordLocation, options.format.texCoord, &vertices[0].texCoord, sizeof(ImportVertex));
+    builder.addColor(kColorLocation, options.format.color, &vertices[0].color, sizeof(ImportVertex));
+    const VertexStream stream = builder.build();
+
+    if (!MeshAsset::write(assetPath, stream, indices, submeshes, boundsMin, boundsMax, error)) {
+        return false;
+    }
+
+    stats.submeshes = submeshes.size();
+    stats.vertices = vertices.size();
+    stats.triangles = indices.size() / 3;
+    stats.vertexBytes = stream.data.size();
+    if (options.optimize && stats.triangles > 0) {
+        stats.acmrBefore = static_cast<float>(weightedAcmrBefore / stats.triangles);
+        stats.acmrAfter = static_cast<float>(weightedAcmrAfter / stats.triangles);
+    }
+
+    // 回读校验: 写出的文件可以被运行时加载
+    MeshAsset asset;
+    if (!asset.load(assetPath)) {
+        error = asset.lastError();
+        return false;
+    }
+    stats.fileBytes = asset.fileSize();
+    return true;
+}
+
+} // namespace MeshImporter
@@ -0,0 +1,43 @@
+// mesh_importer.hpp
+// 单一职责: 离线导入 - 经 assimp 读取 OBJ/glTF/FBX 等模型，优化并打包为 .meshbin 资源 (MeshAsset)
+#pragma once
+#include <cstddef>
+#include <string>
+
+#include "vertex_format.hpp"
+
+/**
+ * @brief 导入选项
+ */
+struct MeshImportOptions {
+    VertexFormat format = VertexFormat::compact();
+    bool optimize = true;       // 每个子网格经过 MeshOptimizer (去重 + 顶点缓存/读取顺序)
+    bool flipUVs = false;       // 源UV原点在左上角时 (部分 D3D 工作流导出的模型) 翻转V
+};
+
+/**
+ * @brief 一次导入的统计
+ */
+struct MeshImportStats {
+    size_t submeshes = 0;
+    size_t vertices = 0;
+    size_t triangles = 0;
+    size_t vertexBytes = 0;
+    size_t fileBytes = 0;
+    float acmrBefore = 0.0f;    // 按三角形数加权的平均值
+    float acmrAfter = 0.0f;
+};
+
+namespace MeshImporter {
+
+/**
+ * @brief 导入 sourcePath 并写出 assetPath
+ *
+ * 场景层级通过 aiProcess_PreTransformVertices 烘焙到顶点，每个 aiMesh 成为一个子网格
+ * (共享同一顶点/索引缓冲)。所有网格统一输出 位置(0)/法线(1)/UV(2)/颜色(3) 四个属性，
+ * 缺失的法线由 assimp 生成，缺失的UV/颜色分别填 0 / 白色。
+ */
+bool importFile(const std::string& sourcePath, const std::string& assetPath,
+                const MeshImportOptions& options, MeshImportStats& stats, std::string& error);
+
+} // namespace MeshImporter
@@ -0,0 +1,343 @@
+#include "mesh_optimizer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+
+namespace {
+
+constexpr uint32_t kInvalidIndex = 0xFFFFFFFFu;
+
+// ============ Forsyth 评分参数 ============
+// 参见 Tom Forsyth, "Linear-Speed Vertex Cache Optimisation"
+
+constexpr size_t kForsythCacheSize = 32;
+constexpr float kCacheDecayPower = 1.5f;
+constexpr float kLastTriangleScore = 0.75f;
+constexpr float kValenceBoostScale = 2.0f;
+constexpr float kValenceBoostPower = 0.5f;
+constexpr uint32_t kValenceTableSize = 64;
+
+struct ForsythScoreTable {
+    float cache[kForsythCacheSize];
+    float valence[kValenceTableSize];
+
+    ForsythScoreTable() {
+        for (size_t i = 0; i < kForsythCacheSize; ++i) {
+            if (i < 3) {
+                // 刚用过的三角形的顶点: 固定分数，避免立即重复使用同一条边
+                cache[i] = kLastTriangleScore;
+            } else {
+                const float scaler = 1.0f / static_cast<float>(kForsythCacheSize - 3);
+                cache[i] = std::pow(1.0f - static_cast<float>(i - 3) * scaler, kCacheDecayPower);
+            }
+        }
+        valence[0] = 0.0f;
+        for (uint32_t i = 1; i < kValenceTableSize; ++i) {
+            valence[i] = kValenceBoostScale * std::pow(static_cast<float>(i), -kValenceBoostPower);
+        }
+    }
+
+    float score(int cachePosition, uint32_t remainingTriangles) const {
+        if (remainingTriangles == 0) {
+            return -1.0f;   // 不再被任何未输出的三角形使用
+        }
+        float result = cachePosition >= 0 ? cache[cachePosition] : 0.0f;
+        result += remainingTriangles < kValenceTableSize
+            ? valence[remainingTriangles]
+            : kValenceBoostScale * std::pow(static_cast<float>(remainingTriangles), -kValenceBoostPower);
+        return result;
+    }
+};
+
+uint64_t hashBytes(const uint8_t* data, size_t size) {
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= data[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+bool indicesInRange(const uint32_t* indices, size_t indexCount, size_t vertexCount) {
+    for (size_t i = 0; i < indexCount; ++i) {
+        if (indices[i] >= vertexCount) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+namespace MeshOptimizer {
+
+// ============ 顶点去重 ============
+
+size_t generateIndexBuffer(const void* vertices, size_t vertexCount, size_t stride, std::vector<uint32_t>& remap) {
+    remap.assign(vertexCount, 0);
+    if (vertexCount == 0) {
+        return 0;
+    }
+
+    const uint8_t* bytes = static_cast<const uint8_t*>(vertices);
+
+    // 开放寻址哈希表 (负载因子 <= 0.5)，槽中存放代表顶点的原始下标
+    size_t tableSize = 16;
+    while (tableSize < vertexCount * 2) {
+        tableSize *= 2;
+    }
+    const size_t mask = tableSize - 1;
+    std::vector<uint32_t> table(tableSize, kInvalidIndex);
+
+    uint32_t unique = 0;
+    for (size_t i = 0; i < vertexCount; ++i) {
+        const uint8_t* vertex = bytes + i * stride;
+        size_t slot = static_cast<size_t>(hashBytes(vertex, stride)) & mask;
+
+        while (true) {
+            const uint32_t representative = table[slot];
+            if (representative == kInvalidIndex) {
+                table[slot] = static_cast<uint32_t>(i);
+                remap[i] = unique++;
+                break;
+            }
+            if (std::memcmp(bytes + representative * stride, vertex, stride) == 0) {
+                remap[i] = remap[representative];
+                break;
+            }
+            slot = (slot + 1) & mask;
+        }
+    }
+    return unique;
+}
+
+void remapVertexBuffer(void* destination, const void* vertices, size_t vertexCount, size_t stride, const std::vector<uint32_t>& remap) {
+    uint8_t* dst = static_cast<uint8_t*>(destination);
+    const uint8_t* src = static_cast<const uint8_t*>(vertices);
+
+    // generateIndexBuffer 按首次出现编号，目标下标不大于源下标，原地压缩安全
+    std::vector<uint8_t> written(vertexCount, 0);
+    for (size_t i = 0; i < vertexCount; ++i) {
+        const uint32_t target = remap[i];
+        if (!written[target]) {
+            written[target] = 1;
+            std::memmove(dst + target * stride, src + i * stride, stride);
+        }
+    }
+}
+
+// ============ 三角形重排 (Forsyth) ============
+
+void optimizeVertexCache(uint32_t* indices, size_t indexCount, size_t vertexCount) {
+    const size_t triangleCount = indexCount / 3;
+    if (triangleCount < 2 || !indicesInRange(indices, triangleCount * 3, vertexCount)) {
+        return;
+    }
+
+    static const ForsythScoreTable scoreTable;
+
+    // 顶点 → 相邻三角形 (CSR: offsets[v] 起的 remaining[v] 个仍未输出)
+    std::vector<uint32_t> offsets(vertexCount + 1, 0);
+    for (size_t i = 0; i < triangleCount * 3; ++i) {
+        offsets[indices[i] + 1]++;
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+    std::vector<uint32_t> remaining(vertexCount);
+    for (size_t v = 0; v < vertexCount; ++v) {
+        remaining[v] = offsets[v + 1] - offsets[v];
+    }
+
+    std::vector<uint32_t> adjacency(triangleCount * 3);
+    std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+    for (size_t t = 0; t < triangleCount; ++t) {
+        for (size_t k = 0; k < 3; ++k) {
+            adjacency[fill[indices[t * 3 + k]]++] = static_cast<uint32_t>(t);
+        }
+    }
+
+    std::vector<int> cachePosition(vertexCount, -1);
+    std::vector<float> vertexScore(vertexCount);
+    for (size_t v = 0; v < vertexCount; ++v) {
+        vertexScore[v] = scoreTable.score(-1, remaining[v]);
+    }
+
+    std::vector<uint8_t> emitted(triangleCount, 0);
+    int best = -1;
+    float bestScore = -1.0f;
+    for (size_t t = 0; t < triangleCount; ++t) {
+        const uint32_t* tri = indices + t * 3;
+        const float score = vertexScore[tri[0]] + vertexScore[tri[1]] + vertexScore[tri[2]];
+        if (score > bestScore) {
+            bestScore = score;
+            best = static_cast<int>(t);
+        }
+    }
+
+    std::vector<uint32_t> output;
+    output.reserve(triangleCount * 3);
+
+    uint32_t cache[kForsythCacheSize + 3];
+    uint32_t nextCache[kForsythCacheSize + 3];
+    size_t cacheCount = 0;
+    size_t fallbackCursor = 0;
+
+    while (output.size() < triangleCount * 3) {
+        if (best < 0) {
+            // 缓存中的顶点已无可用三角形: 顺序取下一个未输出的三角形
+            while (emitted[fallbackCursor]) {
+                ++fallbackCursor;
+            }
+            best = static_cast<int>(fallbackCursor);
+        }
+
+        const uint32_t* tri = indices + static_cast<size_t>(best) * 3;
+        emitted[best] = 1;
+        output.insert(output.end(), tri, tri + 3);
+
+        for (size_t k = 0; k < 3; ++k) {
+            const uint32_t v = tri[k];
+            uint32_t* begin = adjacency.data() + offsets[v];
+            uint32_t* end = begin + remaining[v];
+            uint32_t* it = std::find(begin, end, static_cast<uint32_t>(best));
+            if (it != end) {
+                *it = *(end - 1);
+                remaining[v]--;
+            }
+        }
+
+        // 新缓存: 当前三角形的顶点在最前，旧缓存的其余顶点依次后移
+        size_t nextCount = 0;
+        for (size_t k = 0; k < 3; ++k) {
+            if (std::find(nextCache, nextCache + nextCount, tri[k]) == nextCache + nextCount) {
+                nextCache[nextCount++] = tri[k];
+            }
+        }
+        for (size_t i = 0; i < cacheCount; ++i) {
+            const uint32_t v = cache[i];
+            if (v != tri[0] && v != tri[1] && v != tri[2]) {
+                nextCache[nextCount++] = v;
+            }
+        }
+
+        // 更新受影响顶点 (含被挤出缓存的) 的分数，并在其相邻三角形中挑选下一个
+        for (size_t i = 0; i < nextCount; ++i) {
+            const uint32_t v = nextCache[i];
+            cachePosition[v] = i < kForsythCacheSize ? static_cast<int>(i) : -1;
+            vertexScore[v] = scoreTable.score(cachePosition[v], remaining[v]);
+        }
+
+        best = -1;
+        bestScore = -1.0f;
+        for (size_t i = 0; i < nextCount; ++i) {
+            const uint32_t v = nextCache[i];
+            const uint32_t* begin = adjacency.data() + offsets[v];
+            for (const uint32_t* it = begin; it != begin + remaining[v]; ++it) {
+                const uint32_t* adjacent = indices + static_cast<size_t>(*it) * 3;
+                const float score = vertexScore[adjacent[0]] + vertexScore[adjacent[1]] + vertexScore[adjacent[2]];
+                if (score > bestScore) {
+                    bestScore = score;
+                    best = static_cast<int>(*it);
+                }
+            }
+        }
+
+        cacheCount = std::min(nextCount, kForsythCacheSize);
+        std::copy(nextCache, nextCache + cacheCount, cache);
+    }
+
+    std::copy(output.begin(), output.end(), indices);
+}
+
+// ============ 顶点重排 ============
+
+size_t optimizeVertexFetch(void* vertices, size_t vertexCount, size_t stride, uint32_t* indices, size_t indexCount) {
+    if (!indicesInRange(indices, indexCount, vertexCount)) {
+        return vertexCount;
+    }
+
+    std::vector<uint32_t> remap(vertexCount, kInvalidIndex);
+    uint32_t next = 0;
+    for (size_t i = 0; i < indexCount; ++i) {
+        uint32_t& target = remap[indices[i]];
+        if (target == kInvalidIndex) {
+            target = next++;
+        }
+        indices[i] = target;
+    }
+
+    uint8_t* bytes = static_cast<uint8_t*>(vertices);
+    const std::vector<uint8_t> original(bytes, bytes + vertexCount * stride);
+    for (size_t v = 0; v < vertexCount; ++v) {
+        if (remap[v] != kInvalidIndex) {
+            std::memcpy(bytes + remap[v] * stride, original.data() + v * stride, stride);
+        }
+    }
+    return next;
+}
+
+// ============ 统计 ============
+
+float computeACMR(const uint32_t* indices, size_t indexCount, size_t cacheSize) {
+    const size_t triangleCount = indexCount / 3;
+    if (triangleCount == 0 || cacheSize == 0) {
+        return 0.0f;
+    }
+
+    const uint32_t maxIndex = *std::max_element(indices, indices + triangleCount * 3);
+
+    // FIFO: 顶点在第 stamp 次未命中时进入缓存，之后再发生 cacheSize 次未命中即被挤出
+    std::vector<uint64_t> stamp(static_cast<size_t>(maxIndex) + 1, 0);
+    uint64_t misses = 0;
+    for (size_t i = 0; i < triangleCount * 3; ++i) {
+        uint64_t& inserted = stamp[indices[i]];
+        if (inserted == 0 || misses - inserted >= cacheSize) {
+            inserted = ++misses;
+        }
+    }
+    return static_cast<float>(misses) / static_cast<float>(triangleCount);
+}
+
+// ============ 完整流程 ============
+
+MeshOptimizeStats optimizeMeshData(void* vertices, size_t& vertexCount, size_t stride, std::vector<uint32_t>& indices) {
+    MeshOptimizeStats stats;
+    stats.verticesBefore = vertexCount;
+
+    if (indices.empty()) {
+        indices.resize(vertexCount - vertexCount % 3);
+        std::iota(indices.begin(), indices.end(), 0u);
+    }
+    indices.resize(indices.size() - indices.size() % 3);
+    stats.triangles = indices.size() / 3;
+    stats.acmrBefore = computeACMR(indices.data(), indices.size());
+
+    if (stats.triangles == 0 || !indicesInRange(indices.data(), indices.size(), vertexCount)) {
+        stats.verticesAfter = vertexCount;
+        stats.acmrAfter = stats.acmrBefore;
+        return stats;
+    }
+
+    // 1. 去重: 位置/属性完全相同的顶点合并，生成索引
+    std::vector<uint32_t> remap;
+    const size_t unique = generateIndexBuffer(vertices, vertexCount, stride, remap);
+    remapVertexBuffer(vertices, vertices, vertexCount, stride, remap);
+    for (uint32_t& index : indices) {
+        index = remap[index];
+    }
+    vertexCount = unique;
+
+    // 2. 三角形按顶点缓存局部性重排
+    optimizeVertexCache(indices.data(), indices.size(), vertexCount);
+
+    // 3. 顶点按首次使用排序，顺序读取顶点缓冲
+    vertexCount = optimizeVertexFetch(vertices, vertexCount, stride, indices.data(), indices.size());
+
+    stats.verticesAfter = vertexCount;
+    stats.acmrAfter = computeACMR(indices.data(), indices.size());
+    return stats;
+}
+
+} // namespace MeshOptimizer
@@ -0,0 +1,70 @@
+// mesh_optimizer.hpp
+// 单一职责: 加载期/离线的网格优化 - 顶点去重生成索引、三角形重排提高顶点缓存命中、按首次使用重排顶点
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 一次 optimizeMesh 的前后对比
+ *
+ * ACMR (Average Cache Miss Ratio): 每个三角形平均需要变换的顶点数 (FIFO缓存模拟)，
+ * 范围 0.5 (理想规则网格) ~ 3.0 (无任何复用，等同于非索引绘制)。
+ */
+struct MeshOptimizeStats {
+    size_t verticesBefore = 0;
+    size_t verticesAfter = 0;
+    size_t triangles = 0;
+    float acmrBefore = 0.0f;
+    float acmrAfter = 0.0f;
+};
+
+namespace MeshOptimizer {
+
+// ACMR 模拟使用的FIFO缓存大小 (与常见移动/桌面GPU的后变换缓存同量级)
+constexpr size_t kDefaultCacheSize = 16;
+
+/**
+ * @brief 按字节比较去重，remap[i] 为顶点 i 的新下标 (按首次出现顺序编号)
+ * @return 去重后的顶点数
+ */
+size_t generateIndexBuffer(const void* vertices, size_t vertexCount, size_t stride, std::vector<uint32_t>& remap);
+
+/**
+ * @brief 按 remap 压缩顶点 (destination 可以与 vertices 相同)
+ */
+void remapVertexBuffer(void* destination, const void* vertices, size_t vertexCount, size_t stride, const std::vector<uint32_t>& remap);
+
+/**
+ * @brief Forsyth 线性速度顶点缓存优化: 原地重排三角形顺序
+ */
+void optimizeVertexCache(uint32_t* indices, size_t indexCount, size_t vertexCount);
+
+/**
+ * @brief 按索引中首次使用的顺序重排顶点 (顺序读取顶点缓冲)，丢弃未引用的顶点
+ * @return 重排后的顶点数
+ */
+size_t optimizeVertexFetch(void* vertices, size_t vertexCount, size_t stride, uint32_t* indices, size_t indexCount);
+
+/**
+ * @brief FIFO 顶点缓存模拟: 缓存未命中数 / 三角形数
+ */
+float computeACMR(const uint32_t* indices, size_t indexCount, size_t cacheSize = kDefaultCacheSize);
+
+/**
+ * @brief 完整流程: 去重 → 三角形重排 → 顶点重排
+ *
+ * indices 为空时视为非索引三角形列表 (每3个顶点一个三角形)，输出一定带索引。
+ * vertexCount 输出为优化后的顶点数，vertices 的前 vertexCount 个元素有效。
+ */
+MeshOptimizeStats optimizeMeshData(void* vertices, size_t& vertexCount, size_t stride, std::vector<uint32_t>& indices);
+
+template <typename Vertex>
+MeshOptimizeStats optimizeMesh(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices) {
+    size_t vertexCount = vertices.size();
+    MeshOptimizeStats stats = optimizeMeshData(vertices.data(), vertexCount, sizeof(Vertex), indices);
+    vertices.resize(vertexCount);
+    return stats;
+}
+
+} // namespace MeshOptimizer
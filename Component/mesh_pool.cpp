@@ -0,0 +1,179 @@
+#include "mesh_pool.hpp"
+#include "mesh_asset.hpp"
+#include "gl_state_cache.hpp"
+
+#include <cstring>
+#include <limits>
+
+namespace {
+
+bool sameAttribute(const VertexAttribute& a, const VertexAttribute& b) {
+    return a.location == b.location && a.components == b.components && a.type == b.type
+        && a.normalized == b.normalized && a.integer == b.integer && a.offset == b.offset;
+}
+
+} // namespace
+
+MeshPool::MeshPool()
+    : m_vbo(0)
+    , m_ibo(0)
+    , m_stride(0)
+    , m_vertexCount(0)
+    , m_indexCount(0)
+{ }
+
+MeshPool::~MeshPool() {
+    release();
+}
+
+bool MeshPool::acceptLayout(const std::vector<VertexAttribute>& attributes, size_t stride) {
+    if (isUploaded()) {
+        m_lastError = "MeshPool: Cannot add meshes after upload";
+        return false;
+    }
+    if (stride == 0 || attributes.empty()) {
+        m_lastError = "MeshPool: Mesh has no vertex layout";
+        return false;
+    }
+    if (m_meshes.empty()) {
+        m_attributes = attributes;
+        m_stride = stride;
+        return true;
+    }
+
+    // 所有网格共用一组属性指针，布局必须逐字段相同
+    bool same = attributes.size() == m_attributes.size() && stride == m_stride;
+    for (size_t i = 0; same && i < attributes.size(); ++i) {
+        same = sameAttribute(attributes[i], m_attributes[i]);
+    }
+    if (!same) {
+        m_lastError = "MeshPool: Vertex layout differs from the first mesh";
+        return false;
+    }
+    return true;
+}
+
+int MeshPool::append(const void* vertices, size_t vertexCount, const void* indices, size_t indexCount, GLenum indexType,
+                     const glm::mat4& dequantize, const glm::vec3& boundsMin, const glm::vec3& boundsMax) {
+    if (vertexCount == 0 || indexCount == 0) {
+        m_lastError = "MeshPool: Mesh is empty";
+        return -1;
+    }
+    if (m_vertexCount + vertexCount > std::numeric_limits<uint32_t>::max()
+        || m_indexCount + indexCount > std::numeric_limits<uint32_t>::max()) {
+        m_lastError = "MeshPool: Pool exceeds 32-bit index range";
+        return -1;
+    }
+
+    PoolMesh mesh;
+    mesh.firstIndex = static_cast<uint32_t>(m_indexCount);
+    mesh.indexCount = static_cast<uint32_t>(indexCount);
+    mesh.firstVertex = static_cast<uint32_t>(m_vertexCount);
+    mesh.vertexCount = static_cast<uint32_t>(vertexCount);
+    mesh.dequantize = dequantize;
+    mesh.boundsMin = boundsMin;
+    mesh.boundsMax = boundsMax;
+
+    const size_t vertexBytes = vertexCount * m_stride;
+    const size_t vertexBegin = m_vertexData.size();
+    m_vertexData.resize(vertexBegin + vertexBytes);
+    std::memcpy(m_vertexData.data() + vertexBegin, vertices, vertexBytes);
+
+    // 16/32位索引统一展开为32位，并加上起始顶点
+    const size_t indexBegin = m_indexData.size();
+    m_indexData.resize(indexBegin + indexCount);
+    uint32_t* out = m_indexData.data() + indexBegin;
+    for (size_t i = 0; i < indexCount; ++i) {
+        const uint32_t index = indexType == GL_UNSIGNED_SHORT ? static_cast<const uint16_t*>(indices)[i]
+                                                              : static_cast<const uint32_t*>(indices)[i];
+        if (index >= vertexCount) {
+            m_vertexData.resize(vertexBegin);
+            m_indexData.resize(indexBegin);
+            m_lastError = "MeshPool: Index out of range";
+            return -1;
+        }
+        out[i] = index + mesh.firstVertex;
+    }
+
+    m_vertexCount += vertexCount;
+    m_indexCount += indexCount;
+    m_meshes.push_back(mesh);
+    return static_cast<int>(m_meshes.size() - 1);
+}
+
+int MeshPool::add(const VertexStream& stream, const std::vector<uint32_t>& indices,
+                  const glm::vec3& boundsMin, const glm::vec3& boundsMax) {
+    if (!acceptLayout(stream.attributes, stream.stride)) {
+        return -1;
+    }
+    return append(stream.data.data(), stream.vertexCount, indices.data(), indices.size(), GL_UNSIGNED_INT,
+                  stream.dequantize, boundsMin, boundsMax);
+}
+
+int MeshPool::add(const MeshAsset& asset) {
+    if (!asset.isLoaded()) {
+        m_lastError = "MeshPool: Mesh asset is not loaded";
+        return -1;
+    }
+    if (!acceptLayout(asset.attributes(), asset.vertexStride())) {
+        return -1;
+    }
+    // 子网格是同一顶点段上的连续索引范围，池中合为一个网格
+    return append(asset.vertexData(), asset.vertexCount(), asset.indexData(), asset.indexCount(), asset.indexType(),
+                  asset.dequantize(), asset.boundsMin(), asset.boundsMax());
+}
+
+bool MeshPool::upload() {
+    if (isUploaded()) {
+        return true;
+    }
+    if (m_meshes.empty()) {
+        m_lastError = "MeshPool: No meshes to upload";
+        return false;
+    }
+
+    GLStateCache& state = GLStateCache::current();
+
+    // 索引缓冲经 GL_COPY_WRITE_BUFFER 上传，不影响当前 VAO 记录的索引缓冲
+    glGenBuffers(1, &m_vbo);
+    state.bindBuffer(GL_ARRAY_BUFFER, m_vbo);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(m_vertexData.size()), m_vertexData.data(), GL_STATIC_DRAW);
+
+    glGenBuffers(1, &m_ibo);
+    state.bindBuffer(GL_COPY_WRITE_BUFFER, m_ibo);
+    glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(m_indexData.size() * sizeof(uint32_t)), m_indexData.data(), GL_STATIC_DRAW);
+
+    // 数据已在GPU上
+    std::vector<uint8_t>().swap(m_vertexData);
+    std::vector<uint32_t>().swap(m_indexData);
+    return true;
+}
+
+void MeshPool::release() {
+    GLStateCache& state = GLStateCache::current();
+    if (m_vbo != 0) {
+        state.onBufferDeleted(m_vbo);
+        glDeleteBuffers(1, &m_vbo);
+        m_vbo = 0;
+    }
+    if (m_ibo != 0) {
+        state.onBufferDeleted(m_ibo);
+        glDeleteBuffers(1, &m_ibo);
+        m_ibo = 0;
+    }
+    m_attributes.clear();
+    m_stride = 0;
+    m_vertexCount = 0;
+    m_indexCount = 0;
+    m_meshes.clear();
+    std::vector<uint8_t>().swap(m_vertexData);
+    std::vector<uint32_t>().swap(m_indexData);
+}
+
+void MeshPool::applyVertexState() const {
+    GLStateCache& state = GLStateCache::current();
+    state.bindBuffer(GL_ARRAY_BUFFER, m_vbo);
+    applyVertexAttributes(m_attributes.data(), m_attributes.size(), m_stride);
+    // 索引缓冲绑定记录在 VAO 中
+    state.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ibo);
+}
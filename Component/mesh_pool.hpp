@@ -0,0 +1,114 @@
+// mesh_pool.hpp
+// 单一职责: 网格大缓冲 - 多个网格共用一个 VBO 与一个32位 IBO，按索引范围区分，供一次 glMultiDrawElementsIndirect 绘制全部网格
+#pragma once
+
+// 平台条件编译：OpenGL ES (Android) vs OpenGL Core (PC)
+#ifdef __ANDROID__
+    #include <GLES3/gl3.h>
+    #include <GLES3/gl3ext.h>
+#else
+    #include <glad/glad.h>
+#endif
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "vertex_format.hpp"
+
+class MeshAsset;
+
+/**
+ * @brief 池中的一个网格: 共享索引缓冲中的一段范围
+ *
+ * 索引在加入时已加上网格的起始顶点 (绝对下标)，绘制时 baseVertex 始终为 0，
+ * 没有 glDrawElementsBaseVertex 的 GLES 3.0 也能直接按 firstIndex/indexCount 绘制。
+ */
+struct PoolMesh {
+    uint32_t firstIndex = 0;        // 以索引个数计
+    uint32_t indexCount = 0;
+    uint32_t firstVertex = 0;
+    uint32_t vertexCount = 0;
+    glm::mat4 dequantize = glm::mat4(1.0f);     // 见 VertexStream::dequantize，各网格不同
+    glm::vec3 boundsMin = glm::vec3(0.0f);      // 模型空间 (反量化后)
+    glm::vec3 boundsMax = glm::vec3(0.0f);
+};
+
+/**
+ * @brief MeshPool类 - 先在CPU上依次加入网格，upload 一次性创建GPU缓冲
+ *
+ * 使用方式:
+ *   MeshPool pool;
+ *   int rock = pool.add(asset);                       // .meshbin (所有子网格合为一个)
+ *   int tree = pool.add(stream, indices, min, max);   // VertexStreamBuilder 打包的数据
+ *   pool.upload();                                    // 需要当前GL上下文，之后不能再加入
+ *
+ *   glBindVertexArray(vao);
+ *   pool.applyVertexState();                          // 共享的顶点属性指针 + 索引缓冲记录到 vao
+ *
+ * 第一个网格确定顶点布局 (属性与步长)，之后的网格必须完全相同，否则拒绝加入。
+ */
+class MeshPool {
+public:
+    MeshPool();
+    ~MeshPool();
+
+    // 禁止拷贝 (GL缓冲由池独占)
+    MeshPool(const MeshPool&) = delete;
+    MeshPool& operator=(const MeshPool&) = delete;
+
+    /**
+     * @brief 加入一个网格，返回网格编号；布局不一致或已 upload 时返回 -1 (见 lastError)
+     */
+    int add(const VertexStream& stream, const std::vector<uint32_t>& indices,
+            const glm::vec3& boundsMin, const glm::vec3& boundsMax);
+    int add(const MeshAsset& asset);
+
+    /**
+     * @brief 创建 VBO/IBO 并上传全部网格，随后释放CPU副本
+     */
+    bool upload();
+
+    void release();
+
+    /**
+     * @brief 为当前绑定的 VAO 设置共享顶点属性的指针并绑定索引缓冲
+     */
+    void applyVertexState() const;
+
+    bool isUploaded() const { return m_vbo != 0; }
+    size_t meshCount() const { return m_meshes.size(); }
+    const PoolMesh& mesh(size_t id) const { return m_meshes[id]; }
+
+    const std::vector<VertexAttribute>& attributes() const { return m_attributes; }
+    size_t vertexStride() const { return m_stride; }
+    size_t vertexCount() const { return m_vertexCount; }
+    size_t indexCount() const { return m_indexCount; }
+
+    GLuint vertexBuffer() const { return m_vbo; }
+    GLuint indexBuffer() const { return m_ibo; }
+
+    std::string lastError() const { return m_lastError; }
+
+private:
+    bool acceptLayout(const std::vector<VertexAttribute>& attributes, size_t stride);
+    int append(const void* vertices, size_t vertexCount, const void* indices, size_t indexCount, GLenum indexType,
+               const glm::mat4& dequantize, const glm::vec3& boundsMin, const glm::vec3& boundsMax);
+
+    GLuint m_vbo;
+    GLuint m_ibo;
+    std::vector<VertexAttribute> m_attributes;
+    size_t m_stride;
+    size_t m_vertexCount;
+    size_t m_indexCount;
+    std::vector<PoolMesh> m_meshes;
+
+    // upload 之前的CPU副本
+    std::vector<uint8_t> m_vertexData;
+    std::vector<uint32_t> m_indexData;
+
+    std::string m_lastError;
+};
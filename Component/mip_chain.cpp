@@ -0,0 +1,112 @@
+#include "mip_chain.hpp"
+
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define MIP_CHAIN_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define MIP_CHAIN_NEON 1
+#endif
+
+namespace {
+
+// 一个输出像素的标量版本 (x0/x1/row0/row1 已按边缘重复夹取)
+inline void averagePixel(const uint8_t* row0, const uint8_t* row1, int x0, int x1, uint8_t* destination) {
+    for (int c = 0; c < 4; ++c) {
+        const int sum = row0[x0 * 4 + c] + row0[x1 * 4 + c] + row1[x0 * 4 + c] + row1[x1 * 4 + c];
+        destination[c] = static_cast<uint8_t>((sum + 2) >> 2);
+    }
+}
+
+// 每次处理两个输出像素 (读取两行各4个源像素)，返回已处理的输出像素数
+int downsampleRowSimd(const uint8_t* row0, const uint8_t* row1, int pairs, uint8_t* destination) {
+#if defined(MIP_CHAIN_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rounding = _mm_set1_epi16(2);
+    for (int i = 0; i < pairs; ++i) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + i * 16));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + i * 16));
+        // 16位展开后上下两行相加: low = 源像素0/1，high = 源像素2/3
+        const __m128i low = _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+        const __m128i high = _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+        // 左右相邻像素相加 (低64位有效)
+        const __m128i sumLow = _mm_add_epi16(low, _mm_srli_si128(low, 8));
+        const __m128i sumHigh = _mm_add_epi16(high, _mm_srli_si128(high, 8));
+        __m128i sum = _mm_unpacklo_epi64(sumLow, sumHigh);
+        sum = _mm_srli_epi16(_mm_add_epi16(sum, rounding), 2);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(destination + i * 8), _mm_packus_epi16(sum, zero));
+    }
+    return pairs * 2;
+#elif defined(MIP_CHAIN_NEON)
+    for (int i = 0; i < pairs; ++i) {
+        const uint8x16_t a = vld1q_u8(row0 + i * 16);
+        const uint8x16_t b = vld1q_u8(row1 + i * 16);
+        const uint16x8_t low = vaddl_u8(vget_low_u8(a), vget_low_u8(b));
+        const uint16x8_t high = vaddl_u8(vget_high_u8(a), vget_high_u8(b));
+        const uint16x4_t sumLow = vadd_u16(vget_low_u16(low), vget_high_u16(low));
+        const uint16x4_t sumHigh = vadd_u16(vget_low_u16(high), vget_high_u16(high));
+        // 带舍入右移2位并收窄: (sum + 2) >> 2
+        vst1_u8(destination + i * 8, vrshrn_n_u16(vcombine_u16(sumLow, sumHigh), 2));
+    }
+    return pairs * 2;
+#else
+    (void)row0;
+    (void)row1;
+    (void)pairs;
+    (void)destination;
+    return 0;
+#endif
+}
+
+} // namespace
+
+namespace MipChain {
+
+int levelCount(int width, int height) {
+    int levels = 1;
+    int size = std::max(width, height);
+    while (size > 1) {
+        size /= 2;
+        ++levels;
+    }
+    return levels;
+}
+
+void downsample(const uint8_t* source, int width, int height, uint8_t* destination) {
+    const int nextWidth = std::max(1, width / 2);
+    const int nextHeight = std::max(1, height / 2);
+    const size_t sourceStride = static_cast<size_t>(width) * 4;
+
+    for (int y = 0; y < nextHeight; ++y) {
+        const uint8_t* row0 = source + static_cast<size_t>(std::min(y * 2, height - 1)) * sourceStride;
+        const uint8_t* row1 = source + static_cast<size_t>(std::min(y * 2 + 1, height - 1)) * sourceStride;
+        uint8_t* output = destination + static_cast<size_t>(y) * nextWidth * 4;
+
+        // 成对的完整 2x2 源块走SIMD，奇数尺寸的尾部走标量
+        const int x = downsampleRowSimd(row0, row1, nextWidth / 2, output);
+        for (int column = x; column < nextWidth; ++column) {
+            const int x0 = std::min(column * 2, width - 1);
+            const int x1 = std::min(column * 2 + 1, width - 1);
+            averagePixel(row0, row1, x0, x1, output + column * 4);
+        }
+    }
+}
+
+std::vector<uint8_t> downsample(const std::vector<uint8_t>& source, int width, int height) {
+    std::vector<uint8_t> result(static_cast<size_t>(std::max(1, width / 2)) * std::max(1, height / 2) * 4);
+    downsample(source.data(), width, height, result.data());
+    return result;
+}
+
+void build(std::vector<std::vector<uint8_t>>& levels, int width, int height, int levelCount) {
+    levels.resize(static_cast<size_t>(std::max(levelCount, 1)));
+    for (size_t level = 1; level < levels.size(); ++level) {
+        levels[level] = downsample(levels[level - 1], width, height);
+        width = std::max(1, width / 2);
+        height = std::max(1, height / 2);
+    }
+}
+
+} // namespace MipChain
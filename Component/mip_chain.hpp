@@ -0,0 +1,30 @@
+// mip_chain.hpp
+// 单一职责: CPU端 RGBA8 mip链生成 - 2x2盒式滤波 (SSE2/NEON)，供图集与压缩纹理转码使用
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace MipChain {
+
+/**
+ * @brief 完整mip链的层数 (直到 1x1)
+ */
+int levelCount(int width, int height);
+
+/**
+ * @brief 2x2 盒式滤波生成下一级 (四舍五入；奇数尺寸时边缘像素重复)
+ *
+ * destination 至少 max(1, width/2) * max(1, height/2) * 4 字节。
+ * 在 gamma 空间平均，与 glGenerateMipmap 对 GL_RGBA8 的行为一致。
+ */
+void downsample(const uint8_t* source, int width, int height, uint8_t* destination);
+
+std::vector<uint8_t> downsample(const std::vector<uint8_t>& source, int width, int height);
+
+/**
+ * @brief 由 levels[0] (width x height) 生成其余层级，levels 调整为 levelCount 个
+ */
+void build(std::vector<std::vector<uint8_t>>& levels, int width, int height, int levelCount);
+
+} // namespace MipChain
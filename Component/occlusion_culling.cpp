@@ -0,0 +1,465 @@
+#include "occlusion_culling.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+    #include <xmmintrin.h>
+    #define OCCLUSION_SSE 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define OCCLUSION_NEON 1
+#endif
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int kMaxBands = 16;
+
+double elapsedMs(Clock::time_point from) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - from).count();
+}
+
+// 光栅化一个三角形所需的平面方程: 值 = a * x + b * y + c (像素中心坐标)
+struct Plane {
+    float a;
+    float b;
+    float c;
+
+    float at(float x, float y) const { return a * x + b * y + c; }
+};
+
+// 一行中 [x0, x1) 的像素 (x0、x1 为4的倍数)，edges 全部 >= 0 的像素取 min(深度, z)
+void rasterizeSpanScalar(const Plane edges[3], const Plane& depth, float y, int x0, int x1, float* row) {
+    for (int x = x0; x < x1; ++x) {
+        const float px = static_cast<float>(x) + 0.5f;
+        if (edges[0].at(px, y) >= 0.0f && edges[1].at(px, y) >= 0.0f && edges[2].at(px, y) >= 0.0f) {
+            row[x] = std::min(row[x], depth.at(px, y));
+        }
+    }
+}
+
+void rasterizeSpanSimd(const Plane edges[3], const Plane& depth, float y, int x0, int x1, float* row) {
+#if defined(OCCLUSION_SSE)
+    // 与标量版本相同的求值顺序: (a * x + b * y) + c
+    const __m128 laneOffsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+    const __m128 zero = _mm_setzero_ps();
+    __m128 edgeA[3], edgeBy[3], edgeC[3];
+    for (int e = 0; e < 3; ++e) {
+        edgeA[e] = _mm_set1_ps(edges[e].a);
+        edgeBy[e] = _mm_set1_ps(edges[e].b * y);
+        edgeC[e] = _mm_set1_ps(edges[e].c);
+    }
+    const __m128 depthA = _mm_set1_ps(depth.a);
+    const __m128 depthBy = _mm_set1_ps(depth.b * y);
+    const __m128 depthC = _mm_set1_ps(depth.c);
+
+    for (int x = x0; x < x1; x += 4) {
+        const __m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), laneOffsets);
+        __m128 inside = _mm_cmpge_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(edgeA[0], px), edgeBy[0]), edgeC[0]), zero);
+        inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(edgeA[1], px), edgeBy[1]), edgeC[1]), zero));
+        inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(edgeA[2], px), edgeBy[2]), edgeC[2]), zero));
+        if (_mm_movemask_ps(inside) == 0) {
+            continue;
+        }
+        const __m128 z = _mm_add_ps(_mm_add_ps(_mm_mul_ps(depthA, px), depthBy), depthC);
+        const __m128 old = _mm_loadu_ps(row + x);
+        const __m128 nearer = _mm_min_ps(old, z);
+        _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, nearer), _mm_andnot_ps(inside, old)));
+    }
+#elif defined(OCCLUSION_NEON)
+    const float laneOffsetData[4] = { 0.5f, 1.5f, 2.5f, 3.5f };
+    const float32x4_t laneOffsets = vld1q_f32(laneOffsetData);
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    for (int x = x0; x < x1; x += 4) {
+        const float32x4_t px = vaddq_f32(vdupq_n_f32(static_cast<float>(x)), laneOffsets);
+        uint32x4_t inside = vdupq_n_u32(0xFFFFFFFFu);
+        // vmulq + vaddq 而非 vmlaq/vfmaq，保持与标量版本相同的舍入
+        for (int e = 0; e < 3; ++e) {
+            const float32x4_t value = vaddq_f32(vaddq_f32(vmulq_n_f32(px, edges[e].a), vdupq_n_f32(edges[e].b * y)),
+                                                vdupq_n_f32(edges[e].c));
+            inside = vandq_u32(inside, vcgeq_f32(value, zero));
+        }
+        const float32x4_t z = vaddq_f32(vaddq_f32(vmulq_n_f32(px, depth.a), vdupq_n_f32(depth.b * y)), vdupq_n_f32(depth.c));
+        const float32x4_t old = vld1q_f32(row + x);
+        vst1q_f32(row + x, vbslq_f32(inside, vminq_f32(old, z), old));
+    }
+#else
+    rasterizeSpanScalar(edges, depth, y, x0, x1, row);
+#endif
+}
+
+} // namespace
+
+OcclusionCuller::OcclusionCuller(const OcclusionSettings& settings)
+    : m_width(std::max(4, (settings.width + 3) / 4 * 4))
+    , m_height(std::max(1, settings.height))
+    , m_simd(settings.simd)
+    , m_viewProjection(1.0f)
+    , m_bandCount(0)
+    , m_bandHeight(0)
+    , m_generation(0)
+    , m_activeWorkers(0)
+    , m_stopping(false)
+    , m_nextBand(0)
+{
+    // 金字塔: 每级长宽减半直到 1x1
+    int levelWidth = m_width;
+    int levelHeight = m_height;
+    for (;;) {
+        Level level;
+        level.width = levelWidth;
+        level.height = levelHeight;
+        level.depth.assign(static_cast<size_t>(levelWidth) * levelHeight, 1.0f);
+        m_levels.push_back(std::move(level));
+        if (levelWidth == 1 && levelHeight == 1) {
+            break;
+        }
+        levelWidth = std::max(1, levelWidth / 2);
+        levelHeight = std::max(1, levelHeight / 2);
+    }
+
+    m_bandCount = std::min(kMaxBands, m_height);
+    m_bandHeight = (m_height + m_bandCount - 1) / m_bandCount;
+    m_bandCount = (m_height + m_bandHeight - 1) / m_bandHeight;
+
+    int threads = settings.threads;
+    if (threads < 0) {
+        threads = static_cast<int>(std::thread::hardware_concurrency()) - 1;
+    }
+    threads = std::min(std::max(threads, 0), OcclusionSettings::kMaxThreads);
+    for (int i = 0; i < threads; ++i) {
+        m_threads.emplace_back(&OcclusionCuller::workerMain, this);
+    }
+    m_stats.threads = static_cast<unsigned>(threads) + 1;
+}
+
+OcclusionCuller::~OcclusionCuller() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wakeup.notify_all();
+    for (std::thread& thread : m_threads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+}
+
+void OcclusionCuller::beginFrame(const glm::mat4& viewProjection) {
+    m_viewProjection = viewProjection;
+    m_triangles.clear();
+    const unsigned threads = m_stats.threads;
+    m_stats = OcclusionStats();
+    m_stats.threads = threads;
+}
+
+void OcclusionCuller::addOccluder(const glm::vec3* positions, size_t vertexCount, const uint32_t* indices, size_t indexCount,
+                                  const glm::mat4& model) {
+    const glm::mat4 transform = m_viewProjection * model;
+    m_clipScratch.resize(vertexCount);
+    for (size_t i = 0; i < vertexCount; ++i) {
+        m_clipScratch[i] = transform * glm::vec4(positions[i], 1.0f);
+    }
+
+    const size_t count = indices ? indexCount : vertexCount;
+    for (size_t i = 0; i + 2 < count; i += 3) {
+        const size_t a = indices ? indices[i] : i;
+        const size_t b = indices ? indices[i + 1] : i + 1;
+        const size_t c = indices ? indices[i + 2] : i + 2;
+        if (a >= vertexCount || b >= vertexCount || c >= vertexCount) {
+            continue;
+        }
+        m_stats.occluderTriangles++;
+        clipAndAdd(m_clipScratch[a], m_clipScratch[b], m_clipScratch[c]);
+    }
+}
+
+void OcclusionCuller::clipAndAdd(const glm::vec4& a, const glm::vec4& b, const glm::vec4& c) {
+    const glm::vec4 vertices[3] = { a, b, c };
+
+    // 三个顶点都在同一个侧平面之外时整体丢弃 (屏幕外的部分由光栅化的包围矩形裁掉)
+    for (int axis = 0; axis < 2; ++axis) {
+        if ((a[axis] > a.w && b[axis] > b.w && c[axis] > c.w) || (a[axis] < -a.w && b[axis] < -b.w && c[axis] < -c.w)) {
+            return;
+        }
+    }
+
+    // 只对近平面 (z >= -w) 做 Sutherland-Hodgman 裁剪，之后 w 恒为正
+    glm::vec4 polygon[4];
+    int count = 0;
+    for (int i = 0; i < 3; ++i) {
+        const glm::vec4& current = vertices[i];
+        const glm::vec4& next = vertices[(i + 1) % 3];
+        const float currentDistance = current.z + current.w;
+        const float nextDistance = next.z + next.w;
+        if (currentDistance >= 0.0f) {
+            polygon[count++] = current;
+        }
+        if ((currentDistance >= 0.0f) != (nextDistance >= 0.0f)) {
+            const float t = currentDistance / (currentDistance - nextDistance);
+            polygon[count++] = current + (next - current) * t;
+        }
+    }
+    for (int i = 1; i + 1 < count; ++i) {
+        addScreenTriangle(polygon[0], polygon[i], polygon[i + 1]);
+    }
+}
+
+void OcclusionCuller::addScreenTriangle(const glm::vec4& a, const glm::vec4& b, const glm::vec4& c) {
+    Triangle triangle;
+    const glm::vec4* clip[3] = { &a, &b, &c };
+    for (int i = 0; i < 3; ++i) {
+        const float w = std::max(clip[i]->w, 1e-6f);
+        const glm::vec3 ndc = glm::vec3(*clip[i]) / w;
+        triangle.v[i] = glm::vec3((ndc.x * 0.5f + 0.5f) * m_width,
+                                  (ndc.y * 0.5f + 0.5f) * m_height,
+                                  ndc.z * 0.5f + 0.5f);
+    }
+
+    const glm::vec2 ab = glm::vec2(triangle.v[1] - triangle.v[0]);
+    const glm::vec2 ac = glm::vec2(triangle.v[2] - triangle.v[0]);
+    const float area = ab.x * ac.y - ab.y * ac.x;
+    if (std::fabs(area) < 1e-8f) {
+        return;
+    }
+    // 统一为逆时针，三条边函数在内部均为非负
+    if (area < 0.0f) {
+        std::swap(triangle.v[1], triangle.v[2]);
+    }
+    m_triangles.push_back(triangle);
+    m_stats.rasterTriangles++;
+}
+
+void OcclusionCuller::rasterize() {
+    auto start = Clock::now();
+    if (m_triangles.empty()) {
+        std::fill(m_levels[0].depth.begin(), m_levels[0].depth.end(), 1.0f);
+    } else {
+        runBands();
+    }
+    m_stats.rasterMs = elapsedMs(start);
+
+    start = Clock::now();
+    buildPyramid();
+    m_stats.pyramidMs = elapsedMs(start);
+}
+
+void OcclusionCuller::runBands() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_nextBand.store(0);
+        m_activeWorkers = static_cast<int>(m_threads.size());
+        ++m_generation;
+    }
+    m_wakeup.notify_all();
+
+    // 调用线程也参与
+    for (int band = m_nextBand.fetch_add(1); band < m_bandCount; band = m_nextBand.fetch_add(1)) {
+        rasterizeBand(band);
+    }
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_finished.wait(lock, [this]() { return m_activeWorkers == 0; });
+}
+
+void OcclusionCuller::workerMain() {
+    uint64_t seenGeneration = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wakeup.wait(lock, [&]() { return m_stopping || m_generation != seenGeneration; });
+            if (m_stopping) {
+                return;
+            }
+            seenGeneration = m_generation;
+        }
+
+        for (int band = m_nextBand.fetch_add(1); band < m_bandCount; band = m_nextBand.fetch_add(1)) {
+            rasterizeBand(band);
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (--m_activeWorkers == 0) {
+            m_finished.notify_one();
+        }
+    }
+}
+
+void OcclusionCuller::rasterizeBand(int band) {
+    const int rowBegin = band * m_bandHeight;
+    const int rowEnd = std::min(m_height, rowBegin + m_bandHeight);
+    float* depth = m_levels[0].depth.data();
+    std::fill(depth + static_cast<size_t>(rowBegin) * m_width, depth + static_cast<size_t>(rowEnd) * m_width, 1.0f);
+
+    for (const Triangle& triangle : m_triangles) {
+        const glm::vec3& v0 = triangle.v[0];
+        const glm::vec3& v1 = triangle.v[1];
+        const glm::vec3& v2 = triangle.v[2];
+
+        // 像素中心 (x + 0.5) 落在包围矩形内的像素
+        const float minY = std::min(v0.y, std::min(v1.y, v2.y));
+        const float maxY = std::max(v0.y, std::max(v1.y, v2.y));
+        const int y0 = std::max(rowBegin, static_cast<int>(std::ceil(minY - 0.5f)));
+        const int y1 = std::min(rowEnd - 1, static_cast<int>(std::floor(maxY - 0.5f)));
+        if (y0 > y1) {
+            continue;
+        }
+        const float minX = std::min(v0.x, std::min(v1.x, v2.x));
+        const float maxX = std::max(v0.x, std::max(v1.x, v2.x));
+        const int x0 = std::max(0, static_cast<int>(std::ceil(minX - 0.5f)));
+        const int x1 = std::min(m_width - 1, static_cast<int>(std::floor(maxX - 0.5f)));
+        if (x0 > x1) {
+            continue;
+        }
+
+        // 边 i→j 的边函数 cross(vj - vi, p - vi)，逆时针三角形内部为正
+        Plane edges[3];
+        const glm::vec3* vertices[3] = { &v0, &v1, &v2 };
+        for (int e = 0; e < 3; ++e) {
+            const glm::vec3& from = *vertices[e];
+            const glm::vec3& to = *vertices[(e + 1) % 3];
+            edges[e].a = -(to.y - from.y);
+            edges[e].b = to.x - from.x;
+            edges[e].c = -(edges[e].a * from.x + edges[e].b * from.y);
+        }
+
+        // 深度平面 z = a * x + b * y + c
+        const glm::vec3 normal = glm::cross(v1 - v0, v2 - v0);
+        Plane depthPlane;
+        depthPlane.a = -normal.x / normal.z;
+        depthPlane.b = -normal.y / normal.z;
+        depthPlane.c = v0.z - depthPlane.a * v0.x - depthPlane.b * v0.y;
+
+        // 按4像素对齐 (宽度为4的倍数)，多出的像素由边函数排除
+        const int spanBegin = x0 & ~3;
+        const int spanEnd = std::min(m_width, (x1 + 4) & ~3);
+        for (int y = y0; y <= y1; ++y) {
+            float* row = depth + static_cast<size_t>(y) * m_width;
+            const float py = static_cast<float>(y) + 0.5f;
+            if (m_simd) {
+                rasterizeSpanSimd(edges, depthPlane, py, spanBegin, spanEnd, row);
+            } else {
+                rasterizeSpanScalar(edges, depthPlane, py, spanBegin, spanEnd, row);
+            }
+        }
+    }
+}
+
+void OcclusionCuller::buildPyramid() {
+    for (size_t index = 1; index < m_levels.size(); ++index) {
+        const Level& source = m_levels[index - 1];
+        Level& target = m_levels[index];
+        for (int y = 0; y < target.height; ++y) {
+            // 上一级为奇数尺寸时，最后一行/列并入末尾的纹素，保证覆盖完整
+            const int sy0 = y * 2;
+            const int sy1 = (y == target.height - 1) ? source.height - 1 : std::min(sy0 + 1, source.height - 1);
+            for (int x = 0; x < target.width; ++x) {
+                const int sx0 = x * 2;
+                const int sx1 = (x == target.width - 1) ? source.width - 1 : std::min(sx0 + 1, source.width - 1);
+                float farthest = 0.0f;
+                for (int sy = sy0; sy <= sy1; ++sy) {
+                    const float* row = source.depth.data() + static_cast<size_t>(sy) * source.width;
+                    for (int sx = sx0; sx <= sx1; ++sx) {
+                        farthest = std::max(farthest, row[sx]);
+                    }
+                }
+                target.depth[static_cast<size_t>(y) * target.width + x] = farthest;
+            }
+        }
+    }
+}
+
+bool OcclusionCuller::isVisible(const glm::vec3& center, const glm::vec3& extents) const {
+    // 角点 = 中心 ± 各轴半长，裁剪坐标是线性组合，只需一次矩阵乘法；8个角点按分量成组计算便于向量化
+    static const float kSignX[8] = { -1, 1, -1, 1, -1, 1, -1, 1 };
+    static const float kSignY[8] = { -1, -1, 1, 1, -1, -1, 1, 1 };
+    static const float kSignZ[8] = { -1, -1, -1, -1, 1, 1, 1, 1 };
+    const glm::vec4 clipCenter = m_viewProjection * glm::vec4(center, 1.0f);
+    const glm::vec4 axisX = m_viewProjection[0] * extents.x;
+    const glm::vec4 axisY = m_viewProjection[1] * extents.y;
+    const glm::vec4 axisZ = m_viewProjection[2] * extents.z;
+
+    float clipX[8], clipY[8], clipZ[8], clipW[8];
+    for (int i = 0; i < 8; ++i) {
+        clipX[i] = clipCenter.x + kSignX[i] * axisX.x + kSignY[i] * axisY.x + kSignZ[i] * axisZ.x;
+        clipY[i] = clipCenter.y + kSignX[i] * axisX.y + kSignY[i] * axisY.y + kSignZ[i] * axisZ.y;
+        clipZ[i] = clipCenter.z + kSignX[i] * axisX.z + kSignY[i] * axisY.z + kSignZ[i] * axisZ.z;
+        clipW[i] = clipCenter.w + kSignX[i] * axisX.w + kSignY[i] * axisY.w + kSignZ[i] * axisZ.w;
+    }
+
+    bool crossesNear = false;
+    glm::vec2 screenMin(std::numeric_limits<float>::max());
+    glm::vec2 screenMax(-std::numeric_limits<float>::max());
+    float nearest = std::numeric_limits<float>::max();
+    for (int i = 0; i < 8; ++i) {
+        crossesNear |= clipW[i] <= 1e-6f || clipZ[i] < -clipW[i];
+        const float inverseW = 1.0f / clipW[i];
+        screenMin.x = std::min(screenMin.x, clipX[i] * inverseW);
+        screenMin.y = std::min(screenMin.y, clipY[i] * inverseW);
+        screenMax.x = std::max(screenMax.x, clipX[i] * inverseW);
+        screenMax.y = std::max(screenMax.y, clipY[i] * inverseW);
+        nearest = std::min(nearest, clipZ[i] * inverseW);
+    }
+    // 穿过近平面时投影无意义，保守地视为可见
+    if (crossesNear) {
+        return true;
+    }
+    nearest = nearest * 0.5f + 0.5f;
+
+    // 覆盖的像素范围，向外扩展一个纹素
+    const int x0 = static_cast<int>(std::floor((screenMin.x * 0.5f + 0.5f) * m_width)) - 1;
+    const int x1 = static_cast<int>(std::floor((screenMax.x * 0.5f + 0.5f) * m_width)) + 1;
+    const int y0 = static_cast<int>(std::floor((screenMin.y * 0.5f + 0.5f) * m_height)) - 1;
+    const int y1 = static_cast<int>(std::floor((screenMax.y * 0.5f + 0.5f) * m_height)) + 1;
+    if (x1 < 0 || y1 < 0 || x0 >= m_width || y0 >= m_height) {
+        return true;    // 屏幕外由视锥剔除负责
+    }
+    const int clampedX0 = std::max(0, x0);
+    const int clampedX1 = std::min(m_width - 1, x1);
+    const int clampedY0 = std::max(0, y0);
+    const int clampedY1 = std::min(m_height - 1, y1);
+
+    // 选择使矩形最多覆盖 2x2 个纹素的层级
+    size_t levelIndex = 0;
+    while (levelIndex + 1 < m_levels.size() &&
+           ((clampedX1 >> levelIndex) - (clampedX0 >> levelIndex) > 1 ||
+            (clampedY1 >> levelIndex) - (clampedY0 >> levelIndex) > 1)) {
+        ++levelIndex;
+    }
+    const Level& level = m_levels[levelIndex];
+    const int tx0 = std::min(clampedX0 >> levelIndex, level.width - 1);
+    const int tx1 = std::min(clampedX1 >> levelIndex, level.width - 1);
+    const int ty0 = std::min(clampedY0 >> levelIndex, level.height - 1);
+    const int ty1 = std::min(clampedY1 >> levelIndex, level.height - 1);
+
+    float farthest = 0.0f;
+    for (int y = ty0; y <= ty1; ++y) {
+        for (int x = tx0; x <= tx1; ++x) {
+            farthest = std::max(farthest, level.depth[static_cast<size_t>(y) * level.width + x]);
+        }
+    }
+    return nearest <= farthest;
+}
+
+size_t OcclusionCuller::cull(const CullingBounds& bounds, std::vector<uint32_t>& visible) {
+    const auto start = Clock::now();
+    size_t written = 0;
+    for (uint32_t index : visible) {
+        const glm::vec3 center(bounds.centerX()[index], bounds.centerY()[index], bounds.centerZ()[index]);
+        const glm::vec3 extents(bounds.extentX()[index], bounds.extentY()[index], bounds.extentZ()[index]);
+        if (isVisible(center, extents)) {
+            visible[written++] = index;
+        }
+    }
+    const size_t removed = visible.size() - written;
+    m_stats.tested += visible.size();
+    m_stats.occluded += removed;
+    visible.resize(written);
+    m_stats.testMs += elapsedMs(start);
+    return removed;
+}
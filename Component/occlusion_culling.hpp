@@ -0,0 +1,135 @@
+// occlusion_culling.hpp
+// 单一职责: CPU遮挡剔除 - 遮挡体三角形在工作线程上软件光栅化为低分辨率深度 (SSE/NEON)，构建 Hi-Z 金字塔并测试对象包围盒
+#pragma once
+#include "frustum_culling.hpp"
+
+#include <glm/glm.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct OcclusionSettings {
+    int width = 256;            // 深度缓冲分辨率 (取4的倍数)
+    int height = 128;
+    int threads = -1;           // 工作线程数 (不含调用线程)，-1 = 硬件线程数 - 1，最多 kMaxThreads
+    bool simd = true;           // false 强制标量光栅化 (用于比对)
+
+    static constexpr int kMaxThreads = 7;
+};
+
+struct OcclusionStats {
+    size_t occluderTriangles = 0;   // 提交的遮挡体三角形
+    size_t rasterTriangles = 0;     // 近平面裁剪后实际光栅化的三角形
+    size_t tested = 0;
+    size_t occluded = 0;
+    unsigned threads = 0;           // 参与光栅化的线程 (含调用线程)
+    double rasterMs = 0.0;
+    double pyramidMs = 0.0;
+    double testMs = 0.0;
+};
+
+/**
+ * @brief OcclusionCuller类 - 每帧: 提交遮挡体 → 光栅化 → 测试包围盒
+ *
+ * 使用方式:
+ *   OcclusionCuller occlusion;
+ *   occlusion.beginFrame(projection * view);
+ *   occlusion.addOccluder(positions, vertexCount, indices, indexCount, model);   // 遮挡体 (墙、地形等大物体)
+ *   occlusion.rasterize();                       // 按行带分给工作线程
+ *   occlusion.cull(bounds, visible);             // 在视锥剔除的结果上再去掉被遮挡的对象
+ *
+ * 深度为 NDC 深度映射到 [0,1] (0 = 近平面)，清除值为 1。Hi-Z 第 k 级的每个纹素
+ * 保存第 0 级对应 2^k x 2^k 区域的最远深度，包围盒最近深度比它更远即被完全遮挡。
+ *
+ * 确定性: 每个像素由固定的行带负责，像素深度只取决于像素中心处的直接求值 (不做增量步进)，
+ * 结果与线程数、SIMD/标量路径无关。不依赖GL，可在没有GPU的环境中测试。
+ * 遮挡体按像素中心采样覆盖，测试时包围盒的屏幕矩形向外扩展一个纹素，抵消边缘的半像素误差。
+ */
+class OcclusionCuller {
+public:
+    explicit OcclusionCuller(const OcclusionSettings& settings = OcclusionSettings());
+    ~OcclusionCuller();
+
+    // 禁止拷贝
+    OcclusionCuller(const OcclusionCuller&) = delete;
+    OcclusionCuller& operator=(const OcclusionCuller&) = delete;
+
+    /**
+     * @brief 开始新的一帧，清空遮挡体
+     */
+    void beginFrame(const glm::mat4& viewProjection);
+
+    /**
+     * @brief 提交遮挡体网格 (在调用线程上变换到裁剪空间)
+     * @param indices 为空时按三角形列表读取顶点；双面，不做背面剔除
+     */
+    void addOccluder(const glm::vec3* positions, size_t vertexCount, const uint32_t* indices, size_t indexCount,
+                     const glm::mat4& model);
+
+    /**
+     * @brief 光栅化全部遮挡体并构建 Hi-Z 金字塔 (阻塞直到完成)
+     */
+    void rasterize();
+
+    /**
+     * @brief 世界空间 AABB 是否可能可见 (穿过近平面的包围盒总是可见)
+     */
+    bool isVisible(const glm::vec3& center, const glm::vec3& extents) const;
+
+    /**
+     * @brief 从 visible 中移除被遮挡的对象 (保持顺序)，返回移除的数量
+     */
+    size_t cull(const CullingBounds& bounds, std::vector<uint32_t>& visible);
+
+    int width() const { return m_width; }
+    int height() const { return m_height; }
+    int levelCount() const { return static_cast<int>(m_levels.size()); }
+    // 第 level 级深度，行优先、第0行在底部 (与 NDC y 方向一致)
+    const std::vector<float>& level(int index) const { return m_levels[index].depth; }
+    const OcclusionStats& stats() const { return m_stats; }
+
+private:
+    struct Level {
+        int width = 0;
+        int height = 0;
+        std::vector<float> depth;
+    };
+
+    // 屏幕空间三角形: 像素坐标 + [0,1] 深度
+    struct Triangle {
+        glm::vec3 v[3];
+    };
+
+    void clipAndAdd(const glm::vec4& a, const glm::vec4& b, const glm::vec4& c);
+    void addScreenTriangle(const glm::vec4& a, const glm::vec4& b, const glm::vec4& c);
+    void rasterizeBand(int band);
+    void buildPyramid();
+    void runBands();
+    void workerMain();
+
+    int m_width;
+    int m_height;
+    bool m_simd;
+    glm::mat4 m_viewProjection;
+    std::vector<Triangle> m_triangles;
+    std::vector<glm::vec4> m_clipScratch;
+    std::vector<Level> m_levels;
+    OcclusionStats m_stats;
+
+    // 行带分发: 调用线程与工作线程从 m_nextBand 抢占行带
+    int m_bandCount;
+    int m_bandHeight;
+    std::vector<std::thread> m_threads;
+    std::mutex m_mutex;
+    std::condition_variable m_wakeup;
+    std::condition_variable m_finished;
+    uint64_t m_generation;
+    int m_activeWorkers;
+    bool m_stopping;
+    std::atomic<int> m_nextBand;
+};
@@ -0,0 +1,50 @@
+// placeholder_shader.hpp
+// 单一职责: 正式着色器异步编译期间使用的纯色占位程序 (只依赖位置属性与 FrameBlock)
+#pragma once
+#include "shader.hpp"
+#include "frame_uniforms.hpp"
+
+#ifdef __ANDROID__
+    #include <common/placeholder.vert.es.h>
+    #include <common/placeholder.frag.es.h>
+#else
+    #include <common/placeholder.vert.core.h>
+    #include <common/placeholder.frag.core.h>
+#endif
+
+/**
+ * 程序极小，同步编译的开销可以忽略；顶点布局只要求 location 0 为 vec3 位置，
+ * 因此任何渲染器都可以直接用自己的 VAO 绘制占位几何体。
+ */
+class PlaceholderShader {
+public:
+    bool create() {
+        if (!m_shader.loadFromSource(PLACEHOLDER_VERTEX_SHADER, PLACEHOLDER_FRAGMENT_SHADER)) {
+            return false;
+        }
+        if (!m_shader.bindUniformBlock("FrameBlock", UniformBinding::Frame, sizeof(FrameUniforms))) {
+            return false;
+        }
+        m_modelUniform = m_shader.uniformHandle("model");
+        return true;
+    }
+
+    void use(const glm::mat4& model) const {
+        m_shader.use();
+        m_shader.setMat4(m_modelUniform, model);
+    }
+
+    void unuse() const { m_shader.unuse(); }
+
+    // RenderQueue 提交需要的程序与 model 位置
+    GLuint programId() const { return m_shader.programId(); }
+    GLint modelLocation() const { return m_modelUniform.location; }
+
+    void release() { m_shader.release(); }
+
+    std::string lastError() const { return m_shader.lastError(); }
+
+private:
+    Shader m_shader;
+    UniformHandle m_modelUniform;
+};
@@ -0,0 +1,199 @@
+#include "headless_context.hpp"
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+namespace {
+
+bool hasExtension(const char* extensions, const char* name) {
+    if (!extensions) {
+        return false;
+    }
+    // 扩展列表以空格分隔，需要整词匹配
+    const size_t length = std::strlen(name);
+    const char* p = extensions;
+    while ((p = std::strstr(p, name)) != nullptr) {
+        const bool startOk = (p == extensions) || (p[-1] == ' ');
+        const bool endOk = (p[length] == ' ') || (p[length] == '\0');
+        if (startOk && endOk) {
+            return true;
+        }
+        p += length;
+    }
+    return false;
+}
+
+} // namespace
+
+HeadlessContext::HeadlessContext()
+    : m_display(EGL_NO_DISPLAY)
+    , m_surface(EGL_NO_SURFACE)
+    , m_context(EGL_NO_CONTEXT)
+{
+}
+
+HeadlessContext::~HeadlessContext() {
+    destroy();
+}
+
+bool HeadlessContext::create(int majorVersion, int minorVersion) {
+    destroy();
+
+    if (!acquireDisplay()) {
+        return false;
+    }
+
+    EGLint eglMajor = 0, eglMinor = 0;
+    if (!eglInitialize(m_display, &eglMajor, &eglMinor)) {
+        return setError("eglInitialize failed");
+    }
+    std::cout << "EGL Version: " << eglMajor << "." << eglMinor << std::endl;
+
+#ifdef __ANDROID__
+    const EGLenum api = EGL_OPENGL_ES_API;
+#else
+    const EGLenum api = EGL_OPENGL_API;
+#endif
+    if (!eglBindAPI(api)) {
+        return setError("eglBindAPI failed");
+    }
+
+    const bool surfaceless = hasExtension(eglQueryString(m_display, EGL_EXTENSIONS), "EGL_KHR_surfaceless_context");
+
+    // surfaceless 时不要求配置支持 pbuffer（部分驱动的无头配置没有任何表面类型）
+    EGLConfig config = nullptr;
+    if (!chooseConfig(true, config)) {
+        if (!surfaceless || !chooseConfig(false, config)) {
+            return setError("eglChooseConfig found no matching config");
+        }
+    }
+
+    const EGLint contextAttribs[] = {
+        EGL_CONTEXT_MAJOR_VERSION, majorVersion,
+        EGL_CONTEXT_MINOR_VERSION, minorVersion,
+#ifndef __ANDROID__
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+#endif
+        EGL_NONE
+    };
+    m_context = eglCreateContext(m_display, config, EGL_NO_CONTEXT, contextAttribs);
+    if (m_context == EGL_NO_CONTEXT) {
+        return setError("eglCreateContext failed");
+    }
+
+    if (!surfaceless) {
+        // 仅为满足 eglMakeCurrent 的要求，真正的渲染目标是FBO
+        const EGLint pbufferAttribs[] = {
+            EGL_WIDTH, 1,
+            EGL_HEIGHT, 1,
+            EGL_NONE
+        };
+        m_surface = eglCreatePbufferSurface(m_display, config, pbufferAttribs);
+        if (m_surface == EGL_NO_SURFACE) {
+            return setError("eglCreatePbufferSurface failed");
+        }
+    }
+
+    if (!makeCurrent()) {
+        return false;
+    }
+
+    std::cout << "Headless EGL context created (" << (isSurfaceless() ? "surfaceless" : "pbuffer") << ")" << std::endl;
+    return true;
+}
+
+bool HeadlessContext::makeCurrent() {
+    if (!eglMakeCurrent(m_display, m_surface, m_surface, m_context)) {
+        return setError("eglMakeCurrent failed");
+    }
+    return true;
+}
+
+void HeadlessContext::destroy() {
+    if (m_display == EGL_NO_DISPLAY) {
+        return;
+    }
+
+    eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+
+    if (m_context != EGL_NO_CONTEXT) {
+        eglDestroyContext(m_display, m_context);
+        m_context = EGL_NO_CONTEXT;
+    }
+    if (m_surface != EGL_NO_SURFACE) {
+        eglDestroySurface(m_display, m_surface);
+        m_surface = EGL_NO_SURFACE;
+    }
+
+    eglTerminate(m_display);
+    m_display = EGL_NO_DISPLAY;
+}
+
+void* HeadlessContext::getProcAddress(const char* name) {
+    return reinterpret_cast<void*>(eglGetProcAddress(name));
+}
+
+bool HeadlessContext::acquireDisplay() {
+    // 客户端扩展需要以 EGL_NO_DISPLAY 查询
+    const char* clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+
+    auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+        eglGetProcAddress("eglGetPlatformDisplayEXT"));
+
+    if (getPlatformDisplay) {
+        if (hasExtension(clientExtensions, "EGL_MESA_platform_surfaceless")) {
+            m_display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+            if (m_display != EGL_NO_DISPLAY) {
+                return true;
+            }
+        }
+
+        if (hasExtension(clientExtensions, "EGL_EXT_platform_device")) {
+            auto queryDevices = reinterpret_cast<PFNEGLQUERYDEVICESEXTPROC>(
+                eglGetProcAddress("eglQueryDevicesEXT"));
+            EGLDeviceEXT device = nullptr;
+            EGLint numDevices = 0;
+            if (queryDevices && queryDevices(1, &device, &numDevices) && numDevices > 0) {
+                m_display = getPlatformDisplay(EGL_PLATFORM_DEVICE_EXT, device, nullptr);
+                if (m_display != EGL_NO_DISPLAY) {
+                    return true;
+                }
+            }
+        }
+    }
+
+    m_display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    if (m_display == EGL_NO_DISPLAY) {
+        return setError("No EGL display available");
+    }
+    return true;
+}
+
+bool HeadlessContext::chooseConfig(bool requirePbuffer, EGLConfig& config) {
+#ifdef __ANDROID__
+    const EGLint renderableType = EGL_OPENGL_ES3_BIT_KHR;
+#else
+    const EGLint renderableType = EGL_OPENGL_BIT;
+#endif
+
+    const EGLint configAttribs[] = {
+        EGL_SURFACE_TYPE, requirePbuffer ? EGL_PBUFFER_BIT : EGL_DONT_CARE,
+        EGL_RENDERABLE_TYPE, renderableType,
+        EGL_RED_SIZE, 8,
+        EGL_GREEN_SIZE, 8,
+        EGL_BLUE_SIZE, 8,
+        EGL_ALPHA_SIZE, 8,
+        EGL_NONE
+    };
+
+    EGLint numConfigs = 0;
+    return eglChooseConfig(m_display, configAttribs, &config, 1, &numConfigs) && numConfigs > 0;
+}
+
+bool HeadlessContext::setError(const std::string& message) {
+    std::ostringstream oss;
+    oss << message << " (EGL error: 0x" << std::hex << eglGetError() << ")";
+    m_lastError = oss.str();
+    std::cerr << "HeadlessContext: " << m_lastError << std::endl;
+    return false;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include <string>
+
+/**
+ * @brief HeadlessContext类 - 无窗口的EGL OpenGL上下文
+ *
+ * 单一职责: 在没有显示器/合成器的机器上(渲染农场、CI)创建可用的GL上下文
+ *
+ * 显示连接的获取顺序:
+ *   1. EGL_MESA_platform_surfaceless (Mesa llvmpipe / 无DRM节点)
+ *   2. EGL_EXT_platform_device       (NVIDIA等专有驱动的无头设备)
+ *   3. eglGetDisplay(EGL_DEFAULT_DISPLAY)
+ *
+ * 上下文优先以 surfaceless 方式激活 (EGL_KHR_surfaceless_context)，
+ * 不支持时退化为 1x1 的 pbuffer。实际渲染目标由调用方的 Framebuffer(FBO) 提供，
+ * 因此不存在 SwapBuffers/垂直同步节流。
+ */
+class HeadlessContext {
+public:
+    HeadlessContext();
+    ~HeadlessContext();
+
+    // 禁止拷贝
+    HeadlessContext(const HeadlessContext&) = delete;
+    HeadlessContext& operator=(const HeadlessContext&) = delete;
+
+    /**
+     * @brief 创建EGL显示连接与上下文并设为当前
+     * @param majorVersion GL主版本号 (PC: core profile, Android: ES)
+     * @param minorVersion GL次版本号
+     * @return 是否成功（失败原因见 lastError）
+     */
+    bool create(int majorVersion = 3, int minorVersion = 3);
+
+    /**
+     * @brief 将上下文绑定到调用线程
+     */
+    bool makeCurrent();
+
+    /**
+     * @brief 销毁上下文、表面与显示连接
+     */
+    void destroy();
+
+    /**
+     * @brief 供 gladLoadGLLoader 使用的函数指针加载器
+     */
+    static void* getProcAddress(const char* name);
+
+    bool isValid() const { return m_context != EGL_NO_CONTEXT; }
+    bool isSurfaceless() const { return m_surface == EGL_NO_SURFACE; }
+
+    EGLDisplay display() const { return m_display; }
+    EGLContext context() const { return m_context; }
+
+    std::string lastError() const { return m_lastError; }
+
+private:
+    bool acquireDisplay();
+    bool chooseConfig(bool requirePbuffer, EGLConfig& config);
+    bool setError(const std::string& message);
+
+private:
+    EGLDisplay m_display;
+    EGLSurface m_surface;
+    EGLContext m_context;
+    std::string m_lastError;
+};
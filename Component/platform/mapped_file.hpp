@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief MappedFile类 - 只读内存映射文件
+ *
+ * 单一职责: 把整个文件映射到进程地址空间，数据由操作系统按页按需换入，
+ * 不经过 read() 拷贝，也不需要一次性分配与文件等大的内存。
+ *
+ * POSIX (Linux/Android/macOS) 使用 mmap；Windows 使用 CreateFileMapping/MapViewOfFile。
+ * 映射在 close() 或析构时解除，之后 data() 返回的指针失效。
+ */
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+
+    // 禁止拷贝，允许移动
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /**
+     * @brief 以只读方式映射整个文件
+     * @return 是否成功（失败原因见 lastError）；空文件视为失败
+     */
+    bool open(const std::string& path);
+
+    void close();
+
+    const uint8_t* data() const { return m_data; }
+    size_t size() const { return m_size; }
+    bool isOpen() const { return m_data != nullptr; }
+
+    std::string lastError() const { return m_lastError; }
+
+private:
+    const uint8_t* m_data;
+    size_t m_size;
+#ifdef _WIN32
+    void* m_fileHandle;
+    void* m_mappingHandle;
+#endif
+    std::string m_lastError;
+};
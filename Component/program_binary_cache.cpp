@@ -0,0 +1,200 @@
+#include "program_binary_cache.hpp"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+namespace {
+
+// 文件格式版本，格式变化时递增使旧条目失效
+constexpr uint32_t kCacheMagic = 0x42504C47;    // "GLPB"
+constexpr uint32_t kCacheVersion = 1;
+
+struct CacheFileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t key;
+    uint32_t binaryFormat;
+    uint32_t binaryLength;
+};
+
+uint64_t fnv1a64(const void* data, size_t length, uint64_t hash = 14695981039346656037ull) {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < length; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+uint64_t hashString(const char* str, uint64_t hash) {
+    if (!str) {
+        return hash;
+    }
+    // 包含结尾的'\0'作为分隔，避免 "ab"+"c" 与 "a"+"bc" 冲突
+    return fnv1a64(str, std::char_traits<char>::length(str) + 1, hash);
+}
+
+} // namespace
+
+ProgramBinaryCache::ProgramBinaryCache(const std::string& directory) {
+    setDirectory(directory);
+}
+
+void ProgramBinaryCache::setDirectory(const std::string& directory) {
+    m_directory = directory;
+    if (m_directory.empty()) {
+        return;
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(m_directory, ec);
+    if (ec) {
+        std::cerr << "ProgramBinaryCache: Failed to create directory " << m_directory << ": " << ec.message() << std::endl;
+        m_directory.clear();
+    }
+}
+
+bool ProgramBinaryCache::isEnabled() const {
+    if (m_directory.empty()) {
+        return false;
+    }
+
+#ifndef __ANDROID__
+    // 桌面端 GL 4.1 才引入程序二进制，低版本上下文中函数指针为空
+    if (!glGetProgramBinary || !glProgramBinary || !glProgramParameteri) {
+        return false;
+    }
+#endif
+
+    GLint formatCount = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+    return formatCount > 0;
+}
+
+uint64_t ProgramBinaryCache::computeKey(const std::string& vertexSource, const std::string& fragmentSource) {
+    uint64_t hash = fnv1a64(&kCacheVersion, sizeof(kCacheVersion));
+    hash = hashString(vertexSource.c_str(), hash);
+    hash = hashString(fragmentSource.c_str(), hash);
+    hash = hashString(reinterpret_cast<const char*>(glGetString(GL_RENDERER)), hash);
+    hash = hashString(reinterpret_cast<const char*>(glGetString(GL_VERSION)), hash);
+    return hash;
+}
+
+bool ProgramBinaryCache::load(uint64_t key, GLuint program) {
+    const std::string path = entryPath(key);
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        m_stats.misses++;
+        return false;
+    }
+
+    CacheFileHeader header{};
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    std::vector<char> binary;
+    if (file && header.magic == kCacheMagic && header.version == kCacheVersion && header.key == key) {
+        // 长度来自文件，先与剩余字节数比较，避免损坏的头部请求巨量内存
+        const std::streamoff dataBegin = file.tellg();
+        file.seekg(0, std::ios::end);
+        const std::streamoff remaining = file.tellg() - dataBegin;
+        file.seekg(dataBegin);
+        if (!file || remaining < static_cast<std::streamoff>(header.binaryLength)) {
+            header.binaryLength = 0;
+        }
+        binary.resize(header.binaryLength);
+        file.read(binary.data(), static_cast<std::streamsize>(binary.size()));
+        // 数据截断时按损坏处理
+        if (file.gcount() != static_cast<std::streamsize>(binary.size())) {
+            binary.clear();
+        }
+    }
+    file.close();
+
+    GLint linked = GL_FALSE;
+    if (!binary.empty()) {
+        glProgramBinary(program, header.binaryFormat, binary.data(), static_cast<GLsizei>(binary.size()));
+        glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    }
+
+    if (linked != GL_TRUE) {
+        // 文件损坏或驱动/GPU变化导致二进制不兼容: 删除条目，调用方回退到源码编译
+        m_stats.rejects++;
+        std::remove(path.c_str());
+        std::cerr << "ProgramBinaryCache: Entry rejected, falling back to compile: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool ProgramBinaryCache::store(uint64_t key, GLuint program) {
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) {
+        return false;
+    }
+
+    std::vector<char> binary(static_cast<size_t>(length));
+    GLenum format = 0;
+    GLsizei written = 0;
+    glGetProgramBinary(program, length, &written, &format, binary.data());
+    if (written <= 0) {
+        return false;
+    }
+
+    CacheFileHeader header{};
+    header.magic = kCacheMagic;
+    header.version = kCacheVersion;
+    header.key = key;
+    header.binaryFormat = format;
+    header.binaryLength = static_cast<uint32_t>(written);
+
+    // 先写临时文件再重命名，避免进程中断留下半个条目
+    const std::string path = entryPath(key);
+    const std::string tempPath = path + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(binary.data(), written);
+        if (!file.good()) {
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec) {
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+
+    m_stats.stores++;
+    return true;
+}
+
+void ProgramBinaryCache::recordHit(double ms) {
+    m_stats.hits++;
+    m_stats.hitMs += ms;
+}
+
+void ProgramBinaryCache::recordMiss(double ms) {
+    m_stats.missMs += ms;
+}
+
+std::string ProgramBinaryCache::statsString() const {
+    std::ostringstream oss;
+    oss << "Program cache: " << m_stats.hits << " hits (" << m_stats.hitMs << " ms), "
+        << m_stats.misses << " misses, " << m_stats.rejects << " rejected, "
+        << "compile " << m_stats.missMs << " ms, " << m_stats.stores << " stored";
+    return oss.str();
+}
+
+std::string ProgramBinaryCache::entryPath(uint64_t key) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.glbin", static_cast<unsigned long long>(key));
+    return (std::filesystem::path(m_directory) / name).string();
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+// 平台条件编译：OpenGL ES (Android) vs OpenGL Core (PC)
+#ifdef __ANDROID__
+    #include <GLES3/gl3.h>
+    #include <GLES3/gl3ext.h>
+#else
+    #include <glad/glad.h>
+#endif
+
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief 程序二进制缓存的统计信息
+ */
+struct ProgramCacheStats {
+    uint32_t hits = 0;          // 从磁盘加载成功
+    uint32_t misses = 0;        // 无缓存条目，走完整编译
+    uint32_t rejects = 0;       // 有条目但被驱动拒绝 (驱动升级等)，回退编译
+    uint32_t stores = 0;        // 写入磁盘的条目数
+    double hitMs = 0.0;         // 命中路径累计耗时
+    double missMs = 0.0;        // 编译路径累计耗时 (含拒绝后的重新编译)
+};
+
+/**
+ * @brief ProgramBinaryCache类 - 基于 glGetProgramBinary/glProgramBinary 的磁盘缓存
+ *
+ * 单一职责: 按 (源码, GL_RENDERER, GL_VERSION) 的哈希存取已链接的程序二进制
+ *
+ * 每个条目一个文件 <目录>/<key>.glbin，文件头中再次记录 key 防止误用。
+ * 驱动拒绝二进制 (glProgramBinary 后链接状态为失败) 时删除条目，由调用方回退到源码编译。
+ * 使用方式: 创建后调用 Shader::setProgramCache(&cache)，之后所有 Shader::loadFromSource 自动走缓存。
+ */
+class ProgramBinaryCache {
+public:
+    explicit ProgramBinaryCache(const std::string& directory = "");
+
+    ProgramBinaryCache(const ProgramBinaryCache&) = delete;
+    ProgramBinaryCache& operator=(const ProgramBinaryCache&) = delete;
+
+    /**
+     * @brief 设置缓存目录 (不存在时自动创建)，为空则禁用
+     */
+    void setDirectory(const std::string& directory);
+    const std::string& directory() const { return m_directory; }
+
+    /**
+     * @brief 目录有效且当前上下文支持程序二进制时返回true (需要有效的GL上下文)
+     */
+    bool isEnabled() const;
+
+    /**
+     * @brief 计算缓存键: 着色器源码 + GL_RENDERER + GL_VERSION 的64位FNV-1a哈希
+     */
+    static uint64_t computeKey(const std::string& vertexSource, const std::string& fragmentSource);
+
+    /**
+     * @brief 尝试把缓存的二进制加载到program
+     * @return 加载且链接成功返回true；条目不存在或被拒绝返回false
+     */
+    bool load(uint64_t key, GLuint program);
+
+    /**
+     * @brief 保存已链接程序的二进制 (链接前需设置 GL_PROGRAM_BINARY_RETRIEVABLE_HINT)
+     */
+    bool store(uint64_t key, GLuint program);
+
+    void recordHit(double ms);
+    void recordMiss(double ms);
+
+    const ProgramCacheStats& stats() const { return m_stats; }
+    std::string statsString() const;
+
+private:
+    std::string entryPath(uint64_t key) const;
+
+private:
+    std::string m_directory;
+    ProgramCacheStats m_stats;
+};
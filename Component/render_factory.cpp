@@ -0,0 +1,100 @@
+#include "render_factory.hpp"
+#include "renderers/triangle_render.hpp"
+#include "renderers/cube_render.hpp"
+#include "renderers/mesh_render.hpp"
+#include "renderers/batch_render.hpp"
+
+#include <algorithm>
+#include <utility>
+
+// ============ 注册表 ============
+
+std::vector<RendererDescriptor>& RenderFactory::registry() {
+    // 函数内静态: 避免静态初始化顺序问题，第一次访问时注册内置渲染器
+    static std::vector<RendererDescriptor> descriptors = {
+        {
+            "triangle",
+            []() -> std::unique_ptr<IRenderer> { return std::make_unique<TriangleRender>(); },
+            []() -> std::unique_ptr<IRenderConfig> { return std::make_unique<TriangleConfig>(); },
+        },
+        {
+            "cube",
+            []() -> std::unique_ptr<IRenderer> { return std::make_unique<CubeRender>(); },
+            []() -> std::unique_ptr<IRenderConfig> { return std::make_unique<CubeConfig>(); },
+        },
+        {
+            "mesh",
+            []() -> std::unique_ptr<IRenderer> { return std::make_unique<MeshRender>(); },
+            []() -> std::unique_ptr<IRenderConfig> { return std::make_unique<MeshConfig>(); },
+        },
+        {
+            "batch",
+            []() -> std::unique_ptr<IRenderer> { return std::make_unique<BatchRender>(); },
+            []() -> std::unique_ptr<IRenderConfig> { return std::make_unique<BatchConfig>(); },
+        },
+    };
+    return descriptors;
+}
+
+const RendererDescriptor* RenderFactory::find(const std::string& typeName) {
+    const std::vector<RendererDescriptor>& descriptors = registry();
+    auto it = std::find_if(descriptors.begin(), descriptors.end(),
+                           [&](const RendererDescriptor& d) { return d.name == typeName; });
+    return it != descriptors.end() ? &*it : nullptr;
+}
+
+void RenderFactory::registerRenderer(RendererDescriptor descriptor) {
+    std::vector<RendererDescriptor>& descriptors = registry();
+    for (RendererDescriptor& existing : descriptors) {
+        if (existing.name == descriptor.name) {
+            existing = std::move(descriptor);
+            return;
+        }
+    }
+    descriptors.push_back(std::move(descriptor));
+}
+
+bool RenderFactory::isRegistered(const std::string& typeName) {
+    return find(typeName) != nullptr;
+}
+
+std::vector<std::string> RenderFactory::registeredNames() {
+    std::vector<std::string> names;
+    for (const RendererDescriptor& descriptor : registry()) {
+        names.push_back(descriptor.name);
+    }
+    return names;
+}
+
+// ============ 创建 ============
+
+std::unique_ptr<IRenderer> RenderFactory::create(RenderType type) {
+    switch (type) {
+    case RenderType::Triangle:
+        return create("triangle");
+    case RenderType::Cube:
+        return create("cube");
+    case RenderType::Mesh:
+        return create("mesh");
+    case RenderType::Batch:
+        return create("batch");
+    default:
+        return nullptr;
+    }
+}
+
+std::unique_ptr<IRenderer> RenderFactory::create(const std::string& typeName) {
+    const RendererDescriptor* descriptor = find(typeName);
+    if (!descriptor || !descriptor->createRenderer) {
+        return nullptr;
+    }
+    return descriptor->createRenderer();
+}
+
+std::unique_ptr<IRenderConfig> RenderFactory::createConfig(const std::string& typeName) {
+    const RendererDescriptor* descriptor = find(typeName);
+    if (!descriptor || !descriptor->createConfig) {
+        return nullptr;
+    }
+    return descriptor->createConfig();
+}
@@ -1,57 +1,58 @@
+// render_factory.hpp
+// 单一职责: 运行时渲染器注册表 - 按名称创建渲染器及其默认配置
 #pragma once
 #include "irenderer.hpp"
-#include <memory>
-
-// 根据编译宏包含对应的渲染器
-#ifdef USE_TRIANGLE_RENDER
-    #include "triangle_render.hpp"
-#endif
+#include "irender_config.hpp"
 
-#ifdef USE_CUBE_RENDER
-    #include "cube_render.hpp"
-#endif
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
 
 enum class RenderType {
     Triangle,
     Cube,
+    Mesh,
+    Batch,
+};
+
+/**
+ * @brief 注册表中的一项: 名称 + 渲染器构造 + 默认配置构造
+ */
+struct RendererDescriptor {
+    std::string name;
+    std::function<std::unique_ptr<IRenderer>()> createRenderer;
+    std::function<std::unique_ptr<IRenderConfig>()> createConfig;
 };
 
+/**
+ * @brief RenderFactory - 所有渲染器始终编译进同一个二进制，运行时按名称选择
+ *
+ * 内置渲染器 ("triangle"、"cube") 在第一次访问注册表时注册；
+ * 新渲染器调用 registerRenderer() 即可被 main/benchmark/RenderPipeline 按名称使用。
+ */
 class RenderFactory {
 public:
-    static std::unique_ptr<IRenderer> create(RenderType type) {
-        switch (type) {
-        #ifdef USE_TRIANGLE_RENDER
-        case RenderType::Triangle:
-            return std::make_unique<TriangleRender>();
-        #endif
-        
-        #ifdef USE_CUBE_RENDER
-        case RenderType::Cube:
-            return std::make_unique<CubeRender>();
-        #endif
-        
-        default:
-            return nullptr;
-        }
-    }
-
-    static std::unique_ptr<IRenderer> create(const std::string& typeName) {
-        #ifdef USE_TRIANGLE_RENDER
-        if (typeName == "triangle") {
-            return create(RenderType::Triangle);
-        }
-        #endif
-        
-        #ifdef USE_CUBE_RENDER
-        if (typeName == "cube") {
-            return create(RenderType::Cube);
-        }
-        #endif
-        
-        return nullptr;
-    }
+    /**
+     * @brief 注册 (或替换同名) 渲染器
+     */
+    static void registerRenderer(RendererDescriptor descriptor);
+
+    static bool isRegistered(const std::string& typeName);
+    static std::vector<std::string> registeredNames();
+
+    static std::unique_ptr<IRenderer> create(RenderType type);
+    static std::unique_ptr<IRenderer> create(const std::string& typeName);
+
+    /**
+     * @brief 创建该渲染器的默认配置 (未注册返回 nullptr)
+     */
+    static std::unique_ptr<IRenderConfig> createConfig(const std::string& typeName);
 
 private:
+    static std::vector<RendererDescriptor>& registry();
+    static const RendererDescriptor* find(const std::string& typeName);
+
     RenderFactory() = delete;
     RenderFactory(const RenderFactory&) = delete;
     RenderFactory& operator=(const RenderFactory&) = delete;
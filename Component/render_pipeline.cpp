@@ -0,0 +1,309 @@
+#include "render_pipeline.hpp"
+#include "render_factory.hpp"
+#include "job_system.hpp"
+
+#ifdef __ANDROID__
+    #include <GLES3/gl3.h>
+#else
+    #include <glad/glad.h>
+#endif
+
+#include <algorithm>
+#include <utility>
+
+RenderPipeline::~RenderPipeline() {
+    cleanup();
+}
+
+// ============ 构建 ============
+
+RenderPass& RenderPipeline::addPass(const std::string& name, int order, bool clearDepth) {
+    if (RenderPass* existing = findPass(name)) {
+        return *existing;
+    }
+
+    RenderPass pass;
+    pass.name = name;
+    pass.order = order;
+    pass.clearDepth = clearDepth;
+    m_passes.push_back(std::move(pass));
+
+    std::stable_sort(m_passes.begin(), m_passes.end(),
+                     [](const RenderPass& a, const RenderPass& b) { return a.order < b.order; });
+    return *findPass(name);
+}
+
+RenderPass* RenderPipeline::findPass(const std::string& name) {
+    for (RenderPass& pass : m_passes) {
+        if (pass.name == name) {
+            return &pass;
+        }
+    }
+    return nullptr;
+}
+
+bool RenderPipeline::addRenderer(const std::string& passName, std::unique_ptr<IRenderer> renderer, const IRenderConfig& config) {
+    if (!renderer) {
+        m_lastError = "Null renderer for pass " + passName;
+        return false;
+    }
+
+    if (m_errorCallback) {
+        renderer->setErrorCallback(m_errorCallback);
+    }
+    if (!renderer->initialize(config)) {
+        m_lastError = "Failed to initialize " + renderer->getName();
+        return false;
+    }
+
+    if (!m_hasClearColor) {
+        m_clearColor = config.clearColor();
+        m_hasClearColor = true;
+    }
+
+    RenderPass* pass = findPass(passName);
+    if (!pass) {
+        const int order = m_passes.empty() ? 0 : m_passes.back().order + 1;
+        pass = &addPass(passName, order);
+    }
+    pass->renderers.push_back(std::move(renderer));
+    return true;
+}
+
+bool RenderPipeline::addRenderer(const std::string& passName, const std::string& typeName) {
+    std::unique_ptr<IRenderer> renderer = RenderFactory::create(typeName);
+    std::unique_ptr<IRenderConfig> config = RenderFactory::createConfig(typeName);
+    if (!renderer || !config) {
+        m_lastError = "Unknown renderer: " + typeName;
+        return false;
+    }
+    return addRenderer(passName, std::move(renderer), *config);
+}
+
+std::vector<std::vector<std::string>> RenderPipeline::parseSpec(const std::string& spec) {
+    std::vector<std::vector<std::string>> passes(1);
+    std::string name;
+
+    auto flushName = [&]() {
+        if (!name.empty()) {
+            passes.back().push_back(name);
+            name.clear();
+        }
+    };
+
+    for (char c : spec) {
+        if (c == ',') {
+            flushName();
+        } else if (c == '/') {
+            flushName();
+            passes.emplace_back();
+        } else if (c != ' ') {
+            name += c;
+        }
+    }
+    flushName();
+
+    // 空 pass ("cube//triangle") 没有意义，直接丢弃
+    passes.erase(std::remove_if(passes.begin(), passes.end(),
+                                [](const std::vector<std::string>& names) { return names.empty(); }),
+                 passes.end());
+    return passes;
+}
+
+bool RenderPipeline::addFromSpec(const std::string& spec) {
+    const std::vector<std::vector<std::string>> passes = parseSpec(spec);
+    if (passes.empty()) {
+        m_lastError = "Empty renderer spec";
+        return false;
+    }
+
+    const int baseOrder = m_passes.empty() ? 0 : m_passes.back().order + 1;
+    for (size_t i = 0; i < passes.size(); ++i) {
+        const std::string passName = "pass" + std::to_string(m_passes.size());
+        addPass(passName, baseOrder + static_cast<int>(i), i > 0);
+        for (const std::string& typeName : passes[i]) {
+            if (!addRenderer(passName, typeName)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// ============ 每帧 ============
+
+bool RenderPipeline::render(const RenderContext& context) {
+    m_stats = RenderQueueStats();
+    m_listStats = CommandListStats();
+
+    glClearColor(m_clearColor.x, m_clearColor.y, m_clearColor.z, m_clearColor.w);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    bool ok = true;
+    bool firstPass = true;
+    for (RenderPass& pass : m_passes) {
+        if (pass.clearDepth && !firstPass) {
+            glClear(GL_DEPTH_BUFFER_BIT);
+        }
+        firstPass = false;
+
+        recordCommandLists(pass, context);
+
+        m_queue.clear();
+        for (size_t i = 0; i < pass.renderers.size(); ++i) {
+            const std::unique_ptr<IRenderer>& renderer = pass.renderers[i];
+            if (m_listUsed[i]) {
+                ok = m_listOk[i] && ok;
+                m_commandLists[i]->replay(m_queue);
+            } else if (renderer->usesRenderQueue()) {
+                ok = renderer->record(context, m_queue) && ok;
+            } else {
+                // 保持 pass 内的相对顺序: 先提交已记录的命令
+                submitQueue();
+                ok = renderer->render(context) && ok;
+            }
+        }
+        submitQueue();
+    }
+    return ok;
+}
+
+void RenderPipeline::recordCommandLists(RenderPass& pass, const RenderContext& context) {
+    const size_t count = pass.renderers.size();
+    while (m_commandLists.size() < count) {
+        m_commandLists.push_back(std::unique_ptr<CommandList>(new CommandList()));
+    }
+    m_listUsed.assign(count, 0);
+    m_listOk.assign(count, 1);
+
+    size_t recorded = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (pass.renderers[i]->usesCommandList()) {
+            m_listUsed[i] = 1;
+            recorded++;
+        }
+    }
+    if (recorded == 0) {
+        return;
+    }
+
+    // 每个渲染器只写自己的列表；渲染器内部还可以再用 parallelFor 分段
+    auto record = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            if (m_listUsed[i]) {
+                CommandList& list = *m_commandLists[i];
+                list.reset();
+                m_listOk[i] = pass.renderers[i]->recordCommands(context, list) ? 1 : 0;
+            }
+        }
+    };
+    JobSystem* jobs = m_parallelRecording ? JobSystem::active() : nullptr;
+    if (jobs && recorded > 1) {
+        jobs->parallelFor(count, 1, record);
+    } else {
+        record(0, count);
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        if (m_listUsed[i]) {
+            const CommandListStats stats = m_commandLists[i]->stats();
+            m_listStats.commands += stats.commands;
+            m_listStats.draws += stats.draws;
+            m_listStats.uploadBytes += stats.uploadBytes;
+            m_listStats.usedBytes += stats.usedBytes;
+            m_listStats.capacityBytes += stats.capacityBytes;
+        }
+    }
+}
+
+void RenderPipeline::submitQueue() {
+    if (m_queue.empty()) {
+        return;
+    }
+    m_queue.sort();
+    m_queue.submit();
+    accumulateStats();
+    m_queue.clear();
+}
+
+void RenderPipeline::accumulateStats() {
+    const RenderQueueStats& stats = m_queue.lastStats();
+    m_stats.commands += stats.commands;
+    m_stats.programSwitches += stats.programSwitches;
+    m_stats.vertexArraySwitches += stats.vertexArraySwitches;
+    m_stats.textureSwitches += stats.textureSwitches;
+}
+
+bool RenderPipeline::resize(int width, int height) {
+    bool ok = true;
+    for (RenderPass& pass : m_passes) {
+        for (const std::unique_ptr<IRenderer>& renderer : pass.renderers) {
+            ok = renderer->resize(width, height) && ok;
+        }
+    }
+    return ok;
+}
+
+void RenderPipeline::cleanup() {
+    for (RenderPass& pass : m_passes) {
+        for (const std::unique_ptr<IRenderer>& renderer : pass.renderers) {
+            renderer->cleanup();
+        }
+    }
+    m_passes.clear();
+    m_queue.clear();
+    m_commandLists.clear();
+    m_hasClearColor = false;
+}
+
+// ============ 设置与查询 ============
+
+void RenderPipeline::setErrorCallback(ErrorCallback callback) {
+    m_errorCallback = std::move(callback);
+    for (RenderPass& pass : m_passes) {
+        for (const std::unique_ptr<IRenderer>& renderer : pass.renderers) {
+            renderer->setErrorCallback(m_errorCallback);
+        }
+    }
+}
+
+void RenderPipeline::setClearColor(const glm::vec4& color) {
+    m_clearColor = color;
+    m_hasClearColor = true;
+}
+
+bool RenderPipeline::isReady() const {
+    for (const RenderPass& pass : m_passes) {
+        for (const std::unique_ptr<IRenderer>& renderer : pass.renderers) {
+            if (!renderer->isReady()) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+size_t RenderPipeline::rendererCount() const {
+    size_t count = 0;
+    for (const RenderPass& pass : m_passes) {
+        count += pass.renderers.size();
+    }
+    return count;
+}
+
+std::string RenderPipeline::getName() const {
+    std::string name;
+    for (size_t i = 0; i < m_passes.size(); ++i) {
+        if (i > 0) {
+            name += '/';
+        }
+        const RenderPass& pass = m_passes[i];
+        for (size_t j = 0; j < pass.renderers.size(); ++j) {
+            if (j > 0) {
+                name += ',';
+            }
+            name += pass.renderers[j]->getName();
+        }
+    }
+    return name;
+}
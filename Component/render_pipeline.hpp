@@ -0,0 +1,135 @@
+// render_pipeline.hpp
+// 单一职责: 把多个渲染器按有序的 pass 组合成一帧，同一 pass 内的命令合并排序后一次提交
+#pragma once
+#include "irenderer.hpp"
+#include "irender_config.hpp"
+#include "render_context.hpp"
+#include "render_queue.hpp"
+#include "command_list.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 一个渲染 pass - 按顺序执行，pass 之间不混合排序
+ */
+struct RenderPass {
+    std::string name;
+    int order = 0;                  // 升序执行，相同 order 按添加顺序
+    bool clearDepth = false;        // 执行前清除深度 (叠加层不被前面的 pass 遮挡)
+    std::vector<std::unique_ptr<IRenderer>> renderers;
+};
+
+/**
+ * @brief RenderPipeline - 一帧内组合任意数量的渲染器
+ *
+ * 每帧: 清屏一次 → 对每个 pass: 所有渲染器 record() 到共享 RenderQueue → 排序 → 提交。
+ * 跨渲染器的命令在同一 pass 内按排序键合批 (相同程序/VAO的绘制相邻)。
+ * 不支持 record() 的渲染器在提交已记录的命令后直接调用 render()，此时由渲染器自己负责不清屏。
+ *
+ * usesCommandList() 的渲染器先各自录制到独占的 CommandList (有活动的 JobSystem 时在工作线程上并行)，
+ * 之后GL线程按渲染器顺序回放到 RenderQueue，与 record() 的命令一起排序提交。
+ */
+class RenderPipeline {
+public:
+    RenderPipeline() = default;
+    ~RenderPipeline();
+
+    RenderPipeline(const RenderPipeline&) = delete;
+    RenderPipeline& operator=(const RenderPipeline&) = delete;
+
+    /**
+     * @brief 添加 pass (同名 pass 已存在时直接返回它)
+     */
+    RenderPass& addPass(const std::string& name, int order, bool clearDepth = false);
+    RenderPass* findPass(const std::string& name);
+
+    /**
+     * @brief 初始化渲染器并加入 pass (pass 不存在时以递增的 order 创建)
+     *
+     * 第一个加入的渲染器的清屏颜色作为整帧的清屏颜色 (可用 setClearColor 覆盖)
+     */
+    bool addRenderer(const std::string& passName, std::unique_ptr<IRenderer> renderer, const IRenderConfig& config);
+
+    /**
+     * @brief 通过 RenderFactory 按名称创建渲染器，使用其默认配置
+     */
+    bool addRenderer(const std::string& passName, const std::string& typeName);
+
+    /**
+     * @brief 按描述字符串构建: pass 之间用 '/' 分隔，pass 内渲染器用 ',' 分隔
+     *
+     * 例: "cube,triangle"        一个 pass，两个渲染器合并排序
+     *     "cube/triangle"        两个 pass，第二个清除深度后叠加
+     * pass 依次命名为 "pass0"、"pass1" ...
+     */
+    bool addFromSpec(const std::string& spec);
+
+    /**
+     * @brief 解析描述字符串 (每个元素是一个 pass 的渲染器名称列表)，不检查名称是否注册
+     */
+    static std::vector<std::vector<std::string>> parseSpec(const std::string& spec);
+
+    bool render(const RenderContext& context);
+    bool resize(int width, int height);
+    void cleanup();
+
+    void setErrorCallback(ErrorCallback callback);
+    void setClearColor(const glm::vec4& color);
+
+    /**
+     * @brief 所有渲染器的着色器都已就绪
+     */
+    bool isReady() const;
+
+    bool empty() const { return rendererCount() == 0; }
+    size_t rendererCount() const;
+    const std::vector<RenderPass>& passes() const { return m_passes; }
+
+    /**
+     * @brief 渲染器名称，pass 之间用 '/' 分隔 (与 addFromSpec 的格式一致)
+     */
+    std::string getName() const;
+
+    const std::string& lastError() const { return m_lastError; }
+
+    /**
+     * @brief 最近一帧所有 pass 的提交统计之和
+     */
+    const RenderQueueStats& lastStats() const { return m_stats; }
+
+    /**
+     * @brief 最近一帧所有 CommandList 的统计之和
+     */
+    const CommandListStats& lastCommandListStats() const { return m_listStats; }
+
+    /**
+     * @brief 关闭后 CommandList 在GL线程上依次录制 (对照测量用，默认开启并行)
+     */
+    void setParallelRecording(bool enabled) { m_parallelRecording = enabled; }
+
+private:
+    void recordCommandLists(RenderPass& pass, const RenderContext& context);
+    void submitQueue();
+    void accumulateStats();
+
+    std::vector<RenderPass> m_passes;      // 始终按 order 稳定排序
+    RenderQueue m_queue;                    // 所有 pass 共用，避免每帧重新分配
+    RenderQueueStats m_stats;
+
+    // 下标与 pass 内的渲染器对应，所有 pass 共用 (回放后才录制下一个 pass)
+    std::vector<std::unique_ptr<CommandList>> m_commandLists;
+    std::vector<uint8_t> m_listUsed;        // 本帧是否录制到列表 (uint8_t: 工作线程并发写入不同元素)
+    std::vector<uint8_t> m_listOk;
+    CommandListStats m_listStats;
+    bool m_parallelRecording = true;
+
+    ErrorCallback m_errorCallback;
+    glm::vec4 m_clearColor = glm::vec4(0.1f, 0.1f, 0.1f, 1.0f);
+    bool m_hasClearColor = false;
+    std::string m_lastError;
+};
@@ -0,0 +1,176 @@
+#include "render_queue.hpp"
+#include "gl_state_cache.hpp"
+#include "render_stats.hpp"
+#include "index_buffer.hpp"
+
+#include <glm/gtc/type_ptr.hpp>
+
+#include <cstring>
+#include <utility>
+
+// ============ SortKey ============
+
+namespace SortKey {
+
+uint32_t quantizeDepth(float viewDistance) {
+    if (!(viewDistance > 0.0f)) {
+        return 0;   // 负数/NaN 都视为最近
+    }
+    uint32_t bits;
+    std::memcpy(&bits, &viewDistance, sizeof(bits));
+    return bits >> 8;   // 丢弃低8位尾数，保留24位
+}
+
+uint64_t opaque(uint8_t layer, GLuint program, GLuint material, float viewDistance, uint8_t sequence) {
+    return (static_cast<uint64_t>(layer) << kLayerShift)
+         | (static_cast<uint64_t>(program & 0xFFFu) << 44)
+         | (static_cast<uint64_t>(material & 0xFFFu) << 32)
+         | (static_cast<uint64_t>(quantizeDepth(viewDistance)) << 8)
+         | sequence;
+}
+
+uint64_t translucent(uint8_t layer, GLuint program, GLuint material, float viewDistance, uint8_t sequence) {
+    // 取反后升序即由远到近
+    const uint32_t farFirst = ~quantizeDepth(viewDistance) & 0xFFFFFFu;
+    return (static_cast<uint64_t>(layer) << kLayerShift)
+         | (static_cast<uint64_t>(farFirst) << 32)
+         | (static_cast<uint64_t>(program & 0xFFFu) << 20)
+         | (static_cast<uint64_t>(material & 0xFFFu) << 8)
+         | sequence;
+}
+
+} // namespace SortKey
+
+// ============ RenderQueue ============
+
+void RenderQueue::clear() {
+    m_commands.clear();
+    m_transforms.clear();
+    m_order.clear();
+    m_sorted = false;
+}
+
+void RenderQueue::push(const DrawCommand& command, const glm::mat4& model) {
+    DrawCommand stored = command;
+    stored.transformIndex = static_cast<uint32_t>(m_transforms.size());
+    m_transforms.push_back(model);
+
+    m_order.push_back({ stored.key, static_cast<uint32_t>(m_commands.size()) });
+    m_commands.push_back(stored);
+    m_sorted = false;
+}
+
+void RenderQueue::push(const DrawCommand& command) {
+    DrawCommand stored = command;
+    stored.modelLocation = -1;
+
+    m_order.push_back({ stored.key, static_cast<uint32_t>(m_commands.size()) });
+    m_commands.push_back(stored);
+    m_sorted = false;
+}
+
+void RenderQueue::sort() {
+    const size_t count = m_order.size();
+    if (count < 2) {
+        m_sorted = true;
+        return;
+    }
+
+    m_scratch.resize(count);
+    SortEntry* src = m_order.data();
+    SortEntry* dst = m_scratch.data();
+
+    for (int pass = 0; pass < 8; ++pass) {
+        const int shift = pass * 8;
+
+        uint32_t histogram[256] = {};
+        for (size_t i = 0; i < count; ++i) {
+            histogram[(src[i].key >> shift) & 0xFF]++;
+        }
+
+        // 所有键在这个字节上相同: 这一趟不改变顺序
+        if (histogram[(src[0].key >> shift) & 0xFF] == count) {
+            continue;
+        }
+
+        uint32_t offset = 0;
+        for (uint32_t& bucket : histogram) {
+            const uint32_t bucketCount = bucket;
+            bucket = offset;
+            offset += bucketCount;
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            dst[histogram[(src[i].key >> shift) & 0xFF]++] = src[i];
+        }
+        std::swap(src, dst);
+    }
+
+    // 奇数趟后结果在 scratch 中
+    if (src != m_order.data()) {
+        m_order.swap(m_scratch);
+    }
+    m_sorted = true;
+}
+
+void RenderQueue::submit() {
+    if (!m_sorted) {
+        sort();
+    }
+
+    m_stats = RenderQueueStats();
+    m_stats.commands = static_cast<uint32_t>(m_commands.size());
+
+    GLStateCache& state = GLStateCache::current();
+    const DrawCommand* previous = nullptr;
+
+    for (const SortEntry& entry : m_order) {
+        const DrawCommand& command = m_commands[entry.index];
+
+        if (!previous || previous->program != command.program) {
+            m_stats.programSwitches++;
+        }
+        if (!previous || previous->vertexArray != command.vertexArray) {
+            m_stats.vertexArraySwitches++;
+        }
+        if (command.texture != 0 && (!previous || previous->texture != command.texture)) {
+            m_stats.textureSwitches++;
+        }
+        previous = &command;
+
+        state.useProgram(command.program);
+        if (command.texture != 0) {
+            state.bindTexture(command.textureTarget, command.texture, 0);
+        }
+        state.bindVertexArray(command.vertexArray);
+
+        if (command.modelLocation >= 0) {
+            glUniformMatrix4fv(command.modelLocation, 1, GL_FALSE, glm::value_ptr(m_transforms[command.transformIndex]));
+        }
+
+        if (command.drawCount > 0) {
+#ifndef __ANDROID__
+            state.bindBuffer(GL_DRAW_INDIRECT_BUFFER, command.indirectBuffer);
+            glMultiDrawElementsIndirect(command.primitive, command.indexType,
+                                        reinterpret_cast<const void*>(command.indirectOffset), command.drawCount, 0);
+#endif
+            RenderStats::addMultiDraw(command.drawCount, command.count, command.instanceCount);
+            continue;
+        }
+
+        if (command.indexType != 0) {
+            const void* offset = reinterpret_cast<const void*>(
+                static_cast<uintptr_t>(command.first) * IndexBuffer::sizeOfType(command.indexType));
+            if (command.instanceCount > 1) {
+                glDrawElementsInstanced(command.primitive, command.count, command.indexType, offset, command.instanceCount);
+            } else {
+                glDrawElements(command.primitive, command.count, command.indexType, offset);
+            }
+        } else if (command.instanceCount > 1) {
+            glDrawArraysInstanced(command.primitive, command.first, command.count, command.instanceCount);
+        } else {
+            glDrawArrays(command.primitive, command.first, command.count);
+        }
+        RenderStats::addDrawCall(command.count, command.instanceCount);
+    }
+}
@@ -0,0 +1,157 @@
+// render_queue.hpp
+// 单一职责: 收集一帧的绘制命令，按64位排序键基数排序后统一提交，减少程序/纹理/VAO切换
+#pragma once
+
+// 平台条件编译：OpenGL ES (Android) vs OpenGL Core (PC)
+#ifdef __ANDROID__
+    #include <GLES3/gl3.h>
+    #include <GLES3/gl3ext.h>
+#else
+    #include <glad/glad.h>
+#endif
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 排序键的层 (最高字节，层之间严格按数值先后提交)
+ */
+namespace RenderLayer {
+constexpr uint8_t Background = 0;
+constexpr uint8_t Opaque = 64;
+constexpr uint8_t Translucent = 128;
+constexpr uint8_t Overlay = 192;
+}
+
+/**
+ * @brief 64位排序键
+ *
+ * 不透明 (默认):   [63..56 layer] [55..44 program] [43..32 material] [31..8 depth] [7..0 sequence]
+ *                  先按层、再按状态分组，组内由近到远 (利用 early-Z)
+ * 半透明:          [63..56 layer] [55..32 ~depth]  [31..20 program] [19..8 material] [7..0 sequence]
+ *                  层内严格由远到近，状态只作为次级键
+ *
+ * program/material 只取GL名字的低12位用于分组；键仅决定顺序，实际绑定的对象以命令中的字段为准。
+ */
+namespace SortKey {
+
+constexpr uint64_t kLayerShift = 56;
+
+/**
+ * @brief 把非负视空间距离量化为24位，保持单调 (正浮点数的位模式与数值同序)
+ */
+uint32_t quantizeDepth(float viewDistance);
+
+uint64_t opaque(uint8_t layer, GLuint program, GLuint material, float viewDistance, uint8_t sequence = 0);
+uint64_t translucent(uint8_t layer, GLuint program, GLuint material, float viewDistance, uint8_t sequence = 0);
+
+inline uint8_t layerOf(uint64_t key) { return static_cast<uint8_t>(key >> kLayerShift); }
+
+} // namespace SortKey
+
+/**
+ * @brief glMultiDrawElementsIndirect 从 GL_DRAW_INDIRECT_BUFFER 读取的一条命令 (布局由GL规范规定)
+ */
+struct DrawElementsIndirectCommand {
+    uint32_t count;
+    uint32_t instanceCount;
+    uint32_t firstIndex;
+    int32_t baseVertex;
+    uint32_t baseInstance;          // 逐实例属性从第 baseInstance 个实例开始读取
+};
+
+static_assert(sizeof(DrawElementsIndirectCommand) == 20, "Indirect command layout mismatch");
+
+/**
+ * @brief 一条绘制命令 - 提交时需要的全部状态
+ */
+struct DrawCommand {
+    uint64_t key = 0;
+
+    GLuint program = 0;
+    GLuint vertexArray = 0;
+    GLuint texture = 0;             // 绑定到纹理单元0，0 表示不绑定
+    GLenum textureTarget = GL_TEXTURE_2D;   // 图集为 GL_TEXTURE_2D_ARRAY
+    GLenum primitive = GL_TRIANGLES;
+    GLenum indexType = 0;           // GL_UNSIGNED_SHORT/INT 时走 glDrawElements (索引缓冲由VAO提供)，0 为 glDrawArrays
+    GLint first = 0;                // 索引绘制时为起始索引 (以索引个数计)
+    GLsizei count = 0;
+    GLsizei instanceCount = 1;      // >1 时走 glDraw*Instanced
+
+    // 间接绘制 (GL 4.3): drawCount > 0 时一次 glMultiDrawElementsIndirect 提交 indirectBuffer 中 indirectOffset 处的
+    // drawCount 条 DrawElementsIndirectCommand (要求 indexType 非0)；first 不再使用，count/instanceCount 为所有子绘制的
+    // 顶点数 (已乘实例数) 与实例数之和，只用于统计
+    GLuint indirectBuffer = 0;
+    GLintptr indirectOffset = 0;
+    GLsizei drawCount = 0;
+
+    GLint modelLocation = -1;       // 逐绘制 mat4 uniform (通常为 "model")，-1 表示不设置
+    uint32_t transformIndex = 0;    // RenderQueue 内部矩阵池的下标
+};
+
+/**
+ * @brief 最近一次 submit 的统计
+ */
+struct RenderQueueStats {
+    uint32_t commands = 0;
+    uint32_t programSwitches = 0;
+    uint32_t vertexArraySwitches = 0;
+    uint32_t textureSwitches = 0;
+};
+
+/**
+ * @brief RenderQueue - 渲染器追加命令，帧循环排序并一次性提交
+ *
+ * 用法:
+ *   queue.clear();
+ *   renderer->record(context, queue);   // 可以有多个渲染器
+ *   queue.sort();
+ *   queue.submit();
+ *
+ * 提交经过 GLStateCache，相邻命令的相同状态不会重复设置。
+ */
+class RenderQueue {
+public:
+    void clear();
+
+    /**
+     * @brief 追加一条命令，model 存入矩阵池 (命令的 transformIndex 由此设置)
+     */
+    void push(const DrawCommand& command, const glm::mat4& model);
+    void push(const DrawCommand& command);
+
+    /**
+     * @brief 按键稳定排序 (LSD基数排序，8位一趟，跳过所有键该字节相同的趟)
+     */
+    void sort();
+
+    /**
+     * @brief 按排序后的顺序提交所有命令
+     */
+    void submit();
+
+    size_t size() const { return m_commands.size(); }
+    bool empty() const { return m_commands.empty(); }
+
+    /**
+     * @brief 排序后的命令顺序 (调试/测试用)
+     */
+    const DrawCommand& sortedCommand(size_t i) const { return m_commands[m_order[i].index]; }
+
+    const RenderQueueStats& lastStats() const { return m_stats; }
+
+private:
+    struct SortEntry {
+        uint64_t key;
+        uint32_t index;
+    };
+
+    std::vector<DrawCommand> m_commands;
+    std::vector<glm::mat4> m_transforms;
+    std::vector<SortEntry> m_order;
+    std::vector<SortEntry> m_scratch;
+    bool m_sorted = false;
+    RenderQueueStats m_stats;
+};
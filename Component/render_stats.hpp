@@ -0,0 +1,60 @@
+// render_stats.hpp
+// 单一职责: 统计每帧的绘制调用数量，供基准测试/调试输出使用
+#pragma once
+#include <cstdint>
+
+struct FrameStats {
+    uint32_t drawCalls = 0;     // glDraw* 调用次数 (一次 glMultiDraw*Indirect 计为一次)
+    uint32_t indirectDraws = 0; // 间接绘制调用中包含的子绘制数
+    uint64_t vertices = 0;      // 提交的顶点数 (实例化时为 顶点数 x 实例数)
+    uint64_t instances = 0;     // 提交的实例数
+    uint64_t culled = 0;        // 视锥剔除掉、未提交的对象数
+    uint64_t occluded = 0;      // 通过视锥测试、但被遮挡剔除的对象数
+};
+
+/**
+ * @brief RenderStats - 当前帧的绘制统计
+ *
+ * GL提交只发生在上下文所在的线程，因此这里不做同步。
+ * 渲染器在每次 glDraw* 之后调用 addDrawCall，帧循环在帧开始时调用 reset。
+ */
+class RenderStats {
+public:
+    static FrameStats& current() {
+        static FrameStats stats;
+        return stats;
+    }
+
+    static void reset() {
+        current() = FrameStats();
+    }
+
+    static void addDrawCall(uint64_t vertexCount, uint64_t instanceCount = 1) {
+        FrameStats& stats = current();
+        stats.drawCalls++;
+        stats.vertices += vertexCount * instanceCount;
+        stats.instances += instanceCount;
+    }
+
+    /**
+     * @brief 一次间接多重绘制: drawCount 条子绘制，vertexCount 为已乘实例数的顶点总数
+     */
+    static void addMultiDraw(uint32_t drawCount, uint64_t vertexCount, uint64_t instanceCount) {
+        FrameStats& stats = current();
+        stats.drawCalls++;
+        stats.indirectDraws += drawCount;
+        stats.vertices += vertexCount;
+        stats.instances += instanceCount;
+    }
+
+    static void addCulled(uint64_t count) {
+        current().culled += count;
+    }
+
+    static void addOccluded(uint64_t count) {
+        current().occluded += count;
+    }
+
+private:
+    RenderStats() = delete;
+};
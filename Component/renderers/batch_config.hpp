@@ -0,0 +1,101 @@
+// batch_config.hpp
+// 单一职责: Batch渲染器的专用配置 (网格池的网格来源、场景、提交方式)
+#pragma once
+#include "../irender_config.hpp"
+#include "../vertex_format.hpp"
+#include "../scene.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+
+// 包含着色器源码
+#ifdef __ANDROID__
+    #include <batch/batch.vert.es.h>
+    #include <batch/batch.frag.es.h>
+#else
+    #include <batch/batch.vert.core.h>
+    #include <batch/batch.frag.core.h>
+#endif
+
+// 加入网格池的一个网格: assetPath 非空时加载 .meshbin，否则使用已打包的顶点流
+// 所有网格的顶点布局必须相同 (见 MeshPool)，属性 location 与 MeshImporter 一致
+struct BatchMesh {
+    std::string assetPath;
+    VertexStream stream;
+    std::vector<uint32_t> indices;
+    glm::vec3 boundsMin = glm::vec3(0.0f);
+    glm::vec3 boundsMax = glm::vec3(0.0f);
+};
+
+// 每帧的提交方式
+enum class BatchSubmit {
+    Auto,               // 支持时 MultiDrawIndirect，否则 Loop
+    MultiDrawIndirect,  // 所有网格一次 glMultiDrawElementsIndirect (GL 4.3)，不支持时初始化失败
+    Loop                // 每个有可见实例的网格一次 glDrawElementsInstanced (GLES 3.0 / GL 3.3 路径)
+};
+
+class BatchConfig : public IRenderConfig {
+public:
+    BatchConfig() {
+        m_vertexShader = BATCH_VERTEX_SHADER;
+        m_fragmentShader = BATCH_FRAGMENT_SHADER;
+        m_clearColor = glm::vec4(0.1f, 0.1f, 0.1f, 1.0f);
+        m_rotationSpeed = 1.0f;
+        m_submit = BatchSubmit::Auto;
+        m_drawId = true;
+        m_culling = true;
+        m_demoGrid = 8;
+
+        BatchMesh model;
+        model.assetPath = "assets/model.meshbin";
+        m_meshes.push_back(model);
+    }
+
+    // IRenderConfig 接口实现
+    const std::string& vertexShaderSource() const override { return m_vertexShader; }
+    const std::string& fragmentShaderSource() const override { return m_fragmentShader; }
+    glm::vec4 clearColor() const override { return m_clearColor; }
+    float rotationSpeed() const override { return m_rotationSpeed; }
+
+    // 顶点数据在网格池中，这里不提供
+    const void* vertexData() const override { return nullptr; }
+    size_t vertexCount() const override { return 0; }
+    size_t vertexStride() const override { return 0; }
+
+    // Batch 专用访问器
+    const std::vector<BatchMesh>& meshes() const { return m_meshes; }
+    const std::shared_ptr<Scene>& scene() const { return m_scene; }
+    BatchSubmit submit() const { return m_submit; }
+    bool drawId() const { return m_drawId; }
+    bool culling() const { return m_culling; }
+    uint32_t demoGrid() const { return m_demoGrid; }
+
+    // Builder 方法
+    // 网格编号即加入顺序 (场景实体的 MeshRef::mesh)
+    BatchConfig& clearMeshes() { m_meshes.clear(); return *this; }
+    BatchConfig& addMesh(const BatchMesh& mesh) { m_meshes.push_back(mesh); return *this; }
+    BatchConfig& addMeshAsset(const std::string& path) { BatchMesh mesh; mesh.assetPath = path; m_meshes.push_back(mesh); return *this; }
+    // 绘制带 Transform/Bounds/MeshRef/MaterialRef 且 MeshRef::mesh 小于网格数的全部实体；
+    // 未设置时生成 demoGrid x demoGrid 的静态网格，轮流使用各网格
+    BatchConfig& setScene(const std::shared_ptr<Scene>& scene) { m_scene = scene; return *this; }
+    BatchConfig& setSubmit(BatchSubmit submit) { m_submit = submit; return *this; }
+    // MultiDrawIndirect 且支持 GL_ARB_shader_draw_parameters 时，逐网格的反量化矩阵由着色器按 gl_DrawIDARB 读取；
+    // 关闭 (或不支持) 时在CPU上乘入每个实例的模型矩阵
+    BatchConfig& setDrawId(bool enabled) { m_drawId = enabled; return *this; }
+    BatchConfig& setCulling(bool enabled) { m_culling = enabled; return *this; }
+    BatchConfig& setDemoGrid(uint32_t size) { m_demoGrid = size; return *this; }
+    BatchConfig& setClearColor(const glm::vec4& c) { m_clearColor = c; return *this; }
+
+private:
+    std::string m_vertexShader;
+    std::string m_fragmentShader;
+    std::vector<BatchMesh> m_meshes;
+    std::shared_ptr<Scene> m_scene;
+    BatchSubmit m_submit;
+    bool m_drawId;
+    bool m_culling;
+    uint32_t m_demoGrid;
+    glm::vec4 m_clearColor;
+    float m_rotationSpeed;
+};
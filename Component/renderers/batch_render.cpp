@@ -0,0 +1,566 @@
+#include "batch_render.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace {
+
+// 逐实例属性的 location: 模型矩阵 4~7 (每列一个vec4)、实例颜色 8
+constexpr GLuint kInstanceModelLocation = 4;
+constexpr GLuint kInstanceColorLocation = 8;
+
+// 在 #version 行之后插入宏定义
+std::string withDefine(const std::string& source, const char* name) {
+    const size_t lineEnd = source.find('\n');
+    if (lineEnd == std::string::npos) {
+        return source;
+    }
+    return source.substr(0, lineEnd + 1) + "#define " + name + " 1\n" + source.substr(lineEnd + 1);
+}
+
+} // namespace
+
+BatchRender::BatchRender()
+    : m_octNormals(false)
+    , m_vao(0)
+    , m_instanceVbo(0)
+    , m_indirectBuffer(0)
+    , m_drawBlock(0)
+    , m_multiDraw(false)
+    , m_drawId(false)
+    , m_culling(true)
+    , m_clearColor(0.1f, 0.1f, 0.1f, 1.0f)
+    , m_initialized(false)
+    , m_shaderReady(false)
+{ }
+
+BatchRender::~BatchRender() {
+    this->cleanup();
+}
+
+bool BatchRender::multiDrawIndirectSupported() {
+#ifdef __ANDROID__
+    return false;
+#else
+    GLint major = 0;
+    GLint minor = 0;
+    glGetIntegerv(GL_MAJOR_VERSION, &major);
+    glGetIntegerv(GL_MINOR_VERSION, &minor);
+    return (major > 4 || (major == 4 && minor >= 3)) && glMultiDrawElementsIndirect != nullptr;
+#endif
+}
+
+bool BatchRender::drawParametersSupported() {
+#ifdef __ANDROID__
+    return false;
+#else
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    for (GLint i = 0; i < count; ++i) {
+        const char* name = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i)));
+        if (name && std::strcmp(name, "GL_ARB_shader_draw_parameters") == 0) {
+            return true;
+        }
+    }
+    return false;
+#endif
+}
+
+bool BatchRender::initialize(const IRenderConfig& config) {
+    // 向下转型获取具体配置
+    const auto* batchConfig = dynamic_cast<const BatchConfig*>(&config);
+    if (!batchConfig) {
+        reportError(RenderError::InitializationFailed, "Invalid config type for BatchRender");
+        return false;
+    }
+
+    // 提交方式与逐网格数据的来源须先于编译确定 (gl_DrawIDARB 路径用另一个着色器变体)
+    const bool multiDraw = multiDrawIndirectSupported();
+    if (batchConfig->submit() == BatchSubmit::MultiDrawIndirect && !multiDraw) {
+        reportError(RenderError::InitializationFailed, "glMultiDrawElementsIndirect requires OpenGL 4.3");
+        return false;
+    }
+    m_multiDraw = batchConfig->submit() != BatchSubmit::Loop && multiDraw;
+
+    if (!initializeMeshes(batchConfig->meshes())) {
+        return false;
+    }
+    m_drawId = m_multiDraw && batchConfig->drawId() && m_pool.meshCount() <= kMaxDrawIdMeshes && drawParametersSupported();
+
+    // 正式着色器异步编译；占位程序不读取逐实例属性，完成前不绘制
+    const std::string vertexSource = m_drawId ? withDefine(config.vertexShaderSource(), "BATCH_DRAW_ID")
+                                              : config.vertexShaderSource();
+    ShaderCompileHandle compile = m_shader.loadFromSourceAsync(vertexSource, config.fragmentShaderSource());
+    if (compile.status() == ShaderCompileStatus::Failed) {
+        this->reportError(RenderError::ShaderCompilationFailed, "Failed to compile shader:" + compile.error());
+        return false;
+    }
+
+    if (!initializeVertexArrays() || (m_drawId && !initializeDrawBlock())) {
+        return false;
+    }
+
+    m_scene = batchConfig->scene();
+    if (!m_scene) {
+        initializeDemoScene(batchConfig->demoGrid());
+    }
+
+    // 缓存命中或同步回退时已经就绪
+    if (m_shader.pollAsync() == ShaderCompileStatus::Ready && !finishShader()) {
+        return false;
+    }
+
+    std::cout << "BatchRender: " << m_pool.meshCount() << " meshes, " << m_pool.vertexCount() << " vertices, "
+              << m_pool.indexCount() / 3 << " triangles, submit " << (m_multiDraw ? "multi-draw indirect" : "loop")
+              << ", per-draw data " << (m_drawId ? "gl_DrawID" : "baked") << std::endl;
+
+    // 保存配置
+    m_culling = batchConfig->culling();
+    m_clearColor = config.clearColor();
+    m_initialized = true;
+
+    return true;
+}
+
+bool BatchRender::initializeMeshes(const std::vector<BatchMesh>& meshes) {
+    for (const BatchMesh& source : meshes) {
+        int id = -1;
+        if (!source.assetPath.empty()) {
+            // 映射文件只校验头部，数据段拷入池中后即解除映射
+            MeshAsset asset;
+            if (!asset.load(source.assetPath)) {
+                reportError(RenderError::InitializationFailed, "Failed to load mesh asset: " + asset.lastError());
+                return false;
+            }
+            id = m_pool.add(asset);
+        } else {
+            id = m_pool.add(source.stream, source.indices, source.boundsMin, source.boundsMax);
+        }
+        if (id < 0) {
+            reportError(RenderError::InitializationFailed, m_pool.lastError());
+            return false;
+        }
+    }
+
+    if (!m_pool.upload()) {
+        reportError(RenderError::BufferCreationFailed, m_pool.lastError());
+        return false;
+    }
+
+    const std::vector<VertexAttribute>& attributes = m_pool.attributes();
+    m_octNormals = std::any_of(attributes.begin(), attributes.end(), [](const VertexAttribute& attribute) {
+        return attribute.location == 1 && attribute.components == 2;
+    });
+    return true;
+}
+
+GLuint BatchRender::createVertexArray() {
+    GLStateCache& state = GLStateCache::current();
+    GLuint vao = 0;
+    glGenVertexArrays(1, &vao);
+    state.bindVertexArray(vao);
+    m_pool.applyVertexState();
+    for (GLuint location = kInstanceModelLocation; location <= kInstanceColorLocation; ++location) {
+        glEnableVertexAttribArray(location);
+        glVertexAttribDivisor(location, 1);
+    }
+    state.bindVertexArray(0);
+    return vao;
+}
+
+bool BatchRender::initializeVertexArrays() {
+    // 实例属性的指针在第一次上传时设置 (指向流缓冲或下面的回退缓冲)
+    glGenBuffers(1, &m_instanceVbo);
+    if (m_multiDraw) {
+        m_vao = createVertexArray();
+        glGenBuffers(1, &m_indirectBuffer);
+    } else {
+        m_meshVaos.resize(m_pool.meshCount());
+        m_meshSources.assign(m_pool.meshCount(), InstanceSource());
+        for (GLuint& vao : m_meshVaos) {
+            vao = createVertexArray();
+        }
+    }
+    return true;
+}
+
+bool BatchRender::initializeDrawBlock() {
+    // 网格的反量化矩阵在池的生命周期内不变，只写一次 (不经过流缓冲)
+    std::vector<glm::mat4> dequantize(kMaxDrawIdMeshes, glm::mat4(1.0f));
+    for (size_t i = 0; i < m_pool.meshCount(); ++i) {
+        dequantize[i] = m_pool.mesh(i).dequantize;
+    }
+
+    GLStateCache& state = GLStateCache::current();
+    glGenBuffers(1, &m_drawBlock);
+    state.bindBuffer(GL_UNIFORM_BUFFER, m_drawBlock);
+    glBufferData(GL_UNIFORM_BUFFER, static_cast<GLsizeiptr>(dequantize.size() * sizeof(glm::mat4)), dequantize.data(), GL_STATIC_DRAW);
+    return true;
+}
+
+void BatchRender::initializeDemoScene(uint32_t gridSize) {
+    // gridSize x gridSize 的静态网格铺在 z = -6 处，各网格缩放到相同的包围球
+    m_scene = std::make_shared<Scene>();
+    const float cell = 3.0f / static_cast<float>(std::max(1u, gridSize));
+    for (uint32_t y = 0; y < gridSize; ++y) {
+        for (uint32_t x = 0; x < gridSize; ++x) {
+            const uint32_t index = y * gridSize + x;
+            const PoolMesh& mesh = m_pool.mesh(index % m_pool.meshCount());
+            const glm::vec3 center = (mesh.boundsMin + mesh.boundsMax) * 0.5f;
+            const float radius = std::max(glm::length(mesh.boundsMax - mesh.boundsMin) * 0.5f, 1e-6f);
+
+            Transform transform;
+            transform.world = glm::translate(glm::mat4(1.0f), glm::vec3(-1.5f + cell * (x + 0.5f), -1.5f + cell * (y + 0.5f), -6.0f))
+                            * glm::scale(glm::mat4(1.0f), glm::vec3(0.45f * cell / radius))
+                            * glm::translate(glm::mat4(1.0f), -center);
+            Bounds bounds;
+            bounds.center = center;
+            bounds.extents = (mesh.boundsMax - mesh.boundsMin) * 0.5f;
+            MeshRef meshRef;
+            meshRef.mesh = index % static_cast<uint32_t>(m_pool.meshCount());
+            MaterialRef material;
+            material.color = glm::vec4(0.5f + 0.5f * (x + 1) / gridSize, 0.5f + 0.5f * (y + 1) / gridSize, 0.8f, 1.0f);
+            m_scene->create(transform, bounds, meshRef, material);
+        }
+    }
+}
+
+bool BatchRender::finishShader() {
+    // 投影等帧全局数据来自共享的 FrameBlock UBO
+    if (!m_shader.bindUniformBlock("FrameBlock", UniformBinding::Frame, sizeof(FrameUniforms))) {
+        reportError(RenderError::InitializationFailed, m_shader.lastError());
+        return false;
+    }
+    if (m_drawId && !m_shader.bindUniformBlock("DrawBlock", UniformBinding::BatchDraw,
+                                                static_cast<GLint>(kMaxDrawIdMeshes * sizeof(glm::mat4)))) {
+        reportError(RenderError::InitializationFailed, m_shader.lastError());
+        return false;
+    }
+
+    // 法线编码由池的顶点布局决定，只设置一次
+    m_shader.use();
+    m_shader.setInt("octNormals", m_octNormals ? 1 : 0);
+    m_shaderReady = true;
+    return true;
+}
+
+void BatchRender::cleanup() {
+    GLStateCache& state = GLStateCache::current();
+    if (this->m_vao != 0) {
+        state.onVertexArrayDeleted(this->m_vao);
+        glDeleteVertexArrays(1, &this->m_vao);
+        this->m_vao = 0;
+    }
+    for (GLuint& vao : this->m_meshVaos) {
+        state.onVertexArrayDeleted(vao);
+        glDeleteVertexArrays(1, &vao);
+    }
+    this->m_meshVaos.clear();
+    this->m_meshSources.clear();
+    this->m_source = InstanceSource();
+
+    GLuint* buffers[] = { &this->m_instanceVbo, &this->m_indirectBuffer, &this->m_drawBlock };
+    for (GLuint* buffer : buffers) {
+        if (*buffer != 0) {
+            state.onBufferDeleted(*buffer);
+            glDeleteBuffers(1, buffer);
+            *buffer = 0;
+        }
+    }
+    this->m_pool.release();
+    this->m_scene.reset();
+
+    this->m_shader.release();
+    this->m_shaderReady = false;
+    this->m_initialized = false;
+}
+
+void BatchRender::setErrorCallback(ErrorCallback callback) {
+    this->m_errorCallback = callback;
+}
+
+bool BatchRender::resize(int width, int height) {
+    glViewport(0, 0, width, height);
+    return true;
+}
+
+void BatchRender::reportError(RenderError error, const std::string& msg) {
+    std::cerr << "BatchRender Error: " << msg << std::endl;
+    if (m_errorCallback) {
+        m_errorCallback(error, msg);
+    }
+}
+
+void BatchRender::pointInstanceAttributes(GLuint vao, InstanceSource& source, GLuint buffer, GLintptr offset) {
+    // 流缓冲每帧换偏移 (区域轮换)，只在来源变化时重新设置属性指针
+    if (buffer == source.buffer && offset == source.offset) {
+        return;
+    }
+    source.buffer = buffer;
+    source.offset = offset;
+
+    GLStateCache& state = GLStateCache::current();
+    state.bindVertexArray(vao);
+    state.bindBuffer(GL_ARRAY_BUFFER, buffer);
+    const GLsizei stride = sizeof(BatchInstance);
+    for (GLuint column = 0; column < 4; ++column) {
+        glVertexAttribPointer(kInstanceModelLocation + column, 4, GL_FLOAT, GL_FALSE, stride,
+                              (void*)(offset + offsetof(BatchInstance, model) + sizeof(glm::vec4) * column));
+    }
+    glVertexAttribPointer(kInstanceColorLocation, 4, GL_FLOAT, GL_FALSE, stride, (void*)(offset + offsetof(BatchInstance, color)));
+    state.bindVertexArray(0);
+}
+
+void BatchRender::gatherSceneInstances() {
+    // 按块读取四个组件数组，认领网格编号在池内的实体；变换由场景逻辑写入
+    const SceneView<Transform, Bounds, MeshRef, MaterialRef> view = m_scene->view<Transform, Bounds, MeshRef, MaterialRef>();
+    const uint32_t meshCount = static_cast<uint32_t>(m_pool.meshCount());
+
+    // 顺序统计每块的匹配数，得到各块的写出起点，之后各块互不重叠 (块表只在本帧有效，从帧分配器分配)
+    FrameVector<SceneChunkRange> chunks;
+    size_t count = 0;
+    view.forEachChunk([&](size_t chunkCount, const Entity*, const Transform* transforms, const Bounds* bounds,
+                          const MeshRef* meshes, const MaterialRef* materials) {
+        size_t matched = 0;
+        for (size_t i = 0; i < chunkCount; ++i) {
+            matched += meshes[i].mesh < meshCount ? 1 : 0;
+        }
+        if (matched > 0) {
+            chunks.push_back({ chunkCount, transforms, bounds, meshes, materials, count });
+            count += matched;
+        }
+    });
+    m_instanceData.resize(count);
+    m_instanceMesh.resize(count);
+    m_instanceBounds.resize(count);
+
+    // 没有 gl_DrawIDARB 时反量化矩阵在这里乘入 (即按 baseInstance 区分网格的退化路径)
+    auto gather = [this, &chunks, meshCount](size_t begin, size_t end) {
+        for (size_t c = begin; c < end; ++c) {
+            const SceneChunkRange& chunk = chunks[c];
+            size_t written = chunk.offset;
+            for (size_t i = 0; i < chunk.count; ++i) {
+                const uint32_t mesh = chunk.meshes[i].mesh;
+                if (mesh >= meshCount) {
+                    continue;
+                }
+                const glm::mat4& world = chunk.transforms[i].world;
+                BatchInstance& data = m_instanceData[written];
+                data.model = m_drawId ? world : world * m_pool.mesh(mesh).dequantize;
+                data.color = chunk.materials[i].color;
+                m_instanceMesh[written] = mesh;
+                m_instanceBounds.setTransformed(written, chunk.bounds[i].center, chunk.bounds[i].extents, world);
+                ++written;
+            }
+        }
+    };
+    JobSystem* jobs = JobSystem::active();
+    if (jobs) {
+        jobs->parallelFor(chunks.size(), 1, gather);
+    } else {
+        gather(0, chunks.size());
+    }
+}
+
+size_t BatchRender::cullInstances(const glm::mat4& viewProjection) {
+    gatherSceneInstances();
+    const size_t instanceCount = m_instanceBounds.size();
+
+    if (m_culling) {
+        FrustumCulling::cull(Frustum::fromMatrix(viewProjection), m_instanceBounds, CullShape::Aabb, m_visibleInstances);
+    } else {
+        m_visibleInstances.resize(instanceCount);
+        for (size_t i = 0; i < m_visibleInstances.size(); ++i) {
+            m_visibleInstances[i] = static_cast<uint32_t>(i);
+        }
+    }
+    RenderStats::addCulled(instanceCount - m_visibleInstances.size());
+    return m_visibleInstances.size();
+}
+
+void BatchRender::sortVisibleInstances() {
+    // 计数排序: 同一网格的可见实例连续排列，m_meshFirst[m] 为网格 m 的起点
+    const size_t meshCount = m_pool.meshCount();
+    m_meshFirst.assign(meshCount + 1, 0);
+    for (uint32_t index : m_visibleInstances) {
+        m_meshFirst[m_instanceMesh[index] + 1]++;
+    }
+    for (size_t mesh = 0; mesh < meshCount; ++mesh) {
+        m_meshFirst[mesh + 1] += m_meshFirst[mesh];
+    }
+
+    m_sortedInstances.resize(m_visibleInstances.size());
+    FrameVector<uint32_t> cursor(m_meshFirst.begin(), m_meshFirst.end() - 1);
+    for (uint32_t index : m_visibleInstances) {
+        m_sortedInstances[cursor[m_instanceMesh[index]]++] = index;
+    }
+}
+
+void BatchRender::uploadInstances(GLuint& buffer, GLintptr& offset) {
+    const size_t count = m_sortedInstances.size();
+    const size_t bytes = count * sizeof(BatchInstance);
+
+    // 有流缓冲时按排序后的顺序连续写入映射的区域，不经过 glBufferSubData
+    StreamBuffer* stream = StreamBuffer::active();
+    const StreamAllocation allocation = stream ? stream->map(bytes) : StreamAllocation();
+    if (allocation.isValid()) {
+        BatchInstance* out = reinterpret_cast<BatchInstance*>(allocation.data);
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = m_instanceData[m_sortedInstances[i]];
+        }
+        stream->unmap(allocation);
+        buffer = stream->id();
+        offset = allocation.offset;
+        return;
+    }
+
+    // 先孤立(orphan)旧存储再写入，避免等待GPU读取上一帧的数据
+    m_uploadData.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        m_uploadData[i] = m_instanceData[m_sortedInstances[i]];
+    }
+    GLStateCache::current().bindBuffer(GL_ARRAY_BUFFER, m_instanceVbo);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(bytes), nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(bytes), m_uploadData.data());
+    buffer = m_instanceVbo;
+    offset = 0;
+}
+
+DrawCommand BatchRender::prepareCommand(uint32_t material) const {
+    DrawCommand command;
+    command.program = m_shader.programId();
+    command.indexType = GL_UNSIGNED_INT;
+    command.key = SortKey::opaque(RenderLayer::Opaque, command.program, material, 0.0f);
+    return command;
+}
+
+void BatchRender::recordMultiDraw(RenderQueue& queue, GLuint buffer, GLintptr offset) {
+    // gl_DrawIDARB 路径为每个网格都生成命令 (没有可见实例的 instanceCount 为 0)，第 i 条命令即网格 i
+    const size_t meshCount = m_pool.meshCount();
+    uint64_t vertices = 0;
+    m_commands.clear();
+    for (size_t mesh = 0; mesh < meshCount; ++mesh) {
+        const uint32_t instances = m_meshFirst[mesh + 1] - m_meshFirst[mesh];
+        if (instances == 0 && !m_drawId) {
+            continue;
+        }
+        const PoolMesh& poolMesh = m_pool.mesh(mesh);
+        DrawElementsIndirectCommand indirect;
+        indirect.count = poolMesh.indexCount;
+        indirect.instanceCount = instances;
+        indirect.firstIndex = poolMesh.firstIndex;
+        indirect.baseVertex = 0;
+        indirect.baseInstance = m_meshFirst[mesh];
+        m_commands.push_back(indirect);
+        vertices += static_cast<uint64_t>(poolMesh.indexCount) * instances;
+    }
+
+#ifndef __ANDROID__
+    const size_t bytes = m_commands.size() * sizeof(DrawElementsIndirectCommand);
+    StreamBuffer* stream = StreamBuffer::active();
+    const StreamAllocation allocation = stream ? stream->upload(m_commands.data(), bytes) : StreamAllocation();
+    DrawCommand command = prepareCommand(0);
+    if (allocation.isValid()) {
+        command.indirectBuffer = stream->id();
+        command.indirectOffset = allocation.offset;
+    } else {
+        GLStateCache::current().bindBuffer(GL_DRAW_INDIRECT_BUFFER, m_indirectBuffer);
+        glBufferData(GL_DRAW_INDIRECT_BUFFER, static_cast<GLsizeiptr>(bytes), nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, static_cast<GLsizeiptr>(bytes), m_commands.data());
+        command.indirectBuffer = m_indirectBuffer;
+        command.indirectOffset = 0;
+    }
+
+    // 间接命令的 baseInstance 从实例属性的起点算起
+    pointInstanceAttributes(m_vao, m_source, buffer, offset);
+    command.vertexArray = m_vao;
+    command.drawCount = static_cast<GLsizei>(m_commands.size());
+    command.count = static_cast<GLsizei>(vertices);
+    command.instanceCount = static_cast<GLsizei>(m_sortedInstances.size());
+    queue.push(command);
+#else
+    (void)queue;
+    (void)buffer;
+    (void)offset;
+#endif
+}
+
+void BatchRender::recordLoop(RenderQueue& queue, GLuint buffer, GLintptr offset) {
+    // 没有 baseInstance: 各网格的 VAO 直接把实例属性指向自己的分组
+    for (size_t mesh = 0; mesh < m_pool.meshCount(); ++mesh) {
+        const uint32_t instances = m_meshFirst[mesh + 1] - m_meshFirst[mesh];
+        if (instances == 0) {
+            continue;
+        }
+        const GLintptr groupOffset = offset + static_cast<GLintptr>(m_meshFirst[mesh] * sizeof(BatchInstance));
+        pointInstanceAttributes(m_meshVaos[mesh], m_meshSources[mesh], buffer, groupOffset);
+
+        const PoolMesh& poolMesh = m_pool.mesh(mesh);
+        DrawCommand command = prepareCommand(static_cast<uint32_t>(mesh));
+        command.vertexArray = m_meshVaos[mesh];
+        command.first = static_cast<GLint>(poolMesh.firstIndex);
+        command.count = static_cast<GLsizei>(poolMesh.indexCount);
+        command.instanceCount = static_cast<GLsizei>(instances);
+        queue.push(command);
+    }
+}
+
+bool BatchRender::render(const RenderContext& context) {
+    if (!m_initialized) {
+        reportError(RenderError::InitializationFailed, "BatchRender not initialized");
+        return false;
+    }
+
+    glClearColor(m_clearColor.x, m_clearColor.y, m_clearColor.z, m_clearColor.w);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    // 单独使用时也走命令队列，与多渲染器合帧的提交路径一致
+    m_queue.clear();
+    if (!record(context, m_queue)) {
+        return false;
+    }
+    m_queue.submit();
+    return true;
+}
+
+bool BatchRender::record(const RenderContext& context, RenderQueue& queue) {
+    // 投影矩阵等帧全局数据已由帧循环写入 FrameBlock UBO
+    if (!m_initialized) {
+        reportError(RenderError::InitializationFailed, "BatchRender not initialized");
+        return false;
+    }
+
+    if (!m_shaderReady) {
+        ShaderCompileStatus status = m_shader.pollAsync();
+        if (status == ShaderCompileStatus::Failed) {
+            reportError(RenderError::ShaderCompilationFailed, "Failed to compile shader:" + m_shader.lastError());
+            return false;
+        }
+        if (status != ShaderCompileStatus::Ready) {
+            return true;
+        }
+        if (!finishShader()) {
+            return false;
+        }
+    }
+
+    // FrameBlock 的视图矩阵为单位阵，视锥测试直接使用投影矩阵
+    if (cullInstances(context.projectionMatrix()) == 0) {
+        return true;
+    }
+    sortVisibleInstances();
+
+    GLuint buffer = 0;
+    GLintptr offset = 0;
+    uploadInstances(buffer, offset);
+    if (m_drawId) {
+        GLStateCache::current().bindBufferBase(GL_UNIFORM_BUFFER, UniformBinding::BatchDraw, m_drawBlock);
+    }
+
+    if (m_multiDraw) {
+        recordMultiDraw(queue, buffer, offset);
+    } else {
+        recordLoop(queue, buffer, offset);
+    }
+    return true;
+}
@@ -0,0 +1,142 @@
+#pragma once
+
+#include "../irenderer.hpp"
+#include "../render_context.hpp"
+#include "../shader.hpp"
+#include "../render_stats.hpp"
+#include "../gl_state_cache.hpp"
+#include "../render_queue.hpp"
+#include "../mesh_pool.hpp"
+#include "../mesh_asset.hpp"
+#include "../frame_uniforms.hpp"
+#include "../frustum_culling.hpp"
+#include "../scene.hpp"
+#include "../job_system.hpp"
+#include "../frame_allocator.hpp"
+#include "../stream_buffer.hpp"
+#include "batch_config.hpp"
+
+#ifdef __ANDROID__
+    #include <GLES3/gl3.h>
+    #include <GLES3/gl3ext.h>
+#else
+    #include <glad/glad.h>
+#endif
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <memory>
+#include <vector>
+
+/**
+ * @brief BatchRender - 网格池中的所有网格共用一个 VAO，整个场景一次间接多重绘制
+ *
+ * 每帧从场景收集实体并视锥剔除，可见实例按网格计数排序后写入流缓冲 (同一网格的实例连续)，
+ * 再为每个网格生成一条 DrawElementsIndirectCommand (baseInstance = 该网格实例的起点)，
+ * 最后只向 RenderQueue 提交一条 glMultiDrawElementsIndirect 命令。
+ * 没有 GL 4.3 时 (GLES 3.0、GL 3.3 上下文) 退回每个网格一次实例化绘制，各网格的 VAO 把实例属性指向自己的分组。
+ * 逐实例数据与间接命令都在GL线程写入，不使用 CommandList。
+ */
+class BatchRender : public IRenderer
+{
+public:
+    // DrawBlock 中逐网格数据的上限 (std140 mat4 x 256 = 16KB，GL_MAX_UNIFORM_BLOCK_SIZE 的最小保证)，超过时不用 gl_DrawIDARB
+    static constexpr size_t kMaxDrawIdMeshes = 256;
+
+    BatchRender();
+    ~BatchRender() override;
+
+    bool initialize( const IRenderConfig& config ) override;
+    bool render( const RenderContext& context ) override;
+    bool usesRenderQueue() const override { return true; }
+    bool record( const RenderContext& context, RenderQueue& queue ) override;
+    bool resize( int width, int height ) override;
+    void cleanup() override;
+    void setErrorCallback( ErrorCallback callback ) override;
+    std::string getName() const override { return "batch"; }
+    bool isReady() const override { return m_shaderReady; }
+
+    /**
+     * @brief 当前上下文是否支持 glMultiDrawElementsIndirect (GL 4.3)
+     */
+    static bool multiDrawIndirectSupported();
+
+    /**
+     * @brief 当前上下文是否支持 GL_ARB_shader_draw_parameters (gl_DrawIDARB)
+     */
+    static bool drawParametersSupported();
+
+private:
+    // 逐实例上传到GPU的数据 (与 batch.vert.glsl 的 location 4~8 对应)
+    struct BatchInstance {
+        glm::mat4 model;
+        glm::vec4 color;
+    };
+
+    // 实例属性当前指向的缓冲与偏移 (每个 VAO 一份)
+    struct InstanceSource {
+        GLuint buffer = 0;
+        GLintptr offset = -1;
+    };
+
+    // 按块并行收集: 每块的组件数组与写出起点 (先顺序统计池中网格的实体数)
+    struct SceneChunkRange {
+        size_t count;
+        const Transform* transforms;
+        const Bounds* bounds;
+        const MeshRef* meshes;
+        const MaterialRef* materials;
+        size_t offset;
+    };
+
+    bool initializeMeshes( const std::vector<BatchMesh>& meshes );
+    bool initializeVertexArrays();
+    void initializeDemoScene( uint32_t gridSize );
+    bool initializeDrawBlock();
+    GLuint createVertexArray();
+    void pointInstanceAttributes( GLuint vao, InstanceSource& source, GLuint buffer, GLintptr offset );
+    void gatherSceneInstances();
+    size_t cullInstances( const glm::mat4& viewProjection );
+    void sortVisibleInstances();
+    void uploadInstances( GLuint& buffer, GLintptr& offset );
+    void recordMultiDraw( RenderQueue& queue, GLuint buffer, GLintptr offset );
+    void recordLoop( RenderQueue& queue, GLuint buffer, GLintptr offset );
+    DrawCommand prepareCommand( uint32_t material ) const;
+    bool finishShader();
+    void reportError( RenderError error, const std::string& message );
+
+    Shader m_shader;
+    MeshPool m_pool;
+    bool m_octNormals;
+
+    GLuint m_vao;                               // MultiDrawIndirect: 池的顶点属性 + 全部实例
+    InstanceSource m_source;
+    std::vector<GLuint> m_meshVaos;             // Loop: 每个网格一个，实例属性指向该网格的分组
+    std::vector<InstanceSource> m_meshSources;
+    GLuint m_instanceVbo;                       // 没有 StreamBuffer (或其区域已满) 时孤立后整体重写
+    GLuint m_indirectBuffer;                    // 同上，间接命令
+    GLuint m_drawBlock;                         // DrawBlock UBO (逐网格反量化矩阵，初始化时写入一次)
+
+    bool m_multiDraw;
+    bool m_drawId;
+    bool m_culling;
+
+    std::shared_ptr<Scene> m_scene;             // 配置的场景，或未配置时生成的演示网格
+    std::vector<BatchInstance> m_instanceData;  // 收集到的实例 (未排序)
+    std::vector<uint32_t> m_instanceMesh;
+    CullingBounds m_instanceBounds;             // 逐实例世界空间 AABB
+    std::vector<uint32_t> m_visibleInstances;
+    std::vector<uint32_t> m_meshFirst;          // 排序后每个网格第一个实例的位置 (网格数 + 1 项)
+    std::vector<uint32_t> m_sortedInstances;    // 按网格分组的可见实例下标
+    std::vector<BatchInstance> m_uploadData;    // 没有流缓冲时的上传暂存
+    std::vector<DrawElementsIndirectCommand> m_commands;
+
+    glm::vec4 m_clearColor;
+
+    ErrorCallback m_errorCallback;
+    bool m_initialized;
+    bool m_shaderReady;
+
+    RenderQueue m_queue;    // render() 单独使用时的本地队列
+};
@@ -2,6 +2,9 @@
 // 单一职责: Cube渲染器的专用配置
 #pragma once
 #include "../irender_config.hpp"
+#include "../texture_atlas.hpp"
+#include "../scene.hpp"
+#include <memory>
 #include <vector>
 #include <glm/glm.hpp>
 
@@ -9,9 +12,13 @@
 #ifdef __ANDROID__
     #include <cube/cube.vert.es.h>
     #include <cube/cube.frag.es.h>
+    #include <cube/cube_instanced.vert.es.h>
+    #include <cube/cube_instanced.frag.es.h>
 #else
     #include <cube/cube.vert.core.h>
     #include <cube/cube.frag.core.h>
+    #include <cube/cube_instanced.vert.core.h>
+    #include <cube/cube_instanced.frag.core.h>
 #endif
 
 // Cube 专用顶点数据结构
@@ -20,15 +27,36 @@ struct CubeVertex {
     glm::vec2 texCoord;
 };
 
+// Cube 实例数据: 非空时 CubeRender 切换到实例化绘制 (一次 glDrawElementsInstanced)
+struct CubeInstance {
+    glm::mat4 transform = glm::mat4(1.0f);      // 实例的基础变换 (世界空间)
+    glm::vec4 color = glm::vec4(1.0f);          // 实例颜色 (与纹理或纹理坐标渐变相乘)
+    float rotationSpeed = 1.0f;                 // 相对于全局旋转速度的倍率
+    uint32_t textureIndex = 0;                  // CubeConfig::setAtlas 时采样的子纹理
+    bool occluder = false;                      // CubeConfig::setOcclusionCulling 时光栅化为遮挡体
+};
+
+// 实例化模式的逐帧视锥剔除方式
+enum class InstanceCulling {
+    None,       // 全部上传
+    Linear,     // FrustumCulling: SoA + SIMD 逐对象测试
+    Bvh         // Bvh: 每帧 refit，退化时重建，适合大量实例且多数在视锥外
+};
+
 class CubeConfig : public IRenderConfig {
 public:
     CubeConfig() {
         m_vertexShader = CUBE_VERTEX_SHADER;
         m_fragmentShader = CUBE_FRAGMENT_SHADER;
+        m_instancedVertexShader = CUBE_INSTANCED_VERTEX_SHADER;
+        m_instancedFragmentShader = CUBE_INSTANCED_FRAGMENT_SHADER;
         m_clearColor = glm::vec4(0.1f, 0.1f, 0.1f, 1.0f);
         m_rotationSpeed = 1.0f;
+        m_instanceCulling = InstanceCulling::Linear;
+        m_occlusionCulling = false;
+        m_sceneMesh = 0;
 
-        // 默认平面顶点 (两个三角形组成矩形)
+        // 默认平面顶点 (两个三角形组成矩形，不带索引: 加载时由 MeshOptimizer 去重为4个顶点)
         m_vertices = {
             // 第一个三角形
             { glm::vec3(-1.0f, -1.0f, 0.0f), glm::vec2(0.0f, 0.0f) },
@@ -41,28 +69,68 @@ public:
         };
     }
 
-    // IRenderConfig 接口实现
-    const std::string& vertexShaderSource() const override { return m_vertexShader; }
-    const std::string& fragmentShaderSource() const override { return m_fragmentShader; }
+    // IRenderConfig 接口实现 (实例化模式使用带逐实例属性的着色器)
+    const std::string& vertexShaderSource() const override {
+        return isInstanced() ? m_instancedVertexShader : m_vertexShader;
+    }
+    const std::string& fragmentShaderSource() const override {
+        return isInstanced() ? m_instancedFragmentShader : m_fragmentShader;
+    }
     glm::vec4 clearColor() const override { return m_clearColor; }
     float rotationSpeed() const override { return m_rotationSpeed; }
 
     const void* vertexData() const override { return m_vertices.data(); }
     size_t vertexCount() const override { return m_vertices.size(); }
     size_t vertexStride() const override { return sizeof(CubeVertex); }
+    const uint32_t* indexData() const override { return m_indices.empty() ? nullptr : m_indices.data(); }
+    size_t indexCount() const override { return m_indices.size(); }
+    VertexFormat vertexFormat() const override { return m_vertexFormat; }
 
     // Cube 专用访问器
     const std::vector<CubeVertex>& vertices() const { return m_vertices; }
+    const std::vector<uint32_t>& indices() const { return m_indices; }
+    const std::vector<CubeInstance>& instances() const { return m_instances; }
+    bool isInstanced() const { return !m_instances.empty() || m_scene; }
+    const std::string& texturePath() const { return m_texturePath; }
+    const std::shared_ptr<const TextureAtlas>& atlas() const { return m_atlas; }
+    InstanceCulling instanceCulling() const { return m_instanceCulling; }
+    bool occlusionCulling() const { return m_occlusionCulling; }
+    const std::shared_ptr<Scene>& scene() const { return m_scene; }
+    uint32_t sceneMesh() const { return m_sceneMesh; }
 
     // Builder 方法
     CubeConfig& setVertices(const std::vector<CubeVertex>& v) { m_vertices = v; return *this; }
+    CubeConfig& setIndices(const std::vector<uint32_t>& i) { m_indices = i; return *this; }
+    CubeConfig& setVertexFormat(const VertexFormat& f) { m_vertexFormat = f; return *this; }
+    CubeConfig& setInstances(const std::vector<CubeInstance>& i) { m_instances = i; return *this; }
+    // 漫反射贴图 (经 TextureManager::active() 异步加载)；为空时使用纹理坐标渐变
+    CubeConfig& setTexturePath(const std::string& path) { m_texturePath = path; return *this; }
+    // 实例化模式: 各实例按 textureIndex 从已构建的图集采样，所有实例一次绑定、一次绘制 (优先于 texturePath)
+    CubeConfig& setAtlas(const std::shared_ptr<const TextureAtlas>& atlas) { m_atlas = atlas; return *this; }
+    CubeConfig& setInstanceCulling(InstanceCulling c) { m_instanceCulling = c; return *this; }
+    // 实例化模式: occluder 实例 (场景模式下为带 Occluder 组件的实体) 每帧在CPU上光栅化为低分辨率深度，被其完全挡住的实例不再提交
+    CubeConfig& setOcclusionCulling(bool enabled) { m_occlusionCulling = enabled; return *this; }
+    // 实例来自场景 (优先于 setInstances): 每帧绘制带 Transform/Bounds/MeshRef/MaterialRef 且 MeshRef::mesh == mesh 的实体，
+    // 变换由场景逻辑更新，渲染器不再叠加旋转；MaterialRef::texture 为图集子纹理下标
+    CubeConfig& setScene(const std::shared_ptr<Scene>& scene, uint32_t mesh = 0) { m_scene = scene; m_sceneMesh = mesh; return *this; }
     CubeConfig& setClearColor(const glm::vec4& c) { m_clearColor = c; return *this; }
     CubeConfig& setRotationSpeed(float s) { m_rotationSpeed = s; return *this; }
 
 private:
     std::string m_vertexShader;
     std::string m_fragmentShader;
+    std::string m_instancedVertexShader;
+    std::string m_instancedFragmentShader;
     std::vector<CubeVertex> m_vertices;
+    std::vector<uint32_t> m_indices;
+    VertexFormat m_vertexFormat;
+    std::vector<CubeInstance> m_instances;
+    std::string m_texturePath;
+    std::shared_ptr<const TextureAtlas> m_atlas;
+    InstanceCulling m_instanceCulling;
+    bool m_occlusionCulling;
+    std::shared_ptr<Scene> m_scene;
+    uint32_t m_sceneMesh;
     glm::vec4 m_clearColor;
     float m_rotationSpeed;
 };
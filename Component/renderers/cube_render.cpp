@@ -1,17 +1,24 @@
-#ifdef USE_CUBE_RENDER
-
 #include "cube_render.hpp"
 #include <iostream>
 
 CubeRender::CubeRender()
     : m_vao(0)
     , m_vbo(0)
+    , m_instanceVbo(0)
+    , m_instanceSource(0)
+    , m_instanceOffset(0)
+    , m_dequantize(1.0f)
+    , m_sceneMesh(0)
+    , m_culling(InstanceCulling::Linear)
+    , m_boundsCenter(0.0f)
+    , m_boundsExtents(0.0f)
     , m_projection(1.0f)
     , m_clearColor(0.1f, 0.1f, 0.1f, 1.0f)
     , m_rotationSpeed(1.0f)
     , m_currentAngle(0.0f)
     , m_vertexCount(0)
     , m_initialized(false)
+    , m_shaderReady(false)
 { }
 
 CubeRender::~CubeRender() {
@@ -26,17 +33,65 @@ bool CubeRender::initialize(const IRenderConfig& config) {
         return false;
     }
 
-    if (!m_shader.loadFromSource(config.vertexShaderSource(), config.fragmentShaderSource())) {
-        this->reportError(RenderError::ShaderCompilationFailed, "Failed to compile shader:" + m_shader.lastError());
+    // 正式着色器异步编译，完成前用占位程序绘制，首帧不再等待编译
+    ShaderCompileHandle compile = m_shader.loadFromSourceAsync(config.vertexShaderSource(), config.fragmentShaderSource());
+    if (compile.status() == ShaderCompileStatus::Failed) {
+        this->reportError(RenderError::ShaderCompilationFailed, "Failed to compile shader:" + compile.error());
+        return false;
+    }
+
+    if (!m_placeholder.create()) {
+        reportError(RenderError::ShaderCompilationFailed, "Failed to compile placeholder shader:" + m_placeholder.lastError());
+        return false;
+    }
+
+    // 图集只用于实例化绘制 (子纹理区域是逐实例属性)；须先于 finishShader 确定采样器
+    if (cubeConfig->atlas()) {
+        if (!cubeConfig->isInstanced() || !cubeConfig->atlas()->isBuilt()) {
+            reportError(RenderError::InitializationFailed, "Texture atlas requires instances and a built atlas");
+            return false;
+        }
+        m_atlas = cubeConfig->atlas();
+    }
+
+    // 贴图异步加载，就绪前 glTexture() 返回占位纹理；须先于 finishShader 确定 hasTexture
+    if (!m_atlas && !cubeConfig->texturePath().empty()) {
+        TextureManager* textures = TextureManager::active();
+        if (textures) {
+            m_texture = textures->load(cubeConfig->texturePath());
+        } else {
+            std::cerr << "CubeRender: No active TextureManager, ignoring texture " << cubeConfig->texturePath() << std::endl;
+        }
+    }
+
+    // 缓存命中或同步回退时已经就绪
+    if (m_shader.pollAsync() == ShaderCompileStatus::Ready && !finishShader()) {
         return false;
     }
 
     // 初始化几何体
-    if (!initializeGeometry(cubeConfig->vertices())) {
+    if (!initializeGeometry(cubeConfig->vertices(), cubeConfig->indices(), config.vertexFormat())) {
         reportError(RenderError::BufferCreationFailed, "Failed to create vertex buffer");
         return false;
     }
 
+    // 实例化模式: 逐实例变换/颜色缓冲
+    m_culling = cubeConfig->instanceCulling();
+    if (cubeConfig->occlusionCulling() && cubeConfig->isInstanced()) {
+        m_occlusion.reset(new OcclusionCuller());
+    }
+    if (cubeConfig->scene()) {
+        m_scene = cubeConfig->scene();
+        m_sceneMesh = cubeConfig->sceneMesh();
+        if (!initializeInstanceBuffer()) {
+            reportError(RenderError::BufferCreationFailed, "Failed to create instance buffer");
+            return false;
+        }
+    } else if (cubeConfig->isInstanced() && !initializeInstances(cubeConfig->instances())) {
+        reportError(RenderError::BufferCreationFailed, "Failed to create instance buffer");
+        return false;
+    }
+
     // 保存配置
     m_clearColor = config.clearColor();
     m_rotationSpeed = config.rotationSpeed();
@@ -45,47 +100,379 @@ bool CubeRender::initialize(const IRenderConfig& config) {
     return true;
 }
 
-bool CubeRender::initializeGeometry(const std::vector<CubeVertex>& vertices) {
-    if (vertices.empty()) {
+bool CubeRender::initializeGeometry(const std::vector<CubeVertex>& sourceVertices, const std::vector<uint32_t>& sourceIndices, const VertexFormat& format) {
+    if (sourceVertices.empty()) {
         return false;
     }
 
+    // 加载期优化: 去重生成索引 + 顶点缓存重排
+    std::vector<CubeVertex> vertices = sourceVertices;
+    std::vector<uint32_t> indices = sourceIndices;
+    const MeshOptimizeStats meshStats = MeshOptimizer::optimizeMesh(vertices, indices);
+    if (indices.empty()) {
+        return false;
+    }
+    std::cout << "CubeRender: " << meshStats.verticesBefore << " -> " << meshStats.verticesAfter
+              << " vertices, ACMR " << meshStats.acmrBefore << " -> " << meshStats.acmrAfter << std::endl;
+
     this->m_vertexCount = static_cast<int>(vertices.size());
 
+    // 实例剔除用的模型空间包围盒
+    glm::vec3 boundsMin = vertices[0].position;
+    glm::vec3 boundsMax = vertices[0].position;
+    for (const CubeVertex& vertex : vertices) {
+        boundsMin = glm::min(boundsMin, vertex.position);
+        boundsMax = glm::max(boundsMax, vertex.position);
+    }
+    this->m_boundsCenter = (boundsMin + boundsMax) * 0.5f;
+    this->m_boundsExtents = (boundsMax - boundsMin) * 0.5f;
+    this->m_meshPositions.resize(vertices.size());
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        this->m_meshPositions[i] = vertices[i].position;
+    }
+    this->m_meshIndices = indices;
+
+    // 按配置的格式打包: 位置 (location = 0)、纹理坐标 (location = 1)
+    VertexStreamBuilder builder(vertices.size());
+    builder.addPosition(0, format.position, &vertices[0].position, sizeof(CubeVertex));
+    builder.addTexCoord(1, format.texCoord, &vertices[0].texCoord, sizeof(CubeVertex));
+    const VertexStream stream = builder.build();
+    this->m_dequantize = stream.dequantize;
+
+    GLStateCache& state = GLStateCache::current();
+
     // VAO 
     glGenVertexArrays(1, &this->m_vao);
-    glBindVertexArray(this->m_vao);
+    state.bindVertexArray(this->m_vao);
 
     // VBO
     glGenBuffers(1, &this->m_vbo);
-    glBindBuffer(GL_ARRAY_BUFFER, this->m_vbo);
-    glBufferData(GL_ARRAY_BUFFER, this->m_vertexCount * sizeof(CubeVertex), vertices.data(), GL_STATIC_DRAW);
+    state.bindBuffer(GL_ARRAY_BUFFER, this->m_vbo);
+    glBufferData(GL_ARRAY_BUFFER, stream.data.size(), stream.data.data(), GL_STATIC_DRAW);
+    stream.applyAttributes();
 
-    // 位置属性 (location = 0)
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(CubeVertex), (void*)0);
+    // 索引缓冲 (记录在VAO中)
+    if (!this->m_indexBuffer.create(indices.data(), indices.size(), vertices.size())) {
+        state.bindVertexArray(0);
+        return false;
+    }
 
-    // 纹理坐标属性 (location = 1)
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(CubeVertex), (void*)offsetof(CubeVertex, texCoord));
+    state.bindVertexArray(0);
+    return true;
+}
+
+bool CubeRender::initializeInstances(const std::vector<CubeInstance>& instances) {
+    if (instances.empty() || m_vao == 0) {
+        return false;
+    }
 
-    glBindVertexArray(0);
+    m_instances = instances;
+    m_instanceData.resize(m_instances.size());
+    m_instanceBounds.resize(m_instances.size());
+
+    // 子纹理区域不随帧变化，只写一次
+    for (size_t i = 0; i < m_instances.size(); ++i) {
+        AtlasRegion region;
+        if (m_atlas) {
+            if (m_instances[i].textureIndex >= m_atlas->regions().size()) {
+                std::cerr << "CubeRender: Instance " << i << " textureIndex " << m_instances[i].textureIndex
+                          << " is out of range" << std::endl;
+                return false;
+            }
+            region = m_atlas->region(m_instances[i].textureIndex);
+        }
+        m_instanceData[i].atlasRect = region.uvRect;
+        m_instanceData[i].atlasLayer = static_cast<float>(region.layer);
+    }
+    return initializeInstanceBuffer();
+}
+
+bool CubeRender::initializeInstanceBuffer() {
+    if (m_vao == 0) {
+        return false;
+    }
+
+    GLStateCache& state = GLStateCache::current();
+    state.bindVertexArray(m_vao);
+
+    // 每帧都会整体重写，使用 GL_STREAM_DRAW
+    glGenBuffers(1, &m_instanceVbo);
+    state.bindBuffer(GL_ARRAY_BUFFER, m_instanceVbo);
+    glBufferData(GL_ARRAY_BUFFER, m_instanceData.size() * sizeof(InstanceData), nullptr, GL_STREAM_DRAW);
+
+    // 模型矩阵 (location = 2~5, 每列一个vec4)、实例颜色 (6)、图集子纹理区域与层号 (7, 8)
+    for (GLuint location = 2; location <= 8; ++location) {
+        glEnableVertexAttribArray(location);
+        glVertexAttribDivisor(location, 1);
+    }
+    state.bindVertexArray(0);
+
+    m_instanceSource = 0;
+    pointInstanceAttributes(m_instanceVbo, 0);
     return true;
 }
 
+void CubeRender::pointInstanceAttributes(GLuint buffer, GLintptr offset) {
+    // 流缓冲每帧换偏移 (区域轮换)，只在来源变化时重新设置属性指针
+    if (buffer == m_instanceSource && offset == m_instanceOffset) {
+        return;
+    }
+    m_instanceSource = buffer;
+    m_instanceOffset = offset;
+
+    GLStateCache& state = GLStateCache::current();
+    state.bindVertexArray(m_vao);
+    state.bindBuffer(GL_ARRAY_BUFFER, buffer);
+    const GLsizei stride = sizeof(InstanceData);
+    for (GLuint column = 0; column < 4; ++column) {
+        glVertexAttribPointer(2 + column, 4, GL_FLOAT, GL_FALSE, stride,
+                              (void*)(offset + offsetof(InstanceData, model) + sizeof(glm::vec4) * column));
+    }
+    glVertexAttribPointer(6, 4, GL_FLOAT, GL_FALSE, stride, (void*)(offset + offsetof(InstanceData, color)));
+    glVertexAttribPointer(7, 4, GL_FLOAT, GL_FALSE, stride, (void*)(offset + offsetof(InstanceData, atlasRect)));
+    glVertexAttribPointer(8, 1, GL_FLOAT, GL_FALSE, stride, (void*)(offset + offsetof(InstanceData, atlasLayer)));
+    state.bindVertexArray(0);
+}
+
+void CubeRender::bindStreamedInstances(void* owner, GLuint buffer, GLintptr offset) {
+    static_cast<CubeRender*>(owner)->pointInstanceAttributes(buffer, offset);
+}
+
+size_t CubeRender::cullInstances(const glm::mat4& viewProjection, uint64_t& culled, uint64_t& occluded) {
+    // 只访问CPU数据，可在工作线程上执行 (收集阶段再经 JobSystem 分段)
+    if (m_occlusion) {
+        m_occlusion->beginFrame(viewProjection);
+    }
+    if (m_scene) {
+        gatherSceneInstances();
+    } else {
+        gatherInstances();
+    }
+    const size_t instanceCount = m_instanceBounds.size();
+
+    // 只上传视锥内的实例，绘制的实例数随之减少
+    const Frustum frustum = Frustum::fromMatrix(viewProjection);
+    switch (m_culling) {
+    case InstanceCulling::None:
+        m_visibleInstances.resize(instanceCount);
+        for (size_t i = 0; i < m_visibleInstances.size(); ++i) {
+            m_visibleInstances[i] = static_cast<uint32_t>(i);
+        }
+        break;
+    case InstanceCulling::Linear:
+        FrustumCulling::cull(frustum, m_instanceBounds, CullShape::Aabb, m_visibleInstances);
+        break;
+    case InstanceCulling::Bvh:
+        // 包围盒逐帧变化很小时只需 refit；实例数变化 (场景增删实体) 时自动重建
+        m_instanceBvh.update(m_instanceBounds);
+        m_instanceBvh.cull(frustum, m_instanceBounds, m_visibleInstances);
+        break;
+    }
+    culled = instanceCount - m_visibleInstances.size();
+
+    // 再剔除被遮挡体完全挡住的实例 (遮挡体自身深度相同，不会被自己剔除)
+    occluded = 0;
+    if (m_occlusion) {
+        m_occlusion->rasterize();
+        occluded = m_occlusion->cull(m_instanceBounds, m_visibleInstances);
+    }
+    return m_visibleInstances.size();
+}
+
+void CubeRender::writeVisibleInstances(InstanceData* out) const {
+    for (size_t i = 0; i < m_visibleInstances.size(); ++i) {
+        out[i] = m_instanceData[m_visibleInstances[i]];
+    }
+}
+
+size_t CubeRender::updateInstances(const glm::mat4& viewProjection) {
+    uint64_t culled = 0;
+    uint64_t occluded = 0;
+    const size_t visibleCount = cullInstances(viewProjection, culled, occluded);
+    RenderStats::addCulled(culled);
+    RenderStats::addOccluded(occluded);
+
+    if (visibleCount == 0) {
+        return 0;
+    }
+
+    // 有流缓冲时直接写入映射的区域，不经过 glBufferSubData
+    const size_t bytes = visibleCount * sizeof(InstanceData);
+    StreamBuffer* stream = StreamBuffer::active();
+    const StreamAllocation allocation = stream ? stream->map(bytes) : StreamAllocation();
+    if (allocation.isValid()) {
+        writeVisibleInstances(reinterpret_cast<InstanceData*>(allocation.data));
+        stream->unmap(allocation);
+        pointInstanceAttributes(stream->id(), allocation.offset);
+        return visibleCount;
+    }
+
+    // 先孤立(orphan)旧存储再写入，避免等待GPU读取上一帧的数据
+    m_visibleData.resize(visibleCount);
+    writeVisibleInstances(m_visibleData.data());
+    GLStateCache::current().bindBuffer(GL_ARRAY_BUFFER, m_instanceVbo);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(bytes), nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(bytes), m_visibleData.data());
+    pointInstanceAttributes(m_instanceVbo, 0);
+    return visibleCount;
+}
+
+void CubeRender::gatherInstances() {
+    // 逐实例旋转: 基础变换 x 绕Z轴旋转 (角度按实例倍率缩放)；各实例只写自己的槽位，可分段并行
+    const glm::vec3 axis(0.0f, 0.0f, 1.0f);
+    auto gather = [this, &axis](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const CubeInstance& instance = m_instances[i];
+            float angle = glm::radians(m_currentAngle * instance.rotationSpeed);
+            const glm::mat4 transform = glm::rotate(instance.transform, angle, axis);
+            m_instanceData[i].model = transform * m_dequantize;
+            m_instanceData[i].color = instance.color;
+            m_instanceBounds.setTransformed(i, m_boundsCenter, m_boundsExtents, transform);
+        }
+    };
+    JobSystem* jobs = JobSystem::active();
+    if (jobs) {
+        jobs->parallelFor(m_instances.size(), 256, gather);
+    } else {
+        gather(0, m_instances.size());
+    }
+
+    // 遮挡体提交不是线程安全的，收集完成后顺序提交 (遮挡体通常很少，重算变换即可)
+    if (m_occlusion) {
+        for (const CubeInstance& instance : m_instances) {
+            if (instance.occluder) {
+                float angle = glm::radians(m_currentAngle * instance.rotationSpeed);
+                m_occlusion->addOccluder(m_meshPositions.data(), m_meshPositions.size(),
+                                         m_meshIndices.data(), m_meshIndices.size(),
+                                         glm::rotate(instance.transform, angle, axis));
+            }
+        }
+    }
+}
+
+void CubeRender::gatherSceneInstances() {
+    // 按块读取四个组件数组，只认领网格编号相同的实体；变换由场景逻辑写入，这里不叠加旋转
+    const SceneView<Transform, Bounds, MeshRef, MaterialRef> view = m_scene->view<Transform, Bounds, MeshRef, MaterialRef>();
+
+    // 顺序统计每块的匹配数，得到各块的写出起点，之后各块互不重叠 (块表只在本帧有效，从帧分配器分配)
+    FrameVector<SceneChunkRange> chunks;
+    size_t count = 0;
+    view.forEachChunk([&](size_t chunkCount, const Entity*, const Transform* transforms, const Bounds* bounds,
+                          const MeshRef* meshes, const MaterialRef* materials) {
+        size_t matched = 0;
+        for (size_t i = 0; i < chunkCount; ++i) {
+            matched += meshes[i].mesh == m_sceneMesh ? 1 : 0;
+        }
+        if (matched > 0) {
+            chunks.push_back({ chunkCount, transforms, bounds, meshes, materials, count });
+            count += matched;
+        }
+    });
+    m_instanceData.resize(count);
+    m_instanceBounds.resize(count);
+
+    const size_t regionCount = m_atlas ? m_atlas->regions().size() : 0;
+    auto gather = [this, &chunks, regionCount](size_t begin, size_t end) {
+        for (size_t c = begin; c < end; ++c) {
+            const SceneChunkRange& chunk = chunks[c];
+            size_t written = chunk.offset;
+            for (size_t i = 0; i < chunk.count; ++i) {
+                if (chunk.meshes[i].mesh != m_sceneMesh) {
+                    continue;
+                }
+                InstanceData& data = m_instanceData[written];
+                data.model = chunk.transforms[i].world * m_dequantize;
+                data.color = chunk.materials[i].color;
+                // 越界的子纹理下标退回整张纹理 (AtlasRegion 默认值)
+                AtlasRegion region;
+                if (chunk.materials[i].texture < regionCount) {
+                    region = m_atlas->region(chunk.materials[i].texture);
+                }
+                data.atlasRect = region.uvRect;
+                data.atlasLayer = static_cast<float>(region.layer);
+                m_instanceBounds.setTransformed(written, chunk.bounds[i].center, chunk.bounds[i].extents, chunk.transforms[i].world);
+                ++written;
+            }
+        }
+    };
+    JobSystem* jobs = JobSystem::active();
+    if (jobs) {
+        jobs->parallelFor(chunks.size(), 1, gather);
+    } else {
+        gather(0, chunks.size());
+    }
+
+    // 同 gatherInstances: 收集完成后顺序提交带 Occluder 组件的实体
+    if (m_occlusion) {
+        m_scene->view<Transform, MeshRef, Occluder>().forEach([this](const Transform& transform, const MeshRef& mesh, const Occluder&) {
+            if (mesh.mesh == m_sceneMesh) {
+                m_occlusion->addOccluder(m_meshPositions.data(), m_meshPositions.size(),
+                                         m_meshIndices.data(), m_meshIndices.size(), transform.world);
+            }
+        });
+    }
+}
+
+bool CubeRender::finishShader() {
+    // 投影等帧全局数据来自共享的 FrameBlock UBO
+    if (!m_shader.bindUniformBlock("FrameBlock", UniformBinding::Frame, sizeof(FrameUniforms))) {
+        reportError(RenderError::InitializationFailed, m_shader.lastError());
+        return false;
+    }
+
+    // 贴图固定在纹理单元0 (RenderQueue 按 DrawCommand::texture 绑定)，只设置一次
+    // 实例化着色器另有 sampler2DArray: 两种采样器不能指向同一单元，未使用的一个指向单元1
+    m_shader.use();
+    m_shader.setInt("diffuseTexture", m_atlas ? 1 : 0);
+    m_shader.setInt("hasTexture", m_texture.isValid() ? 1 : 0);
+    m_shader.setInt(m_shader.uniformHandle("atlasTexture"), m_atlas ? 0 : 1);
+    m_shader.setInt(m_shader.uniformHandle("hasAtlas"), m_atlas ? 1 : 0);
+
+    // 热路径上的uniform只解析一次
+    m_modelUniform = m_shader.uniformHandle("model");
+    m_shaderReady = true;
+    return true;
+}
 
 void CubeRender::cleanup() {
+    GLStateCache& state = GLStateCache::current();
     if (this->m_vao != 0) {
-        glDeleteBuffers(1, &this->m_vao);
+        state.onVertexArrayDeleted(this->m_vao);
+        glDeleteVertexArrays(1, &this->m_vao);
         this->m_vao = 0;
     }
 
     if (this->m_vbo != 0) {
+        state.onBufferDeleted(this->m_vbo);
         glDeleteBuffers(1, &this->m_vbo);
         this->m_vbo = 0;
     }
+    this->m_indexBuffer.release();
+
+    if (this->m_instanceVbo != 0) {
+        state.onBufferDeleted(this->m_instanceVbo);
+        glDeleteBuffers(1, &this->m_instanceVbo);
+        this->m_instanceVbo = 0;
+    }
+    this->m_instanceSource = 0;
+    this->m_instanceOffset = 0;
+    this->m_instances.clear();
+    this->m_scene.reset();
+    this->m_instanceData.clear();
+    this->m_visibleData.clear();
+    this->m_instanceBounds.clear();
+    this->m_visibleInstances.clear();
+    this->m_instanceBvh.clear();
+    this->m_occlusion.reset();
+    this->m_meshPositions.clear();
+    this->m_meshIndices.clear();
+    this->m_dequantize = glm::mat4(1.0f);
+    this->m_texture = TextureHandle();
+    this->m_atlas.reset();
 
     this->m_shader.release();
+    this->m_placeholder.release();
+    this->m_shaderReady = false;
     this->m_initialized = false;
 }
 
@@ -123,6 +510,86 @@ bool CubeRender::render(const RenderContext& context) {
     glClearColor(m_clearColor.x, m_clearColor.y, m_clearColor.z, m_clearColor.w);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
+    // 单独使用时也走命令队列，与多渲染器合帧的提交路径一致
+    m_queue.clear();
+    if (!record(context, m_queue)) {
+        return false;
+    }
+    m_queue.submit();
+    return true;
+}
+
+bool CubeRender::record(const RenderContext& context, RenderQueue& queue) {
+    // 投影矩阵等帧全局数据已由帧循环写入 FrameBlock UBO
+    if (!m_initialized) {
+        reportError(RenderError::InitializationFailed, "CubeRender not initialized");
+        return false;
+    }
+
+    if (!m_shaderReady) {
+        ShaderCompileStatus status = m_shader.pollAsync();
+        if (status == ShaderCompileStatus::Failed) {
+            reportError(RenderError::ShaderCompilationFailed, "Failed to compile shader:" + m_shader.lastError());
+            return false;
+        }
+        if (status == ShaderCompileStatus::Ready && !finishShader()) {
+            return false;
+        }
+    }
+
+    glm::mat4 modelMatrix;
+    DrawCommand command = prepareCommand(modelMatrix);
+    if (!m_shaderReady) {
+        // 占位: 单个纯色立方体 (占位程序不读取实例属性)
+        queue.push(command, modelMatrix);
+        return true;
+    }
+
+    if (isInstanced()) {
+        // 实例化: 剔除后流式更新逐实例数据，一次绘制所有可见实例 (实例变换在顶点属性中)
+        // FrameBlock 的视图矩阵为单位阵，视锥与遮挡测试直接使用投影矩阵
+        const size_t visibleCount = updateInstances(context.projectionMatrix());
+        if (visibleCount == 0) {
+            return true;
+        }
+        command.instanceCount = static_cast<GLsizei>(visibleCount);
+        queue.push(command);
+        return true;
+    }
+
+    // 视图投影矩阵在 FrameBlock 中，这里只设置逐绘制的模型矩阵
+    queue.push(command, modelMatrix);
+    return true;
+}
+
+bool CubeRender::recordCommands(const RenderContext& context, CommandList& list) {
+    // 与 record() 相同，但逐实例数据直接写入命令流，上传在GL线程回放时发出
+    if (!m_initialized || !m_shaderReady) {
+        return false;
+    }
+
+    glm::mat4 modelMatrix;
+    DrawCommand command = prepareCommand(modelMatrix);
+    if (isInstanced()) {
+        uint64_t culled = 0;
+        uint64_t occluded = 0;
+        const size_t visibleCount = cullInstances(context.projectionMatrix(), culled, occluded);
+        list.addCulled(culled);
+        list.addOccluded(occluded);
+        if (visibleCount == 0) {
+            return true;
+        }
+        writeVisibleInstances(list.streamUpload<InstanceData>(m_instanceVbo, visibleCount, &CubeRender::bindStreamedInstances, this));
+        command.instanceCount = static_cast<GLsizei>(visibleCount);
+        list.draw(command);
+        return true;
+    }
+
+    list.draw(command, modelMatrix);
+    return true;
+}
+
+DrawCommand CubeRender::prepareCommand(glm::mat4& modelMatrix) {
     // 更新旋转角度
     m_currentAngle += m_rotationSpeed;
     if (m_currentAngle > 360.0f) {
@@ -130,24 +597,37 @@ bool CubeRender::render(const RenderContext& context) {
     }
 
     // 构建模型矩阵
-    glm::mat4 modelMatrix = glm::mat4(1.0f);
+    modelMatrix = glm::mat4(1.0f);
     modelMatrix = glm::translate(modelMatrix, glm::vec3(0.0f, 0.0f, -5.0f));
     modelMatrix = glm::rotate(modelMatrix, glm::radians(m_currentAngle), glm::vec3(0.0f, 0.0f, 1.0f));
+    const float viewDistance = -modelMatrix[3].z;
+    modelMatrix = modelMatrix * m_dequantize;
+
+    DrawCommand command;
+    command.vertexArray = m_vao;
+    command.indexType = m_indexBuffer.type();
+    command.count = m_indexBuffer.count();
+
+    if (!m_shaderReady) {
+        command.program = m_placeholder.programId();
+        command.modelLocation = m_placeholder.modelLocation();
+        command.key = SortKey::opaque(RenderLayer::Opaque, command.program, 0, viewDistance);
+        return command;
+    }
 
-    // MVP矩阵
-    glm::mat4 mvp = context.projectionMatrix() * modelMatrix;
-
-    m_shader.use();
-    m_shader.setMat4("mvp", mvp);
-
-    glBindVertexArray(m_vao);
-    glDrawArrays(GL_TRIANGLES, 0, m_vertexCount);
-    glBindVertexArray(0);
-
-    m_shader.unuse();
+    // 每帧取用: 加载完成后自动从占位纹理切换到实际纹理
+    TextureManager* textures = TextureManager::active();
+    if (m_texture.isValid() && textures) {
+        command.texture = textures->glTexture(m_texture);
+    }
+    if (m_atlas) {
+        command.texture = m_atlas->texture();
+        command.textureTarget = TextureAtlas::kTarget;
+    }
 
-    return true;
+    command.program = m_shader.programId();
+    command.key = SortKey::opaque(RenderLayer::Opaque, command.program, command.texture, viewDistance);
+    // 实例化绘制的模型矩阵在实例属性中，不设置 uniform
+    command.modelLocation = isInstanced() ? -1 : m_modelUniform.location;
+    return command;
 }
-
-
-#endif
\ No newline at end of file
@@ -3,6 +3,23 @@
 #include "../irenderer.hpp"
 #include "../render_context.hpp"
 #include "../shader.hpp"
+#include "../render_stats.hpp"
+#include "../gl_state_cache.hpp"
+#include "../render_queue.hpp"
+#include "../command_list.hpp"
+#include "../index_buffer.hpp"
+#include "../mesh_optimizer.hpp"
+#include "../vertex_format.hpp"
+#include "../frame_uniforms.hpp"
+#include "../placeholder_shader.hpp"
+#include "../texture_manager.hpp"
+#include "../frustum_culling.hpp"
+#include "../bvh.hpp"
+#include "../occlusion_culling.hpp"
+#include "../scene.hpp"
+#include "../job_system.hpp"
+#include "../frame_allocator.hpp"
+#include "../stream_buffer.hpp"
 #include "cube_config.hpp"
 #include "camera.hpp"
 
@@ -17,6 +34,9 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
+#include <memory>
+#include <vector>
+
 class CubeRender : public IRenderer 
 {
 public:
@@ -25,18 +45,78 @@ public:
 
     bool initialize( const IRenderConfig& config ) override;
     bool render( const RenderContext& context ) override;
+    bool usesRenderQueue() const override { return true; }
+    bool record( const RenderContext& context, RenderQueue& queue ) override;
+    bool usesCommandList() const override { return m_initialized && m_shaderReady; }
+    bool recordCommands( const RenderContext& context, CommandList& list ) override;
     bool resize( int width, int height ) override;
     void cleanup() override;
     void setErrorCallback( ErrorCallback callback ) override;
     std::string getName() const override;
+    bool isReady() const override { return m_shaderReady; }
 
 private:
-    bool initializeGeometry( const std::vector<CubeVertex>& vertices );
+    // 逐实例上传到GPU的数据 (与 cube_instanced.vert.glsl 的 location 2~8 对应)
+    struct InstanceData {
+        glm::mat4 model;
+        glm::vec4 color;
+        glm::vec4 atlasRect;    // 子纹理区域 (AtlasRegion::uvRect)，只在初始化时写入
+        float atlasLayer;
+    };
+
+    // 场景模式按块并行收集: 每块的组件数组与写出起点 (先顺序统计网格匹配数)
+    struct SceneChunkRange {
+        size_t count;
+        const Transform* transforms;
+        const Bounds* bounds;
+        const MeshRef* meshes;
+        const MaterialRef* materials;
+        size_t offset;
+    };
+
+    bool initializeGeometry( const std::vector<CubeVertex>& vertices, const std::vector<uint32_t>& indices, const VertexFormat& format );
+    bool initializeInstances( const std::vector<CubeInstance>& instances );
+    bool initializeInstanceBuffer();
+    void pointInstanceAttributes( GLuint buffer, GLintptr offset );
+    static void bindStreamedInstances( void* owner, GLuint buffer, GLintptr offset );
+    DrawCommand prepareCommand( glm::mat4& modelMatrix );
+    size_t cullInstances( const glm::mat4& viewProjection, uint64_t& culled, uint64_t& occluded );
+    void writeVisibleInstances( InstanceData* out ) const;
+    size_t updateInstances( const glm::mat4& viewProjection );
+    void gatherInstances();
+    void gatherSceneInstances();
+    bool isInstanced() const { return !m_instances.empty() || m_scene; }
+    bool finishShader();
     void reportError( RenderError error, const std::string& message );
 
     Shader m_shader;
+    UniformHandle m_modelUniform;
+    PlaceholderShader m_placeholder;    // m_shader 异步编译完成前使用
     GLuint m_vao;
     GLuint m_vbo;
+    IndexBuffer m_indexBuffer;
+    GLuint m_instanceVbo;       // 没有 StreamBuffer (或其区域已满) 时孤立后整体重写
+    GLuint m_instanceSource;    // 实例属性当前指向的缓冲与偏移 (m_instanceVbo 或流缓冲)
+    GLintptr m_instanceOffset;
+    glm::mat4 m_dequantize;     // 量化位置 → 模型空间，右乘到模型矩阵
+    TextureHandle m_texture;    // 无效时不采样纹理
+    std::shared_ptr<const TextureAtlas> m_atlas;    // 实例化模式的图集 (优先于 m_texture)
+
+    // 实例化模式 (m_instances 与 m_scene 都为空时走单次 glDrawElements)
+    std::vector<CubeInstance> m_instances;
+    std::shared_ptr<Scene> m_scene;             // 设置时实例每帧从场景收集 (优先于 m_instances)
+    uint32_t m_sceneMesh;
+    std::vector<InstanceData> m_instanceData;
+    std::vector<InstanceData> m_visibleData;    // 剔除后紧凑排列，实际上传的部分
+    CullingBounds m_instanceBounds;             // 逐实例世界空间 AABB
+    InstanceCulling m_culling;
+    Bvh m_instanceBvh;                          // InstanceCulling::Bvh 时使用
+    std::unique_ptr<OcclusionCuller> m_occlusion;   // CubeConfig::setOcclusionCulling 时创建
+    std::vector<glm::vec3> m_meshPositions;     // 遮挡体光栅化用的模型空间网格 (优化后)
+    std::vector<uint32_t> m_meshIndices;
+    std::vector<uint32_t> m_visibleInstances;
+    glm::vec3 m_boundsCenter;                   // 网格的模型空间 AABB (量化前)
+    glm::vec3 m_boundsExtents;
 
     glm::mat4 m_projection;
     glm::vec4 m_clearColor;
@@ -46,6 +126,9 @@ private:
 
     ErrorCallback m_errorCallback;
     bool m_initialized;
+    bool m_shaderReady;
 
     Camera m_camera;
+
+    RenderQueue m_queue;    // render() 单独使用时的本地队列
 };
\ No newline at end of file
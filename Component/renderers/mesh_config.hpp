@@ -0,0 +1,51 @@
+// mesh_config.hpp
+// 单一职责: Mesh渲染器的专用配置 (顶点/索引来自 .meshbin 资源文件)
+#pragma once
+#include "../irender_config.hpp"
+#include <glm/glm.hpp>
+
+// 包含着色器源码
+#ifdef __ANDROID__
+    #include <mesh/mesh.vert.es.h>
+    #include <mesh/mesh.frag.es.h>
+#else
+    #include <mesh/mesh.vert.core.h>
+    #include <mesh/mesh.frag.core.h>
+#endif
+
+class MeshConfig : public IRenderConfig {
+public:
+    MeshConfig() {
+        m_vertexShader = MESH_VERTEX_SHADER;
+        m_fragmentShader = MESH_FRAGMENT_SHADER;
+        m_assetPath = "assets/model.meshbin";
+        m_clearColor = glm::vec4(0.1f, 0.1f, 0.1f, 1.0f);
+        m_rotationSpeed = 1.0f;
+    }
+
+    // IRenderConfig 接口实现
+    const std::string& vertexShaderSource() const override { return m_vertexShader; }
+    const std::string& fragmentShaderSource() const override { return m_fragmentShader; }
+    glm::vec4 clearColor() const override { return m_clearColor; }
+    float rotationSpeed() const override { return m_rotationSpeed; }
+
+    // 顶点数据在资源文件中 (已按导入时选择的格式打包)，这里不提供
+    const void* vertexData() const override { return nullptr; }
+    size_t vertexCount() const override { return 0; }
+    size_t vertexStride() const override { return 0; }
+
+    // Mesh 专用访问器
+    const std::string& assetPath() const { return m_assetPath; }
+
+    // Builder 方法
+    MeshConfig& setAssetPath(const std::string& path) { m_assetPath = path; return *this; }
+    MeshConfig& setClearColor(const glm::vec4& c) { m_clearColor = c; return *this; }
+    MeshConfig& setRotationSpeed(float s) { m_rotationSpeed = s; return *this; }
+
+private:
+    std::string m_vertexShader;
+    std::string m_fragmentShader;
+    std::string m_assetPath;
+    glm::vec4 m_clearColor;
+    float m_rotationSpeed;
+};
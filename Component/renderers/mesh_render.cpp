@@ -0,0 +1,261 @@
+#include "mesh_render.hpp"
+#include <algorithm>
+#include <iostream>
+
+MeshRender::MeshRender()
+    : m_vao(0)
+    , m_vbo(0)
+    , m_octNormals(false)
+    , m_meshTransform(1.0f)
+    , m_clearColor(0.1f, 0.1f, 0.1f, 1.0f)
+    , m_rotationSpeed(1.0f)
+    , m_currentAngle(0.0f)
+    , m_initialized(false)
+    , m_shaderReady(false)
+{ }
+
+MeshRender::~MeshRender() {
+    this->cleanup();
+}
+
+bool MeshRender::initialize(const IRenderConfig& config) {
+    // 向下转型获取具体配置
+    const auto* meshConfig = dynamic_cast<const MeshConfig*>(&config);
+    if (!meshConfig) {
+        reportError(RenderError::InitializationFailed, "Invalid config type for MeshRender");
+        return false;
+    }
+
+    // 正式着色器异步编译，完成前用占位程序绘制，首帧不再等待编译
+    ShaderCompileHandle compile = m_shader.loadFromSourceAsync(config.vertexShaderSource(), config.fragmentShaderSource());
+    if (compile.status() == ShaderCompileStatus::Failed) {
+        this->reportError(RenderError::ShaderCompilationFailed, "Failed to compile shader:" + compile.error());
+        return false;
+    }
+
+    if (!m_placeholder.create()) {
+        reportError(RenderError::ShaderCompilationFailed, "Failed to compile placeholder shader:" + m_placeholder.lastError());
+        return false;
+    }
+
+    // 几何体先于 finishShader: 法线编码方式由资源文件决定
+    if (!initializeGeometry(meshConfig->assetPath())) {
+        return false;
+    }
+
+    // 缓存命中或同步回退时已经就绪
+    if (m_shader.pollAsync() == ShaderCompileStatus::Ready && !finishShader()) {
+        return false;
+    }
+
+    // 保存配置
+    m_clearColor = config.clearColor();
+    m_rotationSpeed = config.rotationSpeed();
+    m_initialized = true;
+
+    return true;
+}
+
+bool MeshRender::initializeGeometry(const std::string& assetPath) {
+    // 映射文件只校验头部，数据段不经过任何解析直接上传
+    MeshAsset asset;
+    if (!asset.load(assetPath)) {
+        reportError(RenderError::InitializationFailed, "Failed to load mesh asset: " + asset.lastError());
+        return false;
+    }
+
+    const std::vector<VertexAttribute> attributes = asset.attributes();
+    m_octNormals = std::any_of(attributes.begin(), attributes.end(), [](const VertexAttribute& attribute) {
+        return attribute.location == 1 && attribute.components == 2;
+    });
+
+    GLStateCache& state = GLStateCache::current();
+
+    // VAO
+    glGenVertexArrays(1, &this->m_vao);
+    state.bindVertexArray(this->m_vao);
+
+    // VBO
+    glGenBuffers(1, &this->m_vbo);
+    state.bindBuffer(GL_ARRAY_BUFFER, this->m_vbo);
+    glBufferData(GL_ARRAY_BUFFER, asset.vertexBytes(), asset.vertexData(), GL_STATIC_DRAW);
+    applyVertexAttributes(attributes.data(), attributes.size(), asset.vertexStride());
+
+    // 索引缓冲 (记录在VAO中)
+    if (!this->m_indexBuffer.createPacked(asset.indexData(), asset.indexCount(), asset.indexType())) {
+        state.bindVertexArray(0);
+        reportError(RenderError::BufferCreationFailed, "Failed to create index buffer");
+        return false;
+    }
+    state.bindVertexArray(0);
+
+    // 没有子网格表时整体作为一个子网格
+    m_submeshes.assign(asset.submeshes(), asset.submeshes() + asset.submeshCount());
+    if (m_submeshes.empty()) {
+        MeshSubmesh whole;
+        whole.indexCount = static_cast<uint32_t>(asset.indexCount());
+        m_submeshes.push_back(whole);
+    }
+
+    // 缩放到单位球并居中，再右乘位置反量化
+    const glm::vec3 center = (asset.boundsMin() + asset.boundsMax()) * 0.5f;
+    const float radius = std::max(glm::length(asset.boundsMax() - asset.boundsMin()) * 0.5f, 1e-6f);
+    m_meshTransform = glm::scale(glm::mat4(1.0f), glm::vec3(1.0f / radius))
+                    * glm::translate(glm::mat4(1.0f), -center)
+                    * asset.dequantize();
+
+    std::cout << "MeshRender: " << assetPath << " " << asset.vertexCount() << " vertices, "
+              << asset.indexCount() / 3 << " triangles, " << m_submeshes.size() << " submeshes" << std::endl;
+
+    // 数据已在GPU上，解除映射
+    asset.release();
+    return true;
+}
+
+bool MeshRender::finishShader() {
+    // 投影等帧全局数据来自共享的 FrameBlock UBO
+    if (!m_shader.bindUniformBlock("FrameBlock", UniformBinding::Frame, sizeof(FrameUniforms))) {
+        reportError(RenderError::InitializationFailed, m_shader.lastError());
+        return false;
+    }
+
+    // 法线编码在资源生命周期内不变，只设置一次
+    m_shader.use();
+    m_shader.setInt("octNormals", m_octNormals ? 1 : 0);
+
+    // 热路径上的uniform只解析一次
+    m_modelUniform = m_shader.uniformHandle("model");
+    m_shaderReady = true;
+    return true;
+}
+
+void MeshRender::cleanup() {
+    GLStateCache& state = GLStateCache::current();
+    if (this->m_vao != 0) {
+        state.onVertexArrayDeleted(this->m_vao);
+        glDeleteVertexArrays(1, &this->m_vao);
+        this->m_vao = 0;
+    }
+
+    if (this->m_vbo != 0) {
+        state.onBufferDeleted(this->m_vbo);
+        glDeleteBuffers(1, &this->m_vbo);
+        this->m_vbo = 0;
+    }
+    this->m_indexBuffer.release();
+    this->m_submeshes.clear();
+    this->m_meshTransform = glm::mat4(1.0f);
+
+    this->m_shader.release();
+    this->m_placeholder.release();
+    this->m_shaderReady = false;
+    this->m_initialized = false;
+}
+
+void MeshRender::setErrorCallback(ErrorCallback callback) {
+    this->m_errorCallback = callback;
+}
+
+bool MeshRender::resize(int width, int height) {
+    glViewport(0, 0, width, height);
+    return true;
+}
+
+void MeshRender::reportError(RenderError error, const std::string& msg) {
+    std::cerr << "MeshRender Error: " << msg << std::endl;
+    if (m_errorCallback) {
+        m_errorCallback(error, msg);
+    }
+}
+
+bool MeshRender::render(const RenderContext& context) {
+    if (!m_initialized) {
+        reportError(RenderError::InitializationFailed, "MeshRender not initialized");
+        return false;
+    }
+
+    glClearColor(m_clearColor.x, m_clearColor.y, m_clearColor.z, m_clearColor.w);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    // 单独使用时也走命令队列，与多渲染器合帧的提交路径一致
+    m_queue.clear();
+    if (!record(context, m_queue)) {
+        return false;
+    }
+    m_queue.submit();
+    return true;
+}
+
+bool MeshRender::record(const RenderContext& context, RenderQueue& queue) {
+    // 投影矩阵等帧全局数据已由帧循环写入 FrameBlock UBO
+    (void)context;
+
+    if (!m_initialized) {
+        reportError(RenderError::InitializationFailed, "MeshRender not initialized");
+        return false;
+    }
+
+    if (!m_shaderReady) {
+        ShaderCompileStatus status = m_shader.pollAsync();
+        if (status == ShaderCompileStatus::Failed) {
+            reportError(RenderError::ShaderCompilationFailed, "Failed to compile shader:" + m_shader.lastError());
+            return false;
+        }
+        if (status == ShaderCompileStatus::Ready && !finishShader()) {
+            return false;
+        }
+    }
+
+    glm::mat4 modelMatrix;
+    float viewDistance = 0.0f;
+    DrawCommand command = prepareCommand(modelMatrix, viewDistance);
+    for (const MeshSubmesh& submesh : m_submeshes) {
+        command.first = static_cast<GLint>(submesh.firstIndex);
+        command.count = static_cast<GLsizei>(submesh.indexCount);
+        command.key = SortKey::opaque(RenderLayer::Opaque, command.program, submesh.materialIndex, viewDistance);
+        queue.push(command, modelMatrix);
+    }
+    return true;
+}
+
+bool MeshRender::recordCommands(const RenderContext& context, CommandList& list) {
+    // 与 record() 相同，只是命令写入 list (不访问GL状态，可在工作线程执行)
+    (void)context;
+    if (!m_initialized || !m_shaderReady) {
+        return false;
+    }
+
+    glm::mat4 modelMatrix;
+    float viewDistance = 0.0f;
+    DrawCommand command = prepareCommand(modelMatrix, viewDistance);
+    for (const MeshSubmesh& submesh : m_submeshes) {
+        command.first = static_cast<GLint>(submesh.firstIndex);
+        command.count = static_cast<GLsizei>(submesh.indexCount);
+        command.key = SortKey::opaque(RenderLayer::Opaque, command.program, submesh.materialIndex, viewDistance);
+        list.draw(command, modelMatrix);
+    }
+    return true;
+}
+
+DrawCommand MeshRender::prepareCommand(glm::mat4& modelMatrix, float& viewDistance) {
+    // 更新旋转角度
+    m_currentAngle += m_rotationSpeed;
+    if (m_currentAngle > 360.0f) {
+        m_currentAngle -= 360.0f;
+    }
+
+    // 构建模型矩阵
+    modelMatrix = glm::mat4(1.0f);
+    modelMatrix = glm::translate(modelMatrix, glm::vec3(0.0f, 0.0f, -5.0f));
+    modelMatrix = glm::rotate(modelMatrix, glm::radians(m_currentAngle), glm::vec3(0.0f, 1.0f, 0.0f));
+    viewDistance = -modelMatrix[3].z;
+    modelMatrix = modelMatrix * m_meshTransform;
+
+    // 编译完成前用占位程序 (视图投影矩阵在 FrameBlock 中，命令只携带模型矩阵)
+    DrawCommand command;
+    command.program = m_shaderReady ? m_shader.programId() : m_placeholder.programId();
+    command.modelLocation = m_shaderReady ? m_modelUniform.location : m_placeholder.modelLocation();
+    command.vertexArray = m_vao;
+    command.indexType = m_indexBuffer.type();
+    return command;
+}
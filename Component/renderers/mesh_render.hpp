@@ -0,0 +1,78 @@
+#pragma once
+
+#include "../irenderer.hpp"
+#include "../render_context.hpp"
+#include "../shader.hpp"
+#include "../render_stats.hpp"
+#include "../gl_state_cache.hpp"
+#include "../render_queue.hpp"
+#include "../command_list.hpp"
+#include "../index_buffer.hpp"
+#include "../mesh_asset.hpp"
+#include "../frame_uniforms.hpp"
+#include "../placeholder_shader.hpp"
+#include "mesh_config.hpp"
+
+#ifdef __ANDROID__
+    #include <GLES3/gl3.h>
+    #include <GLES3/gl3ext.h>
+#else
+    #include <glad/glad.h>
+#endif
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <vector>
+
+/**
+ * @brief MeshRender - 绘制离线导入的 .meshbin 网格
+ *
+ * 资源文件内存映射后顶点/索引段直接交给 glBufferData，上传完成即解除映射；
+ * 每个子网格记录一条命令 (共享VAO，按 first/count 划分索引范围)。
+ * 模型按包围盒缩放到单位球并放在视图中心，绕Y轴旋转。
+ */
+class MeshRender : public IRenderer
+{
+public:
+    MeshRender();
+    ~MeshRender() override;
+
+    bool initialize( const IRenderConfig& config ) override;
+    bool render( const RenderContext& context ) override;
+    bool usesRenderQueue() const override { return true; }
+    bool record( const RenderContext& context, RenderQueue& queue ) override;
+    bool usesCommandList() const override { return m_initialized && m_shaderReady; }
+    bool recordCommands( const RenderContext& context, CommandList& list ) override;
+    bool resize( int width, int height ) override;
+    void cleanup() override;
+    void setErrorCallback( ErrorCallback callback ) override;
+    std::string getName() const override { return "mesh"; }
+    bool isReady() const override { return m_shaderReady; }
+
+private:
+    bool initializeGeometry( const std::string& assetPath );
+    DrawCommand prepareCommand( glm::mat4& modelMatrix, float& viewDistance );
+    bool finishShader();
+    void reportError( RenderError error, const std::string& message );
+
+    Shader m_shader;
+    UniformHandle m_modelUniform;
+    PlaceholderShader m_placeholder;    // m_shader 异步编译完成前使用
+    GLuint m_vao;
+    GLuint m_vbo;
+    IndexBuffer m_indexBuffer;
+    std::vector<MeshSubmesh> m_submeshes;
+    bool m_octNormals;
+
+    glm::mat4 m_meshTransform;  // 包围盒归一化 x 位置反量化
+    glm::vec4 m_clearColor;
+    float m_rotationSpeed;
+    float m_currentAngle;
+
+    ErrorCallback m_errorCallback;
+    bool m_initialized;
+    bool m_shaderReady;
+
+    RenderQueue m_queue;    // render() 单独使用时的本地队列
+};
@@ -45,12 +45,18 @@ public:
     const void* vertexData() const override { return m_vertices.data(); }
     size_t vertexCount() const override { return m_vertices.size(); }
     size_t vertexStride() const override { return sizeof(TriangleVertex); }
+    const uint32_t* indexData() const override { return m_indices.empty() ? nullptr : m_indices.data(); }
+    size_t indexCount() const override { return m_indices.size(); }
+    VertexFormat vertexFormat() const override { return m_vertexFormat; }
 
     // Triangle 专用访问器
     const std::vector<TriangleVertex>& vertices() const { return m_vertices; }
+    const std::vector<uint32_t>& indices() const { return m_indices; }
 
     // Builder 方法
     TriangleConfig& setVertices(const std::vector<TriangleVertex>& v) { m_vertices = v; return *this; }
+    TriangleConfig& setIndices(const std::vector<uint32_t>& i) { m_indices = i; return *this; }
+    TriangleConfig& setVertexFormat(const VertexFormat& f) { m_vertexFormat = f; return *this; }
     TriangleConfig& setClearColor(const glm::vec4& c) { m_clearColor = c; return *this; }
     TriangleConfig& setRotationSpeed(float s) { m_rotationSpeed = s; return *this; }
 
@@ -58,6 +64,8 @@ private:
     std::string m_vertexShader;
     std::string m_fragmentShader;
     std::vector<TriangleVertex> m_vertices;
+    std::vector<uint32_t> m_indices;
+    VertexFormat m_vertexFormat;
     glm::vec4 m_clearColor;
     float m_rotationSpeed;
 };
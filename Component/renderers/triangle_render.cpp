@@ -1,17 +1,17 @@
-#ifdef USE_TRIANGLE_RENDER
-
 #include "triangle_render.hpp"
 #include <iostream>
 
 TriangleRender::TriangleRender()
     : m_vao(0)
     , m_vbo(0)
+    , m_dequantize(1.0f)
     , m_projection(1.0f)
     , m_clearColor(0.0f, 0.0f, 0.5f, 1.0f)
     , m_rotationSpeed(1.0f)
     , m_currentAngle(0.0f)
     , m_vertexCount(0)
     , m_initialized(false)
+    , m_shaderReady(false)
 {
 }
 
@@ -27,14 +27,25 @@ bool TriangleRender::initialize(const IRenderConfig& config) {
         return false;
     }
 
-    // 使用Shader类从源码加载着色器
-    if (!m_shader.loadFromSource(config.vertexShaderSource(), config.fragmentShaderSource())) {
-        reportError(RenderError::ShaderCompilationFailed,  "Failed to compile shader: " + m_shader.lastError());
+    // 正式着色器异步编译，完成前用占位程序绘制，首帧不再等待编译
+    ShaderCompileHandle compile = m_shader.loadFromSourceAsync(config.vertexShaderSource(), config.fragmentShaderSource());
+    if (compile.status() == ShaderCompileStatus::Failed) {
+        reportError(RenderError::ShaderCompilationFailed,  "Failed to compile shader: " + compile.error());
+        return false;
+    }
+
+    if (!m_placeholder.create()) {
+        reportError(RenderError::ShaderCompilationFailed, "Failed to compile placeholder shader: " + m_placeholder.lastError());
+        return false;
+    }
+
+    // 缓存命中或同步回退时已经就绪
+    if (m_shader.pollAsync() == ShaderCompileStatus::Ready && !finishShader()) {
         return false;
     }
 
     // 初始化几何体
-    if (!initializeGeometry(triangleConfig->vertices())) {
+    if (!initializeGeometry(triangleConfig->vertices(), triangleConfig->indices(), config.vertexFormat())) {
         reportError(RenderError::BufferCreationFailed, "Failed to create vertex buffer");
         return false;
     }
@@ -47,6 +58,19 @@ bool TriangleRender::initialize(const IRenderConfig& config) {
     return true;
 }
 
+bool TriangleRender::finishShader() {
+    // 投影等帧全局数据来自共享的 FrameBlock UBO
+    if (!m_shader.bindUniformBlock("FrameBlock", UniformBinding::Frame, sizeof(FrameUniforms))) {
+        reportError(RenderError::InitializationFailed, m_shader.lastError());
+        return false;
+    }
+
+    // 热路径上的uniform只解析一次
+    m_modelUniform = m_shader.uniformHandle("model");
+    m_shaderReady = true;
+    return true;
+}
+
 bool TriangleRender::render(const RenderContext& context) {
     if (!m_initialized) {
         reportError(RenderError::InitializationFailed, "Renderer not initialized");
@@ -57,6 +81,24 @@ bool TriangleRender::render(const RenderContext& context) {
     glClearColor(m_clearColor.x, m_clearColor.y, m_clearColor.z, m_clearColor.w);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
+    // 单独使用时也走命令队列，与多渲染器合帧的提交路径一致
+    m_queue.clear();
+    if (!record(context, m_queue)) {
+        return false;
+    }
+    m_queue.submit();
+    return true;
+}
+
+bool TriangleRender::record(const RenderContext& context, RenderQueue& queue) {
+    // 投影矩阵等帧全局数据已由帧循环写入 FrameBlock UBO
+    (void)context;
+
+    if (!m_initialized) {
+        reportError(RenderError::InitializationFailed, "Renderer not initialized");
+        return false;
+    }
+
     // 更新旋转角度
     m_currentAngle += m_rotationSpeed;
     if (m_currentAngle > 360.0f) {
@@ -68,19 +110,26 @@ bool TriangleRender::render(const RenderContext& context) {
     modelMatrix = glm::translate(modelMatrix, glm::vec3(0.0f, 0.0f, -5.0f));
     modelMatrix = glm::rotate(modelMatrix, glm::radians(m_currentAngle), glm::vec3(0.0f, 0.0f, 1.0f));
 
-    // MVP矩阵
-    glm::mat4 mvp = context.projectionMatrix() * modelMatrix;
-
-    // 使用着色器并设置uniform
-    m_shader.use();
-    m_shader.setMat4("mvp", mvp);
-
-    // 绑定VAO并绘制
-    glBindVertexArray(m_vao);
-    glDrawArrays(GL_TRIANGLES, 0, m_vertexCount);
-    glBindVertexArray(0);
+    if (!m_shaderReady) {
+        ShaderCompileStatus status = m_shader.pollAsync();
+        if (status == ShaderCompileStatus::Failed) {
+            reportError(RenderError::ShaderCompilationFailed, "Failed to compile shader: " + m_shader.lastError());
+            return false;
+        }
+        if (status == ShaderCompileStatus::Ready && !finishShader()) {
+            return false;
+        }
+    }
 
-    m_shader.unuse();
+    // 编译完成前用占位程序 (视图投影矩阵在 FrameBlock 中，命令只携带模型矩阵)
+    DrawCommand command;
+    command.program = m_shaderReady ? m_shader.programId() : m_placeholder.programId();
+    command.modelLocation = m_shaderReady ? m_modelUniform.location : m_placeholder.modelLocation();
+    command.vertexArray = m_vao;
+    command.indexType = m_indexBuffer.type();
+    command.count = m_indexBuffer.count();
+    command.key = SortKey::opaque(RenderLayer::Opaque, command.program, 0, -modelMatrix[3].z);
+    queue.push(command, modelMatrix * m_dequantize);
 
     return true;
 }
@@ -93,15 +142,22 @@ bool TriangleRender::resize(int width, int height) {
 }
 
 void TriangleRender::cleanup() {
+    GLStateCache& state = GLStateCache::current();
     if (m_vao != 0) {
+        state.onVertexArrayDeleted(m_vao);
         glDeleteVertexArrays(1, &m_vao);
         m_vao = 0;
     }
     if (m_vbo != 0) {
+        state.onBufferDeleted(m_vbo);
         glDeleteBuffers(1, &m_vbo);
         m_vbo = 0;
     }
+    m_indexBuffer.release();
+    m_dequantize = glm::mat4(1.0f);
     m_shader.release();
+    m_placeholder.release();
+    m_shaderReady = false;
     m_initialized = false;
 }
 
@@ -109,32 +165,49 @@ void TriangleRender::setErrorCallback(ErrorCallback callback) {
     m_errorCallback = callback;
 }
 
-bool TriangleRender::initializeGeometry(const std::vector<TriangleVertex>& vertices) {
-    if (vertices.empty()) {
+bool TriangleRender::initializeGeometry(const std::vector<TriangleVertex>& sourceVertices, const std::vector<uint32_t>& sourceIndices, const VertexFormat& format) {
+    if (sourceVertices.empty()) {
+        return false;
+    }
+
+    // 加载期优化: 去重生成索引 + 顶点缓存重排
+    std::vector<TriangleVertex> vertices = sourceVertices;
+    std::vector<uint32_t> indices = sourceIndices;
+    const MeshOptimizeStats meshStats = MeshOptimizer::optimizeMesh(vertices, indices);
+    if (indices.empty()) {
         return false;
     }
+    std::cout << "TriangleRender: " << meshStats.verticesBefore << " -> " << meshStats.verticesAfter
+              << " vertices, ACMR " << meshStats.acmrBefore << " -> " << meshStats.acmrAfter << std::endl;
 
     m_vertexCount = static_cast<int>(vertices.size());
 
+    // 按配置的格式打包: 位置 (location = 0)、颜色 (location = 1)
+    VertexStreamBuilder builder(vertices.size());
+    builder.addPosition(0, format.position, &vertices[0].position, sizeof(TriangleVertex));
+    builder.addColor(1, format.color, &vertices[0].color, sizeof(TriangleVertex));
+    const VertexStream stream = builder.build();
+    m_dequantize = stream.dequantize;
+
+    GLStateCache& state = GLStateCache::current();
+
     // 创建VAO
     glGenVertexArrays(1, &m_vao);
-    glBindVertexArray(m_vao);
+    state.bindVertexArray(m_vao);
 
-    // 创建VBO
+    // 创建VBO并设置顶点属性指针
     glGenBuffers(1, &m_vbo);
-    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-    glBufferData(GL_ARRAY_BUFFER, m_vertexCount * sizeof(TriangleVertex), vertices.data(), GL_STATIC_DRAW);
-
-    // 设置顶点属性指针
-    // 位置属性 (location = 0)
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(TriangleVertex), (void*)0);
+    state.bindBuffer(GL_ARRAY_BUFFER, m_vbo);
+    glBufferData(GL_ARRAY_BUFFER, stream.data.size(), stream.data.data(), GL_STATIC_DRAW);
+    stream.applyAttributes();
 
-    // 颜色属性 (location = 1)
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(TriangleVertex), (void*)offsetof(TriangleVertex, color));
+    // 索引缓冲 (记录在VAO中)
+    if (!m_indexBuffer.create(indices.data(), indices.size(), vertices.size())) {
+        state.bindVertexArray(0);
+        return false;
+    }
 
-    glBindVertexArray(0);
+    state.bindVertexArray(0);
 
     return true;
 }
@@ -145,6 +218,3 @@ void TriangleRender::reportError(RenderError error, const std::string& message)
         m_errorCallback(error, message);
     }
 }
-
-
-#endif
\ No newline at end of file
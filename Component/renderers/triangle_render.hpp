@@ -2,6 +2,14 @@
 #include "../irenderer.hpp"
 #include "../render_context.hpp"
 #include "../shader.hpp"
+#include "../render_stats.hpp"
+#include "../gl_state_cache.hpp"
+#include "../render_queue.hpp"
+#include "../index_buffer.hpp"
+#include "../mesh_optimizer.hpp"
+#include "../vertex_format.hpp"
+#include "../frame_uniforms.hpp"
+#include "../placeholder_shader.hpp"
 #include "triangle_config.hpp"
 
 // 平台条件编译：OpenGL ES (Android) vs OpenGL Core (PC)
@@ -24,18 +32,26 @@ public:
 
     bool initialize(const IRenderConfig& config) override;
     bool render( const RenderContext& context ) override;
+    bool usesRenderQueue() const override { return true; }
+    bool record( const RenderContext& context, RenderQueue& queue ) override;
     bool resize( int width, int height ) override;
     void cleanup() override;
     void setErrorCallback( ErrorCallback callback ) override;
     std::string getName() const override { return "TriangleRender"; };
+    bool isReady() const override { return m_shaderReady; }
 
 private:
-    bool initializeGeometry( const std::vector<TriangleVertex>& vertices );
+    bool initializeGeometry( const std::vector<TriangleVertex>& vertices, const std::vector<uint32_t>& indices, const VertexFormat& format );
+    bool finishShader();
     void reportError( RenderError error, const std::string& message );
 
     Shader m_shader;
+    UniformHandle m_modelUniform;
+    PlaceholderShader m_placeholder;    // m_shader 异步编译完成前使用
     GLuint m_vao;
     GLuint m_vbo;
+    glm::mat4 m_dequantize;     // 量化位置 → 模型空间，右乘到模型矩阵
+    IndexBuffer m_indexBuffer;
     glm::mat4 m_projection;
     glm::vec4 m_clearColor;
     float m_rotationSpeed;
@@ -44,6 +60,9 @@ private:
 
     ErrorCallback m_errorCallback;
     bool m_initialized;
+    bool m_shaderReady;
+
+    RenderQueue m_queue;    // render() 单独使用时的本地队列
 };
 
 
@@ -0,0 +1,291 @@
+#include "scene.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+
+namespace {
+
+// 注册表预留全部槽位，读取已注册类型的大小无需加锁
+struct RegistryState {
+    std::mutex mutex;
+    std::vector<size_t> sizes;
+
+    RegistryState() { sizes.reserve(ComponentRegistry::kMaxComponents); }
+};
+
+RegistryState& registryState() {
+    static RegistryState state;
+    return state;
+}
+
+size_t alignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+// ============ ComponentRegistry ============
+
+ComponentId ComponentRegistry::registerType(size_t size) {
+    RegistryState& state = registryState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if (state.sizes.size() >= kMaxComponents) {
+        std::cerr << "ComponentRegistry: More than " << kMaxComponents << " component types" << std::endl;
+        std::abort();
+    }
+    state.sizes.push_back(size);
+    return static_cast<ComponentId>(state.sizes.size() - 1);
+}
+
+size_t ComponentRegistry::size(ComponentId id) {
+    return registryState().sizes[id];
+}
+
+// ============ SceneArchetype ============
+
+SceneArchetype::SceneArchetype(ComponentMask mask)
+    : m_mask(mask)
+    , m_chunkBytes(kChunkBytes)
+    , m_capacity(1)
+    , m_count(0)
+{
+    std::fill(std::begin(m_offsets), std::end(m_offsets), 0u);
+    std::fill(std::begin(m_sizes), std::end(m_sizes), 0u);
+
+    size_t rowBytes = sizeof(Entity);
+    for (ComponentId id = 0; id < ComponentRegistry::kMaxComponents; ++id) {
+        if (has(id)) {
+            m_components.push_back(id);
+            m_sizes[id] = static_cast<uint32_t>(ComponentRegistry::size(id));
+            rowBytes += m_sizes[id];
+        }
+    }
+
+    // 各数组起点按 64 字节对齐: 从按行宽估计的容量开始减小，直到整体放进一块
+    auto layoutBytes = [this](size_t capacity) {
+        size_t bytes = alignUp(capacity * sizeof(Entity), kChunkAlignment);
+        for (ComponentId id : m_components) {
+            bytes += alignUp(capacity * m_sizes[id], kChunkAlignment);
+        }
+        return bytes;
+    };
+    size_t capacity = std::max<size_t>(1, kChunkBytes / rowBytes);
+    while (capacity > 1 && layoutBytes(capacity) > kChunkBytes) {
+        --capacity;
+    }
+    m_capacity = static_cast<uint32_t>(capacity);
+    m_chunkBytes = std::max(kChunkBytes, layoutBytes(capacity));
+
+    size_t offset = alignUp(capacity * sizeof(Entity), kChunkAlignment);
+    for (ComponentId id : m_components) {
+        m_offsets[id] = static_cast<uint32_t>(offset);
+        offset += alignUp(capacity * m_sizes[id], kChunkAlignment);
+    }
+}
+
+SceneArchetype::~SceneArchetype() {
+    for (SceneChunk& chunk : m_chunks) {
+        ::operator delete(chunk.data, std::align_val_t(kChunkAlignment));
+    }
+}
+
+void SceneArchetype::append(Entity entity, uint32_t& chunkIndex, uint32_t& row) {
+    if (m_chunks.empty() || m_chunks.back().count == m_capacity) {
+        SceneChunk chunk;
+        chunk.data = static_cast<uint8_t*>(::operator new(m_chunkBytes, std::align_val_t(kChunkAlignment)));
+        m_chunks.push_back(chunk);
+    }
+
+    SceneChunk& chunk = m_chunks.back();
+    chunkIndex = static_cast<uint32_t>(m_chunks.size() - 1);
+    row = chunk.count++;
+    entities(chunk)[row] = entity;
+    for (ComponentId id : m_components) {
+        std::memset(static_cast<uint8_t*>(components(chunk, id)) + static_cast<size_t>(row) * m_sizes[id], 0, m_sizes[id]);
+    }
+    m_count++;
+}
+
+Entity SceneArchetype::removeAndFill(uint32_t chunkIndex, uint32_t row) {
+    SceneChunk& last = m_chunks.back();
+    const uint32_t lastRow = last.count - 1;
+    const bool isLast = chunkIndex == m_chunks.size() - 1 && row == lastRow;
+
+    Entity moved;
+    if (!isLast) {
+        SceneChunk& target = m_chunks[chunkIndex];
+        moved = entities(last)[lastRow];
+        entities(target)[row] = moved;
+        for (ComponentId id : m_components) {
+            const size_t size = m_sizes[id];
+            std::memcpy(static_cast<uint8_t*>(components(target, id)) + row * size,
+                        static_cast<const uint8_t*>(components(last, id)) + lastRow * size, size);
+        }
+    }
+
+    last.count--;
+    m_count--;
+    if (last.count == 0) {
+        ::operator delete(last.data, std::align_val_t(kChunkAlignment));
+        m_chunks.pop_back();
+    }
+    return moved;
+}
+
+// ============ Scene ============
+
+Scene::Scene()
+    : m_alive(0)
+{ }
+
+Scene::~Scene() = default;
+
+Entity Scene::createEntity(ComponentMask mask) {
+    Entity entity;
+    if (!m_freeIndices.empty()) {
+        entity.index = m_freeIndices.back();
+        m_freeIndices.pop_back();
+    } else {
+        entity.index = static_cast<uint32_t>(m_records.size());
+        m_records.emplace_back();
+    }
+
+    Record& record = m_records[entity.index];
+    entity.generation = record.generation;
+    record.archetype = archetypeFor(mask);
+    record.archetype->append(entity, record.chunk, record.row);
+    m_alive++;
+    return entity;
+}
+
+bool Scene::destroy(Entity entity) {
+    const Record* found = findRecord(entity);
+    if (!found) {
+        return false;
+    }
+
+    Record& record = m_records[entity.index];
+    removeFromArchetype(record);
+    record.archetype = nullptr;
+    record.generation++;
+    m_freeIndices.push_back(entity.index);
+    m_alive--;
+    return true;
+}
+
+bool Scene::isAlive(Entity entity) const {
+    return findRecord(entity) != nullptr;
+}
+
+void Scene::clear() {
+    // 保留槽位与代数: 清空前取得的句柄全部失效
+    m_freeIndices.clear();
+    for (uint32_t i = static_cast<uint32_t>(m_records.size()); i-- > 0;) {
+        Record& record = m_records[i];
+        if (record.archetype) {
+            record.archetype = nullptr;
+            record.generation++;
+        }
+        m_freeIndices.push_back(i);
+    }
+    m_archetypeByMask.clear();
+    m_archetypes.clear();
+    m_alive = 0;
+}
+
+size_t Scene::chunkCount() const {
+    size_t total = 0;
+    for (const auto& archetype : m_archetypes) {
+        total += archetype->chunks().size();
+    }
+    return total;
+}
+
+const Scene::Record* Scene::findRecord(Entity entity) const {
+    if (entity.index >= m_records.size()) {
+        return nullptr;
+    }
+    const Record& record = m_records[entity.index];
+    if (!record.archetype || record.generation != entity.generation) {
+        return nullptr;
+    }
+    return &record;
+}
+
+void* Scene::componentPointer(Entity entity, ComponentId id) const {
+    const Record* record = findRecord(entity);
+    if (!record || !record->archetype->has(id)) {
+        return nullptr;
+    }
+    const SceneArchetype& archetype = *record->archetype;
+    const SceneChunk& chunk = archetype.chunks()[record->chunk];
+    return static_cast<uint8_t*>(archetype.components(chunk, id)) + static_cast<size_t>(record->row) * archetype.componentSize(id);
+}
+
+bool Scene::addComponent(Entity entity, ComponentId id) {
+    const Record* record = findRecord(entity);
+    if (!record) {
+        return false;
+    }
+    if (!record->archetype->has(id)) {
+        moveEntity(entity, archetypeFor(record->archetype->mask() | (ComponentMask(1) << id)));
+    }
+    return true;
+}
+
+bool Scene::removeComponent(Entity entity, ComponentId id) {
+    const Record* record = findRecord(entity);
+    if (!record || !record->archetype->has(id)) {
+        return false;
+    }
+    moveEntity(entity, archetypeFor(record->archetype->mask() & ~(ComponentMask(1) << id)));
+    return true;
+}
+
+void Scene::moveEntity(Entity entity, SceneArchetype* target) {
+    const Record source = m_records[entity.index];
+    SceneArchetype& from = *source.archetype;
+
+    uint32_t chunkIndex = 0;
+    uint32_t row = 0;
+    target->append(entity, chunkIndex, row);
+
+    // 两个原型共有的组件按字节搬运，新增的组件保持 append 时的零值
+    const SceneChunk& fromChunk = from.chunks()[source.chunk];
+    const SceneChunk& toChunk = target->chunks()[chunkIndex];
+    for (ComponentId id : from.m_components) {
+        if (target->has(id)) {
+            const size_t size = from.m_sizes[id];
+            std::memcpy(static_cast<uint8_t*>(target->components(toChunk, id)) + row * size,
+                        static_cast<const uint8_t*>(from.components(fromChunk, id)) + source.row * size, size);
+        }
+    }
+
+    removeFromArchetype(source);
+    Record& record = m_records[entity.index];
+    record.archetype = target;
+    record.chunk = chunkIndex;
+    record.row = row;
+}
+
+void Scene::removeFromArchetype(const Record& record) {
+    const Entity moved = record.archetype->removeAndFill(record.chunk, record.row);
+    if (moved.isValid()) {
+        m_records[moved.index].chunk = record.chunk;
+        m_records[moved.index].row = record.row;
+    }
+}
+
+SceneArchetype* Scene::archetypeFor(ComponentMask mask) {
+    auto it = m_archetypeByMask.find(mask);
+    if (it != m_archetypeByMask.end()) {
+        return it->second;
+    }
+    m_archetypes.push_back(std::unique_ptr<SceneArchetype>(new SceneArchetype(mask)));
+    SceneArchetype* archetype = m_archetypes.back().get();
+    m_archetypeByMask.emplace(mask, archetype);
+    return archetype;
+}
@@ -0,0 +1,311 @@
+// scene.hpp
+// 单一职责: 场景存储 - 原型 (archetype) ECS，组件组合相同的实体在 16KB 块中按组件连续存放，渲染器按块遍历
+#pragma once
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+// ============ 内置组件 (均为平凡可复制类型，迁移与删除时按字节搬运) ============
+
+struct Transform {
+    glm::mat4 world = glm::mat4(1.0f);          // 模型 → 世界
+};
+
+struct Bounds {
+    glm::vec3 center = glm::vec3(0.0f);         // 模型空间 AABB，渲染器按 Transform 变换到世界空间
+    glm::vec3 extents = glm::vec3(0.0f);
+};
+
+struct MeshRef {
+    uint32_t mesh = 0;                          // 网格编号，渲染器只认领与自身编号相同的实体
+};
+
+struct MaterialRef {
+    glm::vec4 color = glm::vec4(1.0f);
+    uint32_t texture = 0;                       // 图集子纹理下标 (渲染器使用图集时)
+};
+
+// 遮挡体标记: 渲染器开启遮挡剔除时，带此组件的实体按自身网格光栅化到遮挡深度
+struct Occluder { };
+
+/**
+ * @brief 实体句柄: 槽位下标 + 代数，实体删除后槽位复用时代数加一，旧句柄随之失效
+ */
+struct Entity {
+    static constexpr uint32_t kInvalidIndex = 0xFFFFFFFFu;
+
+    uint32_t index = kInvalidIndex;
+    uint32_t generation = 0;
+
+    bool isValid() const { return index != kInvalidIndex; }
+    bool operator==(const Entity& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const Entity& other) const { return !(*this == other); }
+};
+
+using ComponentId = uint32_t;
+using ComponentMask = uint64_t;
+
+/**
+ * @brief 组件类型注册表: 每个类型首次使用时分配编号 (进程内唯一，最多 kMaxComponents 种)
+ */
+class ComponentRegistry {
+public:
+    static constexpr ComponentId kMaxComponents = 64;
+
+    template <typename C>
+    static ComponentId id() {
+        static_assert(std::is_trivially_copyable<C>::value, "Scene components must be trivially copyable");
+        static_assert(alignof(C) <= 64, "Scene components must not need more than 64-byte alignment");
+        static const ComponentId value = registerType(sizeof(C));
+        return value;
+    }
+
+    static size_t size(ComponentId id);
+
+private:
+    static ComponentId registerType(size_t size);
+};
+
+/**
+ * @brief 一个块: 固定 kChunkBytes 字节、64 字节对齐，内部依次是实体数组和每种组件的数组 (各自 64 字节对齐)
+ */
+struct SceneChunk {
+    uint8_t* data = nullptr;
+    uint32_t count = 0;
+};
+
+/**
+ * @brief 原型: 一种组件组合及其全部块。实体在同一原型内紧凑排列，删除时由末尾实体填补空位
+ */
+class SceneArchetype {
+public:
+    static constexpr size_t kChunkBytes = 16 * 1024;
+    static constexpr size_t kChunkAlignment = 64;
+
+    explicit SceneArchetype(ComponentMask mask);
+    ~SceneArchetype();
+
+    SceneArchetype(const SceneArchetype&) = delete;
+    SceneArchetype& operator=(const SceneArchetype&) = delete;
+
+    ComponentMask mask() const { return m_mask; }
+    bool has(ComponentId id) const { return (m_mask >> id) & 1u; }
+    uint32_t chunkCapacity() const { return m_capacity; }
+    size_t size() const { return m_count; }
+    const std::vector<SceneChunk>& chunks() const { return m_chunks; }
+
+    // 块内数组: 调用方保证 has(id)
+    Entity* entities(const SceneChunk& chunk) const { return reinterpret_cast<Entity*>(chunk.data); }
+    void* components(const SceneChunk& chunk, ComponentId id) const { return chunk.data + m_offsets[id]; }
+    size_t componentSize(ComponentId id) const { return m_sizes[id]; }
+
+private:
+    friend class Scene;
+
+    // 在末尾追加一行 (组件内容清零)，返回块号与行号
+    void append(Entity entity, uint32_t& chunkIndex, uint32_t& row);
+    // 末尾实体搬到 (chunkIndex, row)，返回被搬动的实体 (删除的正是末尾实体时返回无效句柄)
+    Entity removeAndFill(uint32_t chunkIndex, uint32_t row);
+
+    ComponentMask m_mask;
+    size_t m_chunkBytes;                        // 通常为 kChunkBytes；单个实体放不下时按一行的大小分配
+    uint32_t m_capacity;                        // 每块实体数
+    uint32_t m_offsets[ComponentRegistry::kMaxComponents];  // 组件数组在块内的字节偏移
+    uint32_t m_sizes[ComponentRegistry::kMaxComponents];
+    std::vector<ComponentId> m_components;
+    std::vector<SceneChunk> m_chunks;           // 只有最后一块可能未满
+    size_t m_count;
+};
+
+template <typename... C>
+class SceneView;
+
+/**
+ * @brief Scene类 - 实体与组件的存储
+ *
+ * 使用方式:
+ *   Scene scene;
+ *   Entity e = scene.create(Transform{ model }, Bounds{ center, extents }, MeshRef{}, MaterialRef{ color, 0 });
+ *   scene.set(e, Spin{ 2.0f });                      // 添加组件: 实体迁移到新的原型
+ *   scene.view<Transform, Spin>().forEach([](Transform& t, Spin& s) { ... });
+ *   scene.view<Transform, MaterialRef>().forEachChunk([](size_t count, const Entity* entities, Transform* t, MaterialRef* m) { ... });
+ *
+ * 遍历时只能读写组件；创建、删除实体或增删组件会移动数据，不能在遍历回调中进行。
+ * 线程约定: 创建、删除实体与修改组件必须在 RenderPipeline::render 之前完成；录制期间场景只读，
+ * 多个渲染器可能在 JobSystem 工作线程上同时读取视图 (见 CubeRender::recordCommands)。
+ */
+class Scene {
+public:
+    Scene();
+    ~Scene();
+
+    // 禁止拷贝
+    Scene(const Scene&) = delete;
+    Scene& operator=(const Scene&) = delete;
+
+    template <typename... C>
+    Entity create(const C&... components) {
+        const Entity entity = createEntity(maskOf<C...>());
+        int expand[] = { 0, (new (componentPointer(entity, ComponentRegistry::id<C>())) C(components), 0)... };
+        (void)expand;
+        return entity;
+    }
+
+    bool destroy(Entity entity);
+    bool isAlive(Entity entity) const;
+    void clear();
+
+    template <typename C>
+    C* get(Entity entity) {
+        return static_cast<C*>(componentPointer(entity, ComponentRegistry::id<C>()));
+    }
+
+    template <typename C>
+    const C* get(Entity entity) const {
+        return static_cast<const C*>(componentPointer(entity, ComponentRegistry::id<C>()));
+    }
+
+    template <typename C>
+    bool has(Entity entity) const {
+        return componentPointer(entity, ComponentRegistry::id<C>()) != nullptr;
+    }
+
+    /**
+     * @brief 设置组件，实体还没有该组件时先迁移到包含它的原型
+     * @return 实体已失效时返回 false
+     */
+    template <typename C>
+    bool set(Entity entity, const C& component) {
+        const ComponentId id = ComponentRegistry::id<C>();
+        if (!addComponent(entity, id)) {
+            return false;
+        }
+        new (componentPointer(entity, id)) C(component);
+        return true;
+    }
+
+    template <typename C>
+    bool remove(Entity entity) {
+        return removeComponent(entity, ComponentRegistry::id<C>());
+    }
+
+    /**
+     * @brief 包含全部 C... 组件的实体视图 (构造时匹配原型，之后新建的原型不在其中)
+     */
+    template <typename... C>
+    SceneView<C...> view() {
+        return SceneView<C...>(m_archetypes, maskOf<C...>());
+    }
+
+    size_t size() const { return m_alive; }
+    size_t archetypeCount() const { return m_archetypes.size(); }
+    size_t chunkCount() const;
+
+    template <typename... C>
+    static ComponentMask maskOf() {
+        ComponentMask mask = 0;
+        int expand[] = { 0, (mask |= ComponentMask(1) << ComponentRegistry::id<C>(), 0)... };
+        (void)expand;
+        return mask;
+    }
+
+private:
+    struct Record {
+        SceneArchetype* archetype = nullptr;    // 空表示槽位空闲
+        uint32_t chunk = 0;
+        uint32_t row = 0;
+        uint32_t generation = 0;
+    };
+
+    Entity createEntity(ComponentMask mask);
+    void* componentPointer(Entity entity, ComponentId id) const;
+    bool addComponent(Entity entity, ComponentId id);
+    bool removeComponent(Entity entity, ComponentId id);
+    void moveEntity(Entity entity, SceneArchetype* target);
+    void removeFromArchetype(const Record& record);
+    SceneArchetype* archetypeFor(ComponentMask mask);
+    const Record* findRecord(Entity entity) const;
+
+    std::vector<std::unique_ptr<SceneArchetype>> m_archetypes;
+    std::unordered_map<ComponentMask, SceneArchetype*> m_archetypeByMask;
+    std::vector<Record> m_records;
+    std::vector<uint32_t> m_freeIndices;
+    size_t m_alive;
+};
+
+/**
+ * @brief 组件视图: 按原型、按块遍历，块内各组件是连续数组 (可直接交给 SIMD 循环)
+ */
+template <typename... C>
+class SceneView {
+public:
+    // 不复制匹配结果 (每帧构造视图不分配内存)，只记住构造时的原型数，遍历时按掩码筛选
+    // (Scene::clear 之后原型减少，只遍历仍存在的部分)
+    SceneView(const std::vector<std::unique_ptr<SceneArchetype>>& archetypes, ComponentMask required)
+        : m_archetypes(&archetypes)
+        , m_archetypeCount(archetypes.size())
+        , m_required(required)
+    { }
+
+    /**
+     * @brief fn(size_t count, const Entity* entities, C*... components)，每块调用一次
+     */
+    template <typename Fn>
+    void forEachChunk(Fn&& fn) const {
+        for (size_t a = 0; a < archetypeCount(); ++a) {
+            const SceneArchetype* archetype = matched(a);
+            if (!archetype) {
+                continue;
+            }
+            for (const SceneChunk& chunk : archetype->chunks()) {
+                if (chunk.count > 0) {
+                    fn(static_cast<size_t>(chunk.count), archetype->entities(chunk),
+                       static_cast<C*>(archetype->components(chunk, ComponentRegistry::id<C>()))...);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief fn(C&... components)，每个实体调用一次
+     */
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        forEachChunk([&fn](size_t count, const Entity*, C*... components) {
+            for (size_t i = 0; i < count; ++i) {
+                fn(components[i]...);
+            }
+        });
+    }
+
+    // 匹配的实体总数
+    size_t size() const {
+        size_t total = 0;
+        for (size_t a = 0; a < archetypeCount(); ++a) {
+            if (const SceneArchetype* archetype = matched(a)) {
+                total += archetype->size();
+            }
+        }
+        return total;
+    }
+
+private:
+    size_t archetypeCount() const {
+        return m_archetypeCount < m_archetypes->size() ? m_archetypeCount : m_archetypes->size();
+    }
+
+    const SceneArchetype* matched(size_t index) const {
+        const SceneArchetype* archetype = (*m_archetypes)[index].get();
+        return (archetype->mask() & m_required) == m_required ? archetype : nullptr;
+    }
+
+    const std::vector<std::unique_ptr<SceneArchetype>>* m_archetypes;
+    size_t m_archetypeCount;
+    ComponentMask m_required;
+};
@@ -1,10 +1,17 @@
 #include "shader.hpp"
+#include "program_binary_cache.hpp"
+#include "gl_state_cache.hpp"
+#include <algorithm>
+#include <chrono>
 #include <fstream>
 #include <sstream>
 #include <iostream>
 
 Shader::Shader()
     : m_programId(0)
+    , m_pendingCacheKey(0)
+    , m_pendingCacheStore(false)
+    , m_pendingStartMs(0.0)
 {
 }
 
@@ -15,9 +22,16 @@ Shader::~Shader() {
 Shader::Shader(Shader&& other) noexcept
     : m_programId(other.m_programId)
     , m_uniformLocationCache(std::move(other.m_uniformLocationCache))
+    , m_uniformBlocks(std::move(other.m_uniformBlocks))
+    , m_uniformTable(std::move(other.m_uniformTable))
     , m_lastError(std::move(other.m_lastError))
+    , m_pendingCompile(std::move(other.m_pendingCompile))
+    , m_pendingCacheKey(other.m_pendingCacheKey)
+    , m_pendingCacheStore(other.m_pendingCacheStore)
+    , m_pendingStartMs(other.m_pendingStartMs)
 {
     other.m_programId = 0;
+    other.m_pendingCompile = ShaderCompileHandle();
 }
 
 Shader& Shader::operator=(Shader&& other) noexcept {
@@ -25,8 +39,15 @@ Shader& Shader::operator=(Shader&& other) noexcept {
         release();
         m_programId = other.m_programId;
         m_uniformLocationCache = std::move(other.m_uniformLocationCache);
+        m_uniformBlocks = std::move(other.m_uniformBlocks);
+        m_uniformTable = std::move(other.m_uniformTable);
         m_lastError = std::move(other.m_lastError);
+        m_pendingCompile = std::move(other.m_pendingCompile);
+        m_pendingCacheKey = other.m_pendingCacheKey;
+        m_pendingCacheStore = other.m_pendingCacheStore;
+        m_pendingStartMs = other.m_pendingStartMs;
         other.m_programId = 0;
+        other.m_pendingCompile = ShaderCompileHandle();
     }
     return *this;
 }
@@ -48,10 +69,68 @@ bool Shader::loadFromFile(const std::string& vertexPath, const std::string& frag
     return loadFromSource(vertexSource, fragmentSource);
 }
 
+namespace {
+ProgramBinaryCache* s_programCache = nullptr;
+ShaderCompileWorker* s_compileWorker = nullptr;
+
+double nowMs() {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+}
+
+void Shader::setProgramCache(ProgramBinaryCache* cache) {
+    s_programCache = cache;
+}
+
+ProgramBinaryCache* Shader::programCache() {
+    return s_programCache;
+}
+
+void Shader::setCompileWorker(ShaderCompileWorker* worker) {
+    s_compileWorker = worker;
+}
+
+ShaderCompileWorker* Shader::compileWorker() {
+    return s_compileWorker;
+}
+
 bool Shader::loadFromSource(const std::string& vertexSource, const std::string& fragmentSource) {
     // 先释放旧的程序
     release();
 
+    ProgramBinaryCache* cache = (s_programCache && s_programCache->isEnabled()) ? s_programCache : nullptr;
+    if (!cache) {
+        return compileAndLink(vertexSource, fragmentSource, false);
+    }
+
+    using Clock = std::chrono::steady_clock;
+    auto start = Clock::now();
+    const uint64_t key = ProgramBinaryCache::computeKey(vertexSource, fragmentSource);
+
+    // 命中: 跳过编译与链接
+    m_programId = glCreateProgram();
+    if (cache->load(key, m_programId)) {
+        onProgramReady();
+        double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        cache->recordHit(ms);
+        std::cout << "Shader: Program cache hit (" << ms << " ms)" << std::endl;
+        return true;
+    }
+    glDeleteProgram(m_programId);
+    m_programId = 0;
+
+    // 未命中或被拒绝: 回退到源码编译，并写回缓存
+    bool success = compileAndLink(vertexSource, fragmentSource, true);
+    if (success) {
+        cache->store(key, m_programId);
+    }
+    double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    cache->recordMiss(ms);
+    std::cout << "Shader: Program cache miss, compiled in " << ms << " ms" << std::endl;
+    return success;
+}
+
+bool Shader::compileAndLink(const std::string& vertexSource, const std::string& fragmentSource, bool retrievable) {
     // 编译顶点着色器
     GLuint vertexShader = compileShader(GL_VERTEX_SHADER, vertexSource);
     if (vertexShader == 0) {
@@ -66,7 +145,7 @@ bool Shader::loadFromSource(const std::string& vertexSource, const std::string&
     }
 
     // 链接程序
-    bool success = linkProgram(vertexShader, fragmentShader);
+    bool success = linkProgram(vertexShader, fragmentShader, retrievable);
 
     // 删除着色器对象（已链接到程序中）
     glDeleteShader(vertexShader);
@@ -75,22 +154,150 @@ bool Shader::loadFromSource(const std::string& vertexSource, const std::string&
     return success;
 }
 
+ShaderCompileHandle Shader::loadFromSourceAsync(const std::string& vertexSource, const std::string& fragmentSource) {
+    release();
+
+    auto job = std::make_shared<ShaderCompileJob>();
+    const bool parallel = hasParallelShaderCompile();
+    ShaderCompileWorker* worker = (s_compileWorker && s_compileWorker->isRunning()) ? s_compileWorker : nullptr;
+
+    // 没有异步手段: 同步编译 (仍然走程序缓存)，返回已完成的句柄
+    if (!parallel && !worker) {
+        const bool success = loadFromSource(vertexSource, fragmentSource);
+        job->program = m_programId;
+        job->error = m_lastError;
+        job->status.store(success ? ShaderCompileStatus::Ready : ShaderCompileStatus::Failed);
+        return ShaderCompileHandle(job);
+    }
+
+    // 缓存命中只需 glProgramBinary，直接同步完成
+    ProgramBinaryCache* cache = (s_programCache && s_programCache->isEnabled()) ? s_programCache : nullptr;
+    m_pendingStartMs = nowMs();
+    m_pendingCacheStore = false;
+    if (cache) {
+        m_pendingCacheKey = ProgramBinaryCache::computeKey(vertexSource, fragmentSource);
+        m_programId = glCreateProgram();
+        if (cache->load(m_pendingCacheKey, m_programId)) {
+            onProgramReady();
+            cache->recordHit(nowMs() - m_pendingStartMs);
+            job->program = m_programId;
+            job->status.store(ShaderCompileStatus::Ready);
+            return ShaderCompileHandle(job);
+        }
+        glDeleteProgram(m_programId);
+        m_programId = 0;
+        m_pendingCacheStore = true;
+    }
+    job->retrievable = m_pendingCacheStore;
+
+    if (parallel) {
+        // 驱动在内部线程编译/链接；此处不查询任何状态，避免强制同步
+        job->mode = ShaderCompileJob::Mode::Parallel;
+        const char* vertexSrc = vertexSource.c_str();
+        const char* fragmentSrc = fragmentSource.c_str();
+
+        job->vertexShader = glCreateShader(GL_VERTEX_SHADER);
+        glShaderSource(job->vertexShader, 1, &vertexSrc, nullptr);
+        glCompileShader(job->vertexShader);
+
+        job->fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
+        glShaderSource(job->fragmentShader, 1, &fragmentSrc, nullptr);
+        glCompileShader(job->fragmentShader);
+
+        job->program = glCreateProgram();
+        glAttachShader(job->program, job->vertexShader);
+        glAttachShader(job->program, job->fragmentShader);
+        if (job->retrievable) {
+            glProgramParameteri(job->program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        }
+        glLinkProgram(job->program);
+    } else {
+        job->vertexSource = vertexSource;
+        job->fragmentSource = fragmentSource;
+        worker->submit(job);
+    }
+
+    m_pendingCompile = ShaderCompileHandle(job);
+    return m_pendingCompile;
+}
+
+ShaderCompileStatus Shader::pollAsync(bool block) {
+    if (!m_pendingCompile.valid()) {
+        return isValid() ? ShaderCompileStatus::Ready : ShaderCompileStatus::Failed;
+    }
+
+    ShaderCompileStatus status = block ? m_pendingCompile.wait() : m_pendingCompile.status();
+    if (status == ShaderCompileStatus::Pending) {
+        return status;
+    }
+
+    std::shared_ptr<ShaderCompileJob> job = m_pendingCompile.job();
+    m_pendingCompile = ShaderCompileHandle();
+
+    if (status == ShaderCompileStatus::Failed) {
+        m_lastError = job->error;
+        std::cerr << "Shader: " << m_lastError << std::endl;
+        if (job->program != 0) {
+            glDeleteProgram(job->program);
+        }
+        return status;
+    }
+
+    m_programId = job->program;
+    onProgramReady();
+
+    if (m_pendingCacheStore && s_programCache) {
+        s_programCache->store(m_pendingCacheKey, m_programId);
+        s_programCache->recordMiss(nowMs() - m_pendingStartMs);
+    }
+    return status;
+}
+
+void Shader::cancelPendingCompile() {
+    if (!m_pendingCompile.valid()) {
+        return;
+    }
+
+    std::shared_ptr<ShaderCompileJob> job = m_pendingCompile.job();
+    m_pendingCompile = ShaderCompileHandle();
+
+    if (job->mode == ShaderCompileJob::Mode::Parallel) {
+        // 主线程独占，直接删除 (驱动会在后台编译结束后回收)
+        glDeleteShader(job->vertexShader);
+        glDeleteShader(job->fragmentShader);
+        glDeleteProgram(job->program);
+        return;
+    }
+
+    // 工作线程可能仍在编译: 已完成则由这里删除，否则由工作线程完成时删除
+    std::lock_guard<std::mutex> lock(job->mutex);
+    job->cancelled = true;
+    if (job->status.load() != ShaderCompileStatus::Pending && job->program != 0) {
+        glDeleteProgram(job->program);
+        job->program = 0;
+    }
+}
+
 void Shader::use() const {
     if (m_programId != 0) {
-        glUseProgram(m_programId);
+        GLStateCache::current().useProgram(m_programId);
     }
 }
 
 void Shader::unuse() const {
-    glUseProgram(0);
+    GLStateCache::current().useProgram(0);
 }
 
 void Shader::release() {
+    cancelPendingCompile();
     if (m_programId != 0) {
+        GLStateCache::current().onProgramDeleted(m_programId);
         glDeleteProgram(m_programId);
         m_programId = 0;
     }
     m_uniformLocationCache.clear();
+    m_uniformBlocks.clear();
+    m_uniformTable.clear();
 }
 
 // ============ Uniform 设置方法实现 ============
@@ -143,6 +350,88 @@ void Shader::setMat4(const std::string& name, const glm::mat4& mat) const {
     glUniformMatrix4fv(getUniformLocation(name), 1, GL_FALSE, glm::value_ptr(mat));
 }
 
+// ============ Uniform 句柄方法实现 ============
+
+UniformHandle Shader::uniformHandle(UniformName name) const {
+    auto it = std::lower_bound(m_uniformTable.begin(), m_uniformTable.end(), name.hash,
+        [](const UniformEntry& entry, uint32_t hash) { return entry.hash < hash; });
+
+    // 同一哈希可能对应多个名字 (冲突)，逐个比对名字
+    for (; it != m_uniformTable.end() && it->hash == name.hash; ++it) {
+        if (it->name == name.name) {
+            return UniformHandle{ it->location };
+        }
+    }
+    return UniformHandle{};
+}
+
+void Shader::setBool(UniformHandle handle, bool value) const {
+    if (handle.isValid()) glUniform1i(handle.location, static_cast<int>(value));
+}
+
+void Shader::setInt(UniformHandle handle, int value) const {
+    if (handle.isValid()) glUniform1i(handle.location, value);
+}
+
+void Shader::setFloat(UniformHandle handle, float value) const {
+    if (handle.isValid()) glUniform1f(handle.location, value);
+}
+
+void Shader::setVec2(UniformHandle handle, const glm::vec2& value) const {
+    if (handle.isValid()) glUniform2fv(handle.location, 1, glm::value_ptr(value));
+}
+
+void Shader::setVec3(UniformHandle handle, const glm::vec3& value) const {
+    if (handle.isValid()) glUniform3fv(handle.location, 1, glm::value_ptr(value));
+}
+
+void Shader::setVec4(UniformHandle handle, const glm::vec4& value) const {
+    if (handle.isValid()) glUniform4fv(handle.location, 1, glm::value_ptr(value));
+}
+
+void Shader::setMat2(UniformHandle handle, const glm::mat2& mat) const {
+    if (handle.isValid()) glUniformMatrix2fv(handle.location, 1, GL_FALSE, glm::value_ptr(mat));
+}
+
+void Shader::setMat3(UniformHandle handle, const glm::mat3& mat) const {
+    if (handle.isValid()) glUniformMatrix3fv(handle.location, 1, GL_FALSE, glm::value_ptr(mat));
+}
+
+void Shader::setMat4(UniformHandle handle, const glm::mat4& mat) const {
+    if (handle.isValid()) glUniformMatrix4fv(handle.location, 1, GL_FALSE, glm::value_ptr(mat));
+}
+
+// ============ Uniform Block 方法实现 ============
+
+const UniformBlockInfo* Shader::uniformBlock(const std::string& blockName) const {
+    for (const auto& block : m_uniformBlocks) {
+        if (block.name == blockName) {
+            return &block;
+        }
+    }
+    return nullptr;
+}
+
+bool Shader::bindUniformBlock(const std::string& blockName, GLuint bindingPoint, GLint expectedSize) {
+    const UniformBlockInfo* block = uniformBlock(blockName);
+    if (!block) {
+        m_lastError = "Uniform block '" + blockName + "' not found";
+        std::cerr << "Shader: " << m_lastError << std::endl;
+        return false;
+    }
+
+    // CPU镜像与GLSL声明不一致时，写入的数据会错位
+    if (expectedSize >= 0 && block->dataSize != expectedSize) {
+        m_lastError = "Uniform block '" + blockName + "' size mismatch: GLSL " + std::to_string(block->dataSize)
+                    + " bytes, CPU " + std::to_string(expectedSize) + " bytes";
+        std::cerr << "Shader: " << m_lastError << std::endl;
+        return false;
+    }
+
+    glUniformBlockBinding(m_programId, block->index, bindingPoint);
+    return true;
+}
+
 // ============ 私有方法实现 ============
 
 std::string Shader::readFile(const std::string& filepath) {
@@ -181,10 +470,14 @@ GLuint Shader::compileShader(GLenum type, const std::string& source) {
     return shader;
 }
 
-bool Shader::linkProgram(GLuint vertexShader, GLuint fragmentShader) {
+bool Shader::linkProgram(GLuint vertexShader, GLuint fragmentShader, bool retrievable) {
     m_programId = glCreateProgram();
     glAttachShader(m_programId, vertexShader);
     glAttachShader(m_programId, fragmentShader);
+    if (retrievable) {
+        // 链接前声明需要取回二进制，部分驱动否则不保留
+        glProgramParameteri(m_programId, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
     glLinkProgram(m_programId);
 
     // 检查链接错误
@@ -202,9 +495,115 @@ bool Shader::linkProgram(GLuint vertexShader, GLuint fragmentShader) {
         return false;
     }
 
+    onProgramReady();
     return true;
 }
 
+void Shader::onProgramReady() {
+    reflectUniformBlocks();
+    buildUniformTable();
+}
+
+void Shader::buildUniformTable() {
+    m_uniformTable.clear();
+
+    GLint uniformCount = 0;
+    glGetProgramiv(m_programId, GL_ACTIVE_UNIFORMS, &uniformCount);
+
+    for (GLint i = 0; i < uniformCount; ++i) {
+        GLchar nameBuffer[256];
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(m_programId, static_cast<GLuint>(i), sizeof(nameBuffer), &length, &size, &type, nameBuffer);
+
+        // uniform块成员没有location，走UBO路径
+        GLint location = glGetUniformLocation(m_programId, nameBuffer);
+        if (location < 0) {
+            continue;
+        }
+
+        // 数组以 "name[0]" 形式返回，按基础名登记
+        std::string name(nameBuffer, static_cast<size_t>(length));
+        if (size > 1 && name.size() > 3 && name.compare(name.size() - 3, 3, "[0]") == 0) {
+            name.resize(name.size() - 3);
+        }
+
+        m_uniformTable.push_back({ fnv1a32(name.c_str(), name.size()), location, name });
+    }
+
+    std::sort(m_uniformTable.begin(), m_uniformTable.end(),
+        [](const UniformEntry& a, const UniformEntry& b) { return a.hash < b.hash; });
+
+    for (size_t i = 1; i < m_uniformTable.size(); ++i) {
+        if (m_uniformTable[i].hash == m_uniformTable[i - 1].hash) {
+            std::cerr << "Shader: Warning - uniform hash collision between '" << m_uniformTable[i - 1].name
+                      << "' and '" << m_uniformTable[i].name << "'" << std::endl;
+        }
+    }
+}
+
+void Shader::reflectUniformBlocks() {
+    m_uniformBlocks.clear();
+
+    GLint blockCount = 0;
+    glGetProgramiv(m_programId, GL_ACTIVE_UNIFORM_BLOCKS, &blockCount);
+
+    for (GLint b = 0; b < blockCount; ++b) {
+        UniformBlockInfo block;
+        block.index = static_cast<GLuint>(b);
+
+        GLint nameLength = 0;
+        glGetActiveUniformBlockiv(m_programId, block.index, GL_UNIFORM_BLOCK_NAME_LENGTH, &nameLength);
+        std::vector<GLchar> nameBuffer(static_cast<size_t>(nameLength > 0 ? nameLength : 1));
+        glGetActiveUniformBlockName(m_programId, block.index, static_cast<GLsizei>(nameBuffer.size()), nullptr, nameBuffer.data());
+        block.name = nameBuffer.data();
+
+        glGetActiveUniformBlockiv(m_programId, block.index, GL_UNIFORM_BLOCK_DATA_SIZE, &block.dataSize);
+
+        GLint memberCount = 0;
+        glGetActiveUniformBlockiv(m_programId, block.index, GL_UNIFORM_BLOCK_ACTIVE_UNIFORMS, &memberCount);
+
+        if (memberCount > 0) {
+            std::vector<GLint> indices(static_cast<size_t>(memberCount));
+            glGetActiveUniformBlockiv(m_programId, block.index, GL_UNIFORM_BLOCK_ACTIVE_UNIFORM_INDICES, indices.data());
+
+            std::vector<GLuint> uindices(indices.begin(), indices.end());
+            std::vector<GLint> offsets(uindices.size());
+            std::vector<GLint> types(uindices.size());
+            std::vector<GLint> sizes(uindices.size());
+            std::vector<GLint> arrayStrides(uindices.size());
+            std::vector<GLint> matrixStrides(uindices.size());
+
+            const GLsizei count = static_cast<GLsizei>(uindices.size());
+            glGetActiveUniformsiv(m_programId, count, uindices.data(), GL_UNIFORM_OFFSET, offsets.data());
+            glGetActiveUniformsiv(m_programId, count, uindices.data(), GL_UNIFORM_TYPE, types.data());
+            glGetActiveUniformsiv(m_programId, count, uindices.data(), GL_UNIFORM_SIZE, sizes.data());
+            glGetActiveUniformsiv(m_programId, count, uindices.data(), GL_UNIFORM_ARRAY_STRIDE, arrayStrides.data());
+            glGetActiveUniformsiv(m_programId, count, uindices.data(), GL_UNIFORM_MATRIX_STRIDE, matrixStrides.data());
+
+            for (size_t i = 0; i < uindices.size(); ++i) {
+                // GLES 3.0 没有 glGetActiveUniformName，用 glGetActiveUniform 取名字
+                GLchar memberName[256];
+                GLint unusedSize = 0;
+                GLenum unusedType = 0;
+                glGetActiveUniform(m_programId, uindices[i], sizeof(memberName), nullptr, &unusedSize, &unusedType, memberName);
+
+                UniformBlockMember member;
+                member.name = memberName;
+                member.offset = offsets[i];
+                member.type = static_cast<GLenum>(types[i]);
+                member.arraySize = sizes[i];
+                member.arrayStride = arrayStrides[i];
+                member.matrixStride = matrixStrides[i];
+                block.members.push_back(member);
+            }
+        }
+
+        m_uniformBlocks.push_back(std::move(block));
+    }
+}
+
 GLint Shader::getUniformLocation(const std::string& name) const {
     // 先查缓存
     auto it = m_uniformLocationCache.find(name);
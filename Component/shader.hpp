@@ -11,8 +11,36 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
+#include "uniform_handle.hpp"
+#include "shader_compile_worker.hpp"
+
+class ProgramBinaryCache;
+
 #include <string>
 #include <unordered_map>
+#include <vector>
+
+/**
+ * @brief uniform块成员的反射信息 (偏移/步长均由驱动按 std140 给出)
+ */
+struct UniformBlockMember {
+    std::string name;
+    GLint offset = 0;
+    GLenum type = 0;
+    GLint arraySize = 1;
+    GLint arrayStride = 0;
+    GLint matrixStride = 0;
+};
+
+/**
+ * @brief uniform块的反射信息
+ */
+struct UniformBlockInfo {
+    std::string name;
+    GLuint index = 0;
+    GLint dataSize = 0;
+    std::vector<UniformBlockMember> members;
+};
 
 /**
  * @brief Shader类 - 封装OpenGL着色器程序的加载、编译和使用
@@ -47,12 +75,35 @@ public:
     bool loadFromSource(const std::string& vertexSource, const std::string& fragmentSource);
 
     /**
-     * @brief 激活着色器程序
+     * @brief 异步编译着色器，立即返回
+     *
+     * 优先级: 程序二进制缓存命中 (同步完成) > GL_KHR_parallel_shader_compile > 共享上下文工作线程 > 同步编译。
+     * 之后每帧调用 pollAsync()，返回 Ready 前 isValid() 为false，渲染器应绘制占位内容。
+     * @return 类 future 的句柄，可用于查询状态或阻塞等待
+     */
+    ShaderCompileHandle loadFromSourceAsync(const std::string& vertexSource, const std::string& fragmentSource);
+
+    /**
+     * @brief 检查异步编译是否完成，完成时接管程序并执行反射 (须在主GL线程调用)
+     * @param block 为true时阻塞到编译结束
+     * @return 没有进行中的编译时按 isValid() 返回 Ready/Failed
+     */
+    ShaderCompileStatus pollAsync(bool block = false);
+
+    /**
+     * @brief 是否有进行中的异步编译
+     */
+    bool isCompiling() const { return m_pendingCompile.valid(); }
+
+    /**
+     * @brief 激活着色器程序 (经 GLStateCache，已是当前程序时不发出GL调用)
      */
     void use() const;
 
     /**
      * @brief 解绑着色器程序
+     *
+     * 渲染循环中不需要调用: 下一个 use() 会直接切换，解绑只会让缓存多发一次调用
      */
     void unuse() const;
 
@@ -90,11 +141,69 @@ public:
     void setMat3(const std::string& name, const glm::mat3& mat) const;
     void setMat4(const std::string& name, const glm::mat4& mat) const;
 
+    // ============ Uniform 句柄 (热路径) ============
+    // 链接时已枚举所有活动uniform并按名称哈希排序，
+    // 渲染器在 initialize 中解析一次句柄，render 中按句柄设置，避免字符串哈希与map查找
+
+    /**
+     * @brief 解析uniform句柄 (二分查找预构建的哈希表，不分配内存)
+     * @return 未找到时返回无效句柄
+     */
+    UniformHandle uniformHandle(UniformName name) const;
+
+    void setBool(UniformHandle handle, bool value) const;
+    void setInt(UniformHandle handle, int value) const;
+    void setFloat(UniformHandle handle, float value) const;
+    void setVec2(UniformHandle handle, const glm::vec2& value) const;
+    void setVec3(UniformHandle handle, const glm::vec3& value) const;
+    void setVec4(UniformHandle handle, const glm::vec4& value) const;
+    void setMat2(UniformHandle handle, const glm::mat2& mat) const;
+    void setMat3(UniformHandle handle, const glm::mat3& mat) const;
+    void setMat4(UniformHandle handle, const glm::mat4& mat) const;
+
+    // ============ Uniform Block (UBO) ============
+
+    /**
+     * @brief 链接后反射得到的所有uniform块
+     */
+    const std::vector<UniformBlockInfo>& uniformBlocks() const { return m_uniformBlocks; }
+
+    /**
+     * @brief 按名称查找uniform块 (未找到返回nullptr)
+     */
+    const UniformBlockInfo* uniformBlock(const std::string& blockName) const;
+
+    /**
+     * @brief 将uniform块绑定到共享的绑定点
+     * @param blockName GLSL中的块名 (如 "FrameBlock")
+     * @param bindingPoint 绑定点 (见 UniformBinding)
+     * @param expectedSize CPU镜像结构体大小，>=0 时与反射得到的 std140 大小校验
+     * @return 块存在且大小匹配时返回true
+     */
+    bool bindUniformBlock(const std::string& blockName, GLuint bindingPoint, GLint expectedSize = -1);
+
     /**
      * @brief 获取最后的错误信息
      */
     std::string lastError() const { return m_lastError; }
 
+    // ============ 程序二进制缓存 ============
+
+    /**
+     * @brief 设置进程级程序二进制缓存 (nullptr 禁用)
+     *
+     * 设置后 loadFromSource 先尝试从缓存加载，未命中或被驱动拒绝时回退到编译并写回缓存。
+     * 缓存对象由调用方持有，需在所有 Shader 加载完成前保持有效。
+     */
+    static void setProgramCache(ProgramBinaryCache* cache);
+    static ProgramBinaryCache* programCache();
+
+    /**
+     * @brief 设置进程级异步编译工作线程 (nullptr 禁用)，无 parallel_shader_compile 扩展时使用
+     */
+    static void setCompileWorker(ShaderCompileWorker* worker);
+    static ShaderCompileWorker* compileWorker();
+
 private:
     /**
      * @brief 从文件读取着色器源码
@@ -109,15 +218,54 @@ private:
     /**
      * @brief 链接着色器程序
      */
-    bool linkProgram(GLuint vertexShader, GLuint fragmentShader);
+    bool linkProgram(GLuint vertexShader, GLuint fragmentShader, bool retrievable);
+
+    /**
+     * @brief 编译+链接 (缓存未命中时的完整路径)
+     */
+    bool compileAndLink(const std::string& vertexSource, const std::string& fragmentSource, bool retrievable);
+
+    /**
+     * @brief 程序就绪后 (链接或二进制加载) 的反射
+     */
+    void onProgramReady();
+
+    /**
+     * @brief 放弃进行中的异步编译 (release 时调用)
+     */
+    void cancelPendingCompile();
 
     /**
      * @brief 获取uniform位置（带缓存）
      */
     GLint getUniformLocation(const std::string& name) const;
 
+    /**
+     * @brief 反射uniform块及其成员布局
+     */
+    void reflectUniformBlocks();
+
+    /**
+     * @brief 枚举活动uniform，构建按名称哈希排序的句柄表
+     */
+    void buildUniformTable();
+
 private:
+    struct UniformEntry {
+        uint32_t hash;
+        GLint location;
+        std::string name;
+    };
+
     GLuint m_programId;
     mutable std::unordered_map<std::string, GLint> m_uniformLocationCache;
+    std::vector<UniformBlockInfo> m_uniformBlocks;
+    std::vector<UniformEntry> m_uniformTable;   // 按 hash 升序
     std::string m_lastError;
+
+    // 进行中的异步编译
+    ShaderCompileHandle m_pendingCompile;
+    uint64_t m_pendingCacheKey;
+    bool m_pendingCacheStore;
+    double m_pendingStartMs;
 };
@@ -0,0 +1,268 @@
+#include "shader_compile_worker.hpp"
+#include <cstring>
+#include <iostream>
+
+namespace {
+
+void finishJob(ShaderCompileJob& job, ShaderCompileStatus status, const std::string& error = std::string()) {
+    {
+        std::lock_guard<std::mutex> lock(job.mutex);
+        job.error = error;
+        job.status.store(status);
+    }
+    job.finished.notify_all();
+}
+
+std::string shaderInfoLog(GLuint shader, const char* typeStr) {
+    GLint compiled = GL_FALSE;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
+    if (compiled) {
+        return std::string();
+    }
+    GLchar infoLog[1024];
+    glGetShaderInfoLog(shader, sizeof(infoLog), nullptr, infoLog);
+    return std::string(typeStr) + " shader compilation failed: " + infoLog;
+}
+
+std::string programInfoLog(GLuint program) {
+    GLchar infoLog[1024];
+    glGetProgramInfoLog(program, sizeof(infoLog), nullptr, infoLog);
+    return std::string("Shader program linking failed: ") + infoLog;
+}
+
+} // namespace
+
+// ============ ShaderCompileHandle ============
+
+ShaderCompileStatus ShaderCompileHandle::status() const {
+    if (!m_job) {
+        return ShaderCompileStatus::Failed;
+    }
+    if (m_job->mode == ShaderCompileJob::Mode::Parallel) {
+        return pollParallelJob(*m_job, false);
+    }
+    return m_job->status.load();
+}
+
+ShaderCompileStatus ShaderCompileHandle::wait() const {
+    if (!m_job) {
+        return ShaderCompileStatus::Failed;
+    }
+    if (m_job->mode == ShaderCompileJob::Mode::Parallel) {
+        return pollParallelJob(*m_job, true);
+    }
+
+    std::unique_lock<std::mutex> lock(m_job->mutex);
+    m_job->finished.wait(lock, [this] { return m_job->status.load() != ShaderCompileStatus::Pending; });
+    return m_job->status.load();
+}
+
+std::string ShaderCompileHandle::error() const {
+    if (!m_job) {
+        return "Invalid compile handle";
+    }
+    std::lock_guard<std::mutex> lock(m_job->mutex);
+    return m_job->error;
+}
+
+// ============ KHR_parallel_shader_compile ============
+
+bool hasParallelShaderCompile() {
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    for (GLint i = 0; i < count; ++i) {
+        const char* name = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i)));
+        if (name && (std::strcmp(name, "GL_KHR_parallel_shader_compile") == 0 ||
+                     std::strcmp(name, "GL_ARB_parallel_shader_compile") == 0)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+ShaderCompileStatus pollParallelJob(ShaderCompileJob& job, bool block) {
+    ShaderCompileStatus status = job.status.load();
+    if (status != ShaderCompileStatus::Pending) {
+        return status;
+    }
+
+    // 未完成时查询 GL_COMPLETION_STATUS_KHR 不会阻塞；block 时直接查询链接状态 (驱动会等待编译结束)
+    if (!block) {
+        GLint completed = GL_FALSE;
+        glGetProgramiv(job.program, GL_COMPLETION_STATUS_KHR, &completed);
+        if (!completed) {
+            return ShaderCompileStatus::Pending;
+        }
+    }
+
+    GLint linked = GL_FALSE;
+    glGetProgramiv(job.program, GL_LINK_STATUS, &linked);
+
+    std::string error;
+    if (!linked) {
+        // 编译错误优先于链接错误，与同步路径的报错一致
+        error = shaderInfoLog(job.vertexShader, "VERTEX");
+        if (error.empty()) {
+            error = shaderInfoLog(job.fragmentShader, "FRAGMENT");
+        }
+        if (error.empty()) {
+            error = programInfoLog(job.program);
+        }
+    }
+
+    glDeleteShader(job.vertexShader);
+    glDeleteShader(job.fragmentShader);
+    job.vertexShader = 0;
+    job.fragmentShader = 0;
+
+    finishJob(job, linked ? ShaderCompileStatus::Ready : ShaderCompileStatus::Failed, error);
+    return job.status.load();
+}
+
+// ============ ShaderCompileWorker ============
+
+ShaderCompileWorker::~ShaderCompileWorker() {
+    stop();
+}
+
+bool ShaderCompileWorker::start(MakeCurrentFunc makeCurrent, DoneCurrentFunc doneCurrent) {
+    if (m_running.load()) {
+        return true;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopRequested = false;
+    }
+    m_startResult = -1;
+    m_thread = std::thread(&ShaderCompileWorker::threadMain, this, std::move(makeCurrent), std::move(doneCurrent));
+
+    std::unique_lock<std::mutex> lock(m_startMutex);
+    m_started.wait(lock, [this] { return m_startResult >= 0; });
+    if (m_startResult == 0) {
+        lock.unlock();
+        m_thread.join();
+        return false;
+    }
+    return true;
+}
+
+void ShaderCompileWorker::stop() {
+    if (!m_thread.joinable()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopRequested = true;
+    }
+    m_wakeup.notify_all();
+    m_thread.join();
+
+    // 没来得及编译的任务不能一直挂起
+    std::deque<std::shared_ptr<ShaderCompileJob>> remaining;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        remaining.swap(m_queue);
+    }
+    for (auto& job : remaining) {
+        finishJob(*job, ShaderCompileStatus::Failed, "Shader compile worker stopped");
+    }
+}
+
+void ShaderCompileWorker::submit(std::shared_ptr<ShaderCompileJob> job) {
+    job->mode = ShaderCompileJob::Mode::Worker;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.push_back(std::move(job));
+    }
+    m_wakeup.notify_one();
+}
+
+void ShaderCompileWorker::threadMain(MakeCurrentFunc makeCurrent, DoneCurrentFunc doneCurrent) {
+    const bool current = makeCurrent && makeCurrent();
+    {
+        std::lock_guard<std::mutex> lock(m_startMutex);
+        m_startResult = current ? 1 : 0;
+    }
+    m_running.store(current);
+    m_started.notify_all();
+    if (!current) {
+        std::cerr << "ShaderCompileWorker: Failed to make shared context current" << std::endl;
+        return;
+    }
+
+    while (true) {
+        std::shared_ptr<ShaderCompileJob> job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wakeup.wait(lock, [this] { return m_stopRequested || !m_queue.empty(); });
+            if (m_stopRequested) {
+                break;
+            }
+            job = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+        compile(*job);
+    }
+
+    m_running.store(false);
+    if (doneCurrent) {
+        doneCurrent();
+    }
+}
+
+void ShaderCompileWorker::compile(ShaderCompileJob& job) {
+    const char* vertexSource = job.vertexSource.c_str();
+    const char* fragmentSource = job.fragmentSource.c_str();
+
+    GLuint vertexShader = glCreateShader(GL_VERTEX_SHADER);
+    glShaderSource(vertexShader, 1, &vertexSource, nullptr);
+    glCompileShader(vertexShader);
+
+    GLuint fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
+    glShaderSource(fragmentShader, 1, &fragmentSource, nullptr);
+    glCompileShader(fragmentShader);
+
+    std::string error = shaderInfoLog(vertexShader, "VERTEX");
+    if (error.empty()) {
+        error = shaderInfoLog(fragmentShader, "FRAGMENT");
+    }
+
+    GLuint program = 0;
+    if (error.empty()) {
+        program = glCreateProgram();
+        glAttachShader(program, vertexShader);
+        glAttachShader(program, fragmentShader);
+        if (job.retrievable) {
+            glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        }
+        glLinkProgram(program);
+
+        GLint linked = GL_FALSE;
+        glGetProgramiv(program, GL_LINK_STATUS, &linked);
+        if (!linked) {
+            error = programInfoLog(program);
+            glDeleteProgram(program);
+            program = 0;
+        }
+    }
+
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+
+    // 共享上下文之间没有隐式同步，结果对主线程可见前必须执行完毕
+    glFinish();
+
+    {
+        std::lock_guard<std::mutex> lock(job.mutex);
+        if (job.cancelled && program != 0) {
+            glDeleteProgram(program);
+            program = 0;
+        }
+        job.program = program;
+        job.error = error;
+        job.status.store(program != 0 ? ShaderCompileStatus::Ready : ShaderCompileStatus::Failed);
+    }
+    job.finished.notify_all();
+}
@@ -0,0 +1,146 @@
+// shader_compile_worker.hpp
+// 单一职责: 异步着色器编译 - 编译任务状态、类 future 句柄与共享上下文工作线程
+#pragma once
+
+// 平台条件编译：OpenGL ES (Android) vs OpenGL Core (PC)
+#ifdef __ANDROID__
+    #include <GLES3/gl3.h>
+    #include <GLES3/gl3ext.h>
+#else
+    #include <glad/glad.h>
+#endif
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// GL_KHR_parallel_shader_compile / GL_ARB_parallel_shader_compile (glad 未生成扩展，手动定义)
+#ifndef GL_COMPLETION_STATUS_KHR
+    #define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
+enum class ShaderCompileStatus {
+    Pending,
+    Ready,
+    Failed
+};
+
+/**
+ * @brief 一次异步编译的共享状态 (Shader、句柄与工作线程共同持有)
+ */
+struct ShaderCompileJob {
+    enum class Mode {
+        Immediate,      // 已在调用线程完成 (缓存命中或同步回退)
+        Parallel,       // 驱动内部并行编译，主线程轮询 GL_COMPLETION_STATUS_KHR
+        Worker          // 共享上下文工作线程编译
+    };
+
+    Mode mode = Mode::Immediate;
+    std::string vertexSource;
+    std::string fragmentSource;
+    bool retrievable = false;       // 链接前设置 GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+
+    GLuint program = 0;
+    GLuint vertexShader = 0;        // 仅 Parallel 模式: 完成后由主线程删除
+    GLuint fragmentShader = 0;
+
+    std::atomic<ShaderCompileStatus> status{ ShaderCompileStatus::Pending };
+    std::string error;              // status == Failed 后有效
+    bool cancelled = false;         // Shader 在完成前被释放: 由最后完成的一方删除程序 (受 mutex 保护)
+
+    std::mutex mutex;
+    std::condition_variable finished;
+};
+
+/**
+ * @brief ShaderCompileHandle - 类 future 的编译句柄
+ *
+ * status()/isReady() 不阻塞; wait() 阻塞到编译结束。
+ * Parallel 模式的查询需要在创建它的GL上下文线程中调用。
+ */
+class ShaderCompileHandle {
+public:
+    ShaderCompileHandle() = default;
+    explicit ShaderCompileHandle(std::shared_ptr<ShaderCompileJob> job)
+        : m_job(std::move(job))
+    {}
+
+    bool valid() const { return m_job != nullptr; }
+
+    ShaderCompileStatus status() const;
+    bool isReady() const { return status() != ShaderCompileStatus::Pending; }
+    ShaderCompileStatus wait() const;
+
+    std::string error() const;
+
+    const std::shared_ptr<ShaderCompileJob>& job() const { return m_job; }
+
+private:
+    std::shared_ptr<ShaderCompileJob> m_job;
+};
+
+/**
+ * @brief 当前上下文是否支持 GL_KHR_parallel_shader_compile (或 ARB 版本)，需要有效的GL上下文
+ */
+bool hasParallelShaderCompile();
+
+/**
+ * @brief 检查 Parallel 模式任务的完成状态 (主线程)，完成时读取链接结果并删除着色器对象
+ */
+ShaderCompileStatus pollParallelJob(ShaderCompileJob& job, bool block);
+
+/**
+ * @brief ShaderCompileWorker - 持有共享GL上下文的编译线程
+ *
+ * 上下文由平台层创建 (GLFW 隐藏窗口 / EGL pbuffer)，通过回调在工作线程中设为当前:
+ *   worker.start([&]{ return makeCurrent(sharedContext); }, [&]{ doneCurrent(); });
+ *   Shader::setCompileWorker(&worker);
+ * 程序对象在共享上下文之间可见；每个任务结束前 glFinish，保证主线程看到完整的链接结果。
+ */
+class ShaderCompileWorker {
+public:
+    using MakeCurrentFunc = std::function<bool()>;
+    using DoneCurrentFunc = std::function<void()>;
+
+    ShaderCompileWorker() = default;
+    ~ShaderCompileWorker();
+
+    ShaderCompileWorker(const ShaderCompileWorker&) = delete;
+    ShaderCompileWorker& operator=(const ShaderCompileWorker&) = delete;
+
+    /**
+     * @brief 启动线程; makeCurrent 失败时线程退出并返回false
+     */
+    bool start(MakeCurrentFunc makeCurrent, DoneCurrentFunc doneCurrent);
+
+    /**
+     * @brief 停止线程 (未开始的任务标记为失败)
+     */
+    void stop();
+
+    bool isRunning() const { return m_running.load(); }
+
+    void submit(std::shared_ptr<ShaderCompileJob> job);
+
+private:
+    void threadMain(MakeCurrentFunc makeCurrent, DoneCurrentFunc doneCurrent);
+    static void compile(ShaderCompileJob& job);
+
+private:
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_wakeup;
+    std::deque<std::shared_ptr<ShaderCompileJob>> m_queue;
+    std::atomic<bool> m_running{ false };
+    bool m_stopRequested = false;
+
+    // start() 等待线程报告上下文是否可用
+    std::mutex m_startMutex;
+    std::condition_variable m_started;
+    int m_startResult = -1;     // -1 未知, 0 失败, 1 成功
+};
@@ -0,0 +1,260 @@
+#include "stream_buffer.hpp"
+#include "gl_state_cache.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+namespace {
+
+StreamBuffer* s_activeBuffer = nullptr;
+
+// 区域起点至少按此对齐 (常见的 GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT 上限)
+constexpr size_t kRegionAlignment = 256;
+
+// Persistent 等待时每次 glClientWaitSync 的超时
+constexpr GLuint64 kWaitTimeoutNs = 1000000;
+
+size_t alignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+} // namespace
+
+StreamBuffer::StreamBuffer()
+    : m_buffer(0)
+    , m_persistent(nullptr)
+    , m_mode(StreamBufferMode::Auto)
+    , m_regionBytes(0)
+    , m_uniformAlignment(kRegionAlignment)
+    , m_region(0)
+    , m_offset(0)
+    , m_overflowBytes(0)
+{ }
+
+StreamBuffer::~StreamBuffer() {
+    release();
+}
+
+bool StreamBuffer::persistentSupported() {
+#ifdef __ANDROID__
+    return false;
+#else
+    GLint major = 0;
+    GLint minor = 0;
+    glGetIntegerv(GL_MAJOR_VERSION, &major);
+    glGetIntegerv(GL_MINOR_VERSION, &minor);
+    return (major > 4 || (major == 4 && minor >= 4)) && glBufferStorage != nullptr;
+#endif
+}
+
+bool StreamBuffer::create(const StreamBufferSettings& settings) {
+    release();
+
+    m_mode = settings.mode;
+    if (m_mode == StreamBufferMode::Auto) {
+        m_mode = persistentSupported() ? StreamBufferMode::Persistent : StreamBufferMode::Unsynchronized;
+    } else if (m_mode == StreamBufferMode::Persistent && !persistentSupported()) {
+        std::cerr << "StreamBuffer: Persistent mapping requires glBufferStorage (GL 4.4)" << std::endl;
+        return false;
+    }
+
+    GLint uniformAlignment = 0;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &uniformAlignment);
+    m_uniformAlignment = std::max<size_t>(static_cast<size_t>(uniformAlignment), kDefaultAlignment);
+
+    m_fences.assign(std::max(1u, settings.regions), nullptr);
+    return allocateStorage(std::max<size_t>(settings.regionBytes, kDefaultAlignment));
+}
+
+void StreamBuffer::release() {
+    releaseStorage();
+    m_fences.clear();
+    m_regionBytes = 0;
+    m_stats = StreamBufferStats();
+}
+
+bool StreamBuffer::allocateStorage(size_t regionBytes) {
+    // 先生成新名字再删除旧缓冲: 名字一定不同，按 (缓冲, 偏移) 缓存顶点属性的使用者不会误判
+    GLuint buffer = 0;
+    glGenBuffers(1, &buffer);
+    releaseStorage();
+    m_buffer = buffer;
+
+    m_regionBytes = alignUp(regionBytes, std::max(kRegionAlignment, m_uniformAlignment));
+    const GLsizeiptr totalBytes = static_cast<GLsizeiptr>(m_regionBytes * m_fences.size());
+    GLStateCache::current().bindBuffer(GL_COPY_WRITE_BUFFER, m_buffer);
+
+#ifndef __ANDROID__
+    if (m_mode == StreamBufferMode::Persistent) {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_COPY_WRITE_BUFFER, totalBytes, nullptr, flags);
+        m_persistent = static_cast<uint8_t*>(glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, totalBytes, flags));
+        if (!m_persistent) {
+            std::cerr << "StreamBuffer: Failed to map persistent storage" << std::endl;
+            releaseStorage();
+            return false;
+        }
+    }
+#endif
+    if (m_mode == StreamBufferMode::Unsynchronized) {
+        glBufferData(GL_COPY_WRITE_BUFFER, totalBytes, nullptr, GL_STREAM_DRAW);
+    }
+
+    m_region = 0;
+    m_offset = 0;
+    m_overflowBytes = 0;
+    return true;
+}
+
+void StreamBuffer::releaseStorage() {
+    for (GLsync& fence : m_fences) {
+        if (fence) {
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+    }
+    if (m_buffer != 0) {
+        // 删除仍被GPU读取的缓冲是安全的: 存储在读取完成后才回收
+        if (m_persistent) {
+            GLStateCache::current().bindBuffer(GL_COPY_WRITE_BUFFER, m_buffer);
+            glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+            m_persistent = nullptr;
+        }
+        GLStateCache::current().onBufferDeleted(m_buffer);
+        glDeleteBuffers(1, &m_buffer);
+        m_buffer = 0;
+    }
+}
+
+void StreamBuffer::orphan() {
+    // 换一块新存储: 旧存储由驱动在GPU读完后回收，所有区域的 fence 随之失效
+    for (GLsync& fence : m_fences) {
+        if (fence) {
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+    }
+    GLStateCache::current().bindBuffer(GL_COPY_WRITE_BUFFER, m_buffer);
+    glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(m_regionBytes * m_fences.size()), nullptr, GL_STREAM_DRAW);
+    m_stats.orphans++;
+}
+
+void StreamBuffer::beginFrame() {
+    if (!isCreated()) {
+        return;
+    }
+
+    // 上一帧的绘制都已发出，fence 完成即表示它们对该区域的读取结束
+    if (m_offset > 0) {
+        m_fences[m_region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+    const size_t needed = m_offset + m_overflowBytes;
+    const bool grow = m_overflowBytes > 0;
+    m_stats = StreamBufferStats();
+
+    // 上一帧放不下: 按当时的总需求重建，之后同样负载的帧不再失败
+    if (grow && !allocateStorage(std::max(needed + needed / 4, m_regionBytes * 2))) {
+        return;
+    }
+    m_stats.regionBytes = m_regionBytes;
+
+    m_region = grow ? 0 : (m_region + 1) % static_cast<uint32_t>(m_fences.size());
+    m_offset = 0;
+    m_overflowBytes = 0;
+
+    GLsync& fence = m_fences[m_region];
+    if (!fence) {
+        return;
+    }
+    GLenum result = glClientWaitSync(fence, 0, 0);
+    if (result == GL_TIMEOUT_EXPIRED) {
+        if (m_mode == StreamBufferMode::Unsynchronized) {
+            orphan();
+            return;
+        }
+        // 不可变存储无法孤立，只能等待GPU读完这个区域
+        const auto waitStart = std::chrono::steady_clock::now();
+        do {
+            result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, kWaitTimeoutNs);
+        } while (result == GL_TIMEOUT_EXPIRED);
+        m_stats.stallMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - waitStart).count();
+        m_stats.stalls++;
+    }
+    glDeleteSync(fence);
+    fence = nullptr;
+}
+
+StreamAllocation StreamBuffer::map(size_t bytes, size_t alignment) {
+    StreamAllocation allocation;
+    if (!isCreated() || bytes == 0) {
+        return allocation;
+    }
+
+    const size_t begin = alignUp(m_offset, alignment);
+    if (begin + bytes > m_regionBytes) {
+        m_overflowBytes += bytes + alignment;
+        m_stats.overflows++;
+        return allocation;
+    }
+
+    const size_t offset = m_region * m_regionBytes + begin;
+    if (m_persistent) {
+        allocation.data = m_persistent + offset;
+    } else {
+        // 本帧区域已确认不被GPU读取 (或刚孤立)，无需驱动再同步
+        GLStateCache::current().bindBuffer(GL_COPY_WRITE_BUFFER, m_buffer);
+        allocation.data = static_cast<uint8_t*>(glMapBufferRange(GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(offset),
+            static_cast<GLsizeiptr>(bytes), GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT));
+        if (!allocation.data) {
+            std::cerr << "StreamBuffer: Failed to map stream region" << std::endl;
+            return allocation;
+        }
+    }
+
+    allocation.offset = static_cast<GLintptr>(offset);
+    allocation.size = bytes;
+    m_offset = begin + bytes;
+    m_stats.bytes += bytes;
+    m_stats.allocations++;
+    return allocation;
+}
+
+void StreamBuffer::unmap(const StreamAllocation& allocation) {
+    // Persistent 映射是 COHERENT 的，写入对之后发出的绘制可见
+    if (!allocation.isValid() || m_persistent) {
+        return;
+    }
+    GLStateCache::current().bindBuffer(GL_COPY_WRITE_BUFFER, m_buffer);
+    glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+}
+
+StreamAllocation StreamBuffer::upload(const void* data, size_t bytes, size_t alignment) {
+    StreamAllocation allocation = map(bytes, alignment);
+    if (allocation.isValid()) {
+        std::memcpy(allocation.data, data, bytes);
+        unmap(allocation);
+    }
+    return allocation;
+}
+
+const char* StreamBuffer::modeName(StreamBufferMode mode) {
+    switch (mode) {
+    case StreamBufferMode::Auto:
+        return "auto";
+    case StreamBufferMode::Persistent:
+        return "persistent";
+    case StreamBufferMode::Unsynchronized:
+        return "unsynchronized";
+    }
+    return "unknown";
+}
+
+void StreamBuffer::setActive(StreamBuffer* buffer) {
+    s_activeBuffer = buffer;
+}
+
+StreamBuffer* StreamBuffer::active() {
+    return s_activeBuffer;
+}
@@ -0,0 +1,145 @@
+// stream_buffer.hpp
+// 单一职责: 逐帧动态数据 (实例、UBO内容) 的环形流缓冲 - 区域轮换 + fence 同步，写入不经过 glBufferData/glBufferSubData
+#pragma once
+
+// 平台条件编译：OpenGL ES (Android) vs OpenGL Core (PC)
+#ifdef __ANDROID__
+    #include <GLES3/gl3.h>
+    #include <GLES3/gl3ext.h>
+#else
+    #include <glad/glad.h>
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+enum class StreamBufferMode {
+    Auto,               // 支持 glBufferStorage (GL 4.4) 时 Persistent，否则 Unsynchronized
+    Persistent,         // 不可变存储，MAP_PERSISTENT | MAP_COHERENT 整体映射一次；区域仍被读取时等待 fence
+    Unsynchronized      // GLES 3.0 路径: 每次写入 glMapBufferRange(UNSYNCHRONIZED)；区域仍被读取时孤立整个缓冲而不等待
+};
+
+struct StreamBufferSettings {
+    size_t regionBytes = 4 * 1024 * 1024;   // 每帧可写的字节数 (不够时下一帧按需求扩容)
+    uint32_t regions = 3;                   // 区域个数，应不小于GPU落后CPU的帧数
+    StreamBufferMode mode = StreamBufferMode::Auto;
+};
+
+/**
+ * @brief 本帧 (最近一次 beginFrame 起) 的统计
+ */
+struct StreamBufferStats {
+    uint64_t bytes = 0;             // 写入的字节
+    uint32_t allocations = 0;
+    double stallMs = 0.0;           // beginFrame 等待区域 fence 的时间
+    uint32_t stalls = 0;            // 需要等待的次数 (Persistent)
+    uint32_t orphans = 0;           // 区域仍被读取而孤立整个缓冲的次数 (Unsynchronized)
+    uint32_t overflows = 0;         // 区域放不下而失败的分配 (调用方退回 glBufferData)
+    size_t regionBytes = 0;
+};
+
+/**
+ * @brief 一次分配: 写入 data 后 unmap，绘制时从 StreamBuffer::id() 的 offset 处读取
+ */
+struct StreamAllocation {
+    uint8_t* data = nullptr;
+    GLintptr offset = 0;
+    size_t size = 0;
+
+    bool isValid() const { return data != nullptr; }
+};
+
+/**
+ * @brief StreamBuffer类 - 一个缓冲对象分成 regions 个区域，第 f 帧只写区域 f % regions
+ *
+ * 使用方式 (GL线程):
+ *   StreamBuffer stream;
+ *   stream.create();
+ *   StreamBuffer::setActive(&stream);
+ *
+ *   // 每帧开始 (渲染之前):
+ *   stream.beginFrame();                         // 给上一帧的区域插入 fence，切换到下一个区域
+ *   StreamAllocation a = stream.map(bytes);      // 失败 (区域已满) 时退回原来的上传方式
+ *   memcpy(a.data, source, bytes);
+ *   stream.unmap(a);                             // 绘制之前必须 unmap
+ *   glBindBufferRange(GL_UNIFORM_BUFFER, binding, stream.id(), a.offset, bytes);
+ *
+ * 上一帧的绘制在下一次 beginFrame 时都已发出，此时插入的 fence 覆盖它们对该区域的全部读取；
+ * 区域轮回时 fence 仍未完成说明GPU落后了 regions 帧: Persistent 等待 (计入 stallMs)，
+ * Unsynchronized 孤立整个缓冲换新存储 (计入 orphans)。
+ * 缓冲对象可以绑定到任意目标 (GL_ARRAY_BUFFER、GL_UNIFORM_BUFFER 等)，内部只使用 GL_COPY_WRITE_BUFFER。
+ * Unsynchronized 模式同一时刻只能有一个分配处于映射状态。
+ */
+class StreamBuffer {
+public:
+    static constexpr size_t kDefaultAlignment = 16;
+
+    StreamBuffer();
+    ~StreamBuffer();
+
+    // 禁止拷贝
+    StreamBuffer(const StreamBuffer&) = delete;
+    StreamBuffer& operator=(const StreamBuffer&) = delete;
+
+    /**
+     * @brief 分配存储 (需要当前GL上下文)，Persistent 不受支持或映射失败时返回 false
+     */
+    bool create(const StreamBufferSettings& settings = StreamBufferSettings());
+    void release();
+    bool isCreated() const { return m_buffer != 0; }
+
+    /**
+     * @brief 当前上下文是否支持 glBufferStorage (GL 4.4)
+     */
+    static bool persistentSupported();
+
+    /**
+     * @brief 为上一帧写过的区域插入 fence，切换到下一个区域并确认GPU已读完它
+     */
+    void beginFrame();
+
+    /**
+     * @brief 在本帧区域内分配 bytes 字节 (起点按 alignment 对齐，alignment 须为2的幂)
+     */
+    StreamAllocation map(size_t bytes, size_t alignment = kDefaultAlignment);
+    void unmap(const StreamAllocation& allocation);
+
+    /**
+     * @brief map + 拷贝 + unmap
+     */
+    StreamAllocation upload(const void* data, size_t bytes, size_t alignment = kDefaultAlignment);
+
+    GLuint id() const { return m_buffer; }
+    StreamBufferMode mode() const { return m_mode; }
+    size_t regionBytes() const { return m_regionBytes; }
+
+    /**
+     * @brief GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT (绑定 UBO 范围时 offset 的对齐要求)
+     */
+    size_t uniformAlignment() const { return m_uniformAlignment; }
+
+    const StreamBufferStats& stats() const { return m_stats; }
+
+    static const char* modeName(StreamBufferMode mode);
+
+    // 与 JobSystem 相同，由应用持有实例并设置
+    static void setActive(StreamBuffer* buffer);
+    static StreamBuffer* active();
+
+private:
+    bool allocateStorage(size_t regionBytes);
+    void releaseStorage();
+    void orphan();
+
+    GLuint m_buffer;
+    uint8_t* m_persistent;          // Persistent: 整个缓冲的映射
+    StreamBufferMode m_mode;
+    size_t m_regionBytes;
+    size_t m_uniformAlignment;
+    std::vector<GLsync> m_fences;   // 每个区域最后一次被写入那一帧的 fence
+    uint32_t m_region;
+    size_t m_offset;                // 本帧区域内已分配的字节
+    size_t m_overflowBytes;         // 本帧放不下的字节 (下一帧扩容依据)
+    StreamBufferStats m_stats;
+};
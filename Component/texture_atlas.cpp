@@ -0,0 +1,384 @@
+#include "texture_atlas.hpp"
+#include "gl_state_cache.hpp"
+#include "mip_chain.hpp"
+
+#include <SOIL2.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <numeric>
+
+namespace {
+
+constexpr size_t kBytesPerPixel = 4;
+
+double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int roundUp(int value, int alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+bool isPowerOfTwo(int value) {
+    return value > 0 && (value & (value - 1)) == 0;
+}
+
+} // namespace
+
+// ============ SkylinePacker ============
+
+SkylinePacker::SkylinePacker(int width, int height)
+    : m_width(0)
+    , m_height(0)
+    , m_usedArea(0)
+{
+    reset(width, height);
+}
+
+void SkylinePacker::reset(int width, int height) {
+    m_width = width;
+    m_height = height;
+    m_usedArea = 0;
+    m_skyline.clear();
+    if (width > 0 && height > 0) {
+        m_skyline.push_back({ 0, 0, width });
+    }
+}
+
+int SkylinePacker::fit(size_t index, int width, int height) const {
+    const int x = m_skyline[index].x;
+    if (x + width > m_width) {
+        return -1;
+    }
+    // 矩形横跨的所有线段中最高的一段决定底边
+    int y = 0;
+    int remaining = width;
+    for (size_t i = index; remaining > 0; ++i) {
+        y = std::max(y, m_skyline[i].y);
+        if (y + height > m_height) {
+            return -1;
+        }
+        remaining -= m_skyline[i].width;
+    }
+    return y;
+}
+
+bool SkylinePacker::insert(int width, int height, glm::ivec2& position) {
+    if (width <= 0 || height <= 0) {
+        return false;
+    }
+
+    size_t best = m_skyline.size();
+    int bestTop = m_height + 1;
+    int bestY = 0;
+    for (size_t i = 0; i < m_skyline.size(); ++i) {
+        const int y = fit(i, width, height);
+        if (y >= 0 && y + height < bestTop) {
+            best = i;
+            bestTop = y + height;
+            bestY = y;
+        }
+    }
+    if (best == m_skyline.size()) {
+        return false;
+    }
+
+    position = glm::ivec2(m_skyline[best].x, bestY);
+    m_skyline.insert(m_skyline.begin() + best, { position.x, bestTop, width });
+
+    // 裁掉被新线段覆盖的部分
+    const int right = position.x + width;
+    for (size_t i = best + 1; i < m_skyline.size(); ) {
+        Segment& segment = m_skyline[i];
+        if (segment.x >= right) {
+            break;
+        }
+        const int overlap = right - segment.x;
+        if (overlap >= segment.width) {
+            m_skyline.erase(m_skyline.begin() + i);
+            continue;
+        }
+        segment.x += overlap;
+        segment.width -= overlap;
+        break;
+    }
+
+    // 合并等高的相邻线段
+    for (size_t i = 0; i + 1 < m_skyline.size(); ) {
+        if (m_skyline[i].y == m_skyline[i + 1].y) {
+            m_skyline[i].width += m_skyline[i + 1].width;
+            m_skyline.erase(m_skyline.begin() + i + 1);
+        } else {
+            ++i;
+        }
+    }
+
+    m_usedArea += static_cast<size_t>(width) * height;
+    return true;
+}
+
+float SkylinePacker::occupancy() const {
+    const size_t area = static_cast<size_t>(m_width) * m_height;
+    return area > 0 ? static_cast<float>(m_usedArea) / static_cast<float>(area) : 0.0f;
+}
+
+// ============ TextureAtlas ============
+
+TextureAtlas::TextureAtlas()
+    : m_texture(0)
+{ }
+
+TextureAtlas::~TextureAtlas() {
+    release();
+}
+
+uint32_t TextureAtlas::add(const uint8_t* rgba, int width, int height) {
+    Image image;
+    image.width = width;
+    image.height = height;
+    image.pixels.assign(rgba, rgba + static_cast<size_t>(width) * height * kBytesPerPixel);
+    m_images.push_back(std::move(image));
+    return static_cast<uint32_t>(m_images.size() - 1);
+}
+
+bool TextureAtlas::addFile(const std::string& path, uint32_t& index, bool flipVertically) {
+    int width = 0;
+    int height = 0;
+    int channels = 0;
+    unsigned char* pixels = SOIL_load_image(path.c_str(), &width, &height, &channels, SOIL_LOAD_RGBA);
+    if (!pixels) {
+        m_lastError = std::string("Failed to decode ") + path + ": " + SOIL_last_result();
+        return false;
+    }
+
+    index = add(pixels, width, height);
+    SOIL_free_image_data(pixels);
+
+    if (flipVertically) {
+        Image& image = m_images[index];
+        const size_t rowBytes = static_cast<size_t>(width) * kBytesPerPixel;
+        for (int y = 0; y < height / 2; ++y) {
+            std::swap_ranges(image.pixels.begin() + y * rowBytes, image.pixels.begin() + (y + 1) * rowBytes,
+                             image.pixels.begin() + (height - 1 - y) * rowBytes);
+        }
+    }
+    return true;
+}
+
+bool TextureAtlas::build(const TextureAtlasSettings& settings) {
+    if (m_texture != 0) {
+        m_lastError = "Texture atlas is already built";
+        return false;
+    }
+    if (m_images.empty()) {
+        m_lastError = "Texture atlas has no images";
+        return false;
+    }
+    if (!isPowerOfTwo(settings.pageSize) || settings.padding < 0) {
+        m_lastError = "Atlas page size must be a power of two and padding non-negative";
+        return false;
+    }
+
+    GLint maxLayers = 0;
+    GLint maxSize = 0;
+    glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxLayers);
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxSize);
+    if (settings.pageSize > maxSize) {
+        m_lastError = "Atlas page size " + std::to_string(settings.pageSize) + " exceeds GL_MAX_TEXTURE_SIZE " + std::to_string(maxSize);
+        return false;
+    }
+    const int maxPages = settings.maxPages > 0 ? std::min(settings.maxPages, static_cast<int>(maxLayers)) : maxLayers;
+
+    // 占位矩形按 2^(n-1) 对齐时，前 n 级的每个纹素都只覆盖一个子纹理 (及其复制的边缘)
+    int alignment = 1;
+    while (alignment * 2 <= settings.padding) {
+        alignment *= 2;
+    }
+    int mipLevels = 1;
+    if (settings.mipMode != AtlasMipMode::None) {
+        const int bleedFreeLevels = MipChain::levelCount(alignment, alignment);
+        mipLevels = settings.maxMipLevels > 0 ? settings.maxMipLevels : bleedFreeLevels;
+        mipLevels = std::min(mipLevels, MipChain::levelCount(settings.pageSize, settings.pageSize));
+    }
+
+    m_stats = TextureAtlasStats();
+    m_stats.images = m_images.size();
+    m_stats.mipLevels = mipLevels;
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<Placement> placements;
+    if (!pack(settings.pageSize, settings.padding, alignment, maxPages, placements)) {
+        return false;
+    }
+    std::vector<std::vector<uint8_t>> pages(m_stats.pages);
+    compose(placements, settings.padding, settings.pageSize, pages);
+    m_stats.packMs = elapsedMs(start);
+
+    m_regions.resize(m_images.size());
+    const float scale = 1.0f / static_cast<float>(settings.pageSize);
+    for (size_t i = 0; i < m_images.size(); ++i) {
+        AtlasRegion& region = m_regions[i];
+        region.layer = placements[i].page;
+        region.position = placements[i].origin + glm::ivec2(settings.padding);
+        region.size = glm::ivec2(m_images[i].width, m_images[i].height);
+        region.uvRect = glm::vec4(glm::vec2(region.position) * scale, glm::vec2(region.size) * scale);
+
+        // 像素已合成到页中
+        m_images[i].pixels = std::vector<uint8_t>();
+    }
+
+    upload(pages, settings.pageSize, mipLevels, settings.mipMode);
+    return true;
+}
+
+bool TextureAtlas::pack(int pageSize, int padding, int alignment, int maxPages, std::vector<Placement>& placements) {
+    // 按高度降序 (同高按宽度) 放入，Skyline 的碎片最少
+    std::vector<uint32_t> order(m_images.size());
+    std::iota(order.begin(), order.end(), 0u);
+    std::stable_sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) {
+        if (m_images[a].height != m_images[b].height) {
+            return m_images[a].height > m_images[b].height;
+        }
+        return m_images[a].width > m_images[b].width;
+    });
+
+    std::vector<SkylinePacker> packers;
+    placements.assign(m_images.size(), Placement());
+    for (uint32_t index : order) {
+        const Image& image = m_images[index];
+        const glm::ivec2 size(roundUp(image.width + padding * 2, alignment), roundUp(image.height + padding * 2, alignment));
+        if (size.x > pageSize || size.y > pageSize) {
+            m_lastError = "Image " + std::to_string(index) + " (" + std::to_string(image.width) + "x" + std::to_string(image.height)
+                        + ") does not fit in a " + std::to_string(pageSize) + " atlas page";
+            return false;
+        }
+
+        // 依次尝试已有页，都放不下时开新页
+        Placement& placement = placements[index];
+        placement.size = size;
+        size_t page = 0;
+        while (page < packers.size() && !packers[page].insert(size.x, size.y, placement.origin)) {
+            ++page;
+        }
+        if (page == packers.size()) {
+            if (static_cast<int>(packers.size()) >= maxPages) {
+                m_lastError = "Texture atlas needs more than " + std::to_string(maxPages) + " pages";
+                return false;
+            }
+            packers.emplace_back(pageSize, pageSize);
+            packers.back().insert(size.x, size.y, placement.origin);
+        }
+        placement.page = static_cast<uint32_t>(page);
+    }
+
+    m_stats.pages = packers.size();
+    size_t used = 0;
+    for (const SkylinePacker& packer : packers) {
+        used += packer.usedArea();
+    }
+    m_stats.occupancy = static_cast<float>(used) / (static_cast<float>(pageSize) * pageSize * packers.size());
+    return true;
+}
+
+void TextureAtlas::compose(const std::vector<Placement>& placements, int padding, int pageSize,
+                           std::vector<std::vector<uint8_t>>& pages) const {
+    const size_t pageStride = static_cast<size_t>(pageSize) * kBytesPerPixel;
+    for (std::vector<uint8_t>& page : pages) {
+        page.assign(pageStride * pageSize, 0);
+    }
+
+    for (size_t i = 0; i < m_images.size(); ++i) {
+        const Image& image = m_images[i];
+        const Placement& placement = placements[i];
+        const size_t rowBytes = static_cast<size_t>(image.width) * kBytesPerPixel;
+        const int right = placement.size.x - padding - image.width;
+
+        // 整个占位矩形: 内容居中，四周 (含对齐多出的部分) 复制最近的边缘像素
+        for (int y = 0; y < placement.size.y; ++y) {
+            const int sourceY = std::clamp(y - padding, 0, image.height - 1);
+            const uint8_t* source = image.pixels.data() + static_cast<size_t>(sourceY) * rowBytes;
+            uint8_t* destination = pages[placement.page].data()
+                                 + static_cast<size_t>(placement.origin.y + y) * pageStride
+                                 + static_cast<size_t>(placement.origin.x) * kBytesPerPixel;
+            for (int x = 0; x < padding; ++x) {
+                std::memcpy(destination + x * kBytesPerPixel, source, kBytesPerPixel);
+            }
+            std::memcpy(destination + padding * kBytesPerPixel, source, rowBytes);
+            const uint8_t* last = source + rowBytes - kBytesPerPixel;
+            uint8_t* tail = destination + (padding + image.width) * kBytesPerPixel;
+            for (int x = 0; x < right; ++x) {
+                std::memcpy(tail + x * kBytesPerPixel, last, kBytesPerPixel);
+            }
+        }
+    }
+}
+
+void TextureAtlas::upload(std::vector<std::vector<uint8_t>>& pages, int pageSize, int mipLevels, AtlasMipMode mode) {
+    GLStateCache& state = GLStateCache::current();
+    const GLsizei layers = static_cast<GLsizei>(pages.size());
+
+    auto start = std::chrono::steady_clock::now();
+    glGenTextures(1, &m_texture);
+    state.bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    state.bindTexture(kTarget, m_texture);
+    glTexParameteri(kTarget, GL_TEXTURE_MIN_FILTER, mipLevels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+    glTexParameteri(kTarget, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(kTarget, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(kTarget, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(kTarget, GL_TEXTURE_MAX_LEVEL, mipLevels - 1);
+    for (int level = 0; level < mipLevels; ++level) {
+        const GLsizei size = std::max(1, pageSize >> level);
+        glTexImage3D(kTarget, level, GL_RGBA8, size, size, layers, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        m_stats.bytes += static_cast<uint64_t>(size) * size * kBytesPerPixel * layers;
+    }
+    m_stats.uploadMs += elapsedMs(start);
+
+    // 逐页生成并上传，同一时刻只保留一页的mip链
+    for (GLsizei layer = 0; layer < layers; ++layer) {
+        std::vector<std::vector<uint8_t>> levels(1);
+        levels[0] = std::move(pages[layer]);
+        if (mode == AtlasMipMode::Cpu) {
+            start = std::chrono::steady_clock::now();
+            MipChain::build(levels, pageSize, pageSize, mipLevels);
+            m_stats.mipMs += elapsedMs(start);
+        }
+
+        start = std::chrono::steady_clock::now();
+        for (size_t level = 0; level < levels.size(); ++level) {
+            const GLsizei size = std::max(1, pageSize >> level);
+            glTexSubImage3D(kTarget, static_cast<GLint>(level), 0, 0, layer, size, size, 1,
+                            GL_RGBA, GL_UNSIGNED_BYTE, levels[level].data());
+        }
+        m_stats.uploadMs += elapsedMs(start);
+    }
+
+    if (mode == AtlasMipMode::Gpu && mipLevels > 1) {
+        start = std::chrono::steady_clock::now();
+        glGenerateMipmap(kTarget);
+        m_stats.uploadMs += elapsedMs(start);
+    }
+}
+
+void TextureAtlas::release() {
+    if (m_texture != 0) {
+        GLStateCache::current().onTextureDeleted(m_texture);
+        glDeleteTextures(1, &m_texture);
+        m_texture = 0;
+    }
+    m_images.clear();
+    m_regions.clear();
+    m_stats = TextureAtlasStats();
+}
+
+void TextureAtlas::remapTexCoords(void* vertices, size_t vertexCount, size_t stride, size_t texCoordOffset,
+                                  const AtlasRegion& region) {
+    uint8_t* bytes = static_cast<uint8_t*>(vertices) + texCoordOffset;
+    for (size_t i = 0; i < vertexCount; ++i, bytes += stride) {
+        glm::vec2 uv;
+        std::memcpy(&uv, bytes, sizeof(uv));
+        uv = region.transform(uv);
+        std::memcpy(bytes, &uv, sizeof(uv));
+    }
+}
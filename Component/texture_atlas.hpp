@@ -0,0 +1,184 @@
+// texture_atlas.hpp
+// 单一职责: 小纹理合并 - Skyline装箱到若干页，各页作为 GL_TEXTURE_2D_ARRAY 的层上传，一次绑定即可采样全部子纹理
+#pragma once
+
+// 平台条件编译：OpenGL ES (Android) vs OpenGL Core (PC)
+#ifdef __ANDROID__
+    #include <GLES3/gl3.h>
+    #include <GLES3/gl3ext.h>
+#else
+    #include <glad/glad.h>
+#endif
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Skyline 装箱 (bottom-left 启发式)
+ *
+ * 天际线是按 x 排列的一组水平线段，新矩形放在使其顶边最低的位置 (同高时取最左)，
+ * 矩形下方被遮住的空隙不再使用。对尺寸相近的小纹理，占用率通常在 85% 以上。
+ */
+class SkylinePacker {
+public:
+    SkylinePacker(int width = 0, int height = 0);
+
+    void reset(int width, int height);
+
+    /**
+     * @brief 放入一个矩形，返回左下角位置；放不下时返回 false 且不修改状态
+     */
+    bool insert(int width, int height, glm::ivec2& position);
+
+    int width() const { return m_width; }
+    int height() const { return m_height; }
+    size_t usedArea() const { return m_usedArea; }
+    float occupancy() const;
+
+private:
+    struct Segment {
+        int x;
+        int y;
+        int width;
+    };
+
+    // 在线段 index 处放置时矩形的底边 y，放不下返回 -1
+    int fit(size_t index, int width, int height) const;
+
+    int m_width;
+    int m_height;
+    size_t m_usedArea;
+    std::vector<Segment> m_skyline;
+};
+
+enum class AtlasMipMode {
+    None,       // 只有第0级
+    Cpu,        // MipChain 盒式滤波 (SIMD)，逐层上传
+    Gpu         // 上传第0级后 glGenerateMipmap
+};
+
+struct TextureAtlasSettings {
+    int pageSize = 1024;                    // 每页 (数组层) 的宽高，取2的幂
+    int padding = 4;                        // 子纹理四周复制边缘像素的宽度，防止双线性/mip采样串色
+    int maxPages = 0;                       // 0 = GL_MAX_ARRAY_TEXTURE_LAYERS
+    int maxMipLevels = 0;                   // 0 = 不串色的最大层数 (对齐粒度 = 不超过 padding 的最大2的幂)
+    AtlasMipMode mipMode = AtlasMipMode::Cpu;
+};
+
+/**
+ * @brief 子纹理在图集中的位置
+ *
+ * 原纹理坐标 uv ∈ [0,1] 映射为 (uvRect.xy + uv * uvRect.zw, layer)。
+ * 超出 [0,1] 的重复平铺 (GL_REPEAT) 无法在图集中表达，这类纹理应单独使用。
+ */
+struct AtlasRegion {
+    glm::vec4 uvRect = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
+    uint32_t layer = 0;
+    glm::ivec2 position = glm::ivec2(0);    // 页内像素坐标 (不含 padding)
+    glm::ivec2 size = glm::ivec2(0);
+
+    glm::vec2 transform(const glm::vec2& uv) const {
+        return glm::vec2(uvRect.x, uvRect.y) + uv * glm::vec2(uvRect.z, uvRect.w);
+    }
+};
+
+struct TextureAtlasStats {
+    size_t images = 0;
+    size_t pages = 0;
+    int mipLevels = 0;
+    float occupancy = 0.0f;     // 所有页的平均占用率 (含 padding)
+    uint64_t bytes = 0;         // 全部层级的显存
+    double packMs = 0.0;
+    double mipMs = 0.0;         // CPU 生成mip链
+    double uploadMs = 0.0;      // 上传 (Gpu 模式含 glGenerateMipmap 的提交)
+};
+
+/**
+ * @brief TextureAtlas类 - 把大量小纹理合并为一个数组纹理
+ *
+ * 使用方式:
+ *   TextureAtlas atlas;
+ *   uint32_t crate = 0;
+ *   atlas.addFile("crate.png", crate);
+ *   uint32_t grass = atlas.add(pixels, 64, 64);
+ *   atlas.build();                          // 装箱、合成、生成mip、上传 (GL线程)
+ *   const AtlasRegion& region = atlas.region(crate);
+ *   TextureAtlas::remapTexCoords(vertices.data(), vertices.size(), sizeof(Vertex), offsetof(Vertex, uv), region);
+ *   // 绘制时绑定 atlas.texture() 到 GL_TEXTURE_2D_ARRAY，层号作为逐实例属性或uniform
+ *
+ * 单页也按数组纹理上传，着色器统一使用 sampler2DArray。
+ * 子纹理按高度降序装箱，位置与尺寸按 mip 对齐粒度取整，
+ * 使前 maxMipLevels 级的每个纹素只覆盖同一个子纹理。
+ */
+class TextureAtlas {
+public:
+    static constexpr GLenum kTarget = GL_TEXTURE_2D_ARRAY;
+
+    TextureAtlas();
+    ~TextureAtlas();
+
+    // 禁止拷贝
+    TextureAtlas(const TextureAtlas&) = delete;
+    TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+    /**
+     * @brief 加入 RGBA8 像素 (拷贝)，返回子纹理下标；须在 build() 之前调用
+     */
+    uint32_t add(const uint8_t* rgba, int width, int height);
+
+    /**
+     * @brief 用 SOIL2 解码图片文件后加入
+     * @param flipVertically 图片首行在上，GL纹理坐标原点在左下 (与 TextureManager 一致)
+     */
+    bool addFile(const std::string& path, uint32_t& index, bool flipVertically = true);
+
+    /**
+     * @brief 装箱并上传为数组纹理，成功后释放CPU端像素
+     */
+    bool build(const TextureAtlasSettings& settings = TextureAtlasSettings());
+
+    void release();
+
+    bool isBuilt() const { return m_texture != 0; }
+    GLuint texture() const { return m_texture; }
+    size_t imageCount() const { return m_images.size(); }
+    const AtlasRegion& region(uint32_t index) const { return m_regions[index]; }
+    const std::vector<AtlasRegion>& regions() const { return m_regions; }
+    const TextureAtlasStats& stats() const { return m_stats; }
+    std::string lastError() const { return m_lastError; }
+
+    /**
+     * @brief 把交错顶点中的 vec2 纹理坐标改写到子纹理的区域内 (每个网格使用一个子纹理时)
+     */
+    static void remapTexCoords(void* vertices, size_t vertexCount, size_t stride, size_t texCoordOffset,
+                               const AtlasRegion& region);
+
+private:
+    struct Image {
+        int width = 0;
+        int height = 0;
+        std::vector<uint8_t> pixels;
+    };
+
+    // 含 padding 与对齐取整的占位矩形
+    struct Placement {
+        uint32_t page = 0;
+        glm::ivec2 origin = glm::ivec2(0);
+        glm::ivec2 size = glm::ivec2(0);
+    };
+
+    bool pack(int pageSize, int padding, int alignment, int maxPages, std::vector<Placement>& placements);
+    void compose(const std::vector<Placement>& placements, int padding, int pageSize,
+                 std::vector<std::vector<uint8_t>>& pages) const;
+    void upload(std::vector<std::vector<uint8_t>>& pages, int pageSize, int mipLevels, AtlasMipMode mode);
+
+    std::vector<Image> m_images;
+    std::vector<AtlasRegion> m_regions;
+    GLuint m_texture;
+    TextureAtlasStats m_stats;
+    std::string m_lastError;
+};
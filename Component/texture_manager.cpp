@@ -0,0 +1,582 @@
+#include "texture_manager.hpp"
+#include "gl_state_cache.hpp"
+
+#include <SOIL2.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+namespace {
+
+TextureManager* s_activeManager = nullptr;
+
+constexpr size_t kBytesPerPixel = 4;    // 统一解码为 RGBA8
+
+bool readFile(const std::string& path, std::vector<uint8_t>& bytes) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+}
+
+std::string replaceExtension(const std::string& path, const std::string& extension) {
+    const size_t dot = path.find_last_of('.');
+    const size_t separator = path.find_last_of("/\\");
+    if (dot == std::string::npos || (separator != std::string::npos && dot < separator)) {
+        return path + extension;
+    }
+    return path.substr(0, dot) + extension;
+}
+
+} // namespace
+
+TextureManager::TextureManager()
+    : m_decodesInFlight(0)
+    , m_stopRequested(false)
+    , m_nextPixelBuffer(0)
+    , m_placeholderTexture(0)
+    , m_whiteTexture(0)
+{ }
+
+TextureManager::~TextureManager() {
+    release();
+}
+
+void TextureManager::setActive(TextureManager* manager) {
+    s_activeManager = manager;
+}
+
+TextureManager* TextureManager::active() {
+    return s_activeManager;
+}
+
+bool TextureManager::create(const TextureManagerSettings& settings) {
+    if (isCreated()) {
+        return true;
+    }
+    m_settings = settings;
+    m_settings.decodeThreads = std::max<size_t>(m_settings.decodeThreads, 1);
+    m_settings.pixelBufferCount = std::max<size_t>(m_settings.pixelBufferCount, 1);
+    m_settings.uploadBudgetBytes = std::max<size_t>(m_settings.uploadBudgetBytes, kBytesPerPixel);
+
+    // 占位: 8x8 灰色棋盘格，一眼能看出纹理尚未就绪
+    uint32_t checker[8 * 8];
+    for (int y = 0; y < 8; ++y) {
+        for (int x = 0; x < 8; ++x) {
+            checker[y * 8 + x] = ((x ^ y) & 1) ? 0xFF808080u : 0xFFB0B0B0u;
+        }
+    }
+    const uint32_t white = 0xFFFFFFFFu;
+    m_placeholderTexture = createBuiltinTexture(checker, 8);
+    m_whiteTexture = createBuiltinTexture(&white, 1);
+
+    // 解码线程据此决定压缩数据原样上传还是转码
+    m_compressedSupport = CompressedFormatSupport::query();
+
+    // PBO环: 每帧写入一个，前一帧的PBO可能仍在被GPU读取
+    GLStateCache& state = GLStateCache::current();
+    m_pixelBuffers.resize(m_settings.pixelBufferCount);
+    for (PixelBuffer& pixelBuffer : m_pixelBuffers) {
+        glGenBuffers(1, &pixelBuffer.buffer);
+        state.bindBuffer(GL_PIXEL_UNPACK_BUFFER, pixelBuffer.buffer);
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(m_settings.uploadBudgetBytes), nullptr, GL_STREAM_DRAW);
+    }
+    state.bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    m_nextPixelBuffer = 0;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopRequested = false;
+    }
+    for (size_t i = 0; i < m_settings.decodeThreads; ++i) {
+        m_threads.emplace_back(&TextureManager::decodeThreadMain, this);
+    }
+    return true;
+}
+
+void TextureManager::release() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopRequested = true;
+        m_decodeQueue.clear();
+    }
+    m_wakeup.notify_all();
+    for (std::thread& thread : m_threads) {
+        thread.join();
+    }
+    m_threads.clear();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_decoded.clear();
+        m_decodesInFlight = 0;
+    }
+    m_uploads.clear();
+
+    if (!isCreated()) {
+        return;
+    }
+
+    GLStateCache& state = GLStateCache::current();
+    for (PixelBuffer& pixelBuffer : m_pixelBuffers) {
+        if (pixelBuffer.fence) {
+            glDeleteSync(pixelBuffer.fence);
+        }
+        state.onBufferDeleted(pixelBuffer.buffer);
+        glDeleteBuffers(1, &pixelBuffer.buffer);
+    }
+    m_pixelBuffers.clear();
+
+    for (Entry& texture : m_entries) {
+        if (texture.texture != 0) {
+            state.onTextureDeleted(texture.texture);
+            glDeleteTextures(1, &texture.texture);
+        }
+    }
+    m_entries.clear();
+    m_pathToId.clear();
+
+    GLuint builtins[2] = { m_placeholderTexture, m_whiteTexture };
+    for (GLuint texture : builtins) {
+        state.onTextureDeleted(texture);
+    }
+    glDeleteTextures(2, builtins);
+    m_placeholderTexture = 0;
+    m_whiteTexture = 0;
+    m_stats = TextureStreamStats();
+}
+
+GLuint TextureManager::createBuiltinTexture(const uint32_t* pixels, int size) {
+    GLuint texture = 0;
+    glGenTextures(1, &texture);
+    GLStateCache::current().bindTexture(GL_TEXTURE_2D, texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, size, size, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    return texture;
+}
+
+TextureHandle TextureManager::load(const std::string& path) {
+    TextureHandle handle;
+    if (!isCreated()) {
+        std::cerr << "TextureManager: load() before create(): " << path << std::endl;
+        return handle;
+    }
+
+    auto found = m_pathToId.find(path);
+    if (found != m_pathToId.end()) {
+        handle.id = found->second;
+        return handle;
+    }
+
+    Entry texture;
+    texture.path = path;
+    m_entries.push_back(texture);
+    handle.id = static_cast<uint32_t>(m_entries.size());
+    m_pathToId[path] = handle.id;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_decodeQueue.push_back({ handle.id, path });
+        ++m_decodesInFlight;
+    }
+    m_wakeup.notify_one();
+    return handle;
+}
+
+void TextureManager::decodeThreadMain() {
+    while (true) {
+        DecodeRequest request;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wakeup.wait(lock, [this] { return m_stopRequested || !m_decodeQueue.empty(); });
+            if (m_stopRequested) {
+                return;
+            }
+            request = std::move(m_decodeQueue.front());
+            m_decodeQueue.pop_front();
+        }
+
+        // 解码 (文件IO + 解压) 是加载中最慢的部分，完全不占用GL线程
+        DecodedImage image = decode(request.path);
+        image.id = request.id;
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_decoded.push_back(std::move(image));
+            --m_decodesInFlight;
+        }
+        m_decodedSignal.notify_all();
+    }
+}
+
+TextureManager::DecodedImage TextureManager::decode(const std::string& path) const {
+    DecodedImage image;
+    std::vector<uint8_t> file;
+
+    // 同一资源按平台发布不同容器时，选驱动能直接采样的那个 (桌面 .dds，GLES .ktx/.pkm)
+    if (m_settings.preferCompressed) {
+        for (const std::string& extension : CompressedTexture::preferredExtensions(m_compressedSupport)) {
+            const std::string candidate = replaceExtension(path, extension);
+            if (candidate != path && readFile(candidate, file) && decodeCompressed(candidate, file, image) && image.error.empty()) {
+                return image;
+            }
+            image = DecodedImage();
+        }
+    }
+
+    image.path = path;
+    if (!readFile(path, file)) {
+        image.error = "Failed to open " + path;
+        return image;
+    }
+    if (decodeCompressed(path, file, image)) {
+        return image;
+    }
+
+    int channels = 0;
+    unsigned char* pixels = SOIL_load_image_from_memory(file.data(), static_cast<int>(file.size()),
+                                                        &image.width, &image.height, &channels, SOIL_LOAD_RGBA);
+    if (pixels) {
+        image.pixels.reset(pixels, [](uint8_t* data) { SOIL_free_image_data(data); });
+    } else {
+        image.error = std::string("Failed to decode ") + path + ": " + SOIL_last_result();
+    }
+    return image;
+}
+
+bool TextureManager::decodeCompressed(const std::string& path, std::vector<uint8_t>& file, DecodedImage& image) const {
+    CompressedImage compressed;
+    std::string error;
+    if (!CompressedTexture::parse(file, compressed, error)) {
+        if (error.empty()) {
+            return false;
+        }
+        image.error = "Failed to load " + path + ": " + error;
+        return true;
+    }
+
+    image.path = path;
+    image.width = compressed.width;
+    image.height = compressed.height;
+
+    // 驱动不支持时才转码 (解码后重新压缩为支持的格式，实在不行才是 RGBA8)
+    if (!m_compressedSupport.supports(compressed)) {
+        CompressedImage transcoded;
+        if (!CompressedTexture::transcode(compressed, m_compressedSupport, transcoded, error)) {
+            image.error = "Failed to load " + path + ": " + error;
+            return true;
+        }
+        image.transcodedFrom = compressed.format;
+        compressed = std::move(transcoded);
+    }
+    image.compressed = std::move(compressed);
+    return true;
+}
+
+void TextureManager::update() {
+    const auto start = std::chrono::steady_clock::now();
+    m_stats = TextureStreamStats();
+
+    if (isCreated()) {
+        collectDecoded();
+        uploadPending();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stats.pending = m_decodesInFlight + m_decoded.size() + m_uploads.size();
+    }
+    m_stats.updateMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void TextureManager::collectDecoded() {
+    std::vector<DecodedImage> decoded;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        decoded.swap(m_decoded);
+    }
+    m_stats.decodesCollected = static_cast<uint32_t>(decoded.size());
+
+    for (DecodedImage& image : decoded) {
+        Entry& texture = m_entries[image.id - 1];
+        if (!image.pixels && !image.compressed.isValid()) {
+            texture.state = TextureState::Failed;
+            texture.error = image.error;
+            std::cerr << "TextureManager: " << image.error << std::endl;
+            continue;
+        }
+
+        texture.state = TextureState::Uploading;
+        texture.width = image.width;
+        texture.height = image.height;
+        texture.internalFormat = image.compressed.isValid() ? image.compressed.glInternalFormat() : GL_RGBA8;
+        if (image.transcodedFrom != CompressedFormat::None) {
+            std::cout << "TextureManager: " << image.path << " " << CompressedTexture::formatName(image.transcodedFrom)
+                      << " is not supported by the driver, transcoded to "
+                      << CompressedTexture::formatName(image.compressed.format) << std::endl;
+        }
+
+        UploadJob job;
+        job.image = std::move(image);
+        beginTexture(job);
+
+        if (job.image.compressed.isValid()) {
+            // 超出PBO容量的层级 (只可能是最前面的几级) 直接从内存上传
+            const std::vector<CompressedLevel>& levels = job.image.compressed.levels;
+            while (!isComplete(job) && levels[job.nextLevel].size > m_settings.uploadBudgetBytes) {
+                uploadLevel(job, job.nextLevel, job.image.compressed.data.data() + levels[job.nextLevel].offset);
+                m_stats.bytesUploaded += levels[job.nextLevel].size;
+                ++job.nextLevel;
+            }
+            if (isComplete(job)) {
+                finishTexture(job);
+            } else {
+                m_uploads.push_back(std::move(job));
+            }
+            continue;
+        }
+
+        // 单行就超出PBO容量的超宽图片无法分帧，直接从内存整体上传
+        const size_t rowBytes = static_cast<size_t>(job.image.width) * kBytesPerPixel;
+        if (rowBytes > m_settings.uploadBudgetBytes) {
+            std::vector<uint8_t> flipped(rowBytes * static_cast<size_t>(job.image.height));
+            copyRows(job, 0, job.image.height, flipped.data());
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, job.image.width, job.image.height, GL_RGBA, GL_UNSIGNED_BYTE, flipped.data());
+            m_stats.bytesUploaded += flipped.size();
+            job.nextRow = job.image.height;
+            finishTexture(job);
+            continue;
+        }
+        m_uploads.push_back(std::move(job));
+    }
+}
+
+void TextureManager::beginTexture(UploadJob& job) {
+    Entry& texture = m_entries[job.image.id - 1];
+    glGenTextures(1, &texture.texture);
+
+    // 分配存储时不能绑定 PIXEL_UNPACK_BUFFER，否则 nullptr 会被当作PBO偏移
+    GLStateCache& state = GLStateCache::current();
+    state.bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    state.bindTexture(GL_TEXTURE_2D, texture.texture);
+    if (job.image.compressed.isValid()) {
+        // 存储由各层级的 glCompressedTexImage2D 分配；mip链来自文件，不能 glGenerateMipmap
+        const GLint levels = static_cast<GLint>(job.image.compressed.levels.size());
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, levels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levels - 1);
+    } else {
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, job.image.width, job.image.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_settings.generateMipmaps ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+    }
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    job.nextRow = 0;
+    job.nextLevel = 0;
+}
+
+void TextureManager::uploadLevel(const UploadJob& job, size_t level, const void* data) {
+    const CompressedImage& image = job.image.compressed;
+    const CompressedLevel& entry = image.levels[level];
+    GLStateCache::current().bindTexture(GL_TEXTURE_2D, m_entries[job.image.id - 1].texture);
+    if (image.format == CompressedFormat::None) {
+        glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), static_cast<GLint>(image.glInternalFormat()), entry.width, entry.height, 0,
+                     GL_RGBA, GL_UNSIGNED_BYTE, data);
+    } else {
+        glCompressedTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), image.glInternalFormat(),
+                               entry.width, entry.height, 0, static_cast<GLsizei>(entry.size), data);
+    }
+}
+
+bool TextureManager::isComplete(const UploadJob& job) {
+    if (job.image.compressed.isValid()) {
+        return job.nextLevel >= job.image.compressed.levels.size();
+    }
+    return job.nextRow >= job.image.height;
+}
+
+void TextureManager::finishTexture(UploadJob& job) {
+    Entry& texture = m_entries[job.image.id - 1];
+    if (m_settings.generateMipmaps && !job.image.compressed.isValid()) {
+        GLStateCache::current().bindTexture(GL_TEXTURE_2D, texture.texture);
+        glGenerateMipmap(GL_TEXTURE_2D);
+    }
+    texture.state = TextureState::Ready;
+    ++m_stats.texturesCompleted;
+
+    // 像素已在GPU上，释放解码内存
+    job.image.pixels.reset();
+    job.image.compressed = CompressedImage();
+}
+
+void TextureManager::copyRows(const UploadJob& job, int firstRow, int rows, uint8_t* destination) const {
+    const size_t rowBytes = static_cast<size_t>(job.image.width) * kBytesPerPixel;
+    const uint8_t* source = job.image.pixels.get();
+    for (int row = firstRow; row < firstRow + rows; ++row) {
+        const int sourceRow = m_settings.flipVertically ? job.image.height - 1 - row : row;
+        std::memcpy(destination, source + static_cast<size_t>(sourceRow) * rowBytes, rowBytes);
+        destination += rowBytes;
+    }
+}
+
+void TextureManager::uploadPending() {
+    if (m_uploads.empty()) {
+        return;
+    }
+
+    PixelBuffer& pixelBuffer = m_pixelBuffers[m_nextPixelBuffer];
+    if (pixelBuffer.fence) {
+        // 不等待: GPU还没读完这个PBO时推迟到下一帧
+        const GLenum result = glClientWaitSync(pixelBuffer.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+        if (result == GL_TIMEOUT_EXPIRED) {
+            ++m_stats.pixelBufferStalls;
+            return;
+        }
+        glDeleteSync(pixelBuffer.fence);
+        pixelBuffer.fence = nullptr;
+    }
+
+    // 按预算切出本帧要上传的行段/层级 (队首优先，尽快让单个纹理就绪)
+    std::vector<UploadBand> bands;
+    size_t used = 0;
+    bool full = false;
+    for (size_t i = 0; i < m_uploads.size() && !full; ++i) {
+        const UploadJob& job = m_uploads[i];
+        if (job.image.compressed.isValid()) {
+            // 压缩层级不拆分，整级放进PBO
+            const std::vector<CompressedLevel>& levels = job.image.compressed.levels;
+            for (size_t level = job.nextLevel; level < levels.size() && !full; ++level) {
+                full = used + levels[level].size > m_settings.uploadBudgetBytes;
+                if (!full) {
+                    bands.push_back({ i, 0, 0, level, used, levels[level].size });
+                    used += levels[level].size;
+                }
+            }
+            continue;
+        }
+
+        const size_t rowBytes = static_cast<size_t>(job.image.width) * kBytesPerPixel;
+        const int rows = std::min(job.image.height - job.nextRow,
+                                  static_cast<int>((m_settings.uploadBudgetBytes - used) / rowBytes));
+        if (rows <= 0) {
+            break;
+        }
+        bands.push_back({ i, job.nextRow, rows, 0, used, rowBytes * static_cast<size_t>(rows) });
+        used += rowBytes * static_cast<size_t>(rows);
+    }
+    if (bands.empty()) {
+        return;
+    }
+
+    GLStateCache& state = GLStateCache::current();
+    state.bindBuffer(GL_PIXEL_UNPACK_BUFFER, pixelBuffer.buffer);
+
+    // fence 已保证GPU不再读取，UNSYNCHRONIZED 避免驱动隐式同步
+    void* mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(used),
+                                    GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+    if (!mapped) {
+        state.bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        std::cerr << "TextureManager: Failed to map pixel unpack buffer" << std::endl;
+        return;
+    }
+    for (const UploadBand& band : bands) {
+        const UploadJob& job = m_uploads[band.jobIndex];
+        uint8_t* destination = static_cast<uint8_t*>(mapped) + band.offset;
+        if (job.image.compressed.isValid()) {
+            std::memcpy(destination, job.image.compressed.data.data() + job.image.compressed.levels[band.level].offset, band.bytes);
+        } else {
+            copyRows(job, band.firstRow, band.rows, destination);
+        }
+    }
+    glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+
+    // 数据源是PBO偏移，调用立即返回，拷贝由驱动异步完成
+    for (const UploadBand& band : bands) {
+        UploadJob& job = m_uploads[band.jobIndex];
+        if (job.image.compressed.isValid()) {
+            uploadLevel(job, band.level, reinterpret_cast<const void*>(band.offset));
+            job.nextLevel = band.level + 1;
+            continue;
+        }
+        state.bindTexture(GL_TEXTURE_2D, m_entries[job.image.id - 1].texture);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, band.firstRow, job.image.width, band.rows, GL_RGBA, GL_UNSIGNED_BYTE,
+                        reinterpret_cast<const void*>(band.offset));
+        job.nextRow += band.rows;
+    }
+    state.bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    m_stats.bytesUploaded += used;
+
+    pixelBuffer.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    m_nextPixelBuffer = (m_nextPixelBuffer + 1) % m_pixelBuffers.size();
+
+    // 队首用不完的预算会顺延给后面的纹理，较小的纹理可能先于队首传完: 扫描整个队列
+    for (auto it = m_uploads.begin(); it != m_uploads.end();) {
+        if (isComplete(*it)) {
+            finishTexture(*it);
+            it = m_uploads.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void TextureManager::finishAll() {
+    while (!isIdle()) {
+        {
+            // 没有待上传的数据时等待解码线程，而不是空转
+            std::unique_lock<std::mutex> lock(m_mutex);
+            if (m_uploads.empty()) {
+                m_decodedSignal.wait(lock, [this] { return !m_decoded.empty() || m_decodesInFlight == 0; });
+            }
+        }
+        update();
+    }
+}
+
+bool TextureManager::isIdle() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_decodesInFlight == 0 && m_decoded.empty() && m_uploads.empty();
+}
+
+const TextureManager::Entry* TextureManager::entry(TextureHandle handle) const {
+    if (!handle.isValid() || handle.id > m_entries.size()) {
+        return nullptr;
+    }
+    return &m_entries[handle.id - 1];
+}
+
+GLuint TextureManager::glTexture(TextureHandle handle) const {
+    const Entry* texture = entry(handle);
+    if (!texture || texture->state != TextureState::Ready) {
+        return m_placeholderTexture;
+    }
+    return texture->texture;
+}
+
+TextureState TextureManager::state(TextureHandle handle) const {
+    const Entry* texture = entry(handle);
+    return texture ? texture->state : TextureState::Failed;
+}
+
+std::string TextureManager::error(TextureHandle handle) const {
+    const Entry* texture = entry(handle);
+    return texture ? texture->error : std::string("Invalid texture handle");
+}
+
+glm::ivec2 TextureManager::size(TextureHandle handle) const {
+    const Entry* texture = entry(handle);
+    return texture ? glm::ivec2(texture->width, texture->height) : glm::ivec2(0);
+}
+
+GLenum TextureManager::internalFormat(TextureHandle handle) const {
+    const Entry* texture = entry(handle);
+    return texture ? texture->internalFormat : 0;
+}
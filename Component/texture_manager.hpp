@@ -0,0 +1,225 @@
+// texture_manager.hpp
+// 单一职责: 纹理流式加载 - 工作线程池解码图片，PBO环分帧上传，就绪前返回占位纹理
+#pragma once
+
+// 平台条件编译：OpenGL ES (Android) vs OpenGL Core (PC)
+#ifdef __ANDROID__
+    #include <GLES3/gl3.h>
+    #include <GLES3/gl3ext.h>
+#else
+    #include <glad/glad.h>
+#endif
+
+#include <glm/glm.hpp>
+
+#include "compressed_texture.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief 纹理句柄 (TextureManager 内的编号，0 表示无效)
+ */
+struct TextureHandle {
+    uint32_t id = 0;
+
+    bool isValid() const { return id != 0; }
+    bool operator==(const TextureHandle& other) const { return id == other.id; }
+    bool operator!=(const TextureHandle& other) const { return id != other.id; }
+};
+
+enum class TextureState {
+    Decoding,       // 在工作线程中解码 (或排队等待)
+    Uploading,      // 已解码，分帧经PBO上传中
+    Ready,
+    Failed
+};
+
+struct TextureManagerSettings {
+    size_t decodeThreads = 2;
+    size_t uploadBudgetBytes = 4 * 1024 * 1024;    // 每帧最多上传的字节数 (也是每个PBO的大小)
+    size_t pixelBufferCount = 3;                    // PBO环大小，应不小于GPU落后CPU的帧数
+    bool generateMipmaps = true;
+    bool flipVertically = true;                     // 图片首行在上，GL纹理坐标原点在左下 (不作用于压缩纹理)
+    bool preferCompressed = true;                   // 优先加载同名的 .dds/.ktx/.pkm/.pvr (按驱动支持排序)
+};
+
+/**
+ * @brief 最近一次 update() 的统计
+ */
+struct TextureStreamStats {
+    uint32_t decodesCollected = 0;      // 本帧收到的解码结果
+    uint32_t texturesCompleted = 0;     // 本帧上传完成的纹理
+    uint64_t bytesUploaded = 0;
+    uint32_t pixelBufferStalls = 0;     // PBO仍被GPU读取而推迟上传的次数
+    size_t pending = 0;                 // 尚未就绪的纹理数
+    double updateMs = 0.0;              // update() 的CPU耗时
+};
+
+/**
+ * @brief TextureManager - 异步纹理加载
+ *
+ * 流程:
+ *   load(path)  → 工作线程读取文件: 块压缩容器 (DDS/KTX/PKM/PVR) 原样保留各mip层级，
+ *                 驱动不支持该格式时才在CPU上转码；其余图片由 SOIL2 解码为 RGBA8
+ *   update()    → 每帧在GL线程调用: 收集解码结果，把若干行像素写入环中的下一个PBO，
+ *                 再由 glTexSubImage2D / glCompressedTexImage2D 从PBO拷贝 (驱动异步DMA)，
+ *                 每帧总量不超过 uploadBudgetBytes
+ *   glTexture() → 未就绪/失败时返回占位纹理，渲染器每帧取用即可，无需关心加载状态
+ *
+ * 大纹理被拆成多帧上传，加载资源不会造成单帧卡顿。PBO用 fence 跟踪，
+ * GPU尚未读完时跳过本帧的上传而不是等待。
+ *
+ * 与 Shader::setProgramCache 相同，由应用持有实例并通过 setActive() 提供给渲染器。
+ * 除构造/setActive 外所有方法都必须在GL线程调用。
+ */
+class TextureManager {
+public:
+    TextureManager();
+    ~TextureManager();
+
+    // 禁止拷贝
+    TextureManager(const TextureManager&) = delete;
+    TextureManager& operator=(const TextureManager&) = delete;
+
+    /**
+     * @brief 创建占位纹理与PBO环并启动解码线程
+     */
+    bool create(const TextureManagerSettings& settings = TextureManagerSettings());
+
+    /**
+     * @brief 停止解码线程并删除所有纹理/PBO
+     */
+    void release();
+
+    bool isCreated() const { return m_placeholderTexture != 0; }
+
+    /**
+     * @brief 请求加载 (不阻塞)；同一路径返回同一句柄
+     */
+    TextureHandle load(const std::string& path);
+
+    /**
+     * @brief 每帧调用一次: 收集解码结果并在预算内上传
+     */
+    void update();
+
+    /**
+     * @brief 阻塞直到所有已请求的纹理就绪或失败 (加载界面/测试用)
+     */
+    void finishAll();
+
+    /**
+     * @brief 可绑定的纹理: 就绪时为实际纹理，否则为占位纹理
+     */
+    GLuint glTexture(TextureHandle handle) const;
+
+    TextureState state(TextureHandle handle) const;
+    std::string error(TextureHandle handle) const;
+    glm::ivec2 size(TextureHandle handle) const;
+    GLenum internalFormat(TextureHandle handle) const;
+
+    GLuint placeholderTexture() const { return m_placeholderTexture; }
+    GLuint whiteTexture() const { return m_whiteTexture; }
+
+    bool isIdle() const;
+    const CompressedFormatSupport& compressedSupport() const { return m_compressedSupport; }
+    const TextureStreamStats& lastStats() const { return m_stats; }
+    const TextureManagerSettings& settings() const { return m_settings; }
+
+    static void setActive(TextureManager* manager);
+    static TextureManager* active();
+
+private:
+    struct Entry {
+        std::string path;
+        TextureState state = TextureState::Decoding;
+        GLuint texture = 0;
+        int width = 0;
+        int height = 0;
+        GLenum internalFormat = 0;
+        std::string error;
+    };
+
+    struct DecodeRequest {
+        uint32_t id;
+        std::string path;
+    };
+
+    struct DecodedImage {
+        uint32_t id = 0;
+        int width = 0;
+        int height = 0;
+        std::shared_ptr<uint8_t> pixels;    // RGBA8，由 SOIL_free_image_data 释放
+        CompressedImage compressed;         // 有效时代替 pixels，按层级上传
+        CompressedFormat transcodedFrom = CompressedFormat::None;
+        std::string path;                   // 实际读取的文件 (可能是同名压缩版本)
+        std::string error;
+    };
+
+    struct UploadJob {
+        DecodedImage image;
+        int nextRow = 0;                    // 下一个要上传的GL行 (自下而上)
+        size_t nextLevel = 0;               // 压缩纹理: 下一个要上传的mip层级
+    };
+
+    struct PixelBuffer {
+        GLuint buffer = 0;
+        GLsync fence = nullptr;
+    };
+
+    // 一次上传: PBO中的一段连续行，或压缩纹理的一个完整层级
+    struct UploadBand {
+        size_t jobIndex;
+        int firstRow;
+        int rows;
+        size_t level;
+        size_t offset;      // PBO内的字节偏移
+        size_t bytes;
+    };
+
+    void decodeThreadMain();
+    DecodedImage decode(const std::string& path) const;
+    bool decodeCompressed(const std::string& path, std::vector<uint8_t>& file, DecodedImage& image) const;
+    void collectDecoded();
+    void uploadPending();
+    void beginTexture(UploadJob& job);
+    void finishTexture(UploadJob& job);
+    void uploadLevel(const UploadJob& job, size_t level, const void* data);
+    static bool isComplete(const UploadJob& job);
+    void copyRows(const UploadJob& job, int firstRow, int rows, uint8_t* destination) const;
+    GLuint createBuiltinTexture(const uint32_t* pixels, int size);
+    const Entry* entry(TextureHandle handle) const;
+
+    TextureManagerSettings m_settings;
+    CompressedFormatSupport m_compressedSupport;            // create() 时查询，之后解码线程只读
+    std::vector<Entry> m_entries;                           // 下标 = id - 1
+    std::unordered_map<std::string, uint32_t> m_pathToId;
+
+    // 解码线程池
+    std::vector<std::thread> m_threads;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wakeup;
+    std::condition_variable m_decodedSignal;
+    std::deque<DecodeRequest> m_decodeQueue;
+    std::vector<DecodedImage> m_decoded;
+    size_t m_decodesInFlight;
+    bool m_stopRequested;
+
+    // GL线程上传
+    std::deque<UploadJob> m_uploads;
+    std::vector<PixelBuffer> m_pixelBuffers;
+    size_t m_nextPixelBuffer;
+    GLuint m_placeholderTexture;
+    GLuint m_whiteTexture;
+
+    TextureStreamStats m_stats;
+};
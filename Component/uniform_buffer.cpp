@@ -0,0 +1,98 @@
+#include "uniform_buffer.hpp"
+#include "gl_state_cache.hpp"
+#include "stream_buffer.hpp"
+#include <utility>
+
+UniformBuffer::UniformBuffer()
+    : m_ubo(0)
+    , m_bindingPoint(0)
+    , m_size(0)
+    , m_streamed(false)
+{
+}
+
+UniformBuffer::~UniformBuffer() {
+    release();
+}
+
+UniformBuffer::UniformBuffer(UniformBuffer&& other) noexcept
+    : m_ubo(std::exchange(other.m_ubo, 0))
+    , m_bindingPoint(other.m_bindingPoint)
+    , m_size(std::exchange(other.m_size, 0))
+    , m_streamed(std::exchange(other.m_streamed, false))
+{
+}
+
+UniformBuffer& UniformBuffer::operator=(UniformBuffer&& other) noexcept {
+    if (this != &other) {
+        release();
+        m_ubo = std::exchange(other.m_ubo, 0);
+        m_bindingPoint = other.m_bindingPoint;
+        m_size = std::exchange(other.m_size, 0);
+        m_streamed = std::exchange(other.m_streamed, false);
+    }
+    return *this;
+}
+
+bool UniformBuffer::create(GLsizeiptr size, GLuint bindingPoint) {
+    release();
+
+    if (size <= 0) {
+        return false;
+    }
+
+    m_size = size;
+    m_bindingPoint = bindingPoint;
+
+    glGenBuffers(1, &m_ubo);
+    GLStateCache::current().bindBuffer(GL_UNIFORM_BUFFER, m_ubo);
+    glBufferData(GL_UNIFORM_BUFFER, m_size, nullptr, GL_DYNAMIC_DRAW);
+
+    bindBase();
+    return true;
+}
+
+void UniformBuffer::update(const void* data, GLsizeiptr size, GLintptr offset) {
+    if (m_ubo == 0 || offset + size > m_size) {
+        return;
+    }
+
+    GLStateCache& state = GLStateCache::current();
+    const bool whole = offset == 0 && size == m_size;
+    StreamBuffer* stream = StreamBuffer::active();
+    if (whole && stream) {
+        const StreamAllocation allocation = stream->upload(data, static_cast<size_t>(size), stream->uniformAlignment());
+        if (allocation.isValid()) {
+            state.bindBufferRange(GL_UNIFORM_BUFFER, m_bindingPoint, stream->id(), allocation.offset, size);
+            m_streamed = true;
+            return;
+        }
+    }
+
+    // 写入自己的UBO: 绑定点此前指向流缓冲中的范围时换回来
+    if (m_streamed) {
+        m_streamed = false;
+        bindBase();
+    }
+    state.bindBuffer(GL_UNIFORM_BUFFER, m_ubo);
+    if (whole) {
+        glBufferData(GL_UNIFORM_BUFFER, m_size, nullptr, GL_DYNAMIC_DRAW);
+    }
+    glBufferSubData(GL_UNIFORM_BUFFER, offset, size, data);
+}
+
+void UniformBuffer::bindBase() const {
+    if (m_ubo != 0) {
+        GLStateCache::current().bindBufferBase(GL_UNIFORM_BUFFER, m_bindingPoint, m_ubo);
+    }
+}
+
+void UniformBuffer::release() {
+    if (m_ubo != 0) {
+        GLStateCache::current().onBufferDeleted(m_ubo);
+        glDeleteBuffers(1, &m_ubo);
+        m_ubo = 0;
+    }
+    m_size = 0;
+    m_streamed = false;
+}
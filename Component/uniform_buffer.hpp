@@ -0,0 +1,110 @@
+#pragma once
+
+// 平台条件编译：OpenGL ES (Android) vs OpenGL Core (PC)
+#ifdef __ANDROID__
+    #include <GLES3/gl3.h>
+    #include <GLES3/gl3ext.h>
+#else
+    #include <glad/glad.h>
+#endif
+
+#include <type_traits>
+
+/**
+ * @brief 全局共享的uniform块绑定点
+ *
+ * 所有着色器中同名的块都绑定到同一个绑定点，因此只需每帧写一次UBO，
+ * 所有渲染器都能读到 (不再需要逐绘制调用 glUniform*)。
+ */
+namespace UniformBinding {
+    constexpr GLuint Frame = 0;     // FrameBlock: 投影/视图矩阵、视口、帧时间
+    constexpr GLuint BatchDraw = 1; // DrawBlock: BatchRender 的逐网格数据 (按 gl_DrawIDARB 索引)
+}
+
+/**
+ * @brief UniformBuffer类 - 封装一个绑定到固定绑定点的UBO
+ *
+ * 单一职责: 管理GL缓冲对象的生命周期与数据上传
+ */
+class UniformBuffer {
+public:
+    UniformBuffer();
+    ~UniformBuffer();
+
+    // 禁止拷贝，允许移动
+    UniformBuffer(const UniformBuffer&) = delete;
+    UniformBuffer& operator=(const UniformBuffer&) = delete;
+    UniformBuffer(UniformBuffer&& other) noexcept;
+    UniformBuffer& operator=(UniformBuffer&& other) noexcept;
+
+    /**
+     * @brief 分配存储并绑定到绑定点
+     * @param size 字节数 (应等于 std140 块大小)
+     * @param bindingPoint 绑定点
+     */
+    bool create(GLsizeiptr size, GLuint bindingPoint);
+
+    /**
+     * @brief 上传数据
+     *
+     * 整块上传且有活动的 StreamBuffer 时写入流缓冲，并把绑定点绑定到该范围 (不经过 glBufferSubData)；
+     * 否则整块上传先孤立旧存储，避免与GPU读取同步。
+     * 部分更新总是写入自己的UBO并换回 bindBase，流式期间的内容不在其中，须先整块上传一次。
+     */
+    void update(const void* data, GLsizeiptr size, GLintptr offset = 0);
+
+    /**
+     * @brief 重新绑定到绑定点 (绑定点被其他缓冲占用后调用)
+     */
+    void bindBase() const;
+
+    void release();
+
+    GLuint id() const { return m_ubo; }
+    GLuint bindingPoint() const { return m_bindingPoint; }
+    GLsizeiptr size() const { return m_size; }
+    bool isValid() const { return m_ubo != 0; }
+
+private:
+    GLuint m_ubo;
+    GLuint m_bindingPoint;
+    GLsizeiptr m_size;
+    bool m_streamed;        // 绑定点当前指向流缓冲中的范围
+};
+
+/**
+ * @brief UniformBlock模板 - 带类型的 std140 CPU 镜像 + UBO
+ *
+ * T 必须按 std140 规则手工布局 (vec3 需补齐到16字节、数组元素按16字节对齐)，
+ * 着色器侧通过 Shader::bindUniformBlock(name, binding, sizeof(T)) 校验大小。
+ */
+template <typename T>
+class UniformBlock {
+    static_assert(std::is_trivially_copyable<T>::value, "UniformBlock requires a trivially copyable type");
+    static_assert(sizeof(T) % 16 == 0, "std140 block size must be a multiple of 16 bytes");
+
+public:
+    bool create(GLuint bindingPoint) {
+        return m_buffer.create(static_cast<GLsizeiptr>(sizeof(T)), bindingPoint);
+    }
+
+    T& data() { return m_data; }
+    const T& data() const { return m_data; }
+
+    /**
+     * @brief 将CPU镜像整体上传到UBO
+     */
+    void upload() {
+        m_buffer.update(&m_data, static_cast<GLsizeiptr>(sizeof(T)));
+    }
+
+    void bindBase() const { m_buffer.bindBase(); }
+    void release() { m_buffer.release(); }
+
+    bool isValid() const { return m_buffer.isValid(); }
+    const UniformBuffer& buffer() const { return m_buffer; }
+
+private:
+    T m_data{};
+    UniformBuffer m_buffer;
+};
@@ -0,0 +1,70 @@
+// uniform_handle.hpp
+// 单一职责: uniform 名称的编译期哈希与预解析的 uniform 句柄
+#pragma once
+
+// 平台条件编译：OpenGL ES (Android) vs OpenGL Core (PC)
+#ifdef __ANDROID__
+    #include <GLES3/gl3.h>
+    #include <GLES3/gl3ext.h>
+#else
+    #include <glad/glad.h>
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief 32位 FNV-1a 哈希 (constexpr，字面量在编译期求值)
+ */
+constexpr uint32_t fnv1a32(const char* str, size_t length) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; ++i) {
+        hash ^= static_cast<uint8_t>(str[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+constexpr size_t constexprStrlen(const char* str) {
+    size_t length = 0;
+    while (str[length] != '\0') {
+        ++length;
+    }
+    return length;
+}
+
+/**
+ * @brief UniformName - 预先哈希的 uniform 名称
+ *
+ * 由字符串字面量隐式构造，不分配 std::string:
+ *   constexpr UniformName kModel("model");      // 编译期求值
+ *   shader.uniformHandle("model");              // 同样无分配
+ */
+struct UniformName {
+    uint32_t hash;
+    const char* name;   // 用于哈希冲突时的比对与错误信息
+
+    constexpr UniformName(const char* str)
+        : hash(fnv1a32(str, constexprStrlen(str)))
+        , name(str)
+    {}
+
+    // 只保存指针: 由 std::string 构造时只在该次调用期间有效，不能保存
+    UniformName(const std::string& str)
+        : hash(fnv1a32(str.c_str(), str.size()))
+        , name(str.c_str())
+    {}
+};
+
+/**
+ * @brief UniformHandle - 链接时解析好的 uniform 位置
+ *
+ * 只对解析它的 Shader 有效；Shader 重新加载后需要重新获取。
+ * 无效句柄 (uniform 不存在或被优化掉) 在设置时直接跳过，不产生GL调用。
+ */
+struct UniformHandle {
+    GLint location = -1;
+
+    bool isValid() const { return location >= 0; }
+};
@@ -0,0 +1,321 @@
+#include "vertex_format.hpp"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+namespace VertexQuantization {
+
+// ============ half float ============
+
+uint16_t floatToHalf(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    const uint32_t sign = (bits >> 16) & 0x8000u;
+    const uint32_t magnitude = bits & 0x7FFFFFFFu;
+
+    if (magnitude >= 0x7F800000u) {
+        // Inf / NaN (NaN 保留为 quiet NaN)
+        return static_cast<uint16_t>(sign | 0x7C00u | (magnitude > 0x7F800000u ? 0x200u : 0u));
+    }
+    if (magnitude >= 0x477FF000u) {
+        // >= 65520 舍入后超出 half 范围
+        return static_cast<uint16_t>(sign | 0x7C00u);
+    }
+
+    if (magnitude < 0x38800000u) {
+        // 小于 2^-14: half 非规格化数 (值 = h * 2^-24)
+        if (magnitude < 0x33000000u) {
+            return static_cast<uint16_t>(sign);
+        }
+        const uint32_t exponent = magnitude >> 23;
+        const uint32_t mantissa = (magnitude & 0x7FFFFFu) | 0x800000u;
+        const uint32_t shift = 126 - exponent;
+        uint32_t half = mantissa >> shift;
+        const uint32_t remainder = mantissa & ((1u << shift) - 1);
+        const uint32_t halfway = 1u << (shift - 1);
+        if (remainder > halfway || (remainder == halfway && (half & 1u))) {
+            ++half;
+        }
+        return static_cast<uint16_t>(sign | half);
+    }
+
+    // 规格化数: 指数偏移 127 → 15，尾数 23 → 10 位 (就近舍入到偶数)
+    uint32_t half = (magnitude - 0x38000000u) >> 13;
+    const uint32_t remainder = magnitude & 0x1FFFu;
+    if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u))) {
+        ++half;
+    }
+    return static_cast<uint16_t>(sign | half);
+}
+
+float halfToFloat(uint16_t value) {
+    const uint32_t sign = static_cast<uint32_t>(value & 0x8000u) << 16;
+    const uint32_t exponent = (value >> 10) & 0x1Fu;
+    const uint32_t mantissa = value & 0x3FFu;
+
+    if (exponent == 0) {
+        const float magnitude = std::ldexp(static_cast<float>(mantissa), -24);
+        return sign ? -magnitude : magnitude;
+    }
+
+    uint32_t bits;
+    if (exponent == 31) {
+        bits = sign | 0x7F800000u | (mantissa << 13);
+    } else {
+        bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    }
+    float result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+// ============ 定点 ============
+
+int16_t toSnorm16(float value) {
+    return static_cast<int16_t>(std::lround(std::clamp(value, -1.0f, 1.0f) * 32767.0f));
+}
+
+uint16_t toUnorm16(float value) {
+    return static_cast<uint16_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * 65535.0f));
+}
+
+uint8_t toUnorm8(float value) {
+    return static_cast<uint8_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * 255.0f));
+}
+
+// ============ 八面体法线 ============
+
+namespace {
+glm::vec2 signNotZero(const glm::vec2& v) {
+    return glm::vec2(v.x >= 0.0f ? 1.0f : -1.0f, v.y >= 0.0f ? 1.0f : -1.0f);
+}
+} // namespace
+
+glm::vec2 octEncode(const glm::vec3& normal) {
+    const float l1 = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+    if (l1 <= 0.0f) {
+        return glm::vec2(0.0f);
+    }
+    glm::vec2 p = glm::vec2(normal.x, normal.y) / l1;
+    if (normal.z < 0.0f) {
+        // 下半球折叠到正方形的四个角
+        p = (1.0f - glm::abs(glm::vec2(p.y, p.x))) * signNotZero(p);
+    }
+    return p;
+}
+
+glm::vec3 octDecode(const glm::vec2& encoded) {
+    glm::vec3 n(encoded.x, encoded.y, 1.0f - std::abs(encoded.x) - std::abs(encoded.y));
+    if (n.z < 0.0f) {
+        const glm::vec2 folded = (1.0f - glm::abs(glm::vec2(n.y, n.x))) * signNotZero(glm::vec2(n.x, n.y));
+        n.x = folded.x;
+        n.y = folded.y;
+    }
+    return glm::normalize(n);
+}
+
+} // namespace VertexQuantization
+
+// ============ 属性指针 ============
+
+void applyVertexAttributes(const VertexAttribute* attributes, size_t count, size_t stride) {
+    for (size_t i = 0; i < count; ++i) {
+        const VertexAttribute& attribute = attributes[i];
+        glEnableVertexAttribArray(attribute.location);
+        const void* offset = reinterpret_cast<const void*>(attribute.offset);
+        if (attribute.integer) {
+            glVertexAttribIPointer(attribute.location, attribute.components, attribute.type,
+                                   static_cast<GLsizei>(stride), offset);
+        } else {
+            glVertexAttribPointer(attribute.location, attribute.components, attribute.type,
+                                  attribute.normalized ? GL_TRUE : GL_FALSE, static_cast<GLsizei>(stride), offset);
+        }
+    }
+}
+
+void VertexStream::applyAttributes() const {
+    applyVertexAttributes(attributes.data(), attributes.size(), stride);
+}
+
+// ============ VertexStreamBuilder ============
+
+VertexStreamBuilder::VertexStreamBuilder(size_t vertexCount)
+    : m_vertexCount(vertexCount)
+    , m_dequantize(1.0f)
+{
+}
+
+void VertexStreamBuilder::addAttribute(const VertexAttribute& attribute, size_t size, Writer writer) {
+    m_attributes.push_back({ attribute, size, std::move(writer) });
+}
+
+void VertexStreamBuilder::addPosition(GLuint location, PositionFormat format, const glm::vec3* source, size_t sourceStride) {
+    VertexAttribute attribute;
+    attribute.location = location;
+    attribute.components = 3;
+
+    if (format == PositionFormat::Float32 || m_vertexCount == 0) {
+        attribute.type = GL_FLOAT;
+        addAttribute(attribute, sizeof(glm::vec3), [=](uint8_t* destination, size_t vertex) {
+            std::memcpy(destination, &at(source, sourceStride, vertex), sizeof(glm::vec3));
+        });
+        return;
+    }
+
+    // 包围盒归一化: q = (p - center) / extent ∈ [-1,1]
+    glm::vec3 minimum = at(source, sourceStride, 0);
+    glm::vec3 maximum = minimum;
+    for (size_t i = 1; i < m_vertexCount; ++i) {
+        minimum = glm::min(minimum, at(source, sourceStride, i));
+        maximum = glm::max(maximum, at(source, sourceStride, i));
+    }
+    const glm::vec3 center = (minimum + maximum) * 0.5f;
+    glm::vec3 extent = (maximum - minimum) * 0.5f;
+    for (int axis = 0; axis < 3; ++axis) {
+        if (extent[axis] <= 0.0f) {
+            extent[axis] = 1.0f;    // 平面网格: 该轴所有值都等于中心
+        }
+    }
+
+    if (format == PositionFormat::Half16) {
+        attribute.type = GL_HALF_FLOAT;
+        m_dequantize = glm::scale(glm::translate(glm::mat4(1.0f), center), extent);
+        addAttribute(attribute, 4 * sizeof(uint16_t), [=](uint8_t* destination, size_t vertex) {
+            const glm::vec3 q = (at(source, sourceStride, vertex) - center) / extent;
+            const uint16_t packed[4] = {
+                VertexQuantization::floatToHalf(q.x),
+                VertexQuantization::floatToHalf(q.y),
+                VertexQuantization::floatToHalf(q.z),
+                0
+            };
+            std::memcpy(destination, packed, sizeof(packed));
+        });
+        return;
+    }
+
+    // snorm16: 以非归一化的 GL_SHORT 读取，1/32767 并入反量化矩阵
+    // (GL 3.3 与 GL 4.2+/ES 3.0 的有符号归一化公式不同，这样在所有版本上都是精确的)
+    attribute.type = GL_SHORT;
+    m_dequantize = glm::scale(glm::translate(glm::mat4(1.0f), center), extent / 32767.0f);
+    addAttribute(attribute, 4 * sizeof(int16_t), [=](uint8_t* destination, size_t vertex) {
+        const glm::vec3 q = (at(source, sourceStride, vertex) - center) / extent;
+        const int16_t packed[4] = {
+            VertexQuantization::toSnorm16(q.x),
+            VertexQuantization::toSnorm16(q.y),
+            VertexQuantization::toSnorm16(q.z),
+            0
+        };
+        std::memcpy(destination, packed, sizeof(packed));
+    });
+}
+
+void VertexStreamBuilder::addTexCoord(GLuint location, TexCoordFormat format, const glm::vec2* source, size_t sourceStride) {
+    VertexAttribute attribute;
+    attribute.location = location;
+    attribute.components = 2;
+
+    if (format == TexCoordFormat::Unorm16) {
+        bool inRange = true;
+        for (size_t i = 0; i < m_vertexCount && inRange; ++i) {
+            const glm::vec2& uv = at(source, sourceStride, i);
+            inRange = uv.x >= 0.0f && uv.x <= 1.0f && uv.y >= 0.0f && uv.y <= 1.0f;
+        }
+
+        if (inRange) {
+            attribute.type = GL_UNSIGNED_SHORT;
+            attribute.normalized = true;
+            addAttribute(attribute, 2 * sizeof(uint16_t), [=](uint8_t* destination, size_t vertex) {
+                const glm::vec2& uv = at(source, sourceStride, vertex);
+                const uint16_t packed[2] = { VertexQuantization::toUnorm16(uv.x), VertexQuantization::toUnorm16(uv.y) };
+                std::memcpy(destination, packed, sizeof(packed));
+            });
+            return;
+        }
+        // 重复平铺的UV (超出 [0,1]) 无法用 unorm 表示，保持浮点
+    }
+
+    attribute.type = GL_FLOAT;
+    addAttribute(attribute, sizeof(glm::vec2), [=](uint8_t* destination, size_t vertex) {
+        std::memcpy(destination, &at(source, sourceStride, vertex), sizeof(glm::vec2));
+    });
+}
+
+void VertexStreamBuilder::addColor(GLuint location, ColorFormat format, const glm::vec3* source, size_t sourceStride) {
+    VertexAttribute attribute;
+    attribute.location = location;
+
+    if (format == ColorFormat::Rgba8) {
+        // 着色器中声明为 vec3 时多出的 alpha 分量被忽略
+        attribute.components = 4;
+        attribute.type = GL_UNSIGNED_BYTE;
+        attribute.normalized = true;
+        addAttribute(attribute, 4, [=](uint8_t* destination, size_t vertex) {
+            const glm::vec3& color = at(source, sourceStride, vertex);
+            destination[0] = VertexQuantization::toUnorm8(color.r);
+            destination[1] = VertexQuantization::toUnorm8(color.g);
+            destination[2] = VertexQuantization::toUnorm8(color.b);
+            destination[3] = 255;
+        });
+        return;
+    }
+
+    attribute.components = 3;
+    attribute.type = GL_FLOAT;
+    addAttribute(attribute, sizeof(glm::vec3), [=](uint8_t* destination, size_t vertex) {
+        std::memcpy(destination, &at(source, sourceStride, vertex), sizeof(glm::vec3));
+    });
+}
+
+void VertexStreamBuilder::addNormal(GLuint location, NormalFormat format, const glm::vec3* source, size_t sourceStride) {
+    VertexAttribute attribute;
+    attribute.location = location;
+
+    if (format == NormalFormat::Oct16) {
+        // 着色器以 vec2 读取并解码 (有符号归一化公式的版本差异对单位向量可以忽略)
+        attribute.components = 2;
+        attribute.type = GL_SHORT;
+        attribute.normalized = true;
+        addAttribute(attribute, 2 * sizeof(int16_t), [=](uint8_t* destination, size_t vertex) {
+            const glm::vec2 encoded = VertexQuantization::octEncode(at(source, sourceStride, vertex));
+            const int16_t packed[2] = { VertexQuantization::toSnorm16(encoded.x), VertexQuantization::toSnorm16(encoded.y) };
+            std::memcpy(destination, packed, sizeof(packed));
+        });
+        return;
+    }
+
+    attribute.components = 3;
+    attribute.type = GL_FLOAT;
+    addAttribute(attribute, sizeof(glm::vec3), [=](uint8_t* destination, size_t vertex) {
+        std::memcpy(destination, &at(source, sourceStride, vertex), sizeof(glm::vec3));
+    });
+}
+
+VertexStream VertexStreamBuilder::build() const {
+    VertexStream stream;
+    stream.vertexCount = m_vertexCount;
+    stream.dequantize = m_dequantize;
+
+    // 每个属性4字节对齐 (部分驱动对未对齐的属性走慢速路径)
+    size_t offset = 0;
+    for (const PendingAttribute& pending : m_attributes) {
+        VertexAttribute attribute = pending.attribute;
+        attribute.offset = offset;
+        stream.attributes.push_back(attribute);
+        offset += (pending.size + 3) & ~static_cast<size_t>(3);
+    }
+    stream.stride = offset;
+
+    stream.data.assign(stream.stride * m_vertexCount, 0);
+    for (size_t vertex = 0; vertex < m_vertexCount; ++vertex) {
+        uint8_t* base = stream.data.data() + vertex * stream.stride;
+        for (size_t i = 0; i < m_attributes.size(); ++i) {
+            m_attributes[i].writer(base + stream.attributes[i].offset, vertex);
+        }
+    }
+    return stream;
+}
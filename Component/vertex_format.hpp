@@ -0,0 +1,155 @@
+// vertex_format.hpp
+// 单一职责: 顶点属性量化 (half/snorm16/unorm16/RGBA8/八面体法线) 与紧凑顶点缓冲的打包、属性指针设置
+#pragma once
+
+// 平台条件编译：OpenGL ES (Android) vs OpenGL Core (PC)
+#ifdef __ANDROID__
+    #include <GLES3/gl3.h>
+    #include <GLES3/gl3ext.h>
+#else
+    #include <glad/glad.h>
+#endif
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// ============ 可选格式 ============
+
+enum class PositionFormat {
+    Float32,    // 12字节
+    Half16,     // 8字节 (含1个填充分量)，包围盒归一化后存储
+    Snorm16,    // 8字节 (含1个填充分量)，包围盒归一化到 [-1,1]
+};
+
+enum class TexCoordFormat {
+    Float32,    // 8字节
+    Unorm16,    // 4字节，要求UV在 [0,1] 内，否则自动退回 Float32
+};
+
+enum class ColorFormat {
+    Float32,    // 12字节 (RGB)
+    Rgba8,      // 4字节
+};
+
+enum class NormalFormat {
+    Float32,    // 12字节
+    Oct16,      // 4字节，八面体映射 snorm16x2 (着色器中解码)
+};
+
+/**
+ * @brief 一个网格各属性的存储格式，由渲染配置选择
+ */
+struct VertexFormat {
+    PositionFormat position = PositionFormat::Float32;
+    TexCoordFormat texCoord = TexCoordFormat::Float32;
+    ColorFormat color = ColorFormat::Float32;
+    NormalFormat normal = NormalFormat::Float32;
+
+    // 全部使用紧凑格式: snorm16 位置 + unorm16 UV + RGBA8 颜色 + 八面体法线
+    static VertexFormat compact() {
+        return { PositionFormat::Snorm16, TexCoordFormat::Unorm16, ColorFormat::Rgba8, NormalFormat::Oct16 };
+    }
+};
+
+// ============ 量化函数 ============
+
+namespace VertexQuantization {
+
+uint16_t floatToHalf(float value);
+float halfToFloat(uint16_t value);
+
+int16_t toSnorm16(float value);     // [-1,1]
+uint16_t toUnorm16(float value);    // [0,1]
+uint8_t toUnorm8(float value);      // [0,1]
+
+/**
+ * @brief 八面体映射: 单位向量 → [-1,1]^2
+ */
+glm::vec2 octEncode(const glm::vec3& normal);
+glm::vec3 octDecode(const glm::vec2& encoded);
+
+} // namespace VertexQuantization
+
+// ============ 打包结果 ============
+
+/**
+ * @brief 一个顶点属性的指针描述 (对应一次 glVertexAttribPointer / glVertexAttribIPointer)
+ */
+struct VertexAttribute {
+    GLuint location = 0;
+    GLint components = 0;
+    GLenum type = GL_FLOAT;
+    bool normalized = false;    // 整数归一化到 [0,1]/[-1,1] 后以浮点读取
+    bool integer = false;       // 着色器以 int/uint 读取 (glVertexAttribIPointer)
+    size_t offset = 0;
+};
+
+/**
+ * @brief 为当前绑定的 VAO/GL_ARRAY_BUFFER 启用并设置一组交错属性的指针
+ */
+void applyVertexAttributes(const VertexAttribute* attributes, size_t count, size_t stride);
+
+/**
+ * @brief 打包后的交错顶点缓冲
+ *
+ * 位置按包围盒量化时，dequantize 把存储值还原到模型空间；
+ * 渲染器把它右乘到模型矩阵 (model * dequantize)，着色器无需任何改动。
+ */
+struct VertexStream {
+    std::vector<uint8_t> data;
+    size_t stride = 0;
+    size_t vertexCount = 0;
+    std::vector<VertexAttribute> attributes;
+    glm::mat4 dequantize = glm::mat4(1.0f);
+
+    /**
+     * @brief 为当前绑定的 VAO/GL_ARRAY_BUFFER 启用并设置所有属性指针
+     */
+    void applyAttributes() const;
+};
+
+/**
+ * @brief VertexStreamBuilder - 从任意顶点结构体按选定格式逐属性打包
+ *
+ * 每个属性4字节对齐，属性按添加顺序交错排列:
+ *   VertexStreamBuilder builder(vertices.size());
+ *   builder.addPosition(0, format.position, &vertices[0].position, sizeof(Vertex));
+ *   builder.addTexCoord(1, format.texCoord, &vertices[0].texCoord, sizeof(Vertex));
+ *   VertexStream stream = builder.build();
+ */
+class VertexStreamBuilder {
+public:
+    explicit VertexStreamBuilder(size_t vertexCount);
+
+    // source 指向第一个顶点的对应成员，sourceStride 为源顶点结构体大小
+    void addPosition(GLuint location, PositionFormat format, const glm::vec3* source, size_t sourceStride);
+    void addTexCoord(GLuint location, TexCoordFormat format, const glm::vec2* source, size_t sourceStride);
+    void addColor(GLuint location, ColorFormat format, const glm::vec3* source, size_t sourceStride);
+    void addNormal(GLuint location, NormalFormat format, const glm::vec3* source, size_t sourceStride);
+
+    VertexStream build() const;
+
+private:
+    using Writer = std::function<void(uint8_t* destination, size_t vertex)>;
+
+    void addAttribute(const VertexAttribute& attribute, size_t size, Writer writer);
+
+    template <typename T>
+    static const T& at(const T* source, size_t sourceStride, size_t vertex) {
+        return *reinterpret_cast<const T*>(reinterpret_cast<const uint8_t*>(source) + vertex * sourceStride);
+    }
+
+    struct PendingAttribute {
+        VertexAttribute attribute;
+        size_t size;
+        Writer writer;
+    };
+
+    size_t m_vertexCount;
+    std::vector<PendingAttribute> m_attributes;
+    glm::mat4 m_dequantize;
+};
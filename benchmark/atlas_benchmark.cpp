@@ -0,0 +1,442 @@
+/**
+ * @file atlas_benchmark.cpp
+ * @brief 图集基准 - 大量各带一张小纹理的物体: 逐物体绑定纹理绘制 vs 图集一次绑定实例化绘制
+ *
+ * 每个物体是网格中的一个四边形，纹理尺寸在 16~64 之间变化 (确定性生成)。
+ *   - separate : 每个物体一条 RenderQueue 命令，各自绑定 GL_TEXTURE_2D 并设置 model uniform
+ *   - atlas    : TextureAtlas 打包为 GL_TEXTURE_2D_ARRAY，位置/子纹理区域/层号为逐实例属性，一次 glDrawArraysInstanced
+ * 报告两种方式的CPU提交耗时、整帧耗时 (含 glFinish)、纹理切换数，图集的页数/占用率、
+ * CPU (MipChain) 与 GPU (glGenerateMipmap) 两种mip生成方式的构建耗时，以及两种画面的逐像素差值。
+ *
+ * 用法:
+ *   atlas_benchmark [--objects N] [--frames N] [--page SIZE] [--padding N] [--size WxH] [--output report.json]
+ */
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "shader.hpp"
+#include "gl_state_cache.hpp"
+#include "render_queue.hpp"
+#include "texture_atlas.hpp"
+#include "framebuffer.hpp"
+#include "platform/headless_context.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    size_t objects = 4096;
+    uint64_t frames = 200;
+    int pageSize = 1024;
+    int padding = 4;
+    int width = 2048;
+    int height = 2048;
+    std::string outputPath;
+};
+
+struct SourceImage {
+    int width = 0;
+    int height = 0;
+    std::vector<uint8_t> pixels;
+};
+
+struct ModeResult {
+    std::string name;
+    double meanSubmitMs = 0.0;      // 记录 + 排序 + 提交 的CPU耗时
+    double meanFrameMs = 0.0;       // 含 glFinish
+    uint32_t drawCalls = 0;
+    uint32_t textureSwitches = 0;
+};
+
+// 逐实例: 位置 (xy 偏移, zw 缩放，NDC)、子纹理区域、层号
+struct AtlasInstance {
+    glm::vec4 placement;
+    glm::vec4 rect;
+    float layer;
+};
+
+const char* kSeparateVertexShader = R"(#version 330 core
+layout(location = 0) in vec2 position;
+uniform mat4 model;
+out vec2 vTexCoord;
+void main() {
+    vTexCoord = position;
+    gl_Position = model * vec4(position, 0.0, 1.0);
+}
+)";
+
+const char* kSeparateFragmentShader = R"(#version 330 core
+in vec2 vTexCoord;
+out vec4 fragColor;
+uniform sampler2D image;
+void main() {
+    fragColor = texture(image, vTexCoord);
+}
+)";
+
+const char* kAtlasVertexShader = R"(#version 330 core
+layout(location = 0) in vec2 position;
+layout(location = 1) in vec4 placement;
+layout(location = 2) in vec4 rect;
+layout(location = 3) in float layer;
+out vec3 vTexCoord;
+void main() {
+    vTexCoord = vec3(rect.xy + position * rect.zw, layer);
+    gl_Position = vec4(placement.xy + position * placement.zw, 0.0, 1.0);
+}
+)";
+
+const char* kAtlasFragmentShader = R"(#version 330 core
+in vec3 vTexCoord;
+out vec4 fragColor;
+uniform sampler2DArray atlas;
+void main() {
+    fragColor = texture(atlas, vTexCoord);
+}
+)";
+
+double elapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// 尺寸 16~64 (宽高独立变化)，内容为按物体变化的渐变 + 边框，便于发现错位与串色
+std::vector<SourceImage> makeImages(size_t count) {
+    std::vector<SourceImage> images(count);
+    for (size_t i = 0; i < count; ++i) {
+        SourceImage& image = images[i];
+        image.width = 16 + 16 * static_cast<int>(i % 4);
+        image.height = 16 + 16 * static_cast<int>((i / 4) % 4);
+        image.pixels.resize(static_cast<size_t>(image.width) * image.height * 4);
+        const uint8_t tint = static_cast<uint8_t>((i * 53) & 0xFF);
+        for (int y = 0; y < image.height; ++y) {
+            for (int x = 0; x < image.width; ++x) {
+                uint8_t* p = &image.pixels[(static_cast<size_t>(y) * image.width + x) * 4];
+                const bool border = x == 0 || y == 0 || x == image.width - 1 || y == image.height - 1;
+                p[0] = border ? 255 : static_cast<uint8_t>((x * 255) / image.width);
+                p[1] = border ? 255 : static_cast<uint8_t>((y * 255) / image.height);
+                p[2] = tint;
+                p[3] = 255;
+            }
+        }
+    }
+    return images;
+}
+
+// 网格中第 i 个物体的 NDC 位置 (xy 左下角, zw 尺寸)
+glm::vec4 placementOf(size_t i, size_t columns) {
+    const float cell = 2.0f / static_cast<float>(columns);
+    const float x = -1.0f + cell * static_cast<float>(i % columns);
+    const float y = -1.0f + cell * static_cast<float>(i / columns);
+    return glm::vec4(x + cell * 0.05f, y + cell * 0.05f, cell * 0.9f, cell * 0.9f);
+}
+
+bool parseArgs(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--objects") == 0 && hasValue) {
+            options.objects = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--frames") == 0 && hasValue) {
+            options.frames = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--page") == 0 && hasValue) {
+            options.pageSize = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--padding") == 0 && hasValue) {
+            options.padding = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--size") == 0 && hasValue) {
+            if (std::sscanf(argv[++i], "%dx%d", &options.width, &options.height) != 2) {
+                std::cerr << "Invalid --size, expected WxH" << std::endl;
+                return false;
+            }
+        } else if (std::strcmp(argv[i], "--output") == 0 && hasValue) {
+            options.outputPath = argv[++i];
+        } else {
+            std::cerr << "Unknown argument: " << argv[i] << std::endl;
+            return false;
+        }
+    }
+    if (options.objects == 0 || options.frames == 0 || options.width <= 0 || options.height <= 0) {
+        std::cerr << "--objects, --frames and --size must be positive" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool buildAtlas(TextureAtlas& atlas, const std::vector<SourceImage>& images, const Options& options, AtlasMipMode mode) {
+    for (const SourceImage& image : images) {
+        atlas.add(image.pixels.data(), image.width, image.height);
+    }
+    TextureAtlasSettings settings;
+    settings.pageSize = options.pageSize;
+    settings.padding = options.padding;
+    settings.mipMode = mode;
+    if (!atlas.build(settings)) {
+        std::cerr << "Failed to build atlas: " << atlas.lastError() << std::endl;
+        return false;
+    }
+    glFinish();
+    return true;
+}
+
+void writeAtlasStats(std::ostream& out, const char* key, const TextureAtlasStats& stats, double buildMs, bool last) {
+    out << "    \"" << key << "\": { "
+        << "\"pages\": " << stats.pages << ", "
+        << "\"occupancy\": " << stats.occupancy << ", "
+        << "\"mip_levels\": " << stats.mipLevels << ", "
+        << "\"mb\": " << stats.bytes / (1024.0 * 1024.0) << ", "
+        << "\"pack_ms\": " << stats.packMs << ", "
+        << "\"mip_ms\": " << stats.mipMs << ", "
+        << "\"upload_ms\": " << stats.uploadMs << ", "
+        << "\"build_ms\": " << buildMs << " }" << (last ? "\n" : ",\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseArgs(argc, argv, options)) {
+        return -1;
+    }
+
+    HeadlessContext context;
+    if (!context.create(3, 3)) {
+        std::cerr << "Failed to create headless context: " << context.lastError() << std::endl;
+        return -1;
+    }
+    if (!gladLoadGLLoader((GLADloadproc)HeadlessContext::getProcAddress)) {
+        std::cerr << "Failed to initialize GLAD" << std::endl;
+        return -1;
+    }
+
+    Framebuffer framebuffer;
+    if (!framebuffer.create(options.width, options.height)) {
+        std::cerr << "Failed to create framebuffer: " << framebuffer.lastError() << std::endl;
+        return -1;
+    }
+    framebuffer.bind();
+    glViewport(0, 0, options.width, options.height);
+
+    Shader separateShader;
+    Shader atlasShader;
+    if (!separateShader.loadFromSource(kSeparateVertexShader, kSeparateFragmentShader) ||
+        !atlasShader.loadFromSource(kAtlasVertexShader, kAtlasFragmentShader)) {
+        std::cerr << "Failed to compile shaders" << std::endl;
+        return -1;
+    }
+    separateShader.use();
+    separateShader.setInt("image", 0);
+    atlasShader.use();
+    atlasShader.setInt("atlas", 0);
+
+    GLStateCache& state = GLStateCache::current();
+    const std::vector<SourceImage> images = makeImages(options.objects);
+    const size_t columns = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(options.objects))));
+
+    // ---- 资源: 逐物体纹理 (glGenerateMipmap) 与两种mip方式的图集 ----
+    auto start = Clock::now();
+    std::vector<GLuint> textures(images.size());
+    glGenTextures(static_cast<GLsizei>(textures.size()), textures.data());
+    for (size_t i = 0; i < images.size(); ++i) {
+        state.bindTexture(GL_TEXTURE_2D, textures[i]);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, images[i].width, images[i].height, 0, GL_RGBA, GL_UNSIGNED_BYTE, images[i].pixels.data());
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glGenerateMipmap(GL_TEXTURE_2D);
+    }
+    glFinish();
+    const double separateBuildMs = elapsedMs(start);
+
+    TextureAtlas gpuMipAtlas;
+    start = Clock::now();
+    if (!buildAtlas(gpuMipAtlas, images, options, AtlasMipMode::Gpu)) {
+        return -1;
+    }
+    const double gpuMipBuildMs = elapsedMs(start);
+    const TextureAtlasStats gpuMipStats = gpuMipAtlas.stats();
+    gpuMipAtlas.release();
+
+    TextureAtlas atlas;
+    start = Clock::now();
+    if (!buildAtlas(atlas, images, options, AtlasMipMode::Cpu)) {
+        return -1;
+    }
+    const double cpuMipBuildMs = elapsedMs(start);
+
+    // ---- 几何: 单位四边形 + 图集的逐实例缓冲 ----
+    const float quad[] = { 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f };
+    std::vector<AtlasInstance> instances(images.size());
+    std::vector<glm::mat4> models(images.size());
+    for (size_t i = 0; i < images.size(); ++i) {
+        const glm::vec4 placement = placementOf(i, columns);
+        const AtlasRegion& region = atlas.region(static_cast<uint32_t>(i));
+        instances[i] = { placement, region.uvRect, static_cast<float>(region.layer) };
+        models[i] = glm::scale(glm::translate(glm::mat4(1.0f), glm::vec3(placement.x, placement.y, 0.0f)),
+                               glm::vec3(placement.z, placement.w, 1.0f));
+    }
+
+    GLuint vaos[2] = { 0, 0 };
+    GLuint buffers[2] = { 0, 0 };
+    glGenVertexArrays(2, vaos);
+    glGenBuffers(2, buffers);
+    state.bindBuffer(GL_ARRAY_BUFFER, buffers[0]);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(quad), quad, GL_STATIC_DRAW);
+    for (GLuint vao : vaos) {
+        state.bindVertexArray(vao);
+        state.bindBuffer(GL_ARRAY_BUFFER, buffers[0]);
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+    }
+    state.bindBuffer(GL_ARRAY_BUFFER, buffers[1]);
+    glBufferData(GL_ARRAY_BUFFER, instances.size() * sizeof(AtlasInstance), instances.data(), GL_STATIC_DRAW);
+    const GLsizei stride = sizeof(AtlasInstance);
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(AtlasInstance, placement));
+    glVertexAttribDivisor(1, 1);
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(AtlasInstance, rect));
+    glVertexAttribDivisor(2, 1);
+    glEnableVertexAttribArray(3);
+    glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(AtlasInstance, layer));
+    glVertexAttribDivisor(3, 1);
+    state.bindVertexArray(0);
+
+    const GLint modelLocation = separateShader.uniformHandle("model").location;
+    RenderQueue queue;
+
+    auto recordSeparate = [&]() {
+        for (size_t i = 0; i < images.size(); ++i) {
+            DrawCommand command;
+            command.program = separateShader.programId();
+            command.vertexArray = vaos[0];
+            command.texture = textures[i];
+            command.primitive = GL_TRIANGLE_STRIP;
+            command.count = 4;
+            command.modelLocation = modelLocation;
+            command.key = SortKey::opaque(RenderLayer::Opaque, command.program, command.texture, 0.0f);
+            queue.push(command, models[i]);
+        }
+    };
+    auto recordAtlas = [&]() {
+        DrawCommand command;
+        command.program = atlasShader.programId();
+        command.vertexArray = vaos[1];
+        command.texture = atlas.texture();
+        command.textureTarget = TextureAtlas::kTarget;
+        command.primitive = GL_TRIANGLE_STRIP;
+        command.count = 4;
+        command.instanceCount = static_cast<GLsizei>(images.size());
+        command.key = SortKey::opaque(RenderLayer::Opaque, command.program, command.texture, 0.0f);
+        queue.push(command);
+    };
+
+    std::vector<ModeResult> results;
+    std::vector<std::vector<uint8_t>> frames;
+    const std::vector<std::pair<const char*, std::function<void()>>> modes = {
+        { "separate", recordSeparate },
+        { "atlas", recordAtlas },
+    };
+    for (const auto& mode : modes) {
+        ModeResult result;
+        result.name = mode.first;
+        double submitMs = 0.0;
+        double frameMs = 0.0;
+        for (uint64_t frame = 0; frame < options.frames; ++frame) {
+            const auto frameStart = Clock::now();
+            glClear(GL_COLOR_BUFFER_BIT);
+            queue.clear();
+            mode.second();
+            queue.sort();
+            queue.submit();
+            submitMs += elapsedMs(frameStart);
+            glFinish();
+            frameMs += elapsedMs(frameStart);
+        }
+        result.meanSubmitMs = submitMs / static_cast<double>(options.frames);
+        result.meanFrameMs = frameMs / static_cast<double>(options.frames);
+        result.drawCalls = queue.lastStats().commands;
+        result.textureSwitches = queue.lastStats().textureSwitches;
+        results.push_back(result);
+
+        frames.emplace_back();
+        framebuffer.readPixels(frames.back());
+    }
+
+    // ---- 正确性: 两种方式的画面 (子纹理错位/串色会产生大的差值) ----
+    int maxPixelDiff = 0;
+    double sumPixelDiff = 0.0;
+    for (size_t p = 0; p < frames[0].size(); ++p) {
+        const int diff = std::abs(static_cast<int>(frames[0][p]) - frames[1][p]);
+        maxPixelDiff = std::max(maxPixelDiff, diff);
+        sumPixelDiff += diff;
+    }
+
+    std::ofstream file;
+    if (!options.outputPath.empty()) {
+        file.open(options.outputPath);
+        if (!file.is_open()) {
+            std::cerr << "Failed to open output file: " << options.outputPath << std::endl;
+            return -1;
+        }
+    }
+    std::ostream& out = options.outputPath.empty() ? std::cout : file;
+
+    out << "{\n";
+    out << "  \"objects\": " << options.objects << ",\n";
+    out << "  \"frames\": " << options.frames << ",\n";
+    out << "  \"page_size\": " << options.pageSize << ",\n";
+    out << "  \"padding\": " << options.padding << ",\n";
+    out << "  \"max_pixel_diff\": " << maxPixelDiff << ",\n";
+    out << "  \"mean_pixel_diff\": " << sumPixelDiff / static_cast<double>(frames[0].size()) << ",\n";
+    out << "  \"separate_build_ms\": " << separateBuildMs << ",\n";
+    out << "  \"atlas\": {\n";
+    writeAtlasStats(out, "cpu_mips", atlas.stats(), cpuMipBuildMs, false);
+    writeAtlasStats(out, "gpu_mips", gpuMipStats, gpuMipBuildMs, true);
+    out << "  },\n";
+    out << "  \"modes\": {\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const ModeResult& r = results[i];
+        out << "    \"" << r.name << "\": { "
+            << "\"submit_ms\": " << r.meanSubmitMs << ", "
+            << "\"frame_ms\": " << r.meanFrameMs << ", "
+            << "\"draw_calls\": " << r.drawCalls << ", "
+            << "\"texture_switches\": " << r.textureSwitches << " }" << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    out << "  }\n";
+    out << "}\n";
+
+    for (GLuint texture : textures) {
+        state.onTextureDeleted(texture);
+    }
+    glDeleteTextures(static_cast<GLsizei>(textures.size()), textures.data());
+    atlas.release();
+    for (GLuint vao : vaos) {
+        state.onVertexArrayDeleted(vao);
+    }
+    glDeleteVertexArrays(2, vaos);
+    for (GLuint buffer : buffers) {
+        state.onBufferDeleted(buffer);
+    }
+    glDeleteBuffers(2, buffers);
+    framebuffer.unbind();
+    separateShader.release();
+    atlasShader.release();
+    framebuffer.release();
+    return 0;
+}
@@ -0,0 +1,273 @@
+/**
+ * @file bvh_benchmark.cpp
+ * @brief BVH 构建/refit/查询耗时 - 与线性SIMD剔除、逐对象射线测试对比 (纯CPU，不需要GL上下文)
+ *
+ * 每个规模 N:
+ *   - 随机包围盒均匀分布在 [-extent, extent]^3 (固定种子，体积密度与 N 无关)
+ *   - 构建: 分箱SAH，报告节点数、深度、SAH代价
+ *   - 运动: 每帧所有对象沿各自速度平移，Bvh::update (refit，退化时重建)，报告 refit 耗时与代价增长
+ *   - 剔除: 相机位于场景内部，Bvh::cull vs FrustumCulling::cull (最宽指令集)，比对可见集合
+ *   - 拾取: 视口内均匀分布的射线，Bvh::raycast vs 逐对象平板测试，比对命中对象
+ *
+ * 用法:
+ *   bvh_benchmark [--objects 10000,100000,1000000] [--frames N] [--rays N] [--output report.json]
+ */
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "bvh.hpp"
+#include "camera.hpp"
+#include "frustum_culling.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Scene {
+    CullingBounds bounds;
+    std::vector<glm::vec3> centers;
+    std::vector<glm::vec3> extents;
+    std::vector<glm::vec3> velocities;
+};
+
+struct ScaleResult {
+    size_t objects = 0;
+    BvhStats build;
+    double meanRefitMs = 0.0;
+    float costAfterMotion = 0.0f;   // 最后一帧的 SAH 代价 / 构建代价
+    uint32_t rebuilds = 0;
+    double linearCullMs = 0.0;
+    double bvhCullMs = 0.0;
+    size_t visible = 0;
+    size_t cullMismatches = 0;
+    double bruteRayUs = 0.0;        // 每条射线
+    double bvhRayUs = 0.0;
+    size_t rayHits = 0;
+    size_t rayMismatches = 0;
+};
+
+double elapsedMs(Clock::time_point from) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - from).count();
+}
+
+// 体积随 N 增长，平均间距保持不变
+Scene makeScene(size_t count) {
+    const float extent = 10.0f * std::cbrt(static_cast<float>(count));
+    std::mt19937 random(4321);
+    std::uniform_real_distribution<float> position(-extent, extent);
+    std::uniform_real_distribution<float> size(0.5f, 3.0f);
+    std::uniform_real_distribution<float> speed(-0.2f, 0.2f);
+
+    Scene scene;
+    scene.bounds.resize(count);
+    scene.centers.resize(count);
+    scene.extents.resize(count);
+    scene.velocities.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        scene.centers[i] = glm::vec3(position(random), position(random), position(random));
+        scene.extents[i] = glm::vec3(size(random), size(random), size(random));
+        scene.velocities[i] = glm::vec3(speed(random), speed(random), speed(random));
+        scene.bounds.setAabb(i, scene.centers[i], scene.extents[i]);
+    }
+    return scene;
+}
+
+void step(Scene& scene) {
+    for (size_t i = 0; i < scene.centers.size(); ++i) {
+        scene.centers[i] += scene.velocities[i];
+        scene.bounds.setAabb(i, scene.centers[i], scene.extents[i]);
+    }
+}
+
+RayHit bruteForceRay(const Ray& ray, const Scene& scene) {
+    RayHit hit;
+    const glm::vec3 inverseDirection = 1.0f / ray.direction;
+    for (size_t i = 0; i < scene.centers.size(); ++i) {
+        const glm::vec3 t0 = (scene.centers[i] - scene.extents[i] - ray.origin) * inverseDirection;
+        const glm::vec3 t1 = (scene.centers[i] + scene.extents[i] - ray.origin) * inverseDirection;
+        const glm::vec3 near = glm::min(t0, t1);
+        const glm::vec3 far = glm::max(t0, t1);
+        const float enter = std::max(std::max(near.x, near.y), std::max(near.z, 0.0f));
+        const float exit = std::min(std::min(far.x, far.y), std::min(far.z, hit.distance));
+        if (enter <= exit && enter < hit.distance) {
+            hit.object = static_cast<uint32_t>(i);
+            hit.distance = enter;
+        }
+    }
+    return hit;
+}
+
+ScaleResult runScale(size_t count, int frames, int rayCount) {
+    ScaleResult result;
+    result.objects = count;
+    Scene scene = makeScene(count);
+
+    Bvh bvh;
+    bvh.build(scene.bounds);
+    result.build = bvh.stats();
+
+    double refitMs = 0.0;
+    for (int frame = 0; frame < frames; ++frame) {
+        step(scene);
+        const auto start = Clock::now();
+        bvh.update(scene.bounds);
+        refitMs += elapsedMs(start);
+    }
+    result.meanRefitMs = frames > 0 ? refitMs / frames : 0.0;
+    result.costAfterMotion = bvh.stats().buildCost > 0.0f ? bvh.stats().cost / bvh.stats().buildCost : 0.0f;
+    result.rebuilds = bvh.stats().rebuilds;
+
+    // 相机在场景中心附近，看向场景内部
+    Camera camera(glm::vec3(0.0f), 50.0f);
+    camera.updateAspectRatio(16.0f / 9.0f);
+    const Frustum frustum = Frustum::fromCamera(camera);
+
+    std::vector<uint32_t> linearVisible;
+    std::vector<uint32_t> bvhVisible;
+    const int cullRuns = 10;
+    result.linearCullMs = std::numeric_limits<double>::max();
+    result.bvhCullMs = std::numeric_limits<double>::max();
+    for (int run = 0; run < cullRuns; ++run) {
+        auto start = Clock::now();
+        FrustumCulling::cull(frustum, scene.bounds, CullShape::Aabb, linearVisible);
+        result.linearCullMs = std::min(result.linearCullMs, elapsedMs(start));
+
+        start = Clock::now();
+        bvh.cull(frustum, scene.bounds, bvhVisible);
+        result.bvhCullMs = std::min(result.bvhCullMs, elapsedMs(start));
+    }
+    std::sort(bvhVisible.begin(), bvhVisible.end());
+    result.visible = linearVisible.size();
+    result.cullMismatches = linearVisible == bvhVisible ? 0 : std::max(linearVisible.size(), bvhVisible.size());
+
+    // 视口内 side x side 的射线网格
+    const int side = std::max(1, static_cast<int>(std::sqrt(static_cast<double>(rayCount))));
+    std::vector<Ray> rays;
+    for (int y = 0; y < side; ++y) {
+        for (int x = 0; x < side; ++x) {
+            const glm::vec2 ndc(-0.9f + 1.8f * (x + 0.5f) / side, -0.9f + 1.8f * (y + 0.5f) / side);
+            rays.push_back(Ray::fromCamera(camera, ndc));
+        }
+    }
+
+    std::vector<RayHit> bvhHits(rays.size());
+    auto start = Clock::now();
+    for (size_t i = 0; i < rays.size(); ++i) {
+        bvh.raycast(rays[i], scene.bounds, bvhHits[i]);
+    }
+    result.bvhRayUs = elapsedMs(start) * 1000.0 / rays.size();
+
+    // 逐对象测试很慢，只取前若干条射线比对
+    const size_t bruteRays = std::min<size_t>(rays.size(), count >= 1000000 ? 16 : 64);
+    start = Clock::now();
+    for (size_t i = 0; i < bruteRays; ++i) {
+        const RayHit reference = bruteForceRay(rays[i], scene);
+        if (reference.object != bvhHits[i].object) {
+            result.rayMismatches++;
+        }
+    }
+    result.bruteRayUs = elapsedMs(start) * 1000.0 / bruteRays;
+    for (const RayHit& hit : bvhHits) {
+        result.rayHits += hit.hit() ? 1 : 0;
+    }
+    return result;
+}
+
+std::vector<size_t> parseCounts(const std::string& text) {
+    std::vector<size_t> counts;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        const size_t count = std::strtoull(item.c_str(), nullptr, 10);
+        if (count > 0) {
+            counts.push_back(count);
+        }
+    }
+    return counts;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::vector<size_t> counts = { 10000, 100000, 1000000 };
+    int frames = 60;
+    int rayCount = 1024;
+    std::string outputPath;
+
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--objects") == 0 && hasValue) {
+            counts = parseCounts(argv[++i]);
+        } else if (std::strcmp(argv[i], "--frames") == 0 && hasValue) {
+            frames = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--rays") == 0 && hasValue) {
+            rayCount = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--output") == 0 && hasValue) {
+            outputPath = argv[++i];
+        } else {
+            std::cerr << "Unknown argument: " << argv[i] << std::endl;
+            return -1;
+        }
+    }
+    if (counts.empty() || frames < 0 || rayCount <= 0) {
+        std::cerr << "--objects must list positive counts, --rays must be positive" << std::endl;
+        return -1;
+    }
+
+    std::vector<ScaleResult> results;
+    for (size_t count : counts) {
+        results.push_back(runScale(count, frames, rayCount));
+    }
+
+    std::ofstream file;
+    if (!outputPath.empty()) {
+        file.open(outputPath);
+        if (!file.is_open()) {
+            std::cerr << "Failed to open output file: " << outputPath << std::endl;
+            return -1;
+        }
+    }
+    std::ostream& out = outputPath.empty() ? std::cout : file;
+
+    out << "{\n";
+    out << "  \"frames\": " << frames << ",\n";
+    out << "  \"rays\": " << rayCount << ",\n";
+    out << "  \"cull_isa\": \"" << FrustumCulling::isaName(FrustumCulling::bestIsa()) << "\",\n";
+    out << "  \"scales\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const ScaleResult& r = results[i];
+        out << "    { \"objects\": " << r.objects << ",\n"
+            << "      \"build\": { \"ms\": " << r.build.buildMs << ", \"nodes\": " << r.build.nodes
+            << ", \"leaves\": " << r.build.leaves << ", \"depth\": " << r.build.depth
+            << ", \"sah_cost\": " << r.build.buildCost << " },\n"
+            << "      \"motion\": { \"update_ms\": " << r.meanRefitMs << ", \"cost_ratio\": " << r.costAfterMotion
+            << ", \"rebuilds\": " << r.rebuilds << " },\n"
+            << "      \"cull\": { \"visible\": " << r.visible << ", \"linear_ms\": " << r.linearCullMs
+            << ", \"bvh_ms\": " << r.bvhCullMs << ", \"mismatches\": " << r.cullMismatches << " },\n"
+            << "      \"raycast\": { \"hits\": " << r.rayHits << ", \"brute_us\": " << r.bruteRayUs
+            << ", \"bvh_us\": " << r.bvhRayUs << ", \"mismatches\": " << r.rayMismatches << " } }"
+            << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    out << "  ]\n";
+    out << "}\n";
+
+    for (const ScaleResult& r : results) {
+        if (r.cullMismatches != 0 || r.rayMismatches != 0) {
+            std::cerr << r.objects << " objects: BVH results differ from linear reference" << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
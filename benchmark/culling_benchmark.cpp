@@ -0,0 +1,164 @@
+/**
+ * @file culling_benchmark.cpp
+ * @brief 视锥剔除吞吐 - 标量 vs SSE/AVX2/NEON 的每对象耗时 (纯CPU，不需要GL上下文)
+ *
+ * 场景: N 个随机包围盒均匀分布在 [-extent, extent]^3 (固定种子)，
+ * 视锥取自环绕原点的 Camera (45°, 16:9)，约三分之一对象可见。
+ * 每种指令集测试 AABB 与包围球两种形状，取多轮中的最小耗时，并与标量结果逐项比对。
+ *
+ * 用法:
+ *   culling_benchmark [--objects N] [--iterations N] [--output report.json]
+ */
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "camera.hpp"
+#include "frustum_culling.hpp"
+
+namespace {
+
+struct CullResult {
+    CullIsa isa;
+    CullShape shape;
+    CullStats best;
+    size_t mismatches = 0;      // 与标量可见列表不同的条目数
+};
+
+CullingBounds makeScene(size_t count, float extent) {
+    std::mt19937 random(1234);
+    std::uniform_real_distribution<float> position(-extent, extent);
+    std::uniform_real_distribution<float> size(0.5f, 3.0f);
+
+    CullingBounds bounds;
+    bounds.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        const glm::vec3 center(position(random), position(random), position(random));
+        bounds.setAabb(i, center, glm::vec3(size(random), size(random), size(random)));
+    }
+    return bounds;
+}
+
+size_t countMismatches(const std::vector<uint32_t>& reference, const std::vector<uint32_t>& visible) {
+    size_t mismatches = reference.size() > visible.size() ? reference.size() - visible.size()
+                                                          : visible.size() - reference.size();
+    const size_t common = std::min(reference.size(), visible.size());
+    for (size_t i = 0; i < common; ++i) {
+        mismatches += reference[i] != visible[i] ? 1 : 0;
+    }
+    return mismatches;
+}
+
+const char* shapeName(CullShape shape) {
+    return shape == CullShape::Aabb ? "aabb" : "sphere";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t objectCount = 100000;
+    int iterations = 50;
+    std::string outputPath;
+
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--objects") == 0 && hasValue) {
+            objectCount = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--iterations") == 0 && hasValue) {
+            iterations = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--output") == 0 && hasValue) {
+            outputPath = argv[++i];
+        } else {
+            std::cerr << "Unknown argument: " << argv[i] << std::endl;
+            return -1;
+        }
+    }
+    if (objectCount == 0 || iterations <= 0) {
+        std::cerr << "--objects and --iterations must be positive" << std::endl;
+        return -1;
+    }
+
+    const float sceneExtent = 500.0f;
+    const CullingBounds bounds = makeScene(objectCount, sceneExtent);
+
+    Camera camera(glm::vec3(0.0f), sceneExtent);
+    camera.updateAspectRatio(16.0f / 9.0f);
+    const Frustum frustum = Frustum::fromCamera(camera);
+
+    const CullIsa isas[] = { CullIsa::Scalar, CullIsa::Sse, CullIsa::Avx2, CullIsa::Neon };
+    const CullShape shapes[] = { CullShape::Aabb, CullShape::Sphere };
+
+    std::vector<CullResult> results;
+    std::vector<uint32_t> reference;
+    std::vector<uint32_t> visible;
+    for (CullShape shape : shapes) {
+        FrustumCulling::cull(frustum, bounds, shape, reference, CullIsa::Scalar);
+
+        for (CullIsa isa : isas) {
+            if (!FrustumCulling::isSupported(isa)) {
+                continue;
+            }
+            CullResult result;
+            result.isa = isa;
+            result.shape = shape;
+            for (int iteration = 0; iteration < iterations; ++iteration) {
+                const CullStats stats = FrustumCulling::cull(frustum, bounds, shape, visible, isa);
+                if (iteration == 0 || stats.ms < result.best.ms) {
+                    result.best = stats;
+                }
+            }
+            result.mismatches = countMismatches(reference, visible);
+            results.push_back(result);
+        }
+    }
+
+    std::ofstream file;
+    if (!outputPath.empty()) {
+        file.open(outputPath);
+        if (!file.is_open()) {
+            std::cerr << "Failed to open output file: " << outputPath << std::endl;
+            return -1;
+        }
+    }
+    std::ostream& out = outputPath.empty() ? std::cout : file;
+
+    out << "{\n";
+    out << "  \"objects\": " << objectCount << ",\n";
+    out << "  \"iterations\": " << iterations << ",\n";
+    out << "  \"best_isa\": \"" << FrustumCulling::isaName(FrustumCulling::bestIsa()) << "\",\n";
+    out << "  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const CullResult& r = results[i];
+        // 加速比相对同形状的标量结果
+        const CullResult& scalar = *std::find_if(results.begin(), results.end(), [&](const CullResult& candidate) {
+            return candidate.shape == r.shape && candidate.isa == CullIsa::Scalar;
+        });
+        out << "    { \"isa\": \"" << FrustumCulling::isaName(r.isa) << "\", "
+            << "\"shape\": \"" << shapeName(r.shape) << "\", "
+            << "\"visible\": " << r.best.visible << ", "
+            << "\"culled\": " << r.best.culled << ", "
+            << "\"ms\": " << r.best.ms << ", "
+            << "\"ns_per_object\": " << r.best.nsPerObject << ", "
+            << "\"speedup\": " << (r.best.ms > 0.0 ? scalar.best.ms / r.best.ms : 0.0) << ", "
+            << "\"mismatches\": " << r.mismatches << " }" << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    out << "  ]\n";
+    out << "}\n";
+
+    for (const CullResult& r : results) {
+        if (r.mismatches != 0) {
+            std::cerr << FrustumCulling::isaName(r.isa) << " " << shapeName(r.shape)
+                      << ": " << r.mismatches << " mismatches against scalar" << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,986 @@
+/**
+ * @file frame_benchmark.cpp
+ * @brief 确定性帧基准测试 - 以固定分辨率、固定步长驱动 RenderPipeline 组合的渲染器
+ *
+ * 在无窗口EGL上下文中渲染到FBO (无垂直同步、无合成器)，逐帧记录:
+ *   - CPU: 整帧耗时 / RenderPipeline::render 调用耗时 / glFlush 提交耗时
+ *   - GPU: RenderPipeline::render 期间的 GL_TIME_ELAPSED
+ *   - 绘制调用数、视锥剔除的对象数 (RenderStats)
+ *   - 状态调用数 (GLStateCache: 实际发出 / 因重复而跳过)
+ *   - 命令队列的程序/VAO切换数 (RenderQueue)
+ *   - 全局 operator new 的调用次数 (稳定状态应为0)
+ *   - StreamBuffer 写入的字节数与等待 fence 的时间
+ *   - 间接多重绘制包含的子绘制数 (BatchRender)
+ * 结束后输出 p50/p95/p99 的JSON报告，用于在流水线中拦截性能回退。
+ *
+ * 用法:
+ *   frame_benchmark [--renderer SPEC] [--frames N] [--warmup N]
+ *                   [--size WxH] [--instances N] [--spread F] [--culling none|linear|bvh] [--occluders N] [--atlas N] [--scene]
+ *                   [--vertex-format float|compact] [--jobs N] [--record parallel|serial]
+ *                   [--frame-allocator on|off] [--stream auto|persistent|unsynchronized|off]
+ *                   [--meshes N] [--submit auto|indirect|loop] [--draw-id on|off]
+ *                   [--output report.json]
+ *
+ *   --renderer SPEC       渲染器组合 (RenderPipeline::addFromSpec 格式)，如 cube、"cube,triangle"、cube/triangle
+ *   --instances N         仅 cube: 以 N 个实例的网格走实例化绘制路径
+ *   --spread F            实例网格的铺开倍数 (默认1 = 恰好铺满视口)，大于1时视口外的实例被CPU视锥剔除
+ *   --culling MODE        实例剔除方式 (InstanceCulling): none、linear (默认) 或 bvh
+ *   --occluders N         仅 cube 实例化: 在网格前方加 N 条竖直遮挡条并开启CPU遮挡剔除，条后的实例不再提交
+ *   --atlas N             仅 cube 实例化: 生成 N 张小纹理打包为图集，实例轮流采样 (一次绑定)
+ *   --scene               仅 cube 实例化: 实例网格存为场景实体 (Scene)，每帧先由旋转系统更新 Transform，渲染器从场景视图收集
+ *   --vertex-format FMT   顶点存储格式: float (默认) 或 compact (VertexFormat::compact)
+ *   --jobs N              创建 N 个工作线程的任务系统 (JobSystem)，场景更新与实例收集分段并行；不指定时全部顺序执行
+ *   --record MODE         CommandList 录制方式: parallel (默认，有任务系统时各渲染器并行录制) 或 serial (GL线程依次录制)
+ *   --frame-allocator M   on (默认): 逐帧数据 (命令流块、场景块表) 从 FrameAllocator 分配；off: 使用普通堆
+ *   --stream MODE         实例数据与 FrameBlock 经 StreamBuffer 写入: auto (默认，GL 4.4 时 persistent)、
+ *                         persistent、unsynchronized (GLES 3.0 路径) 或 off (glBufferData + glBufferSubData)
+ *   --meshes N            仅 batch: 生成 N 个不同细分的球体加入网格池，--scene 的实体轮流引用 (MeshRef::mesh = i % N)
+ *   --submit MODE         仅 batch (BatchSubmit): auto (默认)、indirect (一次 glMultiDrawElementsIndirect) 或 loop (每网格一次绘制)
+ *   --draw-id on|off      仅 batch: on (默认) 时逐网格数据经 gl_DrawIDARB 读取，off 时在CPU上乘入实例矩阵
+ */
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/constants.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "render_factory.hpp"
+#include "render_pipeline.hpp"
+#include "render_context.hpp"
+#include "render_stats.hpp"
+#include "gl_state_cache.hpp"
+#include "framebuffer.hpp"
+#include "gpu_timer.hpp"
+#include "frame_uniforms.hpp"
+#include "platform/headless_context.hpp"
+#include "texture_atlas.hpp"
+#include "scene.hpp"
+#include "job_system.hpp"
+#include "frame_allocator.hpp"
+#include "stream_buffer.hpp"
+#include "cube_config.hpp"
+#include "triangle_config.hpp"
+#include "batch_config.hpp"
+
+namespace {
+
+// 全局 operator new 的调用次数 (含各线程)，逐帧取差值
+std::atomic<uint64_t> g_heapAllocations{ 0 };
+
+void* countedAlloc(size_t size) {
+    g_heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* pointer = std::malloc(size ? size : 1)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void* countedAlignedAlloc(size_t size, std::align_val_t alignment) {
+    g_heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    const size_t align = static_cast<size_t>(alignment);
+    if (void* pointer = std::aligned_alloc(align, (std::max<size_t>(size, 1) + align - 1) / align * align)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+} // namespace
+
+void* operator new(size_t size) { return countedAlloc(size); }
+void* operator new[](size_t size) { return countedAlloc(size); }
+void* operator new(size_t size, std::align_val_t alignment) { return countedAlignedAlloc(size, alignment); }
+void* operator new[](size_t size, std::align_val_t alignment) { return countedAlignedAlloc(size, alignment); }
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete[](void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, size_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::align_val_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, std::align_val_t) noexcept { std::free(pointer); }
+void operator delete(void* pointer, size_t, std::align_val_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, size_t, std::align_val_t) noexcept { std::free(pointer); }
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct BenchmarkOptions {
+    std::string renderer = "cube";   // RenderPipeline 描述字符串
+    uint64_t frames = 1000;
+    uint64_t warmup = 60;
+    int width = 1280;
+    int height = 720;
+    size_t instances = 0;       // cube 实例数 (0 = 非实例化)
+    float spread = 1.0f;        // 实例网格相对视口的铺开倍数
+    InstanceCulling culling = InstanceCulling::Linear;
+    size_t occluders = 0;       // 遮挡条数 (0 = 不开启遮挡剔除)
+    size_t atlasTextures = 0;   // 图集中的子纹理数 (0 = 不使用图集)
+    bool scene = false;         // --scene: 实例来自 Scene
+    bool compactVertices = false;   // --vertex-format compact
+    int jobWorkers = -1;        // --jobs N: 任务系统的工作线程数 (-1 = 不创建任务系统)
+    bool serialRecord = false;  // --record serial
+    bool frameAllocator = true; // --frame-allocator off 时不创建 FrameAllocator
+    bool stream = true;         // --stream off 时不创建 StreamBuffer
+    StreamBufferMode streamMode = StreamBufferMode::Auto;
+    size_t meshes = 0;          // --meshes N: batch 的程序化网格数 (0 = 使用默认资源)
+    BatchSubmit submit = BatchSubmit::Auto;
+    bool drawId = true;         // --draw-id off 时逐网格数据在CPU上乘入
+    std::string outputPath;     // 为空时输出到 stdout
+};
+
+struct Summary {
+    double mean = 0.0;
+    double min = 0.0;
+    double p50 = 0.0;
+    double p95 = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+};
+
+// 每帧一条记录，下标即 (帧号 - warmup)
+struct FrameSample {
+    double cpuFrameMs = 0.0;
+    double cpuRenderMs = 0.0;
+    double cpuFlushMs = 0.0;
+    double cpuSceneMs = 0.0;    // 场景旋转系统 (--scene)
+    double gpuRenderMs = -1.0;  // 未取得结果时为负
+    uint32_t drawCalls = 0;
+    uint32_t indirectDraws = 0; // 间接绘制中的子绘制数
+    uint64_t vertices = 0;
+    uint64_t culled = 0;
+    uint64_t occluded = 0;
+    uint32_t programSwitches = 0;
+    uint32_t vertexArraySwitches = 0;
+    uint64_t commandBytes = 0;  // 所有 CommandList 录制的字节数
+    uint64_t uploadBytes = 0;   // 其中经命令流上传的缓冲区数据
+    uint64_t heapAllocations = 0;   // 本帧全局 operator new 次数
+    size_t frameBytes = 0;      // 本帧从 FrameAllocator 分配的字节
+    uint64_t streamBytes = 0;   // 本帧写入 StreamBuffer 的字节
+    double streamStallMs = 0.0; // 本帧等待 StreamBuffer 区域 fence 的时间
+    uint32_t streamOrphans = 0;
+    uint32_t streamOverflows = 0;
+};
+
+double elapsedMs(Clock::time_point from, Clock::time_point to) {
+    return std::chrono::duration<double, std::milli>(to - from).count();
+}
+
+// 最近秩法 (nearest-rank) 百分位
+double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * sorted.size()));
+    rank = std::clamp<size_t>(rank, 1, sorted.size());
+    return sorted[rank - 1];
+}
+
+Summary summarize(std::vector<double> samples) {
+    Summary summary;
+    if (samples.empty()) {
+        return summary;
+    }
+    std::sort(samples.begin(), samples.end());
+    summary.mean = std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size();
+    summary.min = samples.front();
+    summary.p50 = percentile(samples, 50.0);
+    summary.p95 = percentile(samples, 95.0);
+    summary.p99 = percentile(samples, 99.0);
+    summary.max = samples.back();
+    return summary;
+}
+
+// 在 z = -5 平面上铺满视口 (spread 倍) 的实例网格，旋转倍率与颜色随下标变化 (确定性)
+std::vector<CubeInstance> makeInstanceGrid(size_t count, float spread) {
+    const size_t columns = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(count))));
+    const float extent = 2.4f * spread;
+    const float cell = extent / static_cast<float>(columns);
+
+    std::vector<CubeInstance> instances(count);
+    for (size_t i = 0; i < count; ++i) {
+        const float x = -extent * 0.5f + cell * (static_cast<float>(i % columns) + 0.5f);
+        const float y = -extent * 0.5f + cell * (static_cast<float>(i / columns) + 0.5f);
+
+        glm::mat4 transform = glm::translate(glm::mat4(1.0f), glm::vec3(x, y, -5.0f));
+        instances[i].transform = glm::scale(transform, glm::vec3(cell * 0.4f));
+        instances[i].color = glm::vec4(0.5f + 0.5f * static_cast<float>(i % 7) / 6.0f,
+                                       0.5f + 0.5f * static_cast<float>(i % 5) / 4.0f,
+                                       1.0f, 1.0f);
+        instances[i].rotationSpeed = 0.5f + static_cast<float>(i % 4) * 0.5f;
+    }
+    return instances;
+}
+
+// 在 z = -4 平面上横向等分视口的 N 条竖直遮挡条 (各占所在格的一半宽度，纵向贯穿视口)，不旋转
+void appendOccluderStrips(std::vector<CubeInstance>& instances, size_t count) {
+    const float extent = 3.8f;
+    const float cell = extent / static_cast<float>(count);
+    for (size_t i = 0; i < count; ++i) {
+        const float x = -extent * 0.5f + cell * (static_cast<float>(i) + 0.5f);
+        CubeInstance strip;
+        strip.transform = glm::scale(glm::translate(glm::mat4(1.0f), glm::vec3(x, 0.0f, -4.0f)),
+                                     glm::vec3(cell * 0.25f, 1.1f, 1.0f));
+        strip.color = glm::vec4(0.4f, 0.4f, 0.4f, 1.0f);
+        strip.rotationSpeed = 0.0f;
+        strip.occluder = true;
+        instances.push_back(strip);
+    }
+}
+
+// 球体: rings x segments 细分，纵向按 squash 压扁；顶点布局与 MeshImporter 相同 (位置、法线、UV、颜色 = location 0~3)
+BatchMesh makeSphere(uint32_t rings, uint32_t segments, float squash, const glm::vec3& color, const VertexFormat& format) {
+    struct SphereVertex {
+        glm::vec3 position;
+        glm::vec3 normal;
+        glm::vec2 texCoord;
+        glm::vec3 color;
+    };
+    std::vector<SphereVertex> vertices;
+    for (uint32_t ring = 0; ring <= rings; ++ring) {
+        const float theta = glm::pi<float>() * static_cast<float>(ring) / static_cast<float>(rings);
+        for (uint32_t segment = 0; segment <= segments; ++segment) {
+            const float phi = glm::two_pi<float>() * static_cast<float>(segment) / static_cast<float>(segments);
+            const glm::vec3 unit(std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi));
+            SphereVertex vertex;
+            vertex.position = glm::vec3(unit.x, unit.y * squash, unit.z);
+            vertex.normal = glm::normalize(glm::vec3(unit.x * squash, unit.y, unit.z * squash));
+            vertex.texCoord = glm::vec2(static_cast<float>(segment) / segments, static_cast<float>(ring) / rings);
+            vertex.color = color;
+            vertices.push_back(vertex);
+        }
+    }
+
+    BatchMesh mesh;
+    for (uint32_t ring = 0; ring < rings; ++ring) {
+        for (uint32_t segment = 0; segment < segments; ++segment) {
+            const uint32_t a = ring * (segments + 1) + segment;
+            const uint32_t b = a + segments + 1;
+            mesh.indices.insert(mesh.indices.end(), { a, b, a + 1, a + 1, b, b + 1 });
+        }
+    }
+
+    VertexStreamBuilder builder(vertices.size());
+    builder.addPosition(0, format.position, &vertices[0].position, sizeof(SphereVertex));
+    builder.addNormal(1, format.normal, &vertices[0].normal, sizeof(SphereVertex));
+    builder.addTexCoord(2, format.texCoord, &vertices[0].texCoord, sizeof(SphereVertex));
+    builder.addColor(3, format.color, &vertices[0].color, sizeof(SphereVertex));
+    mesh.stream = builder.build();
+    mesh.boundsMin = glm::vec3(-1.0f, -squash, -1.0f);
+    mesh.boundsMax = glm::vec3(1.0f, squash, 1.0f);
+    return mesh;
+}
+
+// N 个细分、扁平度与颜色都不同的球体 (确定性)
+std::vector<BatchMesh> makeBatchMeshes(size_t count, const VertexFormat& format) {
+    std::vector<BatchMesh> meshes;
+    for (size_t i = 0; i < count; ++i) {
+        const uint32_t rings = 4 + static_cast<uint32_t>(i % 6) * 2;
+        const uint32_t segments = 6 + static_cast<uint32_t>(i % 5) * 3;
+        const float squash = 0.5f + 0.5f * static_cast<float>(i % 3) / 2.0f;
+        const glm::vec3 color(0.6f + 0.4f * static_cast<float>(i % 2), 0.6f + 0.4f * static_cast<float>((i / 2) % 2), 0.8f);
+        meshes.push_back(makeSphere(rings, segments, squash, color, format));
+    }
+    return meshes;
+}
+
+// 场景模式的应用层组件: 基础变换 + 旋转倍率 (对应 CubeInstance::rotationSpeed)
+struct Spin {
+    glm::mat4 base = glm::mat4(1.0f);
+    float speed = 1.0f;
+};
+
+// 与 makeInstanceGrid 相同的网格，存为带 Spin 的场景实体；包围盒取默认平面顶点
+// meshes > 0 时实体轮流引用 batch 的程序化网格，包围盒取单位立方体 (包含所有球体)
+// occluders > 0 时再加 appendOccluderStrips 的遮挡条，带 Occluder 组件且不旋转
+std::shared_ptr<Scene> makeScene(size_t count, float spread, size_t atlasTextures, size_t meshes, size_t occluders) {
+    const CubeConfig defaults;
+    glm::vec3 boundsMin = defaults.vertices()[0].position;
+    glm::vec3 boundsMax = boundsMin;
+    for (const CubeVertex& vertex : defaults.vertices()) {
+        boundsMin = glm::min(boundsMin, vertex.position);
+        boundsMax = glm::max(boundsMax, vertex.position);
+    }
+    Bounds bounds;
+    bounds.center = (boundsMin + boundsMax) * 0.5f;
+    bounds.extents = meshes > 0 ? glm::vec3(1.0f) : (boundsMax - boundsMin) * 0.5f;
+
+    auto scene = std::make_shared<Scene>();
+    const std::vector<CubeInstance> instances = makeInstanceGrid(count, spread);
+    for (size_t i = 0; i < instances.size(); ++i) {
+        Transform transform;
+        transform.world = instances[i].transform;
+        MaterialRef material;
+        material.color = instances[i].color;
+        material.texture = atlasTextures > 0 ? static_cast<uint32_t>(i % atlasTextures) : 0;
+        Spin spin;
+        spin.base = instances[i].transform;
+        spin.speed = instances[i].rotationSpeed;
+        MeshRef mesh;
+        mesh.mesh = meshes > 0 ? static_cast<uint32_t>(i % meshes) : 0;
+        scene->create(transform, bounds, mesh, material, spin);
+    }
+
+    std::vector<CubeInstance> strips;
+    if (occluders > 0) {
+        appendOccluderStrips(strips, occluders);
+    }
+    for (const CubeInstance& strip : strips) {
+        Transform transform;
+        transform.world = strip.transform;
+        MaterialRef material;
+        material.color = strip.color;
+        scene->create(transform, bounds, MeshRef{}, material, Occluder{});
+    }
+    return scene;
+}
+
+struct SpinChunk {
+    size_t count;
+    Transform* transforms;
+    const Spin* spins;
+};
+
+// 旋转系统: world = base * rotateZ(degrees * speed)，先列出块再按块分段 (有活动任务系统时并行)
+void updateScene(Scene& scene, float degrees) {
+    FrameVector<SpinChunk> chunks;
+    scene.view<Transform, Spin>().forEachChunk([&chunks](size_t count, const Entity*, Transform* transforms, const Spin* spins) {
+        chunks.push_back({ count, transforms, spins });
+    });
+
+    auto update = [&chunks, degrees](size_t begin, size_t end) {
+        for (size_t chunk = begin; chunk < end; ++chunk) {
+            Transform* transforms = chunks[chunk].transforms;
+            const Spin* spins = chunks[chunk].spins;
+            for (size_t i = 0; i < chunks[chunk].count; ++i) {
+                const float angle = glm::radians(degrees * spins[i].speed);
+                const float c = std::cos(angle);
+                const float s = std::sin(angle);
+                transforms[i].world[0] = spins[i].base[0] * c + spins[i].base[1] * s;
+                transforms[i].world[1] = spins[i].base[1] * c - spins[i].base[0] * s;
+                transforms[i].world[2] = spins[i].base[2];
+                transforms[i].world[3] = spins[i].base[3];
+            }
+        }
+    };
+    JobSystem* jobs = JobSystem::active();
+    if (jobs) {
+        jobs->parallelFor(chunks.size(), 1, update);
+    } else {
+        update(0, chunks.size());
+    }
+}
+
+// N 张 16~64 像素的棋盘格 (尺寸与颜色随下标变化)，打包为一个图集
+std::shared_ptr<TextureAtlas> makeAtlas(size_t count) {
+    auto atlas = std::make_shared<TextureAtlas>();
+    std::vector<uint8_t> pixels;
+    for (size_t i = 0; i < count; ++i) {
+        const int width = 16 + 16 * static_cast<int>(i % 4);
+        const int height = 16 + 16 * static_cast<int>((i / 4) % 4);
+        pixels.resize(static_cast<size_t>(width) * height * 4);
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                uint8_t* p = &pixels[(static_cast<size_t>(y) * width + x) * 4];
+                const bool dark = ((x / 8) + (y / 8)) % 2 == 0;
+                p[0] = static_cast<uint8_t>(dark ? 64 : (i * 97) & 0xFF);
+                p[1] = static_cast<uint8_t>(dark ? 64 : (i * 57) & 0xFF);
+                p[2] = static_cast<uint8_t>(dark ? 64 : 255);
+                p[3] = 255;
+            }
+        }
+        atlas->add(pixels.data(), width, height);
+    }
+    if (!atlas->build()) {
+        std::cerr << "Failed to build atlas: " << atlas->lastError() << std::endl;
+        return nullptr;
+    }
+    return atlas;
+}
+
+// 注册表中的默认配置；cube 按 --instances 替换为实例网格 (--atlas 时附带图集)，--vertex-format 作用于内置渲染器
+std::unique_ptr<IRenderConfig> createConfig(const std::string& typeName, const BenchmarkOptions& options,
+                                            const std::shared_ptr<const TextureAtlas>& atlas,
+                                            const std::shared_ptr<Scene>& scene) {
+    std::unique_ptr<IRenderConfig> config = RenderFactory::createConfig(typeName);
+    const VertexFormat format = options.compactVertices ? VertexFormat::compact() : VertexFormat();
+
+    if (auto* cubeConfig = dynamic_cast<CubeConfig*>(config.get())) {
+        if (scene) {
+            if (atlas) {
+                cubeConfig->setAtlas(atlas);
+            }
+            cubeConfig->setScene(scene);
+            cubeConfig->setInstanceCulling(options.culling);
+            cubeConfig->setOcclusionCulling(options.occluders > 0);
+        } else if (options.instances > 0) {
+            std::vector<CubeInstance> instances = makeInstanceGrid(options.instances, options.spread);
+            if (atlas) {
+                for (size_t i = 0; i < instances.size(); ++i) {
+                    instances[i].textureIndex = static_cast<uint32_t>(i % atlas->imageCount());
+                }
+                cubeConfig->setAtlas(atlas);
+            }
+            if (options.occluders > 0) {
+                appendOccluderStrips(instances, options.occluders);
+                cubeConfig->setOcclusionCulling(true);
+            }
+            cubeConfig->setInstances(instances);
+            cubeConfig->setInstanceCulling(options.culling);
+        }
+        cubeConfig->setVertexFormat(format);
+    } else if (auto* triangleConfig = dynamic_cast<TriangleConfig*>(config.get())) {
+        triangleConfig->setVertexFormat(format);
+    } else if (auto* batchConfig = dynamic_cast<BatchConfig*>(config.get())) {
+        if (options.meshes > 0) {
+            batchConfig->clearMeshes();
+            for (const BatchMesh& mesh : makeBatchMeshes(options.meshes, format)) {
+                batchConfig->addMesh(mesh);
+            }
+        }
+        if (scene) {
+            batchConfig->setScene(scene);
+        }
+        batchConfig->setSubmit(options.submit);
+        batchConfig->setDrawId(options.drawId);
+        batchConfig->setCulling(options.culling != InstanceCulling::None);
+    }
+    return config;
+}
+
+// 与 RenderPipeline::addFromSpec 相同的 pass 划分，但配置由 createConfig 提供
+bool buildPipeline(RenderPipeline& pipeline, const BenchmarkOptions& options, const std::shared_ptr<const TextureAtlas>& atlas,
+                   const std::shared_ptr<Scene>& scene) {
+    const std::vector<std::vector<std::string>> passes = RenderPipeline::parseSpec(options.renderer);
+    if (passes.empty()) {
+        return false;
+    }
+    for (size_t i = 0; i < passes.size(); ++i) {
+        const std::string passName = "pass" + std::to_string(i);
+        pipeline.addPass(passName, static_cast<int>(i), i > 0);
+        for (const std::string& typeName : passes[i]) {
+            std::unique_ptr<IRenderer> renderer = RenderFactory::create(typeName);
+            std::unique_ptr<IRenderConfig> config = createConfig(typeName, options, atlas, scene);
+            if (!renderer || !config) {
+                std::cerr << "Unknown renderer: " << typeName << std::endl;
+                return false;
+            }
+            if (!pipeline.addRenderer(passName, std::move(renderer), *config)) {
+                std::cerr << pipeline.lastError() << std::endl;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+const char* cullingName(InstanceCulling culling) {
+    switch (culling) {
+    case InstanceCulling::None:   return "none";
+    case InstanceCulling::Linear: return "linear";
+    case InstanceCulling::Bvh:    return "bvh";
+    }
+    return "unknown";
+}
+
+std::string escapeJson(const std::string& text) {
+    std::string out;
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            out += ' ';
+        } else {
+            out += c;
+        }
+    }
+    return out;
+}
+
+void writeSummary(std::ostream& out, const char* key, const Summary& s, bool last = false) {
+    out << "    \"" << key << "\": { "
+        << "\"mean\": " << s.mean << ", "
+        << "\"min\": " << s.min << ", "
+        << "\"p50\": " << s.p50 << ", "
+        << "\"p95\": " << s.p95 << ", "
+        << "\"p99\": " << s.p99 << ", "
+        << "\"max\": " << s.max << " }" << (last ? "\n" : ",\n");
+}
+
+bool parseArgs(int argc, char** argv, BenchmarkOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--renderer") == 0 && hasValue) {
+            options.renderer = argv[++i];
+        } else if (std::strcmp(argv[i], "--frames") == 0 && hasValue) {
+            options.frames = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--warmup") == 0 && hasValue) {
+            options.warmup = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--size") == 0 && hasValue) {
+            if (std::sscanf(argv[++i], "%dx%d", &options.width, &options.height) != 2) {
+                std::cerr << "Invalid --size, expected WxH" << std::endl;
+                return false;
+            }
+        } else if (std::strcmp(argv[i], "--instances") == 0 && hasValue) {
+            options.instances = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--spread") == 0 && hasValue) {
+            options.spread = static_cast<float>(std::atof(argv[++i]));
+        } else if (std::strcmp(argv[i], "--culling") == 0 && hasValue) {
+            const std::string culling = argv[++i];
+            if (culling == "none") {
+                options.culling = InstanceCulling::None;
+            } else if (culling == "linear") {
+                options.culling = InstanceCulling::Linear;
+            } else if (culling == "bvh") {
+                options.culling = InstanceCulling::Bvh;
+            } else {
+                std::cerr << "Invalid --culling, expected none, linear or bvh" << std::endl;
+                return false;
+            }
+        } else if (std::strcmp(argv[i], "--occluders") == 0 && hasValue) {
+            options.occluders = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--atlas") == 0 && hasValue) {
+            options.atlasTextures = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--scene") == 0) {
+            options.scene = true;
+        } else if (std::strcmp(argv[i], "--vertex-format") == 0 && hasValue) {
+            const std::string format = argv[++i];
+            if (format != "float" && format != "compact") {
+                std::cerr << "Invalid --vertex-format, expected float or compact" << std::endl;
+                return false;
+            }
+            options.compactVertices = format == "compact";
+        } else if (std::strcmp(argv[i], "--record") == 0 && hasValue) {
+            const std::string mode = argv[++i];
+            if (mode != "parallel" && mode != "serial") {
+                std::cerr << "Invalid --record, expected parallel or serial" << std::endl;
+                return false;
+            }
+            options.serialRecord = mode == "serial";
+        } else if (std::strcmp(argv[i], "--frame-allocator") == 0 && hasValue) {
+            const std::string mode = argv[++i];
+            if (mode != "on" && mode != "off") {
+                std::cerr << "Invalid --frame-allocator, expected on or off" << std::endl;
+                return false;
+            }
+            options.frameAllocator = mode == "on";
+        } else if (std::strcmp(argv[i], "--stream") == 0 && hasValue) {
+            const std::string mode = argv[++i];
+            if (mode == "auto") {
+                options.streamMode = StreamBufferMode::Auto;
+            } else if (mode == "persistent") {
+                options.streamMode = StreamBufferMode::Persistent;
+            } else if (mode == "unsynchronized") {
+                options.streamMode = StreamBufferMode::Unsynchronized;
+            } else if (mode != "off") {
+                std::cerr << "Invalid --stream, expected auto, persistent, unsynchronized or off" << std::endl;
+                return false;
+            }
+            options.stream = mode != "off";
+        } else if (std::strcmp(argv[i], "--meshes") == 0 && hasValue) {
+            options.meshes = static_cast<size_t>(std::strtoull(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--submit") == 0 && hasValue) {
+            const std::string value = argv[++i];
+            if (value == "auto") {
+                options.submit = BatchSubmit::Auto;
+            } else if (value == "indirect") {
+                options.submit = BatchSubmit::MultiDrawIndirect;
+            } else if (value == "loop") {
+                options.submit = BatchSubmit::Loop;
+            } else {
+                std::cerr << "Invalid --submit, expected auto, indirect or loop" << std::endl;
+                return false;
+            }
+        } else if (std::strcmp(argv[i], "--draw-id") == 0 && hasValue) {
+            const std::string value = argv[++i];
+            if (value != "on" && value != "off") {
+                std::cerr << "Invalid --draw-id, expected on or off" << std::endl;
+                return false;
+            }
+            options.drawId = value == "on";
+        } else if (std::strcmp(argv[i], "--jobs") == 0 && hasValue) {
+            options.jobWorkers = std::atoi(argv[++i]);
+            if (options.jobWorkers < 0) {
+                std::cerr << "--jobs must not be negative" << std::endl;
+                return false;
+            }
+        } else if (std::strcmp(argv[i], "--output") == 0 && hasValue) {
+            options.outputPath = argv[++i];
+        } else {
+            std::cerr << "Unknown argument: " << argv[i] << std::endl;
+            return false;
+        }
+    }
+
+    if (options.frames == 0 || options.width <= 0 || options.height <= 0 || options.spread <= 0.0f) {
+        std::cerr << "Frame count, size and spread must be positive" << std::endl;
+        return false;
+    }
+    if (options.atlasTextures > 0 && options.instances == 0) {
+        std::cerr << "--atlas requires --instances" << std::endl;
+        return false;
+    }
+    if (options.occluders > 0 && options.instances == 0) {
+        std::cerr << "--occluders requires --instances" << std::endl;
+        return false;
+    }
+    if (options.scene && options.instances == 0) {
+        std::cerr << "--scene requires --instances" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    BenchmarkOptions options;
+    if (!parseArgs(argc, argv, options)) {
+        return -1;
+    }
+
+    // ============ 上下文与渲染目标 ============
+
+    HeadlessContext context;
+    if (!context.create(3, 3)) {
+        std::cerr << "Failed to create headless context: " << context.lastError() << std::endl;
+        return -1;
+    }
+    if (!gladLoadGLLoader((GLADloadproc)HeadlessContext::getProcAddress)) {
+        std::cerr << "Failed to initialize GLAD" << std::endl;
+        return -1;
+    }
+
+    Framebuffer framebuffer;
+    if (!framebuffer.create(options.width, options.height)) {
+        std::cerr << "Failed to create framebuffer: " << framebuffer.lastError() << std::endl;
+        return -1;
+    }
+    framebuffer.bind();
+
+    GLStateCache& state = GLStateCache::current();
+    state.invalidate();
+    state.enable(GL_DEPTH_TEST);
+    state.depthFunc(GL_LESS);
+
+    FrameUniformBuffer frameUniforms;
+    if (!frameUniforms.create()) {
+        std::cerr << "Failed to create frame uniform buffer" << std::endl;
+        return -1;
+    }
+
+    StreamBuffer streamBuffer;
+    if (options.stream) {
+        StreamBufferSettings streamSettings;
+        streamSettings.mode = options.streamMode;
+        if (!streamBuffer.create(streamSettings)) {
+            std::cerr << "Failed to create stream buffer" << std::endl;
+            return -1;
+        }
+        StreamBuffer::setActive(&streamBuffer);
+    }
+
+    // 任务系统在GL线程创建，渲染器在此线程上分发并等待任务
+    JobSystem jobs;
+    if (options.jobWorkers >= 0) {
+        JobSystemSettings jobSettings;
+        jobSettings.workers = options.jobWorkers;
+        jobs.create(jobSettings);
+        JobSystem::setActive(&jobs);
+    }
+
+    FrameAllocator frameAllocator;
+    if (options.frameAllocator) {
+        frameAllocator.create();
+        FrameAllocator::setActive(&frameAllocator);
+    }
+
+    // ============ 渲染器 ============
+
+    RenderPipeline pipeline;
+    pipeline.setErrorCallback([](RenderError error, const std::string& msg) {
+        std::cerr << "Render Error [" << static_cast<int>(error) << "]: " << msg << std::endl;
+    });
+
+    auto initStart = Clock::now();
+    std::shared_ptr<TextureAtlas> atlas;
+    if (options.atlasTextures > 0) {
+        atlas = makeAtlas(options.atlasTextures);
+        if (!atlas) {
+            return -1;
+        }
+    }
+    std::shared_ptr<Scene> scene;
+    if (options.scene) {
+        scene = makeScene(options.instances, options.spread, options.atlasTextures, options.meshes, options.occluders);
+    }
+    if (!buildPipeline(pipeline, options, atlas, scene)) {
+        std::cerr << "Failed to create renderers: " << options.renderer << std::endl;
+        return -1;
+    }
+    pipeline.resize(options.width, options.height);
+    pipeline.setParallelRecording(!options.serialRecord);
+
+    // 着色器可能在异步编译: 先渲染占位帧直到正式程序就绪，保证测量的是稳定状态
+    while (!pipeline.isReady()) {
+        if (!pipeline.render(RenderContext(ViewportSize(options.width, options.height), glm::mat4(1.0f), 0.0f))) {
+            std::cerr << "Renderer failed while waiting for shaders" << std::endl;
+            return -1;
+        }
+        glFinish();
+    }
+    glFinish();
+    const double initMs = elapsedMs(initStart, Clock::now());
+
+    float aspect = static_cast<float>(options.width) / static_cast<float>(options.height);
+    glm::mat4 projection = glm::perspective(glm::radians(30.0f), aspect, 3.0f, 10.0f);
+
+    // 固定步长: 结果与真实耗时无关，每次运行渲染完全相同的帧序列
+    const float fixedDeltaTime = 1.0f / 60.0f;
+    RenderContext baseContext(ViewportSize(options.width, options.height), projection, fixedDeltaTime);
+
+    // ============ 帧循环 ============
+
+    GpuTimer gpuTimer;
+    const bool gpuTiming = gpuTimer.create();
+
+    std::vector<FrameSample> samples(options.frames);
+    auto storeGpu = [&](uint64_t frame, double ms) {
+        if (frame >= options.warmup) {
+            samples[frame - options.warmup].gpuRenderMs = ms;
+        }
+    };
+
+    const uint64_t totalFrames = options.warmup + options.frames;
+    Clock::time_point measureStart;
+
+    for (uint64_t frame = 0; frame < totalFrames; ++frame) {
+        if (frame == options.warmup) {
+            glFinish();
+            state.resetStats();
+            measureStart = Clock::now();
+        }
+
+        auto frameStart = Clock::now();
+        const uint64_t heapBefore = g_heapAllocations.load(std::memory_order_relaxed);
+        RenderStats::reset();
+        RenderContext frameContext = baseContext.withFrameNumber(frame);
+        frameAllocator.beginFrame(frameContext);
+        streamBuffer.beginFrame();
+        frameUniforms.update(frameContext);
+
+        // 场景逻辑在提交之前更新 Transform，渲染器只读取
+        auto sceneStart = Clock::now();
+        if (scene) {
+            updateScene(*scene, static_cast<float>(frame + 1));
+        }
+        auto sceneEnd = Clock::now();
+
+        if (gpuTiming) {
+            gpuTimer.begin(frame);
+        }
+        auto renderStart = Clock::now();
+        pipeline.render(frameContext);
+        auto renderEnd = Clock::now();
+        if (gpuTiming) {
+            gpuTimer.end();
+        }
+
+        glFlush();
+        auto frameEnd = Clock::now();
+        const uint64_t heapAllocations = g_heapAllocations.load(std::memory_order_relaxed) - heapBefore;
+
+        if (gpuTiming) {
+            gpuTimer.collect(storeGpu);
+        }
+
+        if (frame >= options.warmup) {
+            FrameSample& sample = samples[frame - options.warmup];
+            sample.cpuFrameMs = elapsedMs(frameStart, frameEnd);
+            sample.cpuRenderMs = elapsedMs(renderStart, renderEnd);
+            sample.cpuFlushMs = elapsedMs(renderEnd, frameEnd);
+            sample.cpuSceneMs = elapsedMs(sceneStart, sceneEnd);
+            sample.drawCalls = RenderStats::current().drawCalls;
+            sample.indirectDraws = RenderStats::current().indirectDraws;
+            sample.vertices = RenderStats::current().vertices;
+            sample.culled = RenderStats::current().culled;
+            sample.occluded = RenderStats::current().occluded;
+            sample.programSwitches = pipeline.lastStats().programSwitches;
+            sample.vertexArraySwitches = pipeline.lastStats().vertexArraySwitches;
+            sample.commandBytes = pipeline.lastCommandListStats().usedBytes;
+            sample.uploadBytes = pipeline.lastCommandListStats().uploadBytes;
+            sample.heapAllocations = heapAllocations;
+            sample.frameBytes = frameAllocator.stats().usedBytes;
+            sample.streamBytes = streamBuffer.stats().bytes;
+            sample.streamStallMs = streamBuffer.stats().stallMs;
+            sample.streamOrphans = streamBuffer.stats().orphans;
+            sample.streamOverflows = streamBuffer.stats().overflows;
+        }
+    }
+
+    glFinish();
+    const double wallMs = elapsedMs(measureStart, Clock::now());
+    const GLStateCacheStats stateStats = state.stats();
+    if (gpuTiming) {
+        gpuTimer.drain(storeGpu);
+    }
+
+    // ============ 汇总 ============
+
+    std::vector<double> cpuFrame, cpuRender, cpuFlush, cpuScene, gpuRender;
+    uint64_t totalDrawCalls = 0;
+    uint64_t totalIndirectDraws = 0;
+    uint64_t totalVertices = 0;
+    uint64_t totalCulled = 0;
+    uint64_t totalOccluded = 0;
+    uint64_t totalProgramSwitches = 0;
+    uint64_t totalVertexArraySwitches = 0;
+    uint64_t totalCommandBytes = 0;
+    uint64_t totalUploadBytes = 0;
+    uint64_t totalHeapAllocations = 0;
+    uint64_t maxHeapAllocations = 0;
+    uint64_t totalFrameBytes = 0;
+    uint64_t totalStreamBytes = 0;
+    uint64_t totalStreamOrphans = 0;
+    uint64_t totalStreamOverflows = 0;
+    std::vector<double> streamStall;
+    for (const FrameSample& sample : samples) {
+        cpuFrame.push_back(sample.cpuFrameMs);
+        cpuRender.push_back(sample.cpuRenderMs);
+        cpuFlush.push_back(sample.cpuFlushMs);
+        cpuScene.push_back(sample.cpuSceneMs);
+        if (sample.gpuRenderMs >= 0.0) {
+            gpuRender.push_back(sample.gpuRenderMs);
+        }
+        totalDrawCalls += sample.drawCalls;
+        totalIndirectDraws += sample.indirectDraws;
+        totalVertices += sample.vertices;
+        totalCulled += sample.culled;
+        totalOccluded += sample.occluded;
+        totalProgramSwitches += sample.programSwitches;
+        totalVertexArraySwitches += sample.vertexArraySwitches;
+        totalCommandBytes += sample.commandBytes;
+        totalUploadBytes += sample.uploadBytes;
+        totalHeapAllocations += sample.heapAllocations;
+        maxHeapAllocations = std::max(maxHeapAllocations, sample.heapAllocations);
+        totalFrameBytes += sample.frameBytes;
+        totalStreamBytes += sample.streamBytes;
+        totalStreamOrphans += sample.streamOrphans;
+        totalStreamOverflows += sample.streamOverflows;
+        streamStall.push_back(sample.streamStallMs);
+    }
+    const FrameAllocatorStats frameStats = frameAllocator.stats();
+
+    std::ofstream file;
+    if (!options.outputPath.empty()) {
+        file.open(options.outputPath);
+        if (!file.is_open()) {
+            std::cerr << "Failed to open output file: " << options.outputPath << std::endl;
+            return -1;
+        }
+    }
+    std::ostream& out = options.outputPath.empty() ? std::cout : file;
+
+    out << "{\n";
+    out << "  \"renderer\": \"" << escapeJson(pipeline.getName()) << "\",\n";
+    out << "  \"gl_renderer\": \"" << escapeJson(reinterpret_cast<const char*>(glGetString(GL_RENDERER))) << "\",\n";
+    out << "  \"gl_version\": \"" << escapeJson(reinterpret_cast<const char*>(glGetString(GL_VERSION))) << "\",\n";
+    out << "  \"width\": " << options.width << ",\n";
+    out << "  \"height\": " << options.height << ",\n";
+    out << "  \"instances\": " << options.instances << ",\n";
+    out << "  \"spread\": " << options.spread << ",\n";
+    out << "  \"culling\": \"" << cullingName(options.culling) << "\",\n";
+    out << "  \"occluders\": " << options.occluders << ",\n";
+    out << "  \"scene\": " << (options.scene ? "true" : "false") << ",\n";
+    out << "  \"atlas_textures\": " << options.atlasTextures << ",\n";
+    out << "  \"meshes\": " << options.meshes << ",\n";
+    out << "  \"record\": \"" << (options.serialRecord ? "serial" : "parallel") << "\",\n";
+    out << "  \"frame_allocator\": " << (frameAllocator.isCreated() ? "true" : "false") << ",\n";
+    out << "  \"job_threads\": " << (jobs.isCreated() ? jobs.threadCount() : 1u) << ",\n";
+    out << "  \"vertex_format\": \"" << (options.compactVertices ? "compact" : "float") << "\",\n";
+    out << "  \"warmup_frames\": " << options.warmup << ",\n";
+    out << "  \"frames\": " << options.frames << ",\n";
+    out << "  \"init_ms\": " << initMs << ",\n";
+    out << "  \"wall_ms\": " << wallMs << ",\n";
+    out << "  \"fps\": " << (wallMs > 0.0 ? options.frames * 1000.0 / wallMs : 0.0) << ",\n";
+    out << "  \"timings_ms\": {\n";
+    writeSummary(out, "cpu_frame", summarize(cpuFrame));
+    writeSummary(out, "cpu_render", summarize(cpuRender));
+    if (scene) {
+        writeSummary(out, "cpu_scene_update", summarize(cpuScene));
+    }
+    writeSummary(out, "cpu_flush", summarize(cpuFlush), !gpuTiming);
+    if (gpuTiming) {
+        writeSummary(out, "gpu_render", summarize(gpuRender), true);
+    }
+    out << "  },\n";
+    out << "  \"draw_calls\": { \"total\": " << totalDrawCalls
+        << ", \"per_frame\": " << static_cast<double>(totalDrawCalls) / options.frames
+        << ", \"indirect_per_frame\": " << static_cast<double>(totalIndirectDraws) / options.frames << " },\n";
+    out << "  \"vertices_per_frame\": " << static_cast<double>(totalVertices) / options.frames << ",\n";
+    out << "  \"culled_per_frame\": " << static_cast<double>(totalCulled) / options.frames << ",\n";
+    out << "  \"occluded_per_frame\": " << static_cast<double>(totalOccluded) / options.frames << ",\n";
+    out << "  \"queue_switches\": { \"program_per_frame\": " << static_cast<double>(totalProgramSwitches) / options.frames
+        << ", \"vertex_array_per_frame\": " << static_cast<double>(totalVertexArraySwitches) / options.frames << " },\n";
+    out << "  \"command_lists\": { \"bytes_per_frame\": " << static_cast<double>(totalCommandBytes) / options.frames
+        << ", \"upload_bytes_per_frame\": " << static_cast<double>(totalUploadBytes) / options.frames
+        << ", \"capacity_bytes\": " << pipeline.lastCommandListStats().capacityBytes << " },\n";
+    out << "  \"heap_allocations\": { \"per_frame\": " << static_cast<double>(totalHeapAllocations) / options.frames
+        << ", \"max\": " << maxHeapAllocations << " },\n";
+    if (streamBuffer.isCreated()) {
+        const Summary stall = summarize(streamStall);
+        out << "  \"stream_buffer\": { \"mode\": \"" << StreamBuffer::modeName(streamBuffer.mode())
+            << "\", \"bytes_per_frame\": " << static_cast<double>(totalStreamBytes) / options.frames
+            << ", \"stall_ms\": { \"mean\": " << stall.mean << ", \"p99\": " << stall.p99 << ", \"max\": " << stall.max << " }"
+            << ", \"orphans\": " << totalStreamOrphans
+            << ", \"overflows\": " << totalStreamOverflows
+            << ", \"region_bytes\": " << streamBuffer.regionBytes() << " },\n";
+    }
+    if (frameAllocator.isCreated()) {
+        out << "  \"frame_arena\": { \"bytes_per_frame\": " << static_cast<double>(totalFrameBytes) / options.frames
+            << ", \"peak_bytes\": " << frameStats.peakBytes
+            << ", \"capacity_bytes\": " << frameStats.capacityBytes
+            << ", \"heap_allocations\": " << frameStats.heapAllocations << " },\n";
+    }
+    out << "  \"gl_state_calls\": {\n";
+    out << "    \"issued_per_frame\": " << static_cast<double>(stateStats.totalIssued()) / options.frames << ",\n";
+    out << "    \"skipped_per_frame\": " << static_cast<double>(stateStats.totalSkipped()) / options.frames << ",\n";
+    out << "    \"skipped_by_category\": {";
+    for (int i = 0; i < GLStateCacheStats::CategoryCount; ++i) {
+        const auto category = static_cast<GLStateCacheStats::Category>(i);
+        out << (i > 0 ? ", " : " ") << "\"" << GLStateCacheStats::categoryName(category) << "\": " << stateStats.skipped[i];
+    }
+    out << " }\n";
+    out << "  }\n";
+    out << "}\n";
+
+    gpuTimer.release();
+    pipeline.cleanup();
+    JobSystem::setActive(nullptr);
+    jobs.release();
+    FrameAllocator::setActive(nullptr);
+    frameAllocator.release();
+    StreamBuffer::setActive(nullptr);
+    streamBuffer.release();
+    if (atlas) {
+        atlas->release();
+    }
+    frameUniforms.release();
+    framebuffer.release();
+    return 0;
+}
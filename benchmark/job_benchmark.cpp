@@ -0,0 +1,265 @@
+/**
+ * @file job_benchmark.cpp
+ * @brief JobSystem 线程扩展 - 1 到 N 个线程下逐帧CPU工作的耗时与加速比 (纯CPU，不需要GL上下文)
+ *
+ * 每个线程数 (工作线程 + 调用线程) 运行三种负载，取多帧平均:
+ *   - parallel_for: 所有实体绕Z轴旋转并重算世界空间 AABB (与场景更新 + 实例收集相同的计算)
+ *   - task_graph:   每批实体一个动画任务 → 一个包围盒任务 (依赖前者)，全部完成后一个视锥剔除任务 (依赖全部包围盒任务)
+ *   - empty_jobs:   大量空任务挂在一个父任务下，测量调度开销 (每任务纳秒)
+ * 各线程数算出的包围盒逐字节相同、可见数相同，否则返回非零。
+ *
+ * 用法:
+ *   job_benchmark [--threads N] [--entities N] [--batches N] [--frames N] [--output report.json]
+ */
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "camera.hpp"
+#include "frustum_culling.hpp"
+#include "job_system.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Workload {
+    std::vector<glm::mat4> base;
+    std::vector<float> speed;
+    std::vector<glm::mat4> world;
+    CullingBounds bounds;
+    Frustum frustum;
+};
+
+struct ThreadResult {
+    unsigned threads = 0;
+    double parallelForMs = 0.0;
+    double taskGraphMs = 0.0;
+    double emptyJobNs = 0.0;
+    size_t visible = 0;
+    uint64_t stolen = 0;
+    size_t mismatches = 0;
+};
+
+double elapsedMs(Clock::time_point from) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - from).count();
+}
+
+Workload makeWorkload(size_t count) {
+    Workload workload;
+    std::mt19937 random(31);
+    const float extent = 10.0f * std::cbrt(static_cast<float>(count));
+    std::uniform_real_distribution<float> position(-extent, extent);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    workload.base.resize(count);
+    workload.speed.resize(count);
+    workload.world.resize(count);
+    workload.bounds.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        workload.base[i] = glm::mat4(1.0f);
+        workload.base[i][3] = glm::vec4(position(random), position(random), position(random), 1.0f);
+        workload.speed[i] = 0.5f + unit(random) * 1.5f;
+    }
+    Camera camera(glm::vec3(0.0f), 50.0f);
+    camera.updateAspectRatio(16.0f / 9.0f);
+    workload.frustum = Frustum::fromCamera(camera);
+    return workload;
+}
+
+void animate(Workload& workload, size_t begin, size_t end, float angle) {
+    for (size_t i = begin; i < end; ++i) {
+        const float c = std::cos(angle * workload.speed[i]);
+        const float s = std::sin(angle * workload.speed[i]);
+        const glm::mat4& base = workload.base[i];
+        glm::mat4& world = workload.world[i];
+        world[0] = base[0] * c + base[1] * s;
+        world[1] = base[1] * c - base[0] * s;
+        world[2] = base[2];
+        world[3] = base[3];
+    }
+}
+
+void updateBounds(Workload& workload, size_t begin, size_t end) {
+    const glm::vec3 center(0.0f);
+    const glm::vec3 extents(1.0f, 1.0f, 0.5f);
+    for (size_t i = begin; i < end; ++i) {
+        workload.bounds.setTransformed(i, center, extents, workload.world[i]);
+    }
+}
+
+size_t countBoundMismatches(const CullingBounds& a, const CullingBounds& b) {
+    size_t mismatches = 0;
+    const size_t count = std::min(a.size(), b.size());
+    const float* arraysA[] = { a.centerX(), a.centerY(), a.centerZ(), a.extentX(), a.extentY(), a.extentZ() };
+    const float* arraysB[] = { b.centerX(), b.centerY(), b.centerZ(), b.extentX(), b.extentY(), b.extentZ() };
+    for (int k = 0; k < 6; ++k) {
+        mismatches += std::memcmp(arraysA[k], arraysB[k], count * sizeof(float)) != 0 ? 1 : 0;
+    }
+    return mismatches;
+}
+
+ThreadResult runThreads(unsigned threads, size_t entities, size_t batches, int frames,
+                        Workload& workload, const CullingBounds* reference, size_t referenceVisible) {
+    JobSystem jobs;
+    JobSystemSettings settings;
+    settings.workers = static_cast<int>(threads) - 1;
+    jobs.create(settings);
+
+    ThreadResult result;
+    result.threads = jobs.threadCount();
+
+    // parallel_for: 旋转 + 包围盒
+    for (int frame = 0; frame < frames; ++frame) {
+        const float angle = glm::radians(static_cast<float>(frame));
+        const auto start = Clock::now();
+        jobs.parallelFor(entities, 1024, [&](size_t begin, size_t end) {
+            animate(workload, begin, end, angle);
+            updateBounds(workload, begin, end);
+        });
+        result.parallelForMs += elapsedMs(start);
+    }
+    result.parallelForMs /= frames;
+
+    // task_graph: 动画 → 包围盒 → 剔除
+    std::vector<uint32_t> visible;
+    const size_t batchSize = (entities + batches - 1) / batches;
+    for (int frame = 0; frame < frames; ++frame) {
+        const float angle = glm::radians(static_cast<float>(frame));
+        const auto start = Clock::now();
+        JobHandle cull = jobs.createJob([&] {
+            FrustumCulling::cull(workload.frustum, workload.bounds, CullShape::Aabb, visible);
+        });
+        for (size_t batch = 0; batch < batches; ++batch) {
+            const size_t begin = batch * batchSize;
+            const size_t end = std::min(entities, begin + batchSize);
+            if (begin >= end) {
+                break;
+            }
+            JobHandle animateJob = jobs.createJob([&workload, begin, end, angle] { animate(workload, begin, end, angle); });
+            JobHandle boundsJob = jobs.createJob([&workload, begin, end] { updateBounds(workload, begin, end); });
+            jobs.addDependency(boundsJob, animateJob);
+            jobs.addDependency(cull, boundsJob);
+            jobs.submit(animateJob);
+            jobs.submit(boundsJob);
+        }
+        jobs.submit(cull);
+        jobs.wait(cull);
+        result.taskGraphMs += elapsedMs(start);
+    }
+    result.taskGraphMs /= frames;
+    result.visible = visible.size();
+
+    // empty_jobs: 调度开销
+    const size_t emptyJobs = 100000;
+    const auto start = Clock::now();
+    JobHandle root = jobs.createJob([] { });
+    for (size_t i = 0; i < emptyJobs; ++i) {
+        jobs.schedule([] { }, root);
+    }
+    jobs.submit(root);
+    jobs.wait(root);
+    result.emptyJobNs = elapsedMs(start) * 1.0e6 / emptyJobs;
+    result.stolen = jobs.stats().stolen;
+
+    if (reference) {
+        result.mismatches = countBoundMismatches(*reference, workload.bounds);
+        result.mismatches += result.visible != referenceVisible ? 1 : 0;
+    }
+    jobs.release();
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    unsigned maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    size_t entities = 1000000;
+    size_t batches = 64;
+    int frames = 20;
+    std::string outputPath;
+
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--threads") == 0 && hasValue) {
+            maxThreads = static_cast<unsigned>(std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--entities") == 0 && hasValue) {
+            entities = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--batches") == 0 && hasValue) {
+            batches = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--frames") == 0 && hasValue) {
+            frames = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--output") == 0 && hasValue) {
+            outputPath = argv[++i];
+        } else {
+            std::cerr << "Unknown argument: " << argv[i] << std::endl;
+            return -1;
+        }
+    }
+    if (maxThreads == 0 || entities == 0 || batches == 0 || frames <= 0) {
+        std::cerr << "--threads, --entities, --batches and --frames must be positive" << std::endl;
+        return -1;
+    }
+    maxThreads = std::min(maxThreads, static_cast<unsigned>(JobSystem::kMaxWorkers + 1));
+
+    Workload workload = makeWorkload(entities);
+    std::vector<ThreadResult> results;
+    CullingBounds reference;
+    for (unsigned threads = 1; threads <= maxThreads; ++threads) {
+        results.push_back(runThreads(threads, entities, batches, frames, workload,
+                                     threads > 1 ? &reference : nullptr, results.empty() ? 0 : results[0].visible));
+        if (threads == 1) {
+            reference = workload.bounds;
+        }
+    }
+
+    std::ofstream file;
+    if (!outputPath.empty()) {
+        file.open(outputPath);
+        if (!file.is_open()) {
+            std::cerr << "Failed to open output file: " << outputPath << std::endl;
+            return -1;
+        }
+    }
+    std::ostream& out = outputPath.empty() ? std::cout : file;
+
+    const ThreadResult& single = results.front();
+    out << "{\n";
+    out << "  \"hardware_threads\": " << std::thread::hardware_concurrency() << ",\n";
+    out << "  \"entities\": " << entities << ",\n";
+    out << "  \"batches\": " << batches << ",\n";
+    out << "  \"frames\": " << frames << ",\n";
+    out << "  \"scaling\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const ThreadResult& r = results[i];
+        out << "    { \"threads\": " << r.threads
+            << ", \"parallel_for_ms\": " << r.parallelForMs
+            << ", \"parallel_for_speedup\": " << single.parallelForMs / r.parallelForMs
+            << ", \"task_graph_ms\": " << r.taskGraphMs
+            << ", \"task_graph_speedup\": " << single.taskGraphMs / r.taskGraphMs
+            << ", \"empty_job_ns\": " << r.emptyJobNs
+            << ", \"stolen\": " << r.stolen
+            << ", \"visible\": " << r.visible
+            << ", \"mismatches\": " << r.mismatches << " }" << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    out << "  ]\n";
+    out << "}\n";
+
+    for (const ThreadResult& r : results) {
+        if (r.mismatches != 0) {
+            std::cerr << r.threads << " threads: results differ from single-threaded run" << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
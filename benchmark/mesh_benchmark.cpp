@@ -0,0 +1,192 @@
+/**
+ * @file mesh_benchmark.cpp
+ * @brief 网格优化报告 - MeshOptimizer 前后的 ACMR 与顶点数 (纯CPU，不需要GL上下文)
+ *
+ * 测试网格:
+ *   - grid_scanline   : N x N 规则网格，按行输出三角形 (常见导出顺序)
+ *   - grid_shuffled   : 同一网格，三角形顺序随机打乱 (固定种子)
+ *   - sphere_unindexed: 经纬球展开为非索引三角形列表 (测试去重)
+ * ACMR 使用 MeshOptimizer::kDefaultCacheSize 大小的FIFO缓存模拟。
+ *
+ * 用法:
+ *   mesh_benchmark [--grid N] [--output report.json]
+ */
+
+#include <glm/glm.hpp>
+#include <glm/gtc/constants.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "mesh_optimizer.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct MeshVertex {
+    glm::vec3 position;
+    glm::vec3 normal;
+    glm::vec2 texCoord;
+};
+
+struct TestMesh {
+    std::string name;
+    std::vector<MeshVertex> vertices;
+    std::vector<uint32_t> indices;      // 为空表示非索引
+};
+
+struct MeshResult {
+    std::string name;
+    MeshOptimizeStats stats;
+    double optimizeMs;
+};
+
+TestMesh makeGrid(uint32_t size) {
+    TestMesh mesh;
+    mesh.name = "grid_scanline";
+    const float step = 1.0f / static_cast<float>(size);
+
+    for (uint32_t y = 0; y <= size; ++y) {
+        for (uint32_t x = 0; x <= size; ++x) {
+            MeshVertex vertex;
+            vertex.position = glm::vec3(x * step, y * step, 0.0f);
+            vertex.normal = glm::vec3(0.0f, 0.0f, 1.0f);
+            vertex.texCoord = glm::vec2(x * step, y * step);
+            mesh.vertices.push_back(vertex);
+        }
+    }
+
+    const uint32_t row = size + 1;
+    for (uint32_t y = 0; y < size; ++y) {
+        for (uint32_t x = 0; x < size; ++x) {
+            const uint32_t a = y * row + x;
+            const uint32_t b = a + 1;
+            const uint32_t c = a + row;
+            const uint32_t d = c + 1;
+            mesh.indices.insert(mesh.indices.end(), { a, b, c, b, d, c });
+        }
+    }
+    return mesh;
+}
+
+TestMesh shuffleTriangles(const TestMesh& source) {
+    TestMesh mesh = source;
+    mesh.name = "grid_shuffled";
+
+    const size_t triangleCount = source.indices.size() / 3;
+    std::vector<size_t> order(triangleCount);
+    for (size_t i = 0; i < triangleCount; ++i) {
+        order[i] = i;
+    }
+    std::mt19937 rng(20240527u);
+    std::shuffle(order.begin(), order.end(), rng);
+
+    for (size_t i = 0; i < triangleCount; ++i) {
+        std::copy_n(source.indices.begin() + order[i] * 3, 3, mesh.indices.begin() + i * 3);
+    }
+    return mesh;
+}
+
+TestMesh makeUnindexedSphere(uint32_t slices, uint32_t stacks) {
+    TestMesh mesh;
+    mesh.name = "sphere_unindexed";
+
+    auto vertexAt = [&](uint32_t slice, uint32_t stack) {
+        const float u = static_cast<float>(slice) / static_cast<float>(slices);
+        const float v = static_cast<float>(stack) / static_cast<float>(stacks);
+        const float theta = u * glm::two_pi<float>();
+        const float phi = v * glm::pi<float>();
+        MeshVertex vertex;
+        vertex.normal = glm::vec3(std::cos(theta) * std::sin(phi), std::cos(phi), std::sin(theta) * std::sin(phi));
+        vertex.position = vertex.normal;
+        vertex.texCoord = glm::vec2(u, v);
+        return vertex;
+    };
+
+    for (uint32_t stack = 0; stack < stacks; ++stack) {
+        for (uint32_t slice = 0; slice < slices; ++slice) {
+            const MeshVertex a = vertexAt(slice, stack);
+            const MeshVertex b = vertexAt(slice + 1, stack);
+            const MeshVertex c = vertexAt(slice, stack + 1);
+            const MeshVertex d = vertexAt(slice + 1, stack + 1);
+            mesh.vertices.insert(mesh.vertices.end(), { a, c, b, b, c, d });
+        }
+    }
+    return mesh;
+}
+
+MeshResult optimize(TestMesh mesh) {
+    MeshResult result;
+    result.name = mesh.name;
+
+    auto start = Clock::now();
+    result.stats = MeshOptimizer::optimizeMesh(mesh.vertices, mesh.indices);
+    result.optimizeMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    uint32_t gridSize = 256;
+    std::string outputPath;
+
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--grid") == 0 && hasValue) {
+            gridSize = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--output") == 0 && hasValue) {
+            outputPath = argv[++i];
+        } else {
+            std::cerr << "Unknown argument: " << argv[i] << std::endl;
+            return -1;
+        }
+    }
+    if (gridSize == 0) {
+        std::cerr << "--grid must be positive" << std::endl;
+        return -1;
+    }
+
+    const TestMesh grid = makeGrid(gridSize);
+
+    std::vector<MeshResult> results;
+    results.push_back(optimize(grid));
+    results.push_back(optimize(shuffleTriangles(grid)));
+    results.push_back(optimize(makeUnindexedSphere(gridSize, gridSize / 2 + 1)));
+
+    std::ofstream file;
+    if (!outputPath.empty()) {
+        file.open(outputPath);
+        if (!file.is_open()) {
+            std::cerr << "Failed to open output file: " << outputPath << std::endl;
+            return -1;
+        }
+    }
+    std::ostream& out = outputPath.empty() ? std::cout : file;
+
+    out << "{\n";
+    out << "  \"cache_size\": " << MeshOptimizer::kDefaultCacheSize << ",\n";
+    out << "  \"meshes\": {\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const MeshResult& r = results[i];
+        out << "    \"" << r.name << "\": { "
+            << "\"triangles\": " << r.stats.triangles << ", "
+            << "\"vertices_before\": " << r.stats.verticesBefore << ", "
+            << "\"vertices_after\": " << r.stats.verticesAfter << ", "
+            << "\"acmr_before\": " << r.stats.acmrBefore << ", "
+            << "\"acmr_after\": " << r.stats.acmrAfter << ", "
+            << "\"optimize_ms\": " << r.optimizeMs << " }" << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    out << "  }\n";
+    out << "}\n";
+    return 0;
+}
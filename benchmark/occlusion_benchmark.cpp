@@ -0,0 +1,262 @@
+/**
+ * @file occlusion_benchmark.cpp
+ * @brief 软件遮挡剔除 - 光栅化/金字塔/测试耗时、线程扩展与确定性校验 (纯CPU，不需要GL上下文)
+ *
+ * 场景 (固定种子，相对 Camera 的朝向摆放):
+ *   - 遮挡体: N 个随机盒子，距相机 25~35
+ *   - 被测对象: M 个小盒子，距相机 45~75 (部分被遮挡)
+ *   - 前景对象: 64 个小盒子，距相机 8~12，位于所有遮挡体之前，必须全部可见 (保守性校验)
+ * 每种配置 (线程数 x SIMD/标量) 的第0级深度须与单线程标量结果逐位相同。
+ *
+ * 用法:
+ *   occlusion_benchmark [--occluders N] [--objects M] [--iterations N] [--size WxH] [--output report.json]
+ */
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "camera.hpp"
+#include "frustum_culling.hpp"
+#include "occlusion_culling.hpp"
+
+namespace {
+
+struct Box {
+    glm::vec3 center;
+    glm::vec3 extents;
+};
+
+struct Scene {
+    glm::mat4 viewProjection;
+    std::vector<Box> occluders;
+    CullingBounds objects;
+    size_t foregroundBegin = 0;     // objects 中前景对象的起始下标
+};
+
+struct ConfigResult {
+    int threads = 0;        // 工作线程数 (不含调用线程)
+    bool simd = true;
+    double rasterMs = 0.0;  // 多轮中的最小值
+    double pyramidMs = 0.0;
+    double testMs = 0.0;
+    size_t occluded = 0;
+    size_t depthMismatches = 0;
+};
+
+// 单位立方体 [-1,1]^3 的8个顶点与12个三角形
+const glm::vec3 kCubePositions[8] = {
+    { -1, -1, -1 }, { 1, -1, -1 }, { 1, 1, -1 }, { -1, 1, -1 },
+    { -1, -1,  1 }, { 1, -1,  1 }, { 1, 1,  1 }, { -1, 1,  1 }
+};
+const uint32_t kCubeIndices[36] = {
+    0, 1, 2, 0, 2, 3,   4, 6, 5, 4, 7, 6,
+    0, 4, 5, 0, 5, 1,   3, 2, 6, 3, 6, 7,
+    0, 3, 7, 0, 7, 4,   1, 5, 6, 1, 6, 2
+};
+
+Scene makeScene(size_t occluderCount, size_t objectCount, float aspect) {
+    Camera camera(glm::vec3(0.0f), 60.0f);
+    camera.updateAspectRatio(aspect);
+    Scene scene;
+    scene.viewProjection = camera.getProjectionMatrix() * camera.getViewMatrix();
+
+    const glm::vec3 eye = camera.getPosition();
+    const glm::vec3 forward = camera.getForward();
+    const glm::vec3 right = glm::normalize(glm::cross(forward, glm::vec3(0.0f, 1.0f, 0.0f)));
+    const glm::vec3 up = glm::cross(right, forward);
+
+    std::mt19937 random(777);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    // 在距离 distance 处，视锥横向/纵向约 ±0.4/±0.35 倍距离内
+    auto place = [&](float distance) {
+        return eye + forward * distance + right * (unit(random) * 0.6f * distance) + up * (unit(random) * 0.35f * distance);
+    };
+
+    std::uniform_real_distribution<float> occluderDistance(25.0f, 35.0f);
+    std::uniform_real_distribution<float> occluderSize(1.0f, 3.0f);
+    for (size_t i = 0; i < occluderCount; ++i) {
+        Box box;
+        box.center = place(occluderDistance(random));
+        box.extents = glm::vec3(occluderSize(random), occluderSize(random), occluderSize(random));
+        scene.occluders.push_back(box);
+    }
+
+    std::uniform_real_distribution<float> objectDistance(45.0f, 75.0f);
+    std::uniform_real_distribution<float> objectSize(0.3f, 1.0f);
+    scene.objects.resize(objectCount + 64);
+    for (size_t i = 0; i < objectCount; ++i) {
+        scene.objects.setAabb(i, place(objectDistance(random)), glm::vec3(objectSize(random)));
+    }
+    scene.foregroundBegin = objectCount;
+    std::uniform_real_distribution<float> foregroundDistance(8.0f, 12.0f);
+    for (size_t i = 0; i < 64; ++i) {
+        scene.objects.setAabb(objectCount + i, place(foregroundDistance(random)), glm::vec3(objectSize(random) * 0.3f));
+    }
+    return scene;
+}
+
+ConfigResult runConfig(const Scene& scene, int threads, bool simd, int width, int height, int iterations,
+                       const std::vector<float>* reference, std::vector<float>* depthOut, size_t& foregroundOccluded) {
+    OcclusionSettings settings;
+    settings.width = width;
+    settings.height = height;
+    settings.threads = threads;
+    settings.simd = simd;
+    OcclusionCuller culler(settings);
+
+    ConfigResult result;
+    result.threads = threads;
+    result.simd = simd;
+
+    std::vector<uint32_t> visible;
+    for (int iteration = 0; iteration < iterations; ++iteration) {
+        culler.beginFrame(scene.viewProjection);
+        for (const Box& box : scene.occluders) {
+            const glm::mat4 model = glm::scale(glm::translate(glm::mat4(1.0f), box.center), box.extents);
+            culler.addOccluder(kCubePositions, 8, kCubeIndices, 36, model);
+        }
+        culler.rasterize();
+
+        visible.resize(scene.objects.size());
+        for (size_t i = 0; i < visible.size(); ++i) {
+            visible[i] = static_cast<uint32_t>(i);
+        }
+        culler.cull(scene.objects, visible);
+
+        const OcclusionStats& stats = culler.stats();
+        if (iteration == 0 || stats.rasterMs < result.rasterMs) {
+            result.rasterMs = stats.rasterMs;
+        }
+        if (iteration == 0 || stats.pyramidMs < result.pyramidMs) {
+            result.pyramidMs = stats.pyramidMs;
+        }
+        if (iteration == 0 || stats.testMs < result.testMs) {
+            result.testMs = stats.testMs;
+        }
+        result.occluded = stats.occluded;
+    }
+
+    // 前景对象位于 visible 末尾之前的全部下标都应保留
+    foregroundOccluded = scene.objects.size() - scene.foregroundBegin;
+    for (uint32_t index : visible) {
+        if (index >= scene.foregroundBegin) {
+            foregroundOccluded--;
+        }
+    }
+
+    const std::vector<float>& depth = culler.level(0);
+    if (reference) {
+        for (size_t i = 0; i < depth.size(); ++i) {
+            result.depthMismatches += std::memcmp(&depth[i], &(*reference)[i], sizeof(float)) != 0 ? 1 : 0;
+        }
+    }
+    if (depthOut) {
+        *depthOut = depth;
+    }
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t occluderCount = 32;
+    size_t objectCount = 10000;
+    int iterations = 50;
+    int width = 256;
+    int height = 128;
+    std::string outputPath;
+
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--occluders") == 0 && hasValue) {
+            occluderCount = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--objects") == 0 && hasValue) {
+            objectCount = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--iterations") == 0 && hasValue) {
+            iterations = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--size") == 0 && hasValue) {
+            if (std::sscanf(argv[++i], "%dx%d", &width, &height) != 2) {
+                std::cerr << "Invalid --size, expected WxH" << std::endl;
+                return -1;
+            }
+        } else if (std::strcmp(argv[i], "--output") == 0 && hasValue) {
+            outputPath = argv[++i];
+        } else {
+            std::cerr << "Unknown argument: " << argv[i] << std::endl;
+            return -1;
+        }
+    }
+    if (iterations <= 0 || width <= 0 || height <= 0) {
+        std::cerr << "--iterations and --size must be positive" << std::endl;
+        return -1;
+    }
+
+    const Scene scene = makeScene(occluderCount, objectCount, static_cast<float>(width) / height);
+
+    // 参考: 单线程标量
+    std::vector<float> reference;
+    size_t foregroundOccluded = 0;
+    std::vector<ConfigResult> results;
+    results.push_back(runConfig(scene, 0, false, width, height, iterations, nullptr, &reference, foregroundOccluded));
+    size_t totalForegroundOccluded = foregroundOccluded;
+
+    const int threadCounts[] = { 0, 1, 3, OcclusionSettings::kMaxThreads };
+    for (int threads : threadCounts) {
+        results.push_back(runConfig(scene, threads, true, width, height, iterations, &reference, nullptr, foregroundOccluded));
+        totalForegroundOccluded += foregroundOccluded;
+    }
+
+    std::ofstream file;
+    if (!outputPath.empty()) {
+        file.open(outputPath);
+        if (!file.is_open()) {
+            std::cerr << "Failed to open output file: " << outputPath << std::endl;
+            return -1;
+        }
+    }
+    std::ostream& out = outputPath.empty() ? std::cout : file;
+
+    const size_t tested = scene.objects.size();
+    out << "{\n";
+    out << "  \"width\": " << width << ",\n";
+    out << "  \"height\": " << height << ",\n";
+    out << "  \"occluder_triangles\": " << occluderCount * 12 << ",\n";
+    out << "  \"objects\": " << tested << ",\n";
+    out << "  \"foreground_occluded\": " << totalForegroundOccluded << ",\n";
+    out << "  \"configs\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const ConfigResult& r = results[i];
+        out << "    { \"worker_threads\": " << r.threads << ", "
+            << "\"simd\": " << (r.simd ? "true" : "false") << ", "
+            << "\"raster_ms\": " << r.rasterMs << ", "
+            << "\"pyramid_ms\": " << r.pyramidMs << ", "
+            << "\"test_ms\": " << r.testMs << ", "
+            << "\"test_ns_per_object\": " << r.testMs * 1.0e6 / static_cast<double>(tested) << ", "
+            << "\"occluded\": " << r.occluded << ", "
+            << "\"depth_mismatches\": " << r.depthMismatches << " }" << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    out << "  ]\n";
+    out << "}\n";
+
+    for (const ConfigResult& r : results) {
+        if (r.depthMismatches != 0 || r.occluded != results[0].occluded) {
+            std::cerr << "Depth buffer differs from single-threaded scalar reference" << std::endl;
+            return 1;
+        }
+    }
+    if (totalForegroundOccluded != 0) {
+        std::cerr << totalForegroundOccluded << " foreground objects were culled" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,319 @@
+/**
+ * @file scene_benchmark.cpp
+ * @brief 场景存储 - 原型ECS 与逐对象堆分配场景的逐帧更新/收集耗时对比 (纯CPU，不需要GL上下文)
+ *
+ * 每个规模 N (固定种子):
+ *   - 更新: 所有实体按各自速度绕Z轴旋转，重写 Transform (ECS 按块遍历 Transform + Spin)
+ *   - 收集: 与 CubeRender 场景模式相同 - 写出逐实例数据 (模型矩阵、颜色、图集区域) 与世界空间 AABB
+ *   - 剔除: 对收集到的包围盒做视锥剔除 (FrustumCulling 最宽指令集)
+ *   - 增删: 每帧删除并重新创建 1% 的实体 (块内由末尾实体补位)
+ * 对照组是 std::vector<std::unique_ptr<SceneObject>>，遍历顺序与内存顺序无关，代表指针式场景。
+ * 两种存储收集到的实例数据须逐字节相同。
+ *
+ * 用法:
+ *   scene_benchmark [--entities 10000,100000] [--frames N] [--output report.json]
+ */
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "camera.hpp"
+#include "frustum_culling.hpp"
+#include "scene.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// 应用层组件: 基础变换 + 旋转倍率
+struct Spin {
+    glm::mat4 base = glm::mat4(1.0f);
+    float speed = 1.0f;
+};
+
+// 与 CubeRender::InstanceData 相同的布局
+struct InstanceData {
+    glm::mat4 model;
+    glm::vec4 color;
+    glm::vec4 atlasRect;
+    float atlasLayer;
+};
+
+// 对照组: 每个对象单独分配
+struct SceneObject {
+    Transform transform;
+    Bounds bounds;
+    MeshRef mesh;
+    MaterialRef material;
+    Spin spin;
+    uint32_t id = 0;
+};
+
+struct ScaleResult {
+    size_t entities = 0;
+    size_t chunks = 0;
+    double ecsUpdateMs = 0.0;       // 各阶段的逐帧平均值
+    double ecsGatherMs = 0.0;
+    double cullMs = 0.0;
+    double churnMs = 0.0;
+    double objectUpdateMs = 0.0;
+    double objectGatherMs = 0.0;
+    size_t visible = 0;
+    size_t mismatches = 0;
+};
+
+double elapsedMs(Clock::time_point from) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - from).count();
+}
+
+// world = base * rotateZ(angle)，直接按列组合，不构造旋转矩阵
+inline void spin(glm::mat4& world, const Spin& s, float angle) {
+    const float c = std::cos(angle * s.speed);
+    const float n = std::sin(angle * s.speed);
+    world[0] = s.base[0] * c + s.base[1] * n;
+    world[1] = s.base[1] * c - s.base[0] * n;
+    world[2] = s.base[2];
+    world[3] = s.base[3];
+}
+
+inline void writeInstance(InstanceData& data, const Transform& transform, const MaterialRef& material) {
+    data.model = transform.world;
+    data.color = material.color;
+    data.atlasRect = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
+    data.atlasLayer = static_cast<float>(material.texture);
+}
+
+SceneObject makeObject(std::mt19937& random, float extent, uint32_t id) {
+    std::uniform_real_distribution<float> position(-extent, extent);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    SceneObject object;
+    object.id = id;
+    object.spin.base = glm::mat4(1.0f);
+    object.spin.base[3] = glm::vec4(position(random), position(random), position(random), 1.0f);
+    object.spin.speed = 0.5f + unit(random) * 1.5f;
+    object.transform.world = object.spin.base;
+    object.bounds.extents = glm::vec3(1.0f, 1.0f, 0.0f);
+    object.material.color = glm::vec4(unit(random), unit(random), unit(random), 1.0f);
+    object.material.texture = id % 16;
+    return object;
+}
+
+ScaleResult runScale(size_t count, int frames) {
+    ScaleResult result;
+    result.entities = count;
+
+    const float extent = 10.0f * std::cbrt(static_cast<float>(count));
+    std::mt19937 random(2024);
+    Scene scene;
+    std::vector<std::unique_ptr<SceneObject>> objects;
+    std::vector<Entity> entities;
+    for (size_t i = 0; i < count; ++i) {
+        const SceneObject object = makeObject(random, extent, static_cast<uint32_t>(i));
+        entities.push_back(scene.create(object.transform, object.bounds, object.mesh, object.material, object.spin));
+        objects.push_back(std::unique_ptr<SceneObject>(new SceneObject(object)));
+    }
+    // 指针式场景的遍历顺序与分配顺序无关
+    std::shuffle(objects.begin(), objects.end(), std::mt19937(99));
+    result.chunks = scene.chunkCount();
+
+    Camera camera(glm::vec3(0.0f), 50.0f);
+    camera.updateAspectRatio(16.0f / 9.0f);
+    const Frustum frustum = Frustum::fromCamera(camera);
+
+    std::vector<InstanceData> ecsData;
+    std::vector<InstanceData> objectData;
+    CullingBounds ecsBounds;
+    CullingBounds objectBounds;
+    std::vector<uint32_t> visible;
+
+    for (int frame = 0; frame < frames; ++frame) {
+        const float angle = glm::radians(static_cast<float>(frame));
+
+        // ---- ECS ----
+        auto start = Clock::now();
+        scene.view<Transform, Spin>().forEachChunk([angle](size_t n, const Entity*, Transform* transforms, const Spin* spins) {
+            for (size_t i = 0; i < n; ++i) {
+                spin(transforms[i].world, spins[i], angle);
+            }
+        });
+        result.ecsUpdateMs += elapsedMs(start);
+
+        start = Clock::now();
+        const auto view = scene.view<Transform, Bounds, MeshRef, MaterialRef>();
+        ecsData.resize(view.size());
+        ecsBounds.resize(view.size());
+        size_t written = 0;
+        view.forEachChunk([&](size_t n, const Entity*, const Transform* transforms, const Bounds* bounds,
+                              const MeshRef* meshes, const MaterialRef* materials) {
+            for (size_t i = 0; i < n; ++i) {
+                if (meshes[i].mesh != 0) {
+                    continue;
+                }
+                writeInstance(ecsData[written], transforms[i], materials[i]);
+                ecsBounds.setTransformed(written, bounds[i].center, bounds[i].extents, transforms[i].world);
+                ++written;
+            }
+        });
+        ecsData.resize(written);
+        ecsBounds.resize(written);
+        result.ecsGatherMs += elapsedMs(start);
+
+        start = Clock::now();
+        FrustumCulling::cull(frustum, ecsBounds, CullShape::Aabb, visible);
+        result.cullMs += elapsedMs(start);
+        result.visible = visible.size();
+
+        // ---- 对照组 ----
+        start = Clock::now();
+        for (const auto& object : objects) {
+            spin(object->transform.world, object->spin, angle);
+        }
+        result.objectUpdateMs += elapsedMs(start);
+
+        start = Clock::now();
+        objectData.resize(objects.size());
+        objectBounds.resize(objects.size());
+        written = 0;
+        for (const auto& object : objects) {
+            if (object->mesh.mesh != 0) {
+                continue;
+            }
+            writeInstance(objectData[written], object->transform, object->material);
+            objectBounds.setTransformed(written, object->bounds.center, object->bounds.extents, object->transform.world);
+            ++written;
+        }
+        objectData.resize(written);
+        objectBounds.resize(written);
+        result.objectGatherMs += elapsedMs(start);
+    }
+
+    // 增删之前比对: ECS 按创建顺序，对照组按 id 还原顺序
+    if (ecsData.size() != objectData.size()) {
+        result.mismatches = std::max(ecsData.size(), objectData.size());
+    } else {
+        for (size_t i = 0; i < objects.size(); ++i) {
+            const InstanceData& expected = objectData[i];
+            const InstanceData& actual = ecsData[objects[i]->id];
+            result.mismatches += std::memcmp(&expected, &actual, sizeof(InstanceData)) != 0 ? 1 : 0;
+        }
+    }
+
+    // 结构变化: 每帧删除 1% 的实体再创建同样数量
+    const size_t churn = std::max<size_t>(1, count / 100);
+    std::uniform_int_distribution<size_t> pick(0, count - 1);
+    for (int frame = 0; frame < frames; ++frame) {
+        const auto start = Clock::now();
+        for (size_t i = 0; i < churn; ++i) {
+            const size_t slot = pick(random);
+            scene.destroy(entities[slot]);
+            const SceneObject object = makeObject(random, extent, static_cast<uint32_t>(slot));
+            entities[slot] = scene.create(object.transform, object.bounds, object.mesh, object.material, object.spin);
+        }
+        result.churnMs += elapsedMs(start);
+    }
+    if (scene.size() != count) {
+        result.mismatches++;
+    }
+
+    const double invFrames = frames > 0 ? 1.0 / frames : 0.0;
+    result.ecsUpdateMs *= invFrames;
+    result.ecsGatherMs *= invFrames;
+    result.cullMs *= invFrames;
+    result.churnMs *= invFrames;
+    result.objectUpdateMs *= invFrames;
+    result.objectGatherMs *= invFrames;
+    return result;
+}
+
+std::vector<size_t> parseCounts(const std::string& text) {
+    std::vector<size_t> counts;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        const size_t count = std::strtoull(item.c_str(), nullptr, 10);
+        if (count > 0) {
+            counts.push_back(count);
+        }
+    }
+    return counts;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::vector<size_t> counts = { 10000, 100000 };
+    int frames = 60;
+    std::string outputPath;
+
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--entities") == 0 && hasValue) {
+            counts = parseCounts(argv[++i]);
+        } else if (std::strcmp(argv[i], "--frames") == 0 && hasValue) {
+            frames = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--output") == 0 && hasValue) {
+            outputPath = argv[++i];
+        } else {
+            std::cerr << "Unknown argument: " << argv[i] << std::endl;
+            return -1;
+        }
+    }
+    if (counts.empty() || frames <= 0) {
+        std::cerr << "--entities must list positive counts, --frames must be positive" << std::endl;
+        return -1;
+    }
+
+    std::vector<ScaleResult> results;
+    for (size_t count : counts) {
+        results.push_back(runScale(count, frames));
+    }
+
+    std::ofstream file;
+    if (!outputPath.empty()) {
+        file.open(outputPath);
+        if (!file.is_open()) {
+            std::cerr << "Failed to open output file: " << outputPath << std::endl;
+            return -1;
+        }
+    }
+    std::ostream& out = outputPath.empty() ? std::cout : file;
+
+    out << "{\n";
+    out << "  \"frames\": " << frames << ",\n";
+    out << "  \"chunk_bytes\": " << SceneArchetype::kChunkBytes << ",\n";
+    out << "  \"scales\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const ScaleResult& r = results[i];
+        out << "    { \"entities\": " << r.entities << ", \"chunks\": " << r.chunks << ",\n"
+            << "      \"ecs_ms\": { \"update\": " << r.ecsUpdateMs << ", \"gather\": " << r.ecsGatherMs
+            << ", \"cull\": " << r.cullMs << ", \"total\": " << r.ecsUpdateMs + r.ecsGatherMs + r.cullMs
+            << ", \"churn_1pct\": " << r.churnMs << " },\n"
+            << "      \"object_ms\": { \"update\": " << r.objectUpdateMs << ", \"gather\": " << r.objectGatherMs << " },\n"
+            << "      \"visible\": " << r.visible << ", \"mismatches\": " << r.mismatches << " }"
+            << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    out << "  ]\n";
+    out << "}\n";
+
+    for (const ScaleResult& r : results) {
+        if (r.mismatches != 0) {
+            std::cerr << r.entities << " entities: ECS results differ from per-object reference" << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
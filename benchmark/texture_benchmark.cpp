@@ -0,0 +1,366 @@
+/**
+ * @file texture_benchmark.cpp
+ * @brief 纹理加载基准 - 主线程同步加载 vs TextureManager 流式加载的帧时间对比
+ *
+ * 先生成 N 张 SxS 的 PNG，然后模拟一段渲染循环: 第0帧请求加载全部图片，每帧把所有纹理各画一次。
+ *   - sync   : 第0帧在主线程内 SOIL 解码 + glTexImage2D + glGenerateMipmap，全部完成后才继续
+ *   - stream : 第0帧只调用 load()，之后每帧 update() 在预算内经PBO上传，未就绪的纹理画占位图
+ * 每帧以 glFinish 结束，帧时间包含GPU完成上传/绘制的时间。
+ * 最后回读两种方式得到的纹理并逐像素比较，确认分帧上传/翻转结果一致。
+ *
+ * --format dds 时生成 DXT5 的 DDS: sync 仍按朴素做法解压为 RGBA8 上传，stream 则原样上传压缩块
+ * (驱动不支持 S3TC 时由 TextureManager 转码)，可对比上传字节数与帧时间；压缩有损，像素差不为0。
+ *
+ * 用法:
+ *   texture_benchmark [--count N] [--size S] [--frames N] [--budget MB] [--format png|dds] [--dir DIR]
+ *                     [--output report.json]
+ */
+
+#include <glad/glad.h>
+#include <SOIL2.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "shader.hpp"
+#include "gl_state_cache.hpp"
+#include "texture_manager.hpp"
+#include "framebuffer.hpp"
+#include "platform/headless_context.hpp"
+
+namespace {
+
+constexpr int kTargetSize = 64;
+
+struct ModeResult {
+    std::string name;
+    double maxFrameMs = 0.0;
+    double p99FrameMs = 0.0;
+    double medianFrameMs = 0.0;
+    uint64_t framesUntilReady = 0;  // 所有纹理可用之前经过的帧数 (含就绪的那一帧)
+    double msUntilReady = 0.0;
+    uint32_t pixelBufferStalls = 0;
+    uint64_t uploadBytes = 0;
+};
+
+// 全屏三角形，顶点由 gl_VertexID 生成，不需要顶点缓冲
+const char* kVertexShader = R"(#version 330 core
+out vec2 vTexCoord;
+void main() {
+    vec2 position = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+    vTexCoord = position;
+    gl_Position = vec4(position * 2.0 - 1.0, 0.0, 1.0);
+}
+)";
+
+const char* kFragmentShader = R"(#version 330 core
+in vec2 vTexCoord;
+out vec4 fragColor;
+uniform sampler2D image;
+void main() {
+    fragColor = texture(image, vTexCoord);
+}
+)";
+
+double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// 每张图不同的渐变 + 噪声，避免PNG压缩得过小而低估解码开销
+bool writeImages(const std::string& directory, const std::string& format, int count, int size,
+                 std::vector<std::string>& paths) {
+    const bool dds = format == "dds";
+    std::vector<unsigned char> pixels(static_cast<size_t>(size) * size * 4);
+    uint32_t seed = 12345u;
+    for (int i = 0; i < count; ++i) {
+        for (int y = 0; y < size; ++y) {
+            for (int x = 0; x < size; ++x) {
+                seed = seed * 1664525u + 1013904223u;
+                unsigned char* p = &pixels[(static_cast<size_t>(y) * size + x) * 4];
+                p[0] = static_cast<unsigned char>((x * 255) / size);
+                p[1] = static_cast<unsigned char>((y * 255) / size);
+                p[2] = static_cast<unsigned char>((i * 37 + (seed >> 24)) & 0xFF);
+                p[3] = 255;
+            }
+        }
+        const std::string path = directory + "/texture_" + std::to_string(i) + "." + format;
+        if (!SOIL_save_image(path.c_str(), dds ? SOIL_SAVE_TYPE_DDS : SOIL_SAVE_TYPE_PNG, size, size, 4, pixels.data())) {
+            std::cerr << "Failed to write " << path << ": " << SOIL_last_result() << std::endl;
+            return false;
+        }
+        paths.push_back(path);
+    }
+    return true;
+}
+
+// 朴素做法: 解码、翻转、上传、生成mipmap 全部在调用线程内同步完成
+// (压缩纹理也解压为 RGBA8；与 TextureManager 一致，压缩数据不翻转)
+GLuint loadSync(const std::string& path, bool flip, uint64_t& uploadBytes) {
+    int width = 0;
+    int height = 0;
+    int channels = 0;
+    unsigned char* pixels = SOIL_load_image(path.c_str(), &width, &height, &channels, SOIL_LOAD_RGBA);
+    if (!pixels) {
+        return 0;
+    }
+    const size_t rowBytes = static_cast<size_t>(width) * 4;
+    std::vector<unsigned char> row(rowBytes);
+    for (int y = 0; flip && y < height / 2; ++y) {
+        unsigned char* top = pixels + static_cast<size_t>(y) * rowBytes;
+        unsigned char* bottom = pixels + static_cast<size_t>(height - 1 - y) * rowBytes;
+        std::memcpy(row.data(), top, rowBytes);
+        std::memcpy(top, bottom, rowBytes);
+        std::memcpy(bottom, row.data(), rowBytes);
+    }
+
+    GLuint texture = 0;
+    glGenTextures(1, &texture);
+    GLStateCache::current().bindTexture(GL_TEXTURE_2D, texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glGenerateMipmap(GL_TEXTURE_2D);
+    SOIL_free_image_data(pixels);
+    uploadBytes += rowBytes * static_cast<size_t>(height);
+    return texture;
+}
+
+void drawTextures(const std::vector<GLuint>& textures) {
+    GLStateCache& state = GLStateCache::current();
+    glClear(GL_COLOR_BUFFER_BIT);
+    for (GLuint texture : textures) {
+        state.bindTexture(GL_TEXTURE_2D, texture);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+    }
+}
+
+void summarize(const std::vector<double>& frameMs, ModeResult& result) {
+    std::vector<double> sorted = frameMs;
+    std::sort(sorted.begin(), sorted.end());
+    result.maxFrameMs = sorted.back();
+    result.medianFrameMs = sorted[sorted.size() / 2];
+    result.p99FrameMs = sorted[std::min(sorted.size() - 1, static_cast<size_t>(std::ceil(sorted.size() * 0.99)) - 1)];
+}
+
+std::vector<uint8_t> readTexture(GLuint texture, glm::ivec2 size) {
+    std::vector<uint8_t> pixels(static_cast<size_t>(size.x) * size.y * 4);
+    GLStateCache::current().bindTexture(GL_TEXTURE_2D, texture);
+    glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+    return pixels;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int count = 16;
+    int size = 1024;
+    uint64_t frames = 120;
+    size_t budgetMB = 4;
+    std::string format = "png";
+    std::string directory = ".";
+    std::string outputPath;
+
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--count") == 0 && hasValue) {
+            count = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--size") == 0 && hasValue) {
+            size = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--frames") == 0 && hasValue) {
+            frames = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--budget") == 0 && hasValue) {
+            budgetMB = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--format") == 0 && hasValue) {
+            format = argv[++i];
+        } else if (std::strcmp(argv[i], "--dir") == 0 && hasValue) {
+            directory = argv[++i];
+        } else if (std::strcmp(argv[i], "--output") == 0 && hasValue) {
+            outputPath = argv[++i];
+        } else {
+            std::cerr << "Unknown argument: " << argv[i] << std::endl;
+            return -1;
+        }
+    }
+    if (count <= 0 || size <= 0 || frames == 0 || budgetMB == 0) {
+        std::cerr << "--count, --size, --frames and --budget must be positive" << std::endl;
+        return -1;
+    }
+    if (format != "png" && format != "dds") {
+        std::cerr << "--format must be png or dds" << std::endl;
+        return -1;
+    }
+
+    std::vector<std::string> paths;
+    if (!writeImages(directory, format, count, size, paths)) {
+        return -1;
+    }
+
+    HeadlessContext context;
+    if (!context.create(3, 3)) {
+        std::cerr << "Failed to create headless context: " << context.lastError() << std::endl;
+        return -1;
+    }
+    if (!gladLoadGLLoader((GLADloadproc)HeadlessContext::getProcAddress)) {
+        std::cerr << "Failed to initialize GLAD" << std::endl;
+        return -1;
+    }
+
+    Framebuffer framebuffer;
+    if (!framebuffer.create(kTargetSize, kTargetSize)) {
+        std::cerr << "Failed to create framebuffer" << std::endl;
+        return -1;
+    }
+    Shader shader;
+    if (!shader.loadFromSource(kVertexShader, kFragmentShader)) {
+        std::cerr << "Failed to compile shader: " << shader.lastError() << std::endl;
+        return -1;
+    }
+    GLuint emptyVao = 0;
+    glGenVertexArrays(1, &emptyVao);
+
+    GLStateCache& state = GLStateCache::current();
+    framebuffer.bind();
+    glViewport(0, 0, kTargetSize, kTargetSize);
+    shader.use();
+    shader.setInt("image", 0);
+    state.bindVertexArray(emptyVao);
+
+    std::vector<ModeResult> results;
+
+    // ---- sync: 第0帧阻塞直到全部加载完成 ----
+    std::vector<GLuint> syncTextures;
+    {
+        ModeResult result;
+        result.name = "sync";
+        std::vector<double> frameMs;
+        const auto begin = std::chrono::steady_clock::now();
+        for (uint64_t frame = 0; frame < frames; ++frame) {
+            const auto start = std::chrono::steady_clock::now();
+            if (frame == 0) {
+                for (const std::string& path : paths) {
+                    syncTextures.push_back(loadSync(path, format == "png", result.uploadBytes));
+                }
+            }
+            drawTextures(syncTextures);
+            glFinish();
+            frameMs.push_back(elapsedMs(start));
+            if (frame == 0) {
+                result.framesUntilReady = 1;
+                result.msUntilReady = elapsedMs(begin);
+            }
+        }
+        summarize(frameMs, result);
+        results.push_back(result);
+    }
+
+    // ---- stream: load() 立即返回，每帧 update() 在预算内上传 ----
+    TextureManager manager;
+    TextureManagerSettings settings;
+    settings.uploadBudgetBytes = budgetMB * 1024 * 1024;
+    if (!manager.create(settings)) {
+        std::cerr << "Failed to create texture manager" << std::endl;
+        return -1;
+    }
+    std::vector<TextureHandle> handles;
+    {
+        ModeResult result;
+        result.name = "stream";
+        std::vector<double> frameMs;
+        std::vector<GLuint> textures(paths.size());
+        const auto begin = std::chrono::steady_clock::now();
+        for (uint64_t frame = 0; frame < frames || !manager.isIdle(); ++frame) {
+            const auto start = std::chrono::steady_clock::now();
+            if (frame == 0) {
+                for (const std::string& path : paths) {
+                    handles.push_back(manager.load(path));
+                }
+            }
+            manager.update();
+            result.pixelBufferStalls += manager.lastStats().pixelBufferStalls;
+            result.uploadBytes += manager.lastStats().bytesUploaded;
+
+            // update() 会切换纹理与 PIXEL_UNPACK 绑定，绘制状态仍由状态缓存保证
+            for (size_t i = 0; i < handles.size(); ++i) {
+                textures[i] = manager.glTexture(handles[i]);
+            }
+            drawTextures(textures);
+            glFinish();
+            frameMs.push_back(elapsedMs(start));
+            if (result.framesUntilReady == 0 && manager.isIdle()) {
+                result.framesUntilReady = frame + 1;
+                result.msUntilReady = elapsedMs(begin);
+            }
+        }
+        summarize(frameMs, result);
+        results.push_back(result);
+    }
+
+    // ---- 正确性: 流式上传的纹理与同步上传逐像素一致 ----
+    int maxPixelDiff = 0;
+    size_t failed = 0;
+    for (size_t i = 0; i < handles.size(); ++i) {
+        if (manager.state(handles[i]) != TextureState::Ready || syncTextures[i] == 0) {
+            ++failed;
+            continue;
+        }
+        const glm::ivec2 textureSize = manager.size(handles[i]);
+        const std::vector<uint8_t> streamed = readTexture(manager.glTexture(handles[i]), textureSize);
+        const std::vector<uint8_t> reference = readTexture(syncTextures[i], textureSize);
+        for (size_t p = 0; p < streamed.size(); ++p) {
+            maxPixelDiff = std::max(maxPixelDiff, std::abs(static_cast<int>(streamed[p]) - reference[p]));
+        }
+    }
+
+    std::ofstream file;
+    if (!outputPath.empty()) {
+        file.open(outputPath);
+        if (!file.is_open()) {
+            std::cerr << "Failed to open output file: " << outputPath << std::endl;
+            return -1;
+        }
+    }
+    std::ostream& out = outputPath.empty() ? std::cout : file;
+
+    out << "{\n";
+    out << "  \"textures\": " << count << ",\n";
+    out << "  \"size\": " << size << ",\n";
+    out << "  \"format\": \"" << format << "\",\n";
+    out << "  \"compressed_support\": \"" << manager.compressedSupport().describe() << "\",\n";
+    out << "  \"upload_budget_mb\": " << budgetMB << ",\n";
+    out << "  \"decode_threads\": " << manager.settings().decodeThreads << ",\n";
+    out << "  \"failed\": " << failed << ",\n";
+    out << "  \"max_pixel_diff\": " << maxPixelDiff << ",\n";
+    out << "  \"modes\": {\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const ModeResult& r = results[i];
+        out << "    \"" << r.name << "\": { "
+            << "\"max_frame_ms\": " << r.maxFrameMs << ", "
+            << "\"p99_frame_ms\": " << r.p99FrameMs << ", "
+            << "\"median_frame_ms\": " << r.medianFrameMs << ", "
+            << "\"frames_until_ready\": " << r.framesUntilReady << ", "
+            << "\"ms_until_ready\": " << r.msUntilReady << ", "
+            << "\"pbo_stalls\": " << r.pixelBufferStalls << ", "
+            << "\"upload_mb\": " << r.uploadBytes / (1024.0 * 1024.0) << " }" << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    out << "  }\n";
+    out << "}\n";
+
+    manager.release();
+    for (GLuint texture : syncTextures) {
+        state.onTextureDeleted(texture);
+    }
+    glDeleteTextures(static_cast<GLsizei>(syncTextures.size()), syncTextures.data());
+    state.onVertexArrayDeleted(emptyVao);
+    glDeleteVertexArrays(1, &emptyVao);
+    framebuffer.unbind();
+    shader.release();
+    framebuffer.release();
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,155 @@
+/**
+ * @file uniform_benchmark.cpp
+ * @brief uniform设置路径的微基准 - 字符串查找 vs 预解析句柄
+ *
+ * 每帧对同一个 mat4 uniform 设置 N 次 (默认 100k)，比较:
+ *   - string_literal : setMat4("model", m)      每次构造 std::string + unordered_map 查找
+ *   - string_cached  : setMat4(name, m)         仅 unordered_map 查找
+ *   - hashed_lookup  : setMat4(uniformHandle(kModel), m)  编译期哈希 + 二分查找
+ *   - handle         : setMat4(handle, m)       链接时解析，直接 glUniformMatrix4fv
+ * 所有路径都包含真实的GL调用，差值即为查找开销。
+ *
+ * 用法:
+ *   uniform_benchmark [--sets N] [--frames N] [--output report.json]
+ */
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "shader.hpp"
+#include "platform/headless_context.hpp"
+#include "cube_config.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct PathResult {
+    const char* name;
+    double medianFrameMs;
+    double nsPerSet;
+};
+
+// 每帧执行一次 body(i) x sets，返回每帧耗时的中位数
+double measure(uint64_t frames, uint64_t sets, const std::function<void(uint64_t)>& body) {
+    std::vector<double> frameMs;
+    frameMs.reserve(frames);
+
+    for (uint64_t frame = 0; frame < frames; ++frame) {
+        auto start = Clock::now();
+        for (uint64_t i = 0; i < sets; ++i) {
+            body(i);
+        }
+        glFlush();
+        frameMs.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+    }
+
+    std::sort(frameMs.begin(), frameMs.end());
+    return frameMs[frameMs.size() / 2];
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    uint64_t sets = 100000;
+    uint64_t frames = 20;
+    std::string outputPath;
+
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--sets") == 0 && hasValue) {
+            sets = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--frames") == 0 && hasValue) {
+            frames = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--output") == 0 && hasValue) {
+            outputPath = argv[++i];
+        } else {
+            std::cerr << "Unknown argument: " << argv[i] << std::endl;
+            return -1;
+        }
+    }
+    if (sets == 0 || frames == 0) {
+        std::cerr << "--sets and --frames must be positive" << std::endl;
+        return -1;
+    }
+
+    HeadlessContext context;
+    if (!context.create(3, 3)) {
+        std::cerr << "Failed to create headless context: " << context.lastError() << std::endl;
+        return -1;
+    }
+    if (!gladLoadGLLoader((GLADloadproc)HeadlessContext::getProcAddress)) {
+        std::cerr << "Failed to initialize GLAD" << std::endl;
+        return -1;
+    }
+
+    Shader shader;
+    if (!shader.loadFromSource(CUBE_VERTEX_SHADER, CUBE_FRAGMENT_SHADER)) {
+        std::cerr << "Failed to compile shader: " << shader.lastError() << std::endl;
+        return -1;
+    }
+    shader.use();
+
+    constexpr UniformName kModel("model");
+    const std::string cachedName = "model";
+    const UniformHandle handle = shader.uniformHandle(kModel);
+    if (!handle.isValid()) {
+        std::cerr << "Uniform 'model' not found" << std::endl;
+        return -1;
+    }
+
+    // 每次设置不同的值，防止驱动合并冗余调用
+    glm::mat4 matrix(1.0f);
+    auto next = [&matrix](uint64_t i) -> const glm::mat4& {
+        matrix[3][0] = static_cast<float>(i & 0xff);
+        return matrix;
+    };
+
+    std::vector<PathResult> results;
+    auto run = [&](const char* name, const std::function<void(uint64_t)>& body) {
+        double ms = measure(frames, sets, body);
+        results.push_back({ name, ms, ms * 1.0e6 / static_cast<double>(sets) });
+    };
+
+    run("string_literal", [&](uint64_t i) { shader.setMat4("model", next(i)); });
+    run("string_cached",  [&](uint64_t i) { shader.setMat4(cachedName, next(i)); });
+    run("hashed_lookup",  [&](uint64_t i) { shader.setMat4(shader.uniformHandle(kModel), next(i)); });
+    run("handle",         [&](uint64_t i) { shader.setMat4(handle, next(i)); });
+
+    glFinish();
+    shader.unuse();
+
+    std::ofstream file;
+    if (!outputPath.empty()) {
+        file.open(outputPath);
+        if (!file.is_open()) {
+            std::cerr << "Failed to open output file: " << outputPath << std::endl;
+            return -1;
+        }
+    }
+    std::ostream& out = outputPath.empty() ? std::cout : file;
+
+    out << "{\n";
+    out << "  \"sets_per_frame\": " << sets << ",\n";
+    out << "  \"frames\": " << frames << ",\n";
+    out << "  \"paths\": {\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        out << "    \"" << results[i].name << "\": { \"median_frame_ms\": " << results[i].medianFrameMs
+            << ", \"ns_per_set\": " << results[i].nsPerSet << " }" << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    out << "  }\n";
+    out << "}\n";
+
+    shader.release();
+    return 0;
+}
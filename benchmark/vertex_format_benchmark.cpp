@@ -0,0 +1,333 @@
+/**
+ * @file vertex_format_benchmark.cpp
+ * @brief 顶点带宽基准 - 同一个大网格以不同的顶点格式绘制，比较顶点读取开销
+ *
+ * 网格: N x N 高度场 (位置 + 法线 + UV + 颜色)，经 MeshOptimizer 优化后每个顶点约读取一次。
+ * 格式:
+ *   - float32 : 全浮点 (44 字节/顶点)
+ *   - half16  : half 位置 + unorm16 UV + RGBA8 颜色 + 八面体法线
+ *   - compact : snorm16 位置 + unorm16 UV + RGBA8 颜色 + 八面体法线 (VertexFormat::compact)
+ * 渲染到很小的FBO使光栅化/片元开销可以忽略，GPU时间主要花在顶点读取与变换上。
+ * 每种格式先各绘制一帧并回读，与 float32 的逐像素最大差值用于确认量化没有可见误差。
+ *
+ * 用法:
+ *   vertex_format_benchmark [--grid N] [--draws N] [--frames N] [--output report.json]
+ */
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "shader.hpp"
+#include "gl_state_cache.hpp"
+#include "index_buffer.hpp"
+#include "mesh_optimizer.hpp"
+#include "vertex_format.hpp"
+#include "framebuffer.hpp"
+#include "gpu_timer.hpp"
+#include "platform/headless_context.hpp"
+
+namespace {
+
+constexpr int kTargetSize = 64;
+
+struct BenchVertex {
+    glm::vec3 position;
+    glm::vec3 normal;
+    glm::vec2 texCoord;
+    glm::vec3 color;
+};
+
+struct FormatCase {
+    const char* name;
+    VertexFormat format;
+};
+
+struct FormatResult {
+    std::string name;
+    size_t bytesPerVertex = 0;
+    double bufferMB = 0.0;
+    double gpuMs = 0.0;         // 每帧GPU耗时中位数
+    double gigabytesPerSecond = 0.0;
+    int maxPixelDiff = 0;       // 与 float32 的逐像素最大差值
+};
+
+const char* kVertexShader = R"(
+layout(location = 0) in vec3 aPosition;
+#ifdef OCT_NORMAL
+layout(location = 1) in vec2 aNormal;
+#else
+layout(location = 1) in vec3 aNormal;
+#endif
+layout(location = 2) in vec2 aTexCoord;
+layout(location = 3) in vec4 aColor;
+
+uniform mat4 transform;
+out vec4 vColor;
+
+vec3 decodeNormal() {
+#ifdef OCT_NORMAL
+    vec3 n = vec3(aNormal, 1.0 - abs(aNormal.x) - abs(aNormal.y));
+    if (n.z < 0.0) {
+        n.xy = (1.0 - abs(n.yx)) * vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+    }
+    return normalize(n);
+#else
+    return normalize(aNormal);
+#endif
+}
+
+void main() {
+    float light = max(dot(decodeNormal(), normalize(vec3(0.3, 0.5, 0.8))), 0.0);
+    vColor = vec4(aColor.rgb * light * (0.5 + 0.5 * aTexCoord.x), 1.0);
+    gl_Position = transform * vec4(aPosition, 1.0);
+}
+)";
+
+const char* kFragmentShader = R"(
+in vec4 vColor;
+out vec4 fragColor;
+void main() {
+    fragColor = vColor;
+}
+)";
+
+std::vector<BenchVertex> makeHeightField(uint32_t size, std::vector<uint32_t>& indices) {
+    std::vector<BenchVertex> vertices;
+    vertices.reserve(static_cast<size_t>(size) * size);
+    const float step = 1.0f / static_cast<float>(size - 1);
+
+    for (uint32_t y = 0; y < size; ++y) {
+        for (uint32_t x = 0; x < size; ++x) {
+            const float u = x * step;
+            const float v = y * step;
+            const float fx = 12.0f * u;
+            const float fy = 9.0f * v;
+            const float height = 0.1f * std::sin(fx) * std::cos(fy);
+
+            BenchVertex vertex;
+            vertex.position = glm::vec3(u * 4.0f - 2.0f, v * 3.0f - 1.5f, height);
+            vertex.normal = glm::normalize(glm::vec3(-0.3f * std::cos(fx) * std::cos(fy),
+                                                     0.3f * std::sin(fx) * std::sin(fy), 1.0f));
+            vertex.texCoord = glm::vec2(u, v);
+            vertex.color = glm::vec3(u, v, 1.0f - u);
+            vertices.push_back(vertex);
+        }
+    }
+
+    indices.clear();
+    indices.reserve(static_cast<size_t>(size - 1) * (size - 1) * 6);
+    for (uint32_t y = 0; y + 1 < size; ++y) {
+        for (uint32_t x = 0; x + 1 < size; ++x) {
+            const uint32_t a = y * size + x;
+            const uint32_t b = a + 1;
+            const uint32_t c = a + size;
+            const uint32_t d = c + 1;
+            indices.insert(indices.end(), { a, b, c, b, d, c });
+        }
+    }
+    return vertices;
+}
+
+VertexStream buildStream(const std::vector<BenchVertex>& vertices, const VertexFormat& format) {
+    VertexStreamBuilder builder(vertices.size());
+    builder.addPosition(0, format.position, &vertices[0].position, sizeof(BenchVertex));
+    builder.addNormal(1, format.normal, &vertices[0].normal, sizeof(BenchVertex));
+    builder.addTexCoord(2, format.texCoord, &vertices[0].texCoord, sizeof(BenchVertex));
+    builder.addColor(3, format.color, &vertices[0].color, sizeof(BenchVertex));
+    return builder.build();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    uint32_t gridSize = 1024;
+    uint64_t draws = 8;
+    uint64_t frames = 50;
+    std::string outputPath;
+
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--grid") == 0 && hasValue) {
+            gridSize = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--draws") == 0 && hasValue) {
+            draws = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--frames") == 0 && hasValue) {
+            frames = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--output") == 0 && hasValue) {
+            outputPath = argv[++i];
+        } else {
+            std::cerr << "Unknown argument: " << argv[i] << std::endl;
+            return -1;
+        }
+    }
+    if (gridSize < 2 || draws == 0 || frames == 0) {
+        std::cerr << "--grid must be >= 2, --draws and --frames must be positive" << std::endl;
+        return -1;
+    }
+
+    HeadlessContext context;
+    if (!context.create(3, 3)) {
+        std::cerr << "Failed to create headless context: " << context.lastError() << std::endl;
+        return -1;
+    }
+    if (!gladLoadGLLoader((GLADloadproc)HeadlessContext::getProcAddress)) {
+        std::cerr << "Failed to initialize GLAD" << std::endl;
+        return -1;
+    }
+
+    GpuTimer timer;
+    if (!timer.create() || !timer.isSupported()) {
+        std::cerr << "GL_TIME_ELAPSED queries are not supported" << std::endl;
+        return -1;
+    }
+
+    Framebuffer framebuffer;
+    if (!framebuffer.create(kTargetSize, kTargetSize)) {
+        std::cerr << "Failed to create framebuffer" << std::endl;
+        return -1;
+    }
+
+    std::vector<uint32_t> indices;
+    std::vector<BenchVertex> vertices = makeHeightField(gridSize, indices);
+    MeshOptimizer::optimizeMesh(vertices, indices);
+
+    VertexFormat halfFormat = VertexFormat::compact();
+    halfFormat.position = PositionFormat::Half16;
+    const FormatCase cases[] = {
+        { "float32", VertexFormat() },
+        { "half16", halfFormat },
+        { "compact", VertexFormat::compact() },
+    };
+
+    // 网格映射到裁剪空间 (z 很小，不会被深度裁剪)
+    const glm::mat4 viewTransform = glm::scale(glm::mat4(1.0f), glm::vec3(0.45f, 0.6f, 1.0f));
+
+    GLStateCache& state = GLStateCache::current();
+    std::vector<FormatResult> results;
+    std::vector<uint8_t> referencePixels;
+
+    for (const FormatCase& formatCase : cases) {
+        const bool octNormal = formatCase.format.normal == NormalFormat::Oct16;
+        const std::string header = std::string("#version 330 core\n") + (octNormal ? "#define OCT_NORMAL\n" : "");
+
+        Shader shader;
+        if (!shader.loadFromSource(header + kVertexShader, header + kFragmentShader)) {
+            std::cerr << "Failed to compile shader: " << shader.lastError() << std::endl;
+            return -1;
+        }
+
+        const VertexStream stream = buildStream(vertices, formatCase.format);
+
+        GLuint vao = 0;
+        GLuint vbo = 0;
+        glGenVertexArrays(1, &vao);
+        state.bindVertexArray(vao);
+        glGenBuffers(1, &vbo);
+        state.bindBuffer(GL_ARRAY_BUFFER, vbo);
+        glBufferData(GL_ARRAY_BUFFER, stream.data.size(), stream.data.data(), GL_STATIC_DRAW);
+        stream.applyAttributes();
+
+        IndexBuffer indexBuffer;
+        if (!indexBuffer.create(indices.data(), indices.size(), vertices.size())) {
+            std::cerr << "Failed to create index buffer" << std::endl;
+            return -1;
+        }
+
+        shader.use();
+        shader.setMat4("transform", viewTransform * stream.dequantize);
+        framebuffer.bind();
+        glViewport(0, 0, kTargetSize, kTargetSize);
+
+        auto drawFrame = [&](uint64_t count) {
+            glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            for (uint64_t i = 0; i < count; ++i) {
+                glDrawElements(GL_TRIANGLES, indexBuffer.count(), indexBuffer.type(), nullptr);
+            }
+        };
+
+        FormatResult result;
+        result.name = formatCase.name;
+        result.bytesPerVertex = stream.stride;
+        result.bufferMB = static_cast<double>(stream.data.size()) / (1024.0 * 1024.0);
+
+        // 正确性: 与 float32 的逐像素差值
+        drawFrame(1);
+        std::vector<uint8_t> pixels;
+        framebuffer.readPixels(pixels);
+        if (referencePixels.empty()) {
+            referencePixels = pixels;
+        } else {
+            for (size_t i = 0; i < pixels.size() && i < referencePixels.size(); ++i) {
+                result.maxPixelDiff = std::max(result.maxPixelDiff, std::abs(static_cast<int>(pixels[i]) - referencePixels[i]));
+            }
+        }
+
+        std::vector<double> gpuMs;
+        for (uint64_t frame = 0; frame < frames; ++frame) {
+            timer.begin(frame);
+            drawFrame(draws);
+            timer.end();
+            timer.collect([&](uint64_t, double ms) { gpuMs.push_back(ms); });
+        }
+        timer.drain([&](uint64_t, double ms) { gpuMs.push_back(ms); });
+
+        std::sort(gpuMs.begin(), gpuMs.end());
+        result.gpuMs = gpuMs.empty() ? 0.0 : gpuMs[gpuMs.size() / 2];
+        const double bytesPerFrame = static_cast<double>(stream.data.size()) * static_cast<double>(draws);
+        result.gigabytesPerSecond = result.gpuMs > 0.0 ? bytesPerFrame / (result.gpuMs * 1.0e6) : 0.0;
+        results.push_back(result);
+
+        framebuffer.unbind();
+        shader.unuse();
+        shader.release();
+        indexBuffer.release();
+        state.onVertexArrayDeleted(vao);
+        glDeleteVertexArrays(1, &vao);
+        state.onBufferDeleted(vbo);
+        glDeleteBuffers(1, &vbo);
+    }
+
+    std::ofstream file;
+    if (!outputPath.empty()) {
+        file.open(outputPath);
+        if (!file.is_open()) {
+            std::cerr << "Failed to open output file: " << outputPath << std::endl;
+            return -1;
+        }
+    }
+    std::ostream& out = outputPath.empty() ? std::cout : file;
+
+    out << "{\n";
+    out << "  \"vertices\": " << vertices.size() << ",\n";
+    out << "  \"triangles\": " << indices.size() / 3 << ",\n";
+    out << "  \"draws_per_frame\": " << draws << ",\n";
+    out << "  \"frames\": " << frames << ",\n";
+    out << "  \"formats\": {\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const FormatResult& r = results[i];
+        out << "    \"" << r.name << "\": { "
+            << "\"bytes_per_vertex\": " << r.bytesPerVertex << ", "
+            << "\"buffer_mb\": " << r.bufferMB << ", "
+            << "\"gpu_ms\": " << r.gpuMs << ", "
+            << "\"vertex_gb_per_s\": " << r.gigabytesPerSecond << ", "
+            << "\"max_pixel_diff\": " << r.maxPixelDiff << " }" << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    out << "  }\n";
+    out << "}\n";
+
+    timer.release();
+    framebuffer.release();
+    return 0;
+}
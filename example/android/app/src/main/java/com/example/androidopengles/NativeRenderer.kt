@@ -70,6 +70,30 @@ class NativeRenderer {
      */
     external fun nativeGetRendererName(): String
     
+    /**
+     * 设置程序二进制缓存目录
+     * 
+     * 必须在nativeInit之前调用。缓存命中时跳过shader编译，缩短冷启动时间；
+     * 驱动升级导致缓存失效时自动回退到源码编译并重建缓存。
+     * 
+     * @param path 缓存根目录，通常为 context.cacheDir.absolutePath
+     * 
+     * 对应C++函数：Java_com_example_androidopengles_NativeRenderer_nativeSetCacheDir
+     */
+    external fun nativeSetCacheDir(path: String)
+    
+    /**
+     * 设置本控件组合的渲染器
+     * 
+     * 在nativeInit之前调用，未调用时只渲染 "triangle"。
+     * 格式：pass 之间用 '/' 分隔、pass 内用 ',' 分隔，例如 "cube,triangle"。
+     * 
+     * @param spec 渲染器描述字符串
+     * 
+     * 对应C++函数：Java_com_example_androidopengles_NativeRenderer_nativeSetRenderers
+     */
+    external fun nativeSetRenderers(spec: String)
+    
     /**
      * companion object - Kotlin的静态成员区域
      * 
@@ -514,6 +514,9 @@ class OpenGLSurfaceView @JvmOverloads constructor(
                     if (surface != null && surface.isValid) {
                         Log.d(TAG, "在渲染线程中初始化EGL...")
                         
+                        // 先设置程序二进制缓存目录，初始化时加载shader会用到
+                        renderer.nativeSetCacheDir(context.cacheDir.absolutePath)
+                        
                         // 调用JNI方法初始化EGL
                         // if 也可以作为表达式（有返回值）
                         if (renderer.nativeInit(surface)) {
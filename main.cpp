@@ -3,22 +3,48 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <memory>
 #include <string>
 
 #include "render_factory.hpp"
+#include "render_pipeline.hpp"
 #include "render_context.hpp"
-
-// 根据编译宏选择配置类
-#ifdef USE_TRIANGLE_RENDER
-    #include "triangle_config.hpp"
-    using ActiveConfig = TriangleConfig;
-#elif USE_CUBE_RENDER
-    #include "cube_config.hpp"
-    using ActiveConfig = CubeConfig;
+#include "framebuffer.hpp"
+#include "frame_uniforms.hpp"
+#include "program_binary_cache.hpp"
+#include "shader.hpp"
+#include "shader_compile_worker.hpp"
+#include "gl_state_cache.hpp"
+#include "texture_manager.hpp"
+#include "job_system.hpp"
+#include "frame_allocator.hpp"
+#include "stream_buffer.hpp"
+#include "mesh_render.hpp"
+#include "cube_render.hpp"
+
+#ifdef ENABLE_HEADLESS
+    #include "platform/headless_context.hpp"
 #endif
 
+/**
+ * @brief 启动参数 - 由命令行解析得到
+ */
+struct LaunchOptions {
+    bool headless = false;        // 无窗口模式: EGL上下文 + FBO，无垂直同步节流
+    uint64_t maxFrames = 0;       // 渲染帧数上限 (0 = 窗口模式不限; 无窗口模式默认300帧)
+    std::string outputPath;       // 无窗口模式结束时将最后一帧保存为PPM (为空则不保存)
+    std::string shaderCacheDir;   // 程序二进制缓存目录 (为空则每次从源码编译)
+    std::string renderers = "cube"; // 渲染器组合 (RenderPipeline::addFromSpec 格式，如 "cube,triangle")
+    std::string meshPath;         // "mesh" 渲染器加载的 .meshbin (为空则使用 MeshConfig 默认路径)
+    std::string texturePath;      // "cube" 渲染器的贴图 (为空则使用纹理坐标渐变)
+    int jobWorkers = -1;          // 逐帧CPU任务的工作线程数 (-1 = 硬件线程数 - 1，0 = 全部在主线程执行)
+};
+
 /**
  * @brief Application类 - 封装整个OpenGL应用程序的生命周期
  * 
@@ -26,15 +52,20 @@
  */
 class Application {
 public:
-    Application(int width, int height, const std::string& title)
+    Application(int width, int height, const std::string& title, const LaunchOptions& options = LaunchOptions())
         : m_width(width)
         , m_height(height)
         , m_title(title)
+        , m_options(options)
         , m_window(nullptr)
+        , m_compileWindow(nullptr)
         , m_frameNumber(0)
         , m_frameCount(0)
         , m_lastTime(0.0)
     {
+        if (m_options.headless && m_options.maxFrames == 0) {
+            m_options.maxFrames = 300;
+        }
     }
 
     ~Application() {
@@ -49,14 +80,24 @@ public:
      * @brief 初始化应用程序
      */
     bool initialize() {
-        // 初始化GLFW
-        if (!initializeGLFW()) {
-            return false;
-        }
-
-        // 初始化GLAD
-        if (!initializeGLAD()) {
-            return false;
+        if (m_options.headless) {
+            // 无窗口: EGL上下文 + GLAD + 离屏FBO
+            if (!initializeHeadless()) {
+                return false;
+            }
+        } else {
+            // 初始化GLFW
+            if (!initializeGLFW()) {
+                return false;
+            }
+
+            // 初始化GLAD
+            if (!initializeGLAD()) {
+                return false;
+            }
+
+            // 异步着色器编译 (失败不影响启动，退回同步编译)
+            initializeCompileWorker();
         }
 
         // 打印OpenGL信息
@@ -65,11 +106,54 @@ public:
         // 初始化OpenGL状态
         initializeGLState();
 
+        // 帧全局UBO (所有渲染器共享同一绑定点)
+        if (!m_frameUniforms.create()) {
+            std::cerr << "Failed to create frame uniform buffer" << std::endl;
+            return false;
+        }
+
+        // 程序二进制缓存 (需要GL上下文判断驱动是否支持)
+        if (!m_options.shaderCacheDir.empty()) {
+            m_programCache.setDirectory(m_options.shaderCacheDir);
+            Shader::setProgramCache(&m_programCache);
+        }
+
+        // 纹理流式加载 (解码线程 + PBO上传)，须先于渲染器创建
+        if (!m_textures.create()) {
+            std::cerr << "Failed to create texture manager" << std::endl;
+            return false;
+        }
+        TextureManager::setActive(&m_textures);
+        std::cout << m_textures.compressedSupport().describe() << std::endl;
+
+        // 逐帧CPU任务 (实例收集等)，主线程是所有者线程
+        JobSystemSettings jobSettings;
+        jobSettings.workers = m_options.jobWorkers;
+        if (!m_jobs.create(jobSettings)) {
+            std::cerr << "Failed to create job system" << std::endl;
+            return false;
+        }
+        JobSystem::setActive(&m_jobs);
+
+        // 逐帧临时数据 (命令流块等) 的线性分配器
+        m_frameAllocator.create();
+        FrameAllocator::setActive(&m_frameAllocator);
+
+        // 逐帧动态数据 (实例、FrameBlock) 的流缓冲，失败时各自退回 glBufferData
+        if (m_streamBuffer.create()) {
+            StreamBuffer::setActive(&m_streamBuffer);
+            std::cout << "Stream buffer: " << StreamBuffer::modeName(m_streamBuffer.mode()) << std::endl;
+        }
+
         // 初始化渲染器
         if (!initializeRenderer()) {
             return false;
         }
 
+        if (Shader::programCache()) {
+            std::cout << m_programCache.statsString() << std::endl;
+        }
+
         // 初始化投影矩阵
         updateProjectionMatrix();
 
@@ -80,9 +164,9 @@ public:
      * @brief 运行主循环
      */
     void run() {
-        m_lastTime = glfwGetTime();
+        m_lastTime = currentTime();
 
-        while (!glfwWindowShouldClose(m_window)) {
+        while (!shouldClose()) {
             // 处理输入
             processInput();
 
@@ -92,30 +176,55 @@ public:
             // 渲染
             render();
 
-            // 交换缓冲区
-            glfwSwapBuffers(m_window);
-            glfwPollEvents();
+            // 交换缓冲区 (无窗口模式直接渲染到FBO，无需交换)
+            if (m_window) {
+                glfwSwapBuffers(m_window);
+                glfwPollEvents();
+            }
 
             // 更新FPS
             updateFPS();
         }
+
+        if (m_options.headless) {
+            finishHeadless();
+        }
     }
 
     /**
      * @brief 关闭应用程序
      */
     void shutdown() {
-        if (m_renderer) {
-            m_renderer->cleanup();
-            m_renderer.reset();
+        m_pipeline.cleanup();
+
+        JobSystem::setActive(nullptr);
+        m_jobs.release();
+        FrameAllocator::setActive(nullptr);
+        m_frameAllocator.release();
+        StreamBuffer::setActive(nullptr);
+        m_streamBuffer.release();
+        TextureManager::setActive(nullptr);
+        m_textures.release();
+        m_frameUniforms.release();
+        m_framebuffer.release();
+        Shader::setProgramCache(nullptr);
+
+        Shader::setCompileWorker(nullptr);
+        m_compileWorker.stop();
+        if (m_compileWindow) {
+            glfwDestroyWindow(m_compileWindow);
+            m_compileWindow = nullptr;
         }
 
         if (m_window) {
             glfwDestroyWindow(m_window);
             m_window = nullptr;
+            glfwTerminate();
         }
 
-        glfwTerminate();
+#ifdef ENABLE_HEADLESS
+        m_headlessContext.destroy();
+#endif
     }
 
 private:
@@ -168,6 +277,76 @@ private:
         return true;
     }
 
+    /**
+     * 驱动支持 GL_KHR_parallel_shader_compile 时由驱动并行编译，不需要工作线程；
+     * 否则创建一个与主窗口共享对象的隐藏窗口，在工作线程中编译链接
+     */
+    void initializeCompileWorker() {
+        if (hasParallelShaderCompile()) {
+            std::cout << "Shader compile: GL_KHR_parallel_shader_compile" << std::endl;
+            return;
+        }
+
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        m_compileWindow = glfwCreateWindow(1, 1, "", nullptr, m_window);
+        glfwDefaultWindowHints();
+        if (!m_compileWindow) {
+            std::cerr << "Failed to create shader compile context, compiling synchronously" << std::endl;
+            return;
+        }
+
+        GLFWwindow* compileWindow = m_compileWindow;
+        bool started = m_compileWorker.start(
+            [compileWindow]() { glfwMakeContextCurrent(compileWindow); return glfwGetCurrentContext() == compileWindow; },
+            []() { glfwMakeContextCurrent(nullptr); });
+        if (!started) {
+            glfwDestroyWindow(m_compileWindow);
+            m_compileWindow = nullptr;
+            return;
+        }
+
+        Shader::setCompileWorker(&m_compileWorker);
+        std::cout << "Shader compile: shared-context worker thread" << std::endl;
+    }
+
+    bool initializeHeadless() {
+#ifdef ENABLE_HEADLESS
+        if (!m_headlessContext.create(3, 3)) {
+            std::cerr << "Failed to create headless context: " << m_headlessContext.lastError() << std::endl;
+            return false;
+        }
+
+        if (!gladLoadGLLoader((GLADloadproc)HeadlessContext::getProcAddress)) {
+            std::cerr << "Failed to initialize GLAD" << std::endl;
+            return false;
+        }
+
+        // 渲染器只看到一个普通的绘制目标，IRenderer/RenderContext 契约不变
+        if (!m_framebuffer.create(m_width, m_height)) {
+            std::cerr << "Failed to create framebuffer: " << m_framebuffer.lastError() << std::endl;
+            return false;
+        }
+        m_framebuffer.bind();
+        return true;
+#else
+        std::cerr << "Headless mode not available: rebuild with -DENABLE_HEADLESS=ON" << std::endl;
+        return false;
+#endif
+    }
+
+    void finishHeadless() {
+        glFinish();
+        std::cout << "Rendered " << m_frameNumber << " frames headless" << std::endl;
+
+        if (!m_options.outputPath.empty()) {
+            if (m_framebuffer.savePPM(m_options.outputPath)) {
+                std::cout << "Saved last frame to " << m_options.outputPath << std::endl;
+            } else {
+                std::cerr << "Failed to save frame to " << m_options.outputPath << std::endl;
+            }
+        }
+    }
+
     void printGLInfo() {
         std::cout << "========================================" << std::endl;
         std::cout << "OpenGL Vendor:   " << glGetString(GL_VENDOR) << std::endl;
@@ -178,38 +357,61 @@ private:
     }
 
     void initializeGLState() {
-        glEnable(GL_DEPTH_TEST);
-        glDepthFunc(GL_LESS);
+        // 新上下文: 丢弃状态缓存中可能残留的记录
+        GLStateCache& state = GLStateCache::current();
+        state.invalidate();
+        state.enable(GL_DEPTH_TEST);
+        state.depthFunc(GL_LESS);
     }
 
-    // 对 m_renderer 进行创建和配置
+    // 按启动参数组合渲染器 (名称在 RenderFactory 注册表中查找，使用各自的默认配置)
     bool initializeRenderer() {
-        // 根据编译宏选择渲染器
-        #ifdef USE_TRIANGLE_RENDER
-            m_renderer = RenderFactory::create("triangle");
-        #elif USE_CUBE_RENDER
-            m_renderer = RenderFactory::create("cube");
-        #endif
-
-        if (!m_renderer) {
-            std::cerr << "Failed to create renderer" << std::endl;
-            return false;
-        }
-
-        // 设置错误回调
-        m_renderer->setErrorCallback([](RenderError error, const std::string& msg) {
+        // 设置错误回调 (对之后加入的渲染器生效)
+        m_pipeline.setErrorCallback([](RenderError error, const std::string& msg) {
             std::cerr << "Render Error [" << static_cast<int>(error) << "]: " << msg << std::endl;
         });
 
-        // 创建配置并初始化 (使用编译期选择的配置类)
-        ActiveConfig config;
-        if (!m_renderer->initialize(config)) {
-            std::cerr << "Failed to initialize renderer" << std::endl;
+        // --mesh: 用指定资源路径覆盖 "mesh" 的默认配置
+        if (!m_options.meshPath.empty()) {
+            const std::string meshPath = m_options.meshPath;
+            RenderFactory::registerRenderer({
+                "mesh",
+                []() -> std::unique_ptr<IRenderer> { return std::make_unique<MeshRender>(); },
+                [meshPath]() -> std::unique_ptr<IRenderConfig> {
+                    auto config = std::make_unique<MeshConfig>();
+                    config->setAssetPath(meshPath);
+                    return config;
+                },
+            });
+        }
+
+        // --texture: 用指定贴图覆盖 "cube" 的默认配置
+        if (!m_options.texturePath.empty()) {
+            const std::string texturePath = m_options.texturePath;
+            RenderFactory::registerRenderer({
+                "cube",
+                []() -> std::unique_ptr<IRenderer> { return std::make_unique<CubeRender>(); },
+                [texturePath]() -> std::unique_ptr<IRenderConfig> {
+                    auto config = std::make_unique<CubeConfig>();
+                    config->setTexturePath(texturePath);
+                    return config;
+                },
+            });
+        }
+
+        if (!m_pipeline.addFromSpec(m_options.renderers)) {
+            std::cerr << "Failed to create renderers: " << m_pipeline.lastError() << std::endl;
+            std::cerr << "Available:";
+            for (const std::string& name : RenderFactory::registeredNames()) {
+                std::cerr << " " << name;
+            }
+            std::cerr << std::endl;
             return false;
         }
+        std::cout << "Renderers: " << m_pipeline.getName() << std::endl;
 
         // 初始化视口
-        m_renderer->resize(m_width, m_height);
+        m_pipeline.resize(m_width, m_height);
 
         return true;
     }
@@ -234,9 +436,7 @@ private:
         m_width = width;
         m_height = height;
 
-        if (m_renderer) {
-            m_renderer->resize(width, height);
-        }
+        m_pipeline.resize(width, height);
 
         updateProjectionMatrix();
     }
@@ -252,6 +452,18 @@ private:
 
     // ============ 主循环方法 ============
 
+    bool shouldClose() const {
+        if (m_options.maxFrames != 0 && m_frameNumber >= m_options.maxFrames) {
+            return true;
+        }
+        return m_window ? glfwWindowShouldClose(m_window) : false;
+    }
+
+    static double currentTime() {
+        using Clock = std::chrono::steady_clock;
+        return std::chrono::duration<double>(Clock::now().time_since_epoch()).count();
+    }
+
     void processInput() {
         // 额外的输入处理可以在这里添加
     }
@@ -261,15 +473,23 @@ private:
     }
 
     void render() {
-        if (!m_renderer) return;
+        if (m_pipeline.empty()) return;
 
         // 创建渲染上下文
         ViewportSize viewportSize(m_width, m_height);
         RenderContext context(viewportSize, m_projectionMatrix, 0.016f);
         context = context.withFrameNumber(m_frameNumber++);
+        m_frameAllocator.beginFrame(context);
+        m_streamBuffer.beginFrame();
 
-        // 执行渲染
-        m_renderer->render(context);
+        // 帧全局数据每帧只写一次
+        m_frameUniforms.update(context);
+
+        // 在预算内推进纹理上传 (就绪的纹理本帧即可使用)
+        m_textures.update();
+
+        // 执行渲染 (所有 pass 的命令排序后提交)
+        m_pipeline.render(context);
     }
 
     void updateProjectionMatrix() {
@@ -281,12 +501,12 @@ private:
 
     void updateFPS() {
         m_frameCount++;
-        double currentTime = glfwGetTime();
+        double now = currentTime();
 
-        if (currentTime - m_lastTime >= 1.0) {
+        if (now - m_lastTime >= 1.0) {
             std::cout << "FPS: " << m_frameCount << std::endl;
             m_frameCount = 0;
-            m_lastTime = currentTime;
+            m_lastTime = now;
         }
     }
 
@@ -295,10 +515,25 @@ private:
     int m_width;
     int m_height;
     std::string m_title;
+    LaunchOptions m_options;
     GLFWwindow* m_window;
+    GLFWwindow* m_compileWindow;        // 编译工作线程的共享上下文 (隐藏窗口)
+    ShaderCompileWorker m_compileWorker;
+
+    // 无窗口模式
+    Framebuffer m_framebuffer;
+#ifdef ENABLE_HEADLESS
+    HeadlessContext m_headlessContext;
+#endif
 
     // 渲染相关
-    std::unique_ptr<IRenderer> m_renderer;
+    RenderPipeline m_pipeline;
+    FrameUniformBuffer m_frameUniforms;
+    ProgramBinaryCache m_programCache;
+    TextureManager m_textures;
+    JobSystem m_jobs;
+    FrameAllocator m_frameAllocator;
+    StreamBuffer m_streamBuffer;
     glm::mat4 m_projectionMatrix;
 
     // 帧计数
@@ -309,8 +544,50 @@ private:
 
 // ============ 主函数 ============
 
-int main() {
-    Application app(800, 600, "OpenGL Triangle");
+/**
+ * 用法: main_opengl [--headless] [--frames N] [--size WxH] [--output frame.ppm] [--shader-cache DIR]
+ *                   [--renderers SPEC] [--mesh model.meshbin] [--texture image.png] [--jobs N]
+ *
+ *   --renderers SPEC  渲染器组合，pass 之间用 '/' 分隔、pass 内用 ',' 分隔 (默认 "cube")
+ *                     例: "cube,triangle" 或 "cube/triangle"
+ *   --mesh PATH       "mesh" 渲染器加载的资源文件 (由 tools/mesh_import 生成)
+ *   --texture PATH    "cube" 渲染器的贴图 (PNG/JPG/TGA/...，后台解码、分帧上传)
+ *   --jobs N          任务系统的工作线程数 (默认硬件线程数 - 1，0 = 只用主线程)
+ */
+int main(int argc, char** argv) {
+    LaunchOptions options;
+    int width = 800;
+    int height = 600;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--headless") == 0) {
+            options.headless = true;
+        } else if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            options.maxFrames = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--size") == 0 && i + 1 < argc) {
+            if (std::sscanf(argv[++i], "%dx%d", &width, &height) != 2 || width <= 0 || height <= 0) {
+                std::cerr << "Invalid --size, expected WxH" << std::endl;
+                return -1;
+            }
+        } else if (std::strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+            options.outputPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--shader-cache") == 0 && i + 1 < argc) {
+            options.shaderCacheDir = argv[++i];
+        } else if (std::strcmp(argv[i], "--renderers") == 0 && i + 1 < argc) {
+            options.renderers = argv[++i];
+        } else if (std::strcmp(argv[i], "--mesh") == 0 && i + 1 < argc) {
+            options.meshPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--texture") == 0 && i + 1 < argc) {
+            options.texturePath = argv[++i];
+        } else if (std::strcmp(argv[i], "--jobs") == 0 && i + 1 < argc) {
+            options.jobWorkers = std::atoi(argv[++i]);
+        } else {
+            std::cerr << "Unknown argument: " << argv[i] << std::endl;
+            return -1;
+        }
+    }
+
+    Application app(width, height, "OpenGL Triangle", options);
 
     if (!app.initialize()) {
         std::cerr << "Application initialization failed!" << std::endl;
@@ -57,12 +57,21 @@
 #include <EGL/egl.h>     // EGL API - OpenGL ES与窗口系统的桥梁
 #include <GLES3/gl3.h>   // OpenGL ES 3.0 API
 
+#include <cstring>
 #include <memory>
 #include <string>
 
-#include "render_factory.hpp"   // 渲染器工厂
-#include "render_config.hpp"    // 渲染配置
+#include "render_factory.hpp"   // 渲染器注册表
+#include "render_pipeline.hpp"  // 多渲染器组合（有序pass）
 #include "render_context.hpp"   // 渲染上下文
+#include "frame_uniforms.hpp"   // 帧全局UBO
+#include "program_binary_cache.hpp" // 程序二进制磁盘缓存
+#include "shader.hpp"
+#include "gl_state_cache.hpp"     // GL状态缓存
+#include "texture_manager.hpp"    // 纹理异步解码 + PBO分帧上传
+#include "job_system.hpp"         // 逐帧CPU任务的工作窃取线程池
+#include "frame_allocator.hpp"    // 逐帧临时数据的线性分配器
+#include "stream_buffer.hpp"      // 逐帧动态顶点/UBO数据的环形流缓冲
 
 // Android日志宏定义
 #define LOG_TAG "NativeRenderer"
@@ -91,13 +100,21 @@ namespace {
     EGLSurface g_surface = EGL_NO_SURFACE;  // EGL绘图表面（关联到Android Surface）
     EGLContext g_context = EGL_NO_CONTEXT;  // OpenGL ES渲染上下文（存储OpenGL状态）
     ANativeWindow* g_window = nullptr;       // Android原生窗口（从Java Surface获取）
+    EGLContext g_compileContext = EGL_NO_CONTEXT;   // 着色器编译线程的共享上下文（无Surface）
+    ShaderCompileWorker g_compileWorker;             // 驱动不支持并行编译时使用
     
     // ------------------------------------------------------------
     // 渲染器资源
     // ------------------------------------------------------------
-    std::unique_ptr<IRenderer> g_renderer;   // 渲染器实例（如TriangleRender）
-    RenderConfig g_config;                   // 渲染配置（shader、顶点数据等）
+    RenderPipeline g_pipeline;               // 本控件组合的渲染器（如TriangleRender），按pass顺序绘制
+    std::string g_rendererSpec = "triangle"; // 渲染器描述（由nativeSetRenderers设置，如 "cube,triangle"）
     glm::mat4 g_projectionMatrix(1.0f);      // 投影矩阵（透视或正交）
+    FrameUniformBuffer g_frameUniforms;      // 帧全局UBO（投影矩阵等，每帧写一次）
+    ProgramBinaryCache g_programCache;       // 程序二进制缓存（目录由nativeSetCacheDir设置，冷启动跳过shader编译）
+    TextureManager g_textures;               // 纹理流式加载（解码线程 + PBO环，每帧在预算内上传）
+    JobSystem g_jobs;                        // 逐帧CPU任务（实例收集等），GL线程是所有者线程
+    FrameAllocator g_frameAllocator;         // 逐帧临时数据（命令流块等），按帧号轮换竞技场
+    StreamBuffer g_streamBuffer;             // 逐帧动态数据（实例、FrameBlock），GLES 3.0 走非同步映射 + 孤立
     
     // ------------------------------------------------------------
     // 视口状态
@@ -253,6 +270,60 @@ static bool initEGL(ANativeWindow* window) {
     return true;
 }
 
+/**
+ * @brief 启动异步着色器编译
+ * 
+ * 驱动支持 GL_KHR_parallel_shader_compile 时直接由驱动并行编译；
+ * 否则创建与主上下文共享对象的无Surface上下文（需要 EGL_KHR_surfaceless_context），
+ * 在工作线程中编译。两者都不可用时 Shader 退回同步编译。
+ */
+static void initCompileWorker() {
+    if (hasParallelShaderCompile()) {
+        LOGI("Shader compile: GL_KHR_parallel_shader_compile");
+        return;
+    }
+
+    const char* extensions = eglQueryString(g_display, EGL_EXTENSIONS);
+    if (!extensions || !std::strstr(extensions, "EGL_KHR_surfaceless_context")) {
+        LOGI("Shader compile: synchronous (no surfaceless context)");
+        return;
+    }
+
+    EGLConfig config;
+    EGLint numConfigs = 0;
+    const EGLint configAttribs[] = {
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_ES3_BIT,
+        EGL_NONE
+    };
+    const EGLint contextAttribs[] = {
+        EGL_CONTEXT_CLIENT_VERSION, 3,
+        EGL_NONE
+    };
+    if (!eglChooseConfig(g_display, configAttribs, &config, 1, &numConfigs) || numConfigs == 0) {
+        return;
+    }
+
+    g_compileContext = eglCreateContext(g_display, config, g_context, contextAttribs);
+    if (g_compileContext == EGL_NO_CONTEXT) {
+        LOGE("Failed to create shader compile context");
+        return;
+    }
+
+    EGLDisplay display = g_display;
+    EGLContext context = g_compileContext;
+    bool started = g_compileWorker.start(
+        [display, context]() { return eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context) == EGL_TRUE; },
+        [display]() { eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT); eglReleaseThread(); });
+    if (!started) {
+        eglDestroyContext(g_display, g_compileContext);
+        g_compileContext = EGL_NO_CONTEXT;
+        return;
+    }
+
+    Shader::setCompileWorker(&g_compileWorker);
+    LOGI("Shader compile: shared-context worker thread");
+}
+
 /**
  * @brief 清理EGL资源
  * 
@@ -267,7 +338,16 @@ static bool initEGL(ANativeWindow* window) {
  * @note 必须在创建EGL的同一线程中调用
  */
 static void terminateEGL() {
+    // 编译线程持有共享上下文，必须先于主上下文停止
+    Shader::setCompileWorker(nullptr);
+    g_compileWorker.stop();
+
     if (g_display != EGL_NO_DISPLAY) {
+        if (g_compileContext != EGL_NO_CONTEXT) {
+            eglDestroyContext(g_display, g_compileContext);
+            g_compileContext = EGL_NO_CONTEXT;
+        }
+
         // 步骤1: 解绑当前上下文
         // 将空值绑定到当前线程，释放OpenGL资源的独占权
         eglMakeCurrent(g_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
@@ -313,54 +393,70 @@ static void terminateEGL() {
  */
 static bool initRenderer() {
     // ------------------------------------------------------------------------
-    // 步骤1: 创建渲染器实例
-    // ------------------------------------------------------------------------
-    // 使用工厂模式，方便切换不同的渲染器
-    // "triangle" -> TriangleRender
-    // "cube"     -> CubeRender (如果实现了)
-    g_renderer = RenderFactory::create("triangle");
-    if (!g_renderer) {
-        LOGE("Failed to create renderer");
-        return false;
-    }
-    
-    // ------------------------------------------------------------------------
-    // 步骤2: 设置错误回调
+    // 步骤1: 设置错误回调
     // ------------------------------------------------------------------------
     // 使用Lambda表达式，将渲染器的错误信息输出到Android日志
-    // 这样在Logcat中可以看到详细的错误信息
-    g_renderer->setErrorCallback([](RenderError error, const std::string& msg) {
+    // 这样在Logcat中可以看到详细的错误信息（对之后加入的所有渲染器生效）
+    g_pipeline.setErrorCallback([](RenderError error, const std::string& msg) {
         LOGE("Render Error [%d]: %s", static_cast<int>(error), msg.c_str());
     });
     
-    // ------------------------------------------------------------------------
-    // 步骤3: 创建渲染配置
-    // ------------------------------------------------------------------------
-    // RenderConfig包含：
-    // - Shader源码（编译时嵌入的头文件）
-    // - 顶点数据（位置、颜色等）
-    // - 清屏颜色
-    // - 旋转速度等参数
-    g_config = RenderConfig::createTriangleConfig();
+    // Surface重建后是新的上下文，同一线程上的状态缓存已失效
+    GLStateCache::current().invalidate();
+    
+    // 着色器异步编译: 渲染器在编译完成前绘制占位内容
+    initCompileWorker();
+    
+    // 帧全局UBO必须在渲染器之前创建，渲染器初始化时会把FrameBlock绑定到同一绑定点
+    if (!g_frameUniforms.create()) {
+        LOGE("Failed to create frame uniform buffer");
+        return false;
+    }
+    
+    // 纹理管理器同样必须先于渲染器创建，渲染器初始化时发起加载请求
+    if (!g_textures.create()) {
+        LOGE("Failed to create texture manager");
+        return false;
+    }
+    TextureManager::setActive(&g_textures);
+    LOGI("%s", g_textures.compressedSupport().describe().c_str());
+    
+    // 任务系统在GL线程创建，渲染器在GL线程上分发并等待任务
+    if (!g_jobs.create()) {
+        LOGE("Failed to create job system");
+        return false;
+    }
+    JobSystem::setActive(&g_jobs);
+    g_frameAllocator.create();
+    FrameAllocator::setActive(&g_frameAllocator);
+    if (g_streamBuffer.create()) {
+        StreamBuffer::setActive(&g_streamBuffer);
+    }
     
     // ------------------------------------------------------------------------
-    // 步骤4: 初始化渲染器
+    // 步骤2: 创建并初始化渲染器
     // ------------------------------------------------------------------------
-    // 这会执行：
-    // - 编译和链接shader程序
+    // 按名称从注册表创建，使用各自的默认配置：
+    // "triangle" -> TriangleRender + TriangleConfig
+    // "cube"     -> CubeRender + CubeConfig
+    // 初始化会执行：
+    // - 编译和链接shader程序（缓存命中时直接加载程序二进制）
     // - 创建VAO/VBO
     // - 上传顶点数据到GPU
-    if (!g_renderer->initialize(g_config)) {
-        LOGE("Failed to initialize renderer");
+    Shader::setProgramCache(&g_programCache);
+    if (!g_pipeline.addFromSpec(g_rendererSpec)) {
+        LOGE("Failed to initialize renderers: %s", g_pipeline.lastError().c_str());
         return false;
     }
+    LOGI("Renderers: %s", g_pipeline.getName().c_str());
+    LOGI("%s", g_programCache.statsString().c_str());
     
     // ------------------------------------------------------------------------
-    // 步骤5: 设置视口和投影矩阵
+    // 步骤3: 设置视口和投影矩阵
     // ------------------------------------------------------------------------
     // 视口(Viewport)：定义OpenGL渲染区域的像素坐标
     // 投影矩阵：将3D场景投影到2D屏幕
-    g_renderer->resize(g_width, g_height);
+    g_pipeline.resize(g_width, g_height);
     
     // 计算宽高比，避免图像变形
     // aspect = 宽/高，例如 1920/1080 = 1.78 (16:9)
@@ -389,10 +485,16 @@ static bool initRenderer() {
  * @note 必须在OpenGL上下文有效时调用
  */
 static void cleanupRenderer() {
-    if (g_renderer) {
-        g_renderer->cleanup();  // 释放OpenGL资源
-        g_renderer.reset();      // 释放C++对象
-    }
+    g_pipeline.cleanup();       // 释放所有渲染器的OpenGL资源和C++对象
+    JobSystem::setActive(nullptr);
+    g_jobs.release();           // 停止工作线程
+    FrameAllocator::setActive(nullptr);
+    g_frameAllocator.release();
+    StreamBuffer::setActive(nullptr);
+    g_streamBuffer.release();   // 删除缓冲与 fence
+    TextureManager::setActive(nullptr);
+    g_textures.release();       // 停止解码线程，删除纹理和PBO
+    g_frameUniforms.release();
 }
 
 // ============================================================================
@@ -413,6 +515,44 @@ static void cleanupRenderer() {
 
 extern "C" {
 
+/**
+ * @brief 设置程序二进制缓存目录
+ *
+ * Kotlin调用示例：
+ *   renderer.nativeSetCacheDir(context.cacheDir.absolutePath)
+ *
+ * 时机：在nativeInit之前调用；未调用时每次启动都从GLSL源码编译
+ *
+ * @param path 应用缓存目录，缓存文件放在其下的 shader_cache 子目录
+ */
+JNIEXPORT void JNICALL
+Java_com_example_androidopengles_NativeRenderer_nativeSetCacheDir(JNIEnv* env, jobject thiz, jstring path) {
+    const char* chars = env->GetStringUTFChars(path, nullptr);
+    std::string directory = std::string(chars) + "/shader_cache";
+    env->ReleaseStringUTFChars(path, chars);
+
+    g_programCache.setDirectory(directory);
+    LOGI("Program binary cache: %s", g_programCache.directory().c_str());
+}
+
+/**
+ * @brief 设置本控件组合的渲染器
+ *
+ * Kotlin调用示例：
+ *   renderer.nativeSetRenderers("cube,triangle")
+ *
+ * 时机：在nativeInit之前调用；未调用时只渲染 "triangle"
+ *
+ * @param spec pass之间用 '/' 分隔、pass内用 ',' 分隔（见 RenderPipeline::addFromSpec）
+ */
+JNIEXPORT void JNICALL
+Java_com_example_androidopengles_NativeRenderer_nativeSetRenderers(JNIEnv* env, jobject thiz, jstring spec) {
+    const char* chars = env->GetStringUTFChars(spec, nullptr);
+    g_rendererSpec = chars;
+    env->ReleaseStringUTFChars(spec, chars);
+    LOGI("Renderer spec: %s", g_rendererSpec.c_str());
+}
+
 /**
  * @brief 初始化OpenGL渲染环境
  * 
@@ -491,6 +631,8 @@ Java_com_example_androidopengles_NativeRenderer_nativeInit(JNIEnv* env, jobject
     // 此时OpenGL上下文已经可用，所有OpenGL调用都是有效的
     if (!initRenderer()) {
         LOGE("Failed to initialize renderer");
+        // 已创建的全局对象 (pipeline、纹理管理器、任务系统等) 不会在下次初始化时替换，必须在上下文销毁前释放
+        cleanupRenderer();
         terminateEGL();
         ANativeWindow_release(g_window);
         g_window = nullptr;
@@ -531,7 +673,7 @@ Java_com_example_androidopengles_NativeRenderer_nativeRender(JNIEnv* env, jobjec
     // ------------------------------------------------------------------------
     // 安全检查：确保已初始化
     // ------------------------------------------------------------------------
-    if (!g_initialized || !g_renderer) {
+    if (!g_initialized || g_pipeline.empty()) {
         return;  // 静默返回，避免日志刷屏
     }
     
@@ -546,17 +688,24 @@ Java_com_example_androidopengles_NativeRenderer_nativeRender(JNIEnv* env, jobjec
     ViewportSize viewportSize(g_width, g_height);
     RenderContext context(viewportSize, g_projectionMatrix, 0.016f); // 0.016f ≈ 1/60秒
     context = context.withFrameNumber(g_frameNumber++);
+    g_frameAllocator.beginFrame(context);   // 回收 frames 帧之前的逐帧分配
+    g_streamBuffer.beginFrame();            // 给上一帧的区域插入 fence，切换到下一个区域
+    
+    // 帧全局数据（投影矩阵等）写入UBO，所有渲染器共享
+    g_frameUniforms.update(context);
+    
+    // 收集解码完成的图片并在每帧预算内经PBO上传
+    g_textures.update();
     
     // ------------------------------------------------------------------------
     // 步骤2: 执行渲染
     // ------------------------------------------------------------------------
-    // 这会调用TriangleRender::render()，执行：
-    // 1. glClear() - 清屏
-    // 2. 计算模型矩阵（旋转、平移等）
-    // 3. shader.use() - 激活shader程序
-    // 4. 设置uniform变量（MVP矩阵等）
-    // 5. glDrawArrays() - 绘制三角形
-    g_renderer->render(context);
+    // RenderPipeline::render() 执行：
+    // 1. glClear() - 清屏（整帧一次）
+    // 2. 每个pass中各渲染器record()：计算模型矩阵（旋转、平移等），追加绘制命令
+    // 3. 按排序键排序，相同shader程序/VAO的命令相邻
+    // 4. 提交：useProgram、设置uniform变量、glDrawArrays()
+    g_pipeline.render(context);
     
     // ------------------------------------------------------------------------
     // 步骤3: 交换缓冲区
@@ -607,11 +756,11 @@ Java_com_example_androidopengles_NativeRenderer_nativeResize(JNIEnv* env, jobjec
     // ------------------------------------------------------------------------
     // 步骤2: 更新渲染器
     // ------------------------------------------------------------------------
-    if (g_renderer && g_initialized) {
+    if (!g_pipeline.empty() && g_initialized) {
         // 更新OpenGL视口
         // glViewport(0, 0, width, height) 告诉OpenGL：
         // "你可以在这个矩形区域内绘制，坐标从(0,0)到(width,height)"
-        g_renderer->resize(width, height);
+        g_pipeline.resize(width, height);
         
         // 重新计算投影矩阵
         // 宽高比改变会影响图像的缩放比例
@@ -714,10 +863,11 @@ Java_com_example_androidopengles_NativeRenderer_nativeCleanup(JNIEnv* env, jobje
  */
 JNIEXPORT jstring JNICALL
 Java_com_example_androidopengles_NativeRenderer_nativeGetRendererName(JNIEnv* env, jobject thiz) {
-    if (g_renderer) {
+    if (!g_pipeline.empty()) {
         // C++ string -> Java String
         // env->NewStringUTF() 创建一个新的Java字符串对象
-        return env->NewStringUTF(g_renderer->getName().c_str());
+        // 多个渲染器时格式与nativeSetRenderers相同，如 "CubeRender,TriangleRender"
+        return env->NewStringUTF(g_pipeline.getName().c_str());
     }
     return env->NewStringUTF("No Renderer");
 }
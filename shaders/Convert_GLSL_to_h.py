@@ -108,7 +108,11 @@ def convert_version_for_android(content):
     
     # 在版本声明后添加精度声明（OpenGL ES必需）
     content = re.sub(r'(#version\s+310\s+es\s*\n)', r'\1\nprecision highp float;\n', content)
-    
+
+    # 数组纹理采样器在 GLSL ES 中没有默认精度
+    if 'sampler2DArray' in content:
+        content = content.replace('precision highp float;\n', 'precision highp float;\nprecision highp sampler2DArray;\n', 1)
+
     return content
 
 def convert_version_for_pc(content):
@@ -0,0 +1,13 @@
+#version 330 core
+
+in vec3 fragNormal;
+in vec4 fragColor;
+out vec4 finalColor;
+
+void main()
+{
+    // 与 mesh.frag 相同的固定方向光 + 环境光
+    vec3 lightDirection = normalize(vec3(0.4, 0.7, 0.6));
+    float diffuse = max(dot(normalize(fragNormal), lightDirection), 0.0);
+    finalColor = vec4(fragColor.rgb * (0.25 + 0.75 * diffuse), 1.0);
+}
@@ -0,0 +1,6 @@
+#pragma once
+
+// Auto-generated from batch.vert.glsl
+// Do not edit this file manually
+
+const char* const BATCH_VERTEX_SHADER = "#version 310 es\n\nprecision highp float;\n#ifdef BATCH_DRAW_ID\n#extension GL_ARB_shader_draw_parameters : require\n#endif\n\nlayout(location = 0) in vec3 position;\nlayout(location = 1) in vec3 normal;\nlayout(location = 2) in vec2 texcoord;\nlayout(location = 3) in vec4 color;\n\nlayout(location = 4) in mat4 instanceModel;\nlayout(location = 8) in vec4 instanceColor;\n\nout vec3 fragNormal;\nout vec4 fragColor;\n\nlayout(std140) uniform FrameBlock\n{\n    mat4 projection;\n    mat4 view;\n    mat4 viewProjection;\n    vec4 viewport;\n    vec4 timing;\n} frame;\n\n#ifdef BATCH_DRAW_ID\n\nlayout(std140) uniform DrawBlock\n{\n    mat4 dequantize[256];\n} draws;\n#endif\n\nuniform int octNormals;\n\nvec3 octDecode(vec2 e)\n{\n    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));\n    if (n.z < 0.0) {\n        n.xy = (1.0 - abs(n.yx)) * vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);\n    }\n    return n;\n}\n\nvoid main()\n{\n#ifdef BATCH_DRAW_ID\n    mat4 model = instanceModel * draws.dequantize[gl_DrawIDARB];\n#else\n    mat4 model = instanceModel;\n#endif\n    vec3 n = octNormals != 0 ? octDecode(normal.xy) : normal;\n\n    mat3 m = mat3(model);\n    mat3 cofactor = mat3(cross(m[1], m[2]), cross(m[2], m[0]), cross(m[0], m[1]));\n    fragNormal = normalize(cofactor * n);\n\n    fragColor = color * instanceColor;\n    gl_Position = frame.viewProjection * model * vec4(position, 1.0);\n}";
@@ -0,0 +1,65 @@
+#version 330 core
+#ifdef BATCH_DRAW_ID
+#extension GL_ARB_shader_draw_parameters : require
+#endif
+
+// 网格池共享的逐顶点属性 (与 MeshImporter 写出的 location 对应)
+layout(location = 0) in vec3 position;
+layout(location = 1) in vec3 normal;        // 八面体编码时只有 xy 有效 (z 默认为 0)
+layout(location = 2) in vec2 texcoord;
+layout(location = 3) in vec4 color;
+
+// 逐实例属性 (glVertexAttribDivisor = 1)，按网格分组，间接绘制的 baseInstance 指向组的起点
+// mat4 占用 location 4~7 四个槽位
+layout(location = 4) in mat4 instanceModel;
+layout(location = 8) in vec4 instanceColor;
+
+out vec3 fragNormal;
+out vec4 fragColor;
+
+// 帧全局数据: 每帧由帧循环写入一次，绑定到 UniformBinding::Frame
+layout(std140) uniform FrameBlock
+{
+    mat4 projection;
+    mat4 view;
+    mat4 viewProjection;
+    vec4 viewport;
+    vec4 timing;
+} frame;
+
+#ifdef BATCH_DRAW_ID
+// 逐网格数据: 第 i 条间接命令绘制网格 i，gl_DrawIDARB 即网格编号
+layout(std140) uniform DrawBlock
+{
+    mat4 dequantize[256];
+} draws;
+#endif
+
+uniform int octNormals;
+
+vec3 octDecode(vec2 e)
+{
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    if (n.z < 0.0) {
+        n.xy = (1.0 - abs(n.yx)) * vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+    }
+    return n;
+}
+
+void main()
+{
+#ifdef BATCH_DRAW_ID
+    mat4 model = instanceModel * draws.dequantize[gl_DrawIDARB];
+#else
+    mat4 model = instanceModel;             // 反量化矩阵已在CPU上右乘
+#endif
+    vec3 n = octNormals != 0 ? octDecode(normal.xy) : normal;
+
+    // 法线变换用余子式矩阵 (与逆转置只差一个标量倍数)
+    mat3 m = mat3(model);
+    mat3 cofactor = mat3(cross(m[1], m[2]), cross(m[2], m[0]), cross(m[0], m[1]));
+    fragNormal = normalize(cofactor * n);
+
+    fragColor = color * instanceColor;
+    gl_Position = frame.viewProjection * model * vec4(position, 1.0);
+}
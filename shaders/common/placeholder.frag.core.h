@@ -0,0 +1,6 @@
+#pragma once
+
+// Auto-generated from placeholder.frag.glsl
+// Do not edit this file manually
+
+const char* const PLACEHOLDER_FRAGMENT_SHADER = "#version 330 core\n\nout vec4 finalColor;\n\nvoid main()\n{\n    finalColor = vec4(0.5, 0.5, 0.5, 1.0);\n}";
@@ -0,0 +1,8 @@
+#version 330 core
+
+out vec4 finalColor;
+
+void main()
+{
+    finalColor = vec4(0.5, 0.5, 0.5, 1.0);
+}
@@ -0,0 +1,21 @@
+#version 330 core
+
+// 占位着色器: 正式程序异步编译完成前使用，只依赖位置属性
+layout(location = 0) in vec3 position;
+
+// 帧全局数据: 每帧由帧循环写入一次，绑定到 UniformBinding::Frame
+layout(std140) uniform FrameBlock
+{
+    mat4 projection;
+    mat4 view;
+    mat4 viewProjection;
+    vec4 viewport;
+    vec4 timing;
+} frame;
+
+uniform mat4 model;
+
+void main()
+{
+    gl_Position = frame.viewProjection * model * vec4(position, 1.0);
+}
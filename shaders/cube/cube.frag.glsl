@@ -3,7 +3,15 @@
 in vec2 fragTexCoord;
 out vec4 finalColor;
 
+// 由 TextureManager 提供 (加载完成前为占位棋盘格)；hasTexture 为0时使用纹理坐标渐变
+uniform sampler2D diffuseTexture;
+uniform int hasTexture;
+
 void main()
 {
-    finalColor = vec4(fragTexCoord.x, fragTexCoord.y, 0.5, 1.0);
+    if (hasTexture != 0) {
+        finalColor = texture(diffuseTexture, fragTexCoord);
+    } else {
+        finalColor = vec4(fragTexCoord.x, fragTexCoord.y, 0.5, 1.0);
+    }
 }
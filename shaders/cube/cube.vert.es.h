@@ -0,0 +1,6 @@
+#pragma once
+
+// Auto-generated from cube.vert.glsl
+// Do not edit this file manually
+
+const char* const CUBE_VERTEX_SHADER = "#version 310 es\n\n\nprecision highp float;\nlayout(location = 0) in vec3 position;\nlayout(location = 1) in vec2 texcoord;\n\nout vec2 fragTexCoord;\n\nlayout(std140) uniform FrameBlock\n{\n    mat4 projection;\n    mat4 view;\n    mat4 viewProjection;\n    vec4 viewport;\n    vec4 timing;\n} frame;\n\nuniform mat4 model;\n\nvoid main()\n{\n    gl_Position = frame.viewProjection * model * vec4(position, 1.0);\n    fragTexCoord = texcoord;\n}";
@@ -0,0 +1,6 @@
+#pragma once
+
+// Auto-generated from cube_instanced.frag.glsl
+// Do not edit this file manually
+
+const char* const CUBE_INSTANCED_FRAGMENT_SHADER = "#version 310 es\n\n\nprecision highp float;\nprecision highp sampler2DArray;\nin vec2 fragTexCoord;\nin vec3 fragAtlasCoord;\nin vec4 fragColor;\nout vec4 finalColor;\n\nuniform sampler2D diffuseTexture;\nuniform int hasTexture;\n\nuniform sampler2DArray atlasTexture;\nuniform int hasAtlas;\n\nvoid main()\n{\n\n    vec4 baseColor;\n    if (hasAtlas != 0) {\n        baseColor = texture(atlasTexture, fragAtlasCoord);\n    } else if (hasTexture != 0) {\n        baseColor = texture(diffuseTexture, fragTexCoord);\n    } else {\n        baseColor = vec4(fragTexCoord.x, fragTexCoord.y, 0.5, 1.0);\n    }\n    finalColor = baseColor * fragColor;\n}";
@@ -0,0 +1,28 @@
+#version 330 core
+
+in vec2 fragTexCoord;
+in vec3 fragAtlasCoord;
+in vec4 fragColor;
+out vec4 finalColor;
+
+// 由 TextureManager 提供 (加载完成前为占位棋盘格)；hasTexture 为0时使用纹理坐标渐变
+uniform sampler2D diffuseTexture;
+uniform int hasTexture;
+
+// 由 TextureAtlas 提供，所有实例共用一次绑定；hasAtlas 非0时优先
+uniform sampler2DArray atlasTexture;
+uniform int hasAtlas;
+
+void main()
+{
+    // 基础色 (图集/纹理或纹理坐标渐变) x 实例颜色
+    vec4 baseColor;
+    if (hasAtlas != 0) {
+        baseColor = texture(atlasTexture, fragAtlasCoord);
+    } else if (hasTexture != 0) {
+        baseColor = texture(diffuseTexture, fragTexCoord);
+    } else {
+        baseColor = vec4(fragTexCoord.x, fragTexCoord.y, 0.5, 1.0);
+    }
+    finalColor = baseColor * fragColor;
+}
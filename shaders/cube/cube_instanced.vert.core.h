@@ -0,0 +1,6 @@
+#pragma once
+
+// Auto-generated from cube_instanced.vert.glsl
+// Do not edit this file manually
+
+const char* const CUBE_INSTANCED_VERTEX_SHADER = "#version 330 core\n\nlayout(location = 0) in vec3 position;\nlayout(location = 1) in vec2 texcoord;\n\nlayout(location = 2) in mat4 instanceModel;\nlayout(location = 6) in vec4 instanceColor;\n\nlayout(location = 7) in vec4 instanceAtlasRect;\nlayout(location = 8) in float instanceAtlasLayer;\n\nout vec2 fragTexCoord;\nout vec3 fragAtlasCoord;\nout vec4 fragColor;\n\nlayout(std140) uniform FrameBlock\n{\n    mat4 projection;\n    mat4 view;\n    mat4 viewProjection;\n    vec4 viewport;\n    vec4 timing;\n} frame;\n\nvoid main()\n{\n    gl_Position = frame.viewProjection * instanceModel * vec4(position, 1.0);\n    fragTexCoord = texcoord;\n    fragAtlasCoord = vec3(instanceAtlasRect.xy + texcoord * instanceAtlasRect.zw, instanceAtlasLayer);\n    fragColor = instanceColor;\n}";
@@ -0,0 +1,35 @@
+#version 330 core
+
+// 逐顶点属性
+layout(location = 0) in vec3 position;
+layout(location = 1) in vec2 texcoord;
+
+// 逐实例属性 (glVertexAttribDivisor = 1)
+// mat4 占用 location 2~5 四个槽位
+layout(location = 2) in mat4 instanceModel;
+layout(location = 6) in vec4 instanceColor;
+// 图集子纹理: xy 偏移、zw 缩放，层号为数组纹理的层
+layout(location = 7) in vec4 instanceAtlasRect;
+layout(location = 8) in float instanceAtlasLayer;
+
+out vec2 fragTexCoord;
+out vec3 fragAtlasCoord;
+out vec4 fragColor;
+
+// 帧全局数据: 每帧由帧循环写入一次，绑定到 UniformBinding::Frame
+layout(std140) uniform FrameBlock
+{
+    mat4 projection;
+    mat4 view;
+    mat4 viewProjection;
+    vec4 viewport;
+    vec4 timing;
+} frame;
+
+void main()
+{
+    gl_Position = frame.viewProjection * instanceModel * vec4(position, 1.0);
+    fragTexCoord = texcoord;
+    fragAtlasCoord = vec3(instanceAtlasRect.xy + texcoord * instanceAtlasRect.zw, instanceAtlasLayer);
+    fragColor = instanceColor;
+}
@@ -0,0 +1,6 @@
+#pragma once
+
+// Auto-generated from mesh.frag.glsl
+// Do not edit this file manually
+
+const char* const MESH_FRAGMENT_SHADER = "#version 310 es\n\n\nprecision highp float;\nin vec3 fragNormal;\nin vec2 fragTexCoord;\nin vec4 fragColor;\nout vec4 finalColor;\n\nvoid main()\n{\n\n    vec3 lightDirection = normalize(vec3(0.4, 0.7, 0.6));\n    float diffuse = max(dot(normalize(fragNormal), lightDirection), 0.0);\n    finalColor = vec4(fragColor.rgb * (0.25 + 0.75 * diffuse), 1.0);\n}";
@@ -0,0 +1,47 @@
+#version 330 core
+
+// 与 MeshImporter 写出的属性 location 对应
+layout(location = 0) in vec3 position;
+layout(location = 1) in vec3 normal;        // 八面体编码时只有 xy 有效 (z 默认为 0)
+layout(location = 2) in vec2 texcoord;
+layout(location = 3) in vec4 color;
+
+out vec3 fragNormal;
+out vec2 fragTexCoord;
+out vec4 fragColor;
+
+// 帧全局数据: 每帧由帧循环写入一次，绑定到 UniformBinding::Frame
+layout(std140) uniform FrameBlock
+{
+    mat4 projection;
+    mat4 view;
+    mat4 viewProjection;
+    vec4 viewport;
+    vec4 timing;
+} frame;
+
+uniform mat4 model;                         // 已包含位置反量化矩阵
+uniform int octNormals;
+
+vec3 octDecode(vec2 e)
+{
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    if (n.z < 0.0) {
+        n.xy = (1.0 - abs(n.yx)) * vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+    }
+    return n;
+}
+
+void main()
+{
+    vec3 n = octNormals != 0 ? octDecode(normal.xy) : normal;
+
+    // 法线变换用余子式矩阵 (与逆转置只差一个标量倍数)，反量化的非均匀缩放也能正确处理
+    mat3 m = mat3(model);
+    mat3 cofactor = mat3(cross(m[1], m[2]), cross(m[2], m[0]), cross(m[0], m[1]));
+    fragNormal = normalize(cofactor * n);
+
+    fragTexCoord = texcoord;
+    fragColor = color;
+    gl_Position = frame.viewProjection * model * vec4(position, 1.0);
+}
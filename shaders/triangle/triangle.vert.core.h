@@ -3,4 +3,4 @@
 // Auto-generated from triangle.vert.glsl
 // Do not edit this file manually
 
-const char* const TRIANGLE_VERTEX_SHADER = "#version 330 core\n\nlayout(location = 0) in vec3 position;\nlayout(location = 1) in vec3 color;\n\nout vec3 fragColor;\n\nuniform mat4 mvp;\n\nvoid main()\n{\n    gl_Position = mvp * vec4(position, 1.0);\n    fragColor = color;\n}";
+const char* const TRIANGLE_VERTEX_SHADER = "#version 330 core\n\nlayout(location = 0) in vec3 position;\nlayout(location = 1) in vec3 color;\n\nout vec3 fragColor;\n\nlayout(std140) uniform FrameBlock\n{\n    mat4 projection;\n    mat4 view;\n    mat4 viewProjection;\n    vec4 viewport;\n    vec4 timing;\n} frame;\n\nuniform mat4 model;\n\nvoid main()\n{\n    gl_Position = frame.viewProjection * model * vec4(position, 1.0);\n    fragColor = color;\n}";
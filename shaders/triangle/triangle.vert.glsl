@@ -5,10 +5,20 @@ layout(location = 1) in vec3 color;
 
 out vec3 fragColor;
 
-uniform mat4 mvp;
+// 帧全局数据: 每帧由帧循环写入一次，绑定到 UniformBinding::Frame
+layout(std140) uniform FrameBlock
+{
+    mat4 projection;
+    mat4 view;
+    mat4 viewProjection;
+    vec4 viewport;
+    vec4 timing;
+} frame;
+
+uniform mat4 model;
 
 void main()
 {
-    gl_Position = mvp * vec4(position, 1.0);
+    gl_Position = frame.viewProjection * model * vec4(position, 1.0);
     fragColor = color;
 }
@@ -0,0 +1,67 @@
+/**
+ * @file mesh_import.cpp
+ * @brief 离线网格导入工具 - 把 OBJ/glTF/FBX 等模型转换为运行时内存映射加载的 .meshbin
+ *
+ * 用法:
+ *   mesh_import <input> <output.meshbin> [--format float|compact] [--flip-uvs] [--no-optimize]
+ *
+ *   --format      顶点存储格式 (默认 compact: snorm16位置/八面体法线/unorm16 UV/RGBA8颜色)
+ *   --flip-uvs    翻转V坐标
+ *   --no-optimize 跳过 MeshOptimizer (保留源文件的顶点/三角形顺序)
+ */
+
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "mesh_importer.hpp"
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "Usage: mesh_import <input> <output.meshbin> [--format float|compact] [--flip-uvs] [--no-optimize]" << std::endl;
+        return -1;
+    }
+
+    const std::string inputPath = argv[1];
+    const std::string outputPath = argv[2];
+    MeshImportOptions options;
+
+    for (int i = 3; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--format") == 0 && hasValue) {
+            const std::string format = argv[++i];
+            if (format == "float") {
+                options.format = VertexFormat();
+            } else if (format == "compact") {
+                options.format = VertexFormat::compact();
+            } else {
+                std::cerr << "Invalid --format, expected float or compact" << std::endl;
+                return -1;
+            }
+        } else if (std::strcmp(argv[i], "--flip-uvs") == 0) {
+            options.flipUVs = true;
+        } else if (std::strcmp(argv[i], "--no-optimize") == 0) {
+            options.optimize = false;
+        } else {
+            std::cerr << "Unknown argument: " << argv[i] << std::endl;
+            return -1;
+        }
+    }
+
+    MeshImportStats stats;
+    std::string error;
+    if (!MeshImporter::importFile(inputPath, outputPath, options, stats, error)) {
+        std::cerr << error << std::endl;
+        return -1;
+    }
+
+    std::cout << inputPath << " -> " << outputPath << "\n"
+              << "  submeshes: " << stats.submeshes << "\n"
+              << "  vertices:  " << stats.vertices << " (" << stats.vertexBytes / stats.vertices << " bytes each)\n"
+              << "  triangles: " << stats.triangles << "\n"
+              << "  file size: " << stats.fileBytes << " bytes\n";
+    if (options.optimize) {
+        std::cout << "  ACMR:      " << stats.acmrBefore << " -> " << stats.acmrAfter << "\n";
+    }
+    return 0;
+}